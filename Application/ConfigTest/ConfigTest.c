@@ -0,0 +1,638 @@
+///
+/// @file Application/ConfigTest/ConfigTest.c
+///
+/// Configuration regression tests
+///
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/ConfigLib.h>
+#include <Library/LogLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/StringLib.h>
+
+// CONFIG_TEST_PATH
+/// The configuration path below which the tests set values, which is freed when the tests finish
+#define CONFIG_TEST_PATH L"\\ConfigTest"
+
+// CONFIG_TEST_RUN
+/// Run a configuration test
+/// @return Whether the test passed or not
+/// @retval EFI_ABORTED If the test failed
+/// @retval EFI_SUCCESS If the test passed
+typedef EFI_STATUS
+(EFIAPI
+*CONFIG_TEST_RUN) (
+  VOID
+);
+
+// CONFIG_TEST
+/// Configuration test
+typedef struct _CONFIG_TEST CONFIG_TEST;
+struct _CONFIG_TEST {
+
+  // Name
+  /// The name of the test
+  CHAR16          *Name;
+  // Run
+  /// Run the test
+  CONFIG_TEST_RUN  Run;
+
+};
+
+// ConfigTestUnsigned
+/// Check an unsigned integer configuration value is found with the expected value
+/// @param Path     The path of the configuration value
+/// @param Unsigned The expected unsigned integer configuration value
+/// @retval TRUE  If the configuration value was found with the expected value
+/// @retval FALSE If the configuration value was not found or has another type or value
+STATIC BOOLEAN
+EFIAPI
+ConfigTestUnsigned (
+  IN CHAR16 *Path,
+  IN UINTN   Unsigned
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_UNSIGNED) || (Value.Unsigned != Unsigned)) {
+    Log2(L"  Mismatch:", L"\"%s\"\n", Path);
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// ConfigTestSeparators
+/// Check that a path to a value with trailing or repeated separators still finds the value
+/// @return Whether the test passed or not
+/// @retval EFI_ABORTED If the test failed
+/// @retval EFI_SUCCESS If the test passed
+STATIC EFI_STATUS
+EFIAPI
+ConfigTestSeparators (
+  VOID
+) {
+  EFI_STATUS Status = ConfigSetUnsigned(CONFIG_TEST_PATH L"\\Separators\\A\\B", 1);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (!ConfigTestUnsigned(CONFIG_TEST_PATH L"\\Separators\\A\\B", 1) ||
+      !ConfigTestUnsigned(CONFIG_TEST_PATH L"\\Separators\\A\\B\\", 1) ||
+      !ConfigTestUnsigned(CONFIG_TEST_PATH L"\\Separators\\A\\B\\\\", 1) ||
+      !ConfigTestUnsigned(CONFIG_TEST_PATH L"\\\\Separators\\\\A\\\\B", 1)) {
+    return EFI_ABORTED;
+  }
+  return EFI_SUCCESS;
+}
+
+// mConfigTestOrderPaths
+/// The relative paths set directly and in a transaction, which are deliberately not in path order
+STATIC CHAR16 *mConfigTestOrderPaths[] = {
+  L"Zeta",
+  L"10\\B",
+  L"2\\A",
+  L"10\\A",
+  L"Alpha",
+};
+// mConfigTestOrderLists
+/// The lists of which the children must be in the same order whether set directly or in a transaction
+STATIC CHAR16 *mConfigTestOrderLists[][2] = {
+  { CONFIG_TEST_PATH L"\\Direct",     CONFIG_TEST_PATH L"\\Staged" },
+  { CONFIG_TEST_PATH L"\\Direct\\10", CONFIG_TEST_PATH L"\\Staged\\10" },
+  { CONFIG_TEST_PATH L"\\Direct\\2",  CONFIG_TEST_PATH L"\\Staged\\2" },
+};
+
+// ConfigTestOrderSet
+/// Set the configuration values of the order test below a base path
+/// @param Base The path relative to the test path below which to set the values
+/// @return Whether the configuration values were set or not
+STATIC EFI_STATUS
+EFIAPI
+ConfigTestOrderSet (
+  IN CHAR16 *Base
+) {
+  EFI_STATUS    Status;
+  CONFIG_VALUE  Value;
+  CHAR16       *Segments[3];
+  UINTN         Index;
+  Segments[0] = CONFIG_TEST_PATH;
+  Segments[1] = Base;
+  for (Index = 0; Index < ARRAY_SIZE(mConfigTestOrderPaths); ++Index) {
+    Segments[2] = mConfigTestOrderPaths[Index];
+    Value.Unsigned = Index;
+    Status = ConfigSetSegmentsValue(Segments, ARRAY_SIZE(Segments), CONFIG_TYPE_UNSIGNED, &Value);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  return EFI_SUCCESS;
+}
+// ConfigTestSameChildren
+/// Check two configuration lists have children with the same names in the same order
+/// @param Path  The path of the first list
+/// @param Other The path of the second list
+/// @retval TRUE  If both lists have the same children in the same order
+/// @retval FALSE If the lists were not found or the children differ
+STATIC BOOLEAN
+EFIAPI
+ConfigTestSameChildren (
+  IN CHAR16 *Path,
+  IN CHAR16 *Other
+) {
+  CONFIG_ITERATOR Iterator;
+  CONFIG_ITERATOR OtherIterator;
+  EFI_STATUS      Status;
+  EFI_STATUS      OtherStatus;
+  BOOLEAN         Same = TRUE;
+  if (EFI_ERROR(ConfigIteratorStart(Path, &Iterator))) {
+    Log2(L"  Missing:", L"\"%s\"\n", Path);
+    return FALSE;
+  }
+  if (EFI_ERROR(ConfigIteratorStart(Other, &OtherIterator))) {
+    Log2(L"  Missing:", L"\"%s\"\n", Other);
+    ConfigIteratorFinish(&Iterator);
+    return FALSE;
+  }
+  // Walk both lists together until either ends
+  do {
+    Status = ConfigIteratorNext(&Iterator);
+    OtherStatus = ConfigIteratorNext(&OtherIterator);
+    if ((Status != OtherStatus) || (!EFI_ERROR(Status) && (StrCmp(Iterator.Name, OtherIterator.Name) != 0))) {
+      Log2(L"  Order:", L"\"%s\" differs from \"%s\"\n", Path, Other);
+      Same = FALSE;
+      break;
+    }
+  } while (!EFI_ERROR(Status));
+  ConfigIteratorFinish(&OtherIterator);
+  ConfigIteratorFinish(&Iterator);
+  return Same;
+}
+// ConfigTestTransactionOrder
+/// Check that values set in a transaction create the same tree as values set directly
+/// @return Whether the test passed or not
+/// @retval EFI_ABORTED If the test failed
+/// @retval EFI_SUCCESS If the test passed
+STATIC EFI_STATUS
+EFIAPI
+ConfigTestTransactionOrder (
+  VOID
+) {
+  EFI_STATUS Status;
+  UINTN      Index;
+  // Set the values directly and then the same values in a transaction
+  Status = ConfigTestOrderSet(L"Direct");
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  Status = ConfigTransactionBegin();
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  Status = ConfigTestOrderSet(L"Staged");
+  if (EFI_ERROR(Status)) {
+    ConfigTransactionAbort();
+    return Status;
+  }
+  Status = ConfigTransactionCommit();
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Compare the children of each list
+  for (Index = 0; Index < ARRAY_SIZE(mConfigTestOrderLists); ++Index) {
+    if (!ConfigTestSameChildren(mConfigTestOrderLists[Index][0], mConfigTestOrderLists[Index][1])) {
+      return EFI_ABORTED;
+    }
+  }
+  return EFI_SUCCESS;
+}
+
+// ConfigTestSameValue
+/// Check two configuration values have the same type and value
+/// @param Segments      The path segments of the first configuration value
+/// @param OtherSegments The path segments of the second configuration value
+/// @param Count         The count of path segments of each configuration value
+/// @retval TRUE  If both configuration values were found with the same type and value
+/// @retval FALSE If either configuration value was not found or the types or values differ
+STATIC BOOLEAN
+EFIAPI
+ConfigTestSameValue (
+  IN CHAR16 **Segments,
+  IN CHAR16 **OtherSegments,
+  IN UINTN    Count
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_TYPE  OtherType = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  CONFIG_VALUE OtherValue;
+  BOOLEAN      Same;
+  if (EFI_ERROR(ConfigGetSegmentsValue(Segments, Count, &Type, &Value)) ||
+      EFI_ERROR(ConfigGetSegmentsValue(OtherSegments, Count, &OtherType, &OtherValue)) ||
+      (Type != OtherType)) {
+    Log2(L"  Mismatch:", L"\"%s\"\n", Segments[Count - 1]);
+    return FALSE;
+  }
+  // Compare the values by type
+  switch (Type) {
+    case CONFIG_TYPE_BOOLEAN:
+      Same = (Value.Boolean == OtherValue.Boolean);
+      break;
+
+    case CONFIG_TYPE_INTEGER:
+      Same = (Value.Integer == OtherValue.Integer);
+      break;
+
+    case CONFIG_TYPE_UNSIGNED:
+      Same = (Value.Unsigned == OtherValue.Unsigned);
+      break;
+
+    case CONFIG_TYPE_STRING:
+      Same = ((Value.String != NULL) && (OtherValue.String != NULL) && (StrCmp(Value.String, OtherValue.String) == 0));
+      break;
+
+    case CONFIG_TYPE_DATA:
+      Same = ((Value.Data.Size == OtherValue.Data.Size) &&
+              ((Value.Data.Size == 0) || (CompareMem(Value.Data.Data, OtherValue.Data.Data, Value.Data.Size) == 0)));
+      break;
+
+    default:
+      Same = TRUE;
+      break;
+  }
+  if (!Same) {
+    Log2(L"  Mismatch:", L"\"%s\"\n", Segments[Count - 1]);
+  }
+  return Same;
+}
+
+// ConfigTestKeyRegeneration
+/// Check that a configuration key handle finds a value that was freed and set again
+/// @return Whether the test passed or not
+/// @retval EFI_ABORTED If the test failed
+/// @retval EFI_SUCCESS If the test passed
+STATIC EFI_STATUS
+EFIAPI
+ConfigTestKeyRegeneration (
+  VOID
+) {
+  EFI_STATUS    Status;
+  CONFIG_KEY   *Key = NULL;
+  CONFIG_TYPE   Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE  Value;
+  Status = ConfigSetUnsigned(CONFIG_TEST_PATH L"\\Key\\Value", 1);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  Status = ConfigKeyOpen(CONFIG_TEST_PATH L"\\Key\\Value", &Key);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // The key finds the value, then nothing once freed, then the value set again
+  Status = EFI_ABORTED;
+  if (EFI_ERROR(ConfigKeyGetValue(Key, &Type, &Value)) || (Type != CONFIG_TYPE_UNSIGNED) || (Value.Unsigned != 1)) {
+    Log2(L"  Mismatch:", L"\"%s\"\n", CONFIG_TEST_PATH L"\\Key\\Value");
+  } else {
+    ConfigPartialFree(CONFIG_TEST_PATH L"\\Key");
+    if (!EFI_ERROR(ConfigKeyGetValue(Key, &Type, &Value))) {
+      Log2(L"  Stale:", L"\"%s\"\n", CONFIG_TEST_PATH L"\\Key\\Value");
+    } else if (!EFI_ERROR(ConfigSetUnsigned(CONFIG_TEST_PATH L"\\Key\\Value", 2))) {
+      if (EFI_ERROR(ConfigKeyGetValue(Key, &Type, &Value)) || (Type != CONFIG_TYPE_UNSIGNED) || (Value.Unsigned != 2)) {
+        Log2(L"  Mismatch:", L"\"%s\"\n", CONFIG_TEST_PATH L"\\Key\\Value");
+      } else {
+        Status = EFI_SUCCESS;
+      }
+    }
+  }
+  ConfigKeyClose(Key);
+  return Status;
+}
+
+// mConfigTestRecordData
+/// The data configuration value of the compiled records test
+STATIC UINT8 mConfigTestRecordData[] = { 0x00, 0x01, 0x7F, 0x80, 0xFF };
+// mConfigTestRecordPaths
+/// The relative paths of the configuration values of the compiled records test
+STATIC CHAR16 *mConfigTestRecordPaths[] = {
+  L"Boolean",
+  L"Integer",
+  L"Unsigned",
+  L"String",
+  L"Data",
+  L"List\\Nested",
+  L"List\\Blank",
+};
+
+// ConfigTestRecords
+/// Check that every type of configuration value is the same after being written to and parsed from compiled configuration records
+/// @return Whether the test passed or not
+/// @retval EFI_ABORTED If the test failed
+/// @retval EFI_SUCCESS If the test passed
+STATIC EFI_STATUS
+EFIAPI
+ConfigTestRecords (
+  VOID
+) {
+  EFI_STATUS  Status;
+  CHAR16     *Segments[3];
+  CHAR16     *OtherSegments[3];
+  VOID       *Buffer = NULL;
+  UINTN       Size = 0;
+  UINTN       Index;
+  // Set a value of each type
+  Status = ConfigSetBoolean(CONFIG_TEST_PATH L"\\Records\\Source\\Boolean", TRUE);
+  if (!EFI_ERROR(Status)) {
+    Status = ConfigSetInteger(CONFIG_TEST_PATH L"\\Records\\Source\\Integer", -5);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = ConfigSetUnsigned(CONFIG_TEST_PATH L"\\Records\\Source\\Unsigned", 7);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = ConfigSetString(CONFIG_TEST_PATH L"\\Records\\Source\\String", L"Text");
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = ConfigSetData(CONFIG_TEST_PATH L"\\Records\\Source\\Data", sizeof(mConfigTestRecordData), mConfigTestRecordData);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = ConfigSetUnsigned(CONFIG_TEST_PATH L"\\Records\\Source\\List\\Nested", 9);
+  }
+  if (!EFI_ERROR(Status)) {
+    Status = ConfigSetString(CONFIG_TEST_PATH L"\\Records\\Source\\List\\Blank", L"");
+  }
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Write the records and parse them below another path
+  Status = ConfigExport(CONFIG_TEST_PATH L"\\Records\\Source", &Size, &Buffer);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  Status = ConfigImport(CONFIG_TEST_PATH L"\\Records\\Copy", Size, Buffer);
+  FreePool(Buffer);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Compare each value
+  Segments[0] = OtherSegments[0] = CONFIG_TEST_PATH;
+  Segments[1] = L"Records\\Source";
+  OtherSegments[1] = L"Records\\Copy";
+  for (Index = 0; Index < ARRAY_SIZE(mConfigTestRecordPaths); ++Index) {
+    Segments[2] = OtherSegments[2] = mConfigTestRecordPaths[Index];
+    if (!ConfigTestSameValue(Segments, OtherSegments, ARRAY_SIZE(Segments))) {
+      return EFI_ABORTED;
+    }
+  }
+  return ConfigTestSameChildren(CONFIG_TEST_PATH L"\\Records\\Source", CONFIG_TEST_PATH L"\\Records\\Copy") ? EFI_SUCCESS : EFI_ABORTED;
+}
+
+// ConfigTestIterator
+/// Check that a configuration child enumeration is aborted once a configuration value is freed
+/// @return Whether the test passed or not
+/// @retval EFI_ABORTED If the test failed
+/// @retval EFI_SUCCESS If the test passed
+STATIC EFI_STATUS
+EFIAPI
+ConfigTestIterator (
+  VOID
+) {
+  EFI_STATUS      Status;
+  CONFIG_ITERATOR Iterator;
+  Status = ConfigSetUnsigned(CONFIG_TEST_PATH L"\\Iterator\\A", 1);
+  if (!EFI_ERROR(Status)) {
+    Status = ConfigSetUnsigned(CONFIG_TEST_PATH L"\\Iterator\\B", 2);
+  }
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  Status = ConfigIteratorStart(CONFIG_TEST_PATH L"\\Iterator", &Iterator);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Free the next child after advancing to the first child
+  Status = ConfigIteratorNext(&Iterator);
+  if (!EFI_ERROR(Status)) {
+    ConfigPartialFree(CONFIG_TEST_PATH L"\\Iterator\\B");
+    Status = ConfigIteratorNext(&Iterator);
+    if (Status != EFI_ABORTED) {
+      Log2(L"  Stale:", L"%r\n", Status);
+      Status = EFI_ABORTED;
+    } else {
+      Status = EFI_SUCCESS;
+    }
+  }
+  ConfigIteratorFinish(&Iterator);
+  return Status;
+}
+
+// mConfigTestEncoded
+/// The configuration with encoded data values that are decoded on first read
+STATIC CHAR8 mConfigTestEncoded[] =
+  "<?xml version=\"1.0\"?>"
+  "<configuration>"
+  "<ConfigTest>"
+  "<Encoded>"
+  "<Whole><data>QUJD</data></Whole>"
+  "<Padded><data>QUJDRA==</data></Padded>"
+  "<Unpadded><data>QUJDRA</data></Unpadded>"
+  "<Spaced><data> QU JD RE VG </data></Spaced>"
+  "<Single><data>QQ==</data></Single>"
+  "</Encoded>"
+  "</ConfigTest>"
+  "</configuration>";
+// mConfigTestEncodedValues
+/// The relative paths and base64 strings of the encoded data values
+STATIC CHAR16 *mConfigTestEncodedValues[][2] = {
+  { L"Whole",    L"QUJD" },
+  { L"Padded",   L"QUJDRA==" },
+  { L"Unpadded", L"QUJDRA" },
+  { L"Spaced",   L" QU JD RE VG " },
+  { L"Single",   L"QQ==" },
+};
+
+// ConfigTestEncoded
+/// Check that encoded data configuration values decode to the same data as FromBase64
+/// @return Whether the test passed or not
+/// @retval EFI_ABORTED If the test failed
+/// @retval EFI_SUCCESS If the test passed
+STATIC EFI_STATUS
+EFIAPI
+ConfigTestEncoded (
+  VOID
+) {
+  EFI_STATUS    Status;
+  CHAR16       *Segments[3];
+  CONFIG_TYPE   Type;
+  CONFIG_VALUE  Value;
+  VOID         *Data;
+  UINTN         Size;
+  UINTN         Index;
+  Status = ConfigParse(sizeof(mConfigTestEncoded) - 1, mConfigTestEncoded);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Compare each decoded value
+  Segments[0] = CONFIG_TEST_PATH;
+  Segments[1] = L"Encoded";
+  for (Index = 0; Index < ARRAY_SIZE(mConfigTestEncodedValues); ++Index) {
+    Segments[2] = mConfigTestEncodedValues[Index][0];
+    Type = CONFIG_TYPE_UNKNOWN;
+    Data = NULL;
+    Size = 0;
+    if (EFI_ERROR(FromBase64(mConfigTestEncodedValues[Index][1], &Size, &Data)) ||
+        EFI_ERROR(ConfigGetSegmentsValue(Segments, ARRAY_SIZE(Segments), &Type, &Value)) ||
+        (Type != CONFIG_TYPE_DATA) || (Value.Data.Size != Size) ||
+        ((Size != 0) && (CompareMem(Value.Data.Data, Data, Size) != 0))) {
+      Log2(L"  Mismatch:", L"\"%s\"\n", Segments[2]);
+      Status = EFI_ABORTED;
+    }
+    if (Data != NULL) {
+      FreePool(Data);
+    }
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  return EFI_SUCCESS;
+}
+
+// mConfigTestExportPaths
+/// The relative paths of the unsigned integer configuration values of the export and import test
+STATIC CHAR16 *mConfigTestExportPaths[] = {
+  L"A",
+  L"B",
+  L"C",
+  L"D",
+};
+
+// ConfigTestExportCopy
+/// Check the unsigned integer configuration values of the export and import test were imported
+/// @retval TRUE  If every configuration value was found with the expected value
+/// @retval FALSE If any configuration value was not found or has another type or value
+STATIC BOOLEAN
+EFIAPI
+ConfigTestExportCopy (
+  VOID
+) {
+  CHAR16       *Segments[3];
+  CONFIG_TYPE   Type;
+  CONFIG_VALUE  Value;
+  UINTN         Index;
+  Segments[0] = CONFIG_TEST_PATH;
+  Segments[1] = L"Export\\Copy";
+  for (Index = 0; Index < ARRAY_SIZE(mConfigTestExportPaths); ++Index) {
+    Segments[2] = mConfigTestExportPaths[Index];
+    Type = CONFIG_TYPE_UNKNOWN;
+    if (EFI_ERROR(ConfigGetSegmentsValue(Segments, ARRAY_SIZE(Segments), &Type, &Value)) ||
+        (Type != CONFIG_TYPE_UNSIGNED) || (Value.Unsigned != Index)) {
+      Log2(L"  Mismatch:", L"\"%s\"\n", Segments[2]);
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+// ConfigTestExport
+/// Check that exported configuration imports to the same values, that corrupted exported configuration is rejected
+///  without changing the configuration path and that importing is refused while a transaction is open
+/// @return Whether the test passed or not
+/// @retval EFI_ABORTED If the test failed
+/// @retval EFI_SUCCESS If the test passed
+STATIC EFI_STATUS
+EFIAPI
+ConfigTestExport (
+  VOID
+) {
+  EFI_STATUS    Status;
+  CHAR16       *Segments[3];
+  CONFIG_VALUE  Value;
+  VOID         *Buffer = NULL;
+  UINT8        *Corrupt;
+  UINTN         Size = 0;
+  UINTN         Index;
+  // Set the values, ending with a string so the last record can be truncated
+  Segments[0] = CONFIG_TEST_PATH;
+  Segments[1] = L"Export\\Source";
+  for (Index = 0; Index < ARRAY_SIZE(mConfigTestExportPaths); ++Index) {
+    Segments[2] = mConfigTestExportPaths[Index];
+    Value.Unsigned = Index;
+    Status = ConfigSetSegmentsValue(Segments, ARRAY_SIZE(Segments), CONFIG_TYPE_UNSIGNED, &Value);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  Status = ConfigSetString(CONFIG_TEST_PATH L"\\Export\\Source\\Name", L"Source");
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Export and import below another path
+  Status = ConfigExport(CONFIG_TEST_PATH L"\\Export\\Source", &Size, &Buffer);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  Status = ConfigImport(CONFIG_TEST_PATH L"\\Export\\Copy", Size, Buffer);
+  if (EFI_ERROR(Status) || !ConfigTestExportCopy()) {
+    FreePool(Buffer);
+    return EFI_ERROR(Status) ? Status : EFI_ABORTED;
+  }
+  // Overwrite the records after the header, the import must fail and leave the imported values
+  Status = EFI_ABORTED;
+  Corrupt = (UINT8 *)AllocateCopyPool(Size, Buffer);
+  if (Corrupt == NULL) {
+    FreePool(Buffer);
+    return EFI_OUT_OF_RESOURCES;
+  }
+  SetMem(Corrupt + (Size >> 1), Size - (Size >> 1), 0xFF);
+  if (!EFI_ERROR(ConfigImport(CONFIG_TEST_PATH L"\\Export\\Copy", Size, Corrupt))) {
+    Log2(L"  Imported:", L"\"%s\"\n", L"Corrupt");
+  } else if (ConfigTestExportCopy() && !EFI_ERROR(ConfigTransactionBegin())) {
+    // Importing while a transaction is open must be refused
+    if (ConfigImport(CONFIG_TEST_PATH L"\\Export\\Copy", Size, Buffer) != EFI_NOT_READY) {
+      Log2(L"  Imported:", L"\"%s\"\n", L"Transaction");
+    } else {
+      Status = EFI_SUCCESS;
+    }
+    ConfigTransactionAbort();
+  }
+  FreePool(Corrupt);
+  FreePool(Buffer);
+  return Status;
+}
+
+// mConfigTests
+/// The configuration tests
+STATIC CONFIG_TEST mConfigTests[] = {
+  { L"Trailing separators:",   ConfigTestSeparators },
+  { L"Transaction order:",     ConfigTestTransactionOrder },
+  { L"Key regeneration:",      ConfigTestKeyRegeneration },
+  { L"Compiled records:",      ConfigTestRecords },
+  { L"Iterator invalidation:", ConfigTestIterator },
+  { L"Encoded data:",          ConfigTestEncoded },
+  { L"Export and import:",     ConfigTestExport },
+};
+
+// ConfigTestMain
+/// Configuration regression tests entry point
+/// @param ImageHandle The assigned image handle for this application
+/// @param SystemTable The EFI system table
+/// @return Whether every test passed or not
+/// @retval EFI_ABORTED If any test failed
+/// @retval EFI_SUCCESS If every test passed
+EFI_STATUS
+EFIAPI
+ConfigTestMain (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE *SystemTable
+) {
+  EFI_STATUS Status = EFI_SUCCESS;
+  EFI_STATUS Result;
+  UINTN      Index;
+  // Run each test from an empty test path
+  for (Index = 0; Index < ARRAY_SIZE(mConfigTests); ++Index) {
+    ConfigPartialFree(CONFIG_TEST_PATH);
+    Result = mConfigTests[Index].Run();
+    Log2(mConfigTests[Index].Name, L"%r\n", Result);
+    if (EFI_ERROR(Result)) {
+      Status = EFI_ABORTED;
+    }
+  }
+  ConfigPartialFree(CONFIG_TEST_PATH);
+  Log2(L"Configuration tests:", L"%r\n", Status);
+  FlushLog();
+  return Status;
+}
@@ -29,6 +29,7 @@ GUIMain (
   CHAR8          **Languages;
   UINTN            Count;
   UINTN            Index;
+  UINTN            Span;
   EFI_INPUT_KEY    Key = { 0 };
 
   // Clear the watchdog timer
@@ -71,10 +72,19 @@ GUIMain (
   Status = GetLanguage(&Language);
   Log2(L"Language:", L"%a\n", (EFI_ERROR(Status) || (Language == NULL)) ? "None" : Language);
 
-  // Run GUI
+  // Run GUI, after showing any buffered log output since the GUI takes over the screen
+  FlushLog();
+  Span = BeginLogSpan(L"GUIRun");
   Status = GUIRun();
+  EndLogSpan(Span);
   Log2(L"GUI status:", L"%r\n", Status);
 
+  // Print which configuration paths were the most costly to look up
+  ConfigLogStatistics();
+
+  // Save how long each boot phase took as a trace that can be opened in a trace viewer
+  Log2(L"Boot trace:", L"%r\n", SaveLogSpans(NULL));
+
   // Print quit
   Log2(L"Runtime:", NULL);
   LogTimestamp();
@@ -83,7 +93,8 @@ GUIMain (
   LogDateAndTime();
   Log(L"\n\n");
 
-  // Wait for key press
+  // Wait for key press, after showing any buffered log output
+  FlushLog();
   while (gST->ConIn->ReadKeyStroke(gST->ConIn, &Key) == EFI_NOT_READY);
 
   // Enable the watchdog timer - 5 minutes (300 seconds)
@@ -75,6 +75,124 @@ union _CONFIG_VALUE {
   CONFIG_DATA  Data;
 
 };
+// CONFIG_QUERY
+/// Configuration batch query descriptor
+typedef struct _CONFIG_QUERY CONFIG_QUERY;
+struct _CONFIG_QUERY {
+
+  // Path
+  /// The path of the configuration value relative to the base path of the query
+  CHAR16       *Path;
+  // Type
+  /// The expected type of the configuration value
+  CONFIG_TYPE   Type;
+  // Default
+  /// The default value used when the configuration value is not found or is another type
+  CONFIG_VALUE  Default;
+  // Value
+  /// On output, the configuration value as BOOLEAN, INTN, UINTN, CHAR16 * or CONFIG_DATA according to Type
+  VOID         *Value;
+
+};
+// CONFIG_ITERATOR
+/// Configuration child enumeration, which needs no allocation unless the configuration can only be read through the protocol of another image
+typedef struct _CONFIG_ITERATOR CONFIG_ITERATOR;
+struct _CONFIG_ITERATOR {
+
+  // Name
+  /// The name of the current child
+  CHAR16        *Name;
+  // Type
+  /// The type of the current child
+  CONFIG_TYPE    Type;
+  // Value
+  /// The value of the current child
+  CONFIG_VALUE   Value;
+  // Path
+  /// The configuration path being enumerated, which must stay valid until the enumeration is finished
+  CHAR16        *Path;
+  // Parent
+  /// The node being enumerated, private to the configuration library
+  VOID          *Parent;
+  // Node
+  /// The current child node, private to the configuration library
+  VOID          *Node;
+  // Snapshot
+  /// The shared configuration snapshot being enumerated, private to the configuration library
+  VOID          *Snapshot;
+  // List
+  /// The child names when enumerating through the configuration protocol, private to the configuration library
+  CHAR16       **List;
+  // Count
+  /// The count of child names when enumerating through the configuration protocol
+  UINTN          Count;
+  // Index
+  /// The index of the current child name when enumerating through the configuration protocol
+  UINTN          Index;
+  // Generation
+  /// The configuration tree generation when the enumeration started
+  UINTN          Generation;
+
+};
+// CONFIG_KEY
+/// Resolved configuration key handle, which is resolved again by path after configuration values are freed or reloaded
+typedef struct _CONFIG_KEY CONFIG_KEY;
+// CONFIG_SUBSCRIPTION
+/// Configuration change subscription for a configuration path prefix
+typedef struct _CONFIG_SUBSCRIPTION CONFIG_SUBSCRIPTION;
+
+// CONFIG_NOTIFY
+/// Configuration change notification callback, which must not unsubscribe any subscription other than its own
+/// @param Prefix  The configuration path prefix of the subscription under which values changed
+/// @param Context The context passed when subscribing
+typedef VOID
+(EFIAPI
+*CONFIG_NOTIFY) (
+  IN CHAR16 *Prefix,
+  IN VOID   *Context OPTIONAL
+);
+
+// CONFIG_SCHEMA
+/// Configuration section schema entry, which fills a native structure field from a configuration value
+typedef struct _CONFIG_SCHEMA CONFIG_SCHEMA;
+struct _CONFIG_SCHEMA {
+
+  // Path
+  /// The path of the configuration value relative to the base path of the section
+  CHAR16      *Path;
+  // Type
+  /// The type of the configuration value
+  CONFIG_TYPE  Type;
+  // Offset
+  /// The offset of the structure field, which is BOOLEAN, INTN, UINTN, CHAR16 * or CONFIG_DATA according to Type
+  UINTN        Offset;
+  // Default
+  /// The default boolean, integer or unsigned integer value
+  UINTN        Default;
+  // DefaultString
+  /// The default string value
+  CHAR16      *DefaultString;
+
+};
+// CONFIG_SCHEMA_BOOLEAN
+/// Declare a boolean configuration section schema entry
+#define CONFIG_SCHEMA_BOOLEAN(Path, Structure, Field, Default) { Path, CONFIG_TYPE_BOOLEAN, OFFSET_OF(Structure, Field), (UINTN)(Default), NULL }
+// CONFIG_SCHEMA_INTEGER
+/// Declare an integer configuration section schema entry
+#define CONFIG_SCHEMA_INTEGER(Path, Structure, Field, Default) { Path, CONFIG_TYPE_INTEGER, OFFSET_OF(Structure, Field), (UINTN)(INTN)(Default), NULL }
+// CONFIG_SCHEMA_UNSIGNED
+/// Declare an unsigned integer configuration section schema entry
+#define CONFIG_SCHEMA_UNSIGNED(Path, Structure, Field, Default) { Path, CONFIG_TYPE_UNSIGNED, OFFSET_OF(Structure, Field), (UINTN)(Default), NULL }
+// CONFIG_SCHEMA_STRING
+/// Declare a string configuration section schema entry
+#define CONFIG_SCHEMA_STRING(Path, Structure, Field, Default) { Path, CONFIG_TYPE_STRING, OFFSET_OF(Structure, Field), 0, Default }
+// CONFIG_SCHEMA_DATA
+/// Declare a data configuration section schema entry, which defaults to empty
+#define CONFIG_SCHEMA_DATA(Path, Structure, Field) { Path, CONFIG_TYPE_DATA, OFFSET_OF(Structure, Field), 0, NULL }
+
+// CONFIG_SECTION
+/// Configuration section bound to a native structure, which is filled again whenever values in the section change
+typedef struct _CONFIG_SECTION CONFIG_SECTION;
 
 // ConfigLoad
 /// Load configuration information from file
@@ -1154,4 +1272,721 @@ ConfigVSSetData (
   IN VA_LIST  Args
 );
 
+// ConfigGetIndexedValue
+/// Get a configuration value by base path, index and leaf path
+/// @param Path  The base path of the configuration value
+/// @param Index The index of the child of the base path
+/// @param Leaf  The path relative to the indexed child or NULL for the indexed child
+/// @param Type  On output, the type of the configuration value
+/// @param Value On output, the value of the configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, Type, or Value is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetIndexedValue (
+  IN  CHAR16       *Path,
+  IN  UINTN         Index,
+  IN  CHAR16       *Leaf OPTIONAL,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value
+);
+// ConfigGetIndexedBooleanWithDefault
+/// Get a boolean configuration value by base path, index and leaf path with default
+/// @param Path           The base path of the configuration value
+/// @param Index          The index of the child of the base path
+/// @param Leaf           The path relative to the indexed child or NULL for the indexed child
+/// @param DefaultBoolean The default boolean configuration value
+/// @return The boolean configuration value
+BOOLEAN
+EFIAPI
+ConfigGetIndexedBooleanWithDefault (
+  IN CHAR16  *Path,
+  IN UINTN    Index,
+  IN CHAR16  *Leaf OPTIONAL,
+  IN BOOLEAN  DefaultBoolean
+);
+// ConfigGetIndexedIntegerWithDefault
+/// Get an integer configuration value by base path, index and leaf path with default
+/// @param Path           The base path of the configuration value
+/// @param Index          The index of the child of the base path
+/// @param Leaf           The path relative to the indexed child or NULL for the indexed child
+/// @param DefaultInteger The default integer configuration value
+/// @return The integer configuration value
+INTN
+EFIAPI
+ConfigGetIndexedIntegerWithDefault (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN INTN    DefaultInteger
+);
+// ConfigGetIndexedUnsignedWithDefault
+/// Get an unsigned integer configuration value by base path, index and leaf path with default
+/// @param Path            The base path of the configuration value
+/// @param Index           The index of the child of the base path
+/// @param Leaf            The path relative to the indexed child or NULL for the indexed child
+/// @param DefaultUnsigned The default unsigned configuration value
+/// @return The unsigned integer configuration value
+UINTN
+EFIAPI
+ConfigGetIndexedUnsignedWithDefault (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN UINTN   DefaultUnsigned
+);
+// ConfigGetIndexedStringWithDefault
+/// Get a string configuration value by base path, index and leaf path with default
+/// @param Path          The base path of the configuration value
+/// @param Index         The index of the child of the base path
+/// @param Leaf          The path relative to the indexed child or NULL for the indexed child
+/// @param DefaultString The default string configuration value
+/// @return The string configuration value
+CHAR16 *
+EFIAPI
+ConfigGetIndexedStringWithDefault (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN CHAR16 *DefaultString
+);
+
+// ConfigSetIndexedValue
+/// Set a configuration value by base path, index and leaf path
+/// @param Path  The base path of the configuration value
+/// @param Index The index of the child of the base path
+/// @param Leaf  The path relative to the indexed child or NULL for the indexed child
+/// @param Type  The configuration type to set
+/// @param Value The configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or Value is NULL or Type is invalid
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetIndexedValue (
+  IN CHAR16       *Path,
+  IN UINTN         Index,
+  IN CHAR16       *Leaf OPTIONAL,
+  IN CONFIG_TYPE   Type,
+  IN CONFIG_VALUE *Value
+);
+// ConfigSetIndexedBoolean
+/// Set a boolean configuration value by base path, index and leaf path
+/// @param Path    The base path of the configuration value
+/// @param Index   The index of the child of the base path
+/// @param Leaf    The path relative to the indexed child or NULL for the indexed child
+/// @param Boolean The boolean configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetIndexedBoolean (
+  IN CHAR16  *Path,
+  IN UINTN    Index,
+  IN CHAR16  *Leaf OPTIONAL,
+  IN BOOLEAN  Boolean
+);
+// ConfigSetIndexedInteger
+/// Set an integer configuration value by base path, index and leaf path
+/// @param Path    The base path of the configuration value
+/// @param Index   The index of the child of the base path
+/// @param Leaf    The path relative to the indexed child or NULL for the indexed child
+/// @param Integer The integer configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetIndexedInteger (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN INTN    Integer
+);
+// ConfigSetIndexedUnsigned
+/// Set an unsigned integer configuration value by base path, index and leaf path
+/// @param Path     The base path of the configuration value
+/// @param Index    The index of the child of the base path
+/// @param Leaf     The path relative to the indexed child or NULL for the indexed child
+/// @param Unsigned The unsigned integer configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetIndexedUnsigned (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN UINTN   Unsigned
+);
+// ConfigSetIndexedString
+/// Set a string configuration value by base path, index and leaf path
+/// @param Path   The base path of the configuration value
+/// @param Index  The index of the child of the base path
+/// @param Leaf   The path relative to the indexed child or NULL for the indexed child
+/// @param String The string configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetIndexedString (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN CHAR16 *String
+);
+
+// ConfigGetSegmentsValue
+/// Get a configuration value by path segments
+/// @param Segments The path segments of the configuration value, which may contain separators
+/// @param Count    The count of path segments
+/// @param Type     On output, the type of the configuration value
+/// @param Value    On output, the value of the configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Segments, Type, or Value is NULL or Count is zero
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetSegmentsValue (
+  IN  CHAR16       **Segments,
+  IN  UINTN          Count,
+  OUT CONFIG_TYPE   *Type,
+  OUT CONFIG_VALUE  *Value
+);
+// ConfigSetSegmentsValue
+/// Set a configuration value by path segments
+/// @param Segments The path segments of the configuration value, which may contain separators
+/// @param Count    The count of path segments
+/// @param Type     The configuration type to set
+/// @param Value    The configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Segments or Value is NULL, Count is zero or Type is invalid
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetSegmentsValue (
+  IN CHAR16       **Segments,
+  IN UINTN          Count,
+  IN CONFIG_TYPE    Type,
+  IN CONFIG_VALUE  *Value
+);
+
+// ConfigQuery
+/// Get many configuration values relative to a common base path at once
+/// @param Base    The base path of the configuration values or NULL for root
+/// @param Queries The configuration query descriptors
+/// @param Count   The count of configuration query descriptors
+/// @param Found   On output, the count of configuration values found with the expected type
+/// @return Whether the configuration values were retrieved or not, every output is set to either the value or the default
+/// @retval EFI_INVALID_PARAMETER If Queries is NULL, Count is zero, or a descriptor has no Path or Value or an invalid Type
+/// @retval EFI_SUCCESS           If the configuration values were retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigQuery (
+  IN  CHAR16       *Base OPTIONAL,
+  IN  CONFIG_QUERY *Queries,
+  IN  UINTN         Count,
+  OUT UINTN        *Found OPTIONAL
+);
+
+// ConfigIteratorStart
+/// Start enumerating the children of a configuration path
+/// @param Path     The configuration path of which to enumerate children or NULL for root, which must stay valid until finished
+/// @param Iterator On output, the configuration child enumeration positioned before the first child, which must be finished with ConfigIteratorFinish
+/// @return Whether the enumeration was started or not
+/// @retval EFI_INVALID_PARAMETER If Iterator is NULL
+/// @retval EFI_NOT_FOUND         If the configuration path was not found or is not a list
+/// @retval EFI_SUCCESS           If the enumeration was started successfully
+EFI_STATUS
+EFIAPI
+ConfigIteratorStart (
+  IN  CHAR16          *Path OPTIONAL,
+  OUT CONFIG_ITERATOR *Iterator
+);
+// ConfigIteratorNext
+/// Advance a configuration child enumeration to the next child and get its name, type and value
+/// @param Iterator The configuration child enumeration
+/// @return Whether there was another child or not
+/// @retval EFI_INVALID_PARAMETER If Iterator is NULL
+/// @retval EFI_ABORTED           If configuration values were freed since the enumeration started
+/// @retval EFI_NOT_FOUND         If there are no more children
+/// @retval EFI_SUCCESS           If the enumeration advanced to the next child
+EFI_STATUS
+EFIAPI
+ConfigIteratorNext (
+  IN OUT CONFIG_ITERATOR *Iterator
+);
+// ConfigIteratorFinish
+/// Finish a configuration child enumeration
+/// @param Iterator The configuration child enumeration
+VOID
+EFIAPI
+ConfigIteratorFinish (
+  IN OUT CONFIG_ITERATOR *Iterator
+);
+// ConfigIteratorGetValue
+/// Get a configuration value relative to the current child of a configuration child enumeration
+/// @param Iterator The configuration child enumeration
+/// @param Path     The path relative to the current child or NULL for the current child
+/// @param Type     On output, the type of the configuration value
+/// @param Value    On output, the value of the configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Iterator, Type, or Value is NULL or there is no current child
+/// @retval EFI_ABORTED           If configuration values were freed since the enumeration started
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigIteratorGetValue (
+  IN  CONFIG_ITERATOR *Iterator,
+  IN  CHAR16          *Path OPTIONAL,
+  OUT CONFIG_TYPE     *Type,
+  OUT CONFIG_VALUE    *Value
+);
+// ConfigIteratorGetBooleanWithDefault
+/// Get a boolean configuration value relative to the current child of a configuration child enumeration with default
+/// @param Iterator       The configuration child enumeration
+/// @param Path           The path relative to the current child or NULL for the current child
+/// @param DefaultBoolean The default boolean configuration value
+/// @return The boolean configuration value
+BOOLEAN
+EFIAPI
+ConfigIteratorGetBooleanWithDefault (
+  IN CONFIG_ITERATOR *Iterator,
+  IN CHAR16          *Path OPTIONAL,
+  IN BOOLEAN          DefaultBoolean
+);
+// ConfigIteratorGetIntegerWithDefault
+/// Get an integer configuration value relative to the current child of a configuration child enumeration with default
+/// @param Iterator       The configuration child enumeration
+/// @param Path           The path relative to the current child or NULL for the current child
+/// @param DefaultInteger The default integer configuration value
+/// @return The integer configuration value
+INTN
+EFIAPI
+ConfigIteratorGetIntegerWithDefault (
+  IN CONFIG_ITERATOR *Iterator,
+  IN CHAR16          *Path OPTIONAL,
+  IN INTN             DefaultInteger
+);
+// ConfigIteratorGetUnsignedWithDefault
+/// Get an unsigned integer configuration value relative to the current child of a configuration child enumeration with default
+/// @param Iterator        The configuration child enumeration
+/// @param Path            The path relative to the current child or NULL for the current child
+/// @param DefaultUnsigned The default unsigned integer configuration value
+/// @return The unsigned integer configuration value
+UINTN
+EFIAPI
+ConfigIteratorGetUnsignedWithDefault (
+  IN CONFIG_ITERATOR *Iterator,
+  IN CHAR16          *Path OPTIONAL,
+  IN UINTN            DefaultUnsigned
+);
+// ConfigIteratorGetStringWithDefault
+/// Get a string configuration value relative to the current child of a configuration child enumeration with default
+/// @param Iterator      The configuration child enumeration
+/// @param Path          The path relative to the current child or NULL for the current child
+/// @param DefaultString The default string configuration value
+/// @return The string configuration value
+CHAR16 *
+EFIAPI
+ConfigIteratorGetStringWithDefault (
+  IN CONFIG_ITERATOR *Iterator,
+  IN CHAR16          *Path OPTIONAL,
+  IN CHAR16          *DefaultString
+);
+
+// ConfigExport
+/// Export the descendants of a configuration path so they can be stored and imported on another boot
+/// @param Path   The configuration path to export or NULL for root
+/// @param Size   On output, the size, in bytes, of the exported configuration
+/// @param Buffer On output, the exported configuration, which must be freed
+/// @return Whether the configuration was exported or not
+/// @retval EFI_INVALID_PARAMETER If Size or Buffer is NULL or *Buffer is not NULL
+/// @retval EFI_UNSUPPORTED       If the configuration tree belongs to another image or is too large
+/// @retval EFI_NOT_FOUND         If the configuration path was not found or is not a list
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration was exported successfully
+EFI_STATUS
+EFIAPI
+ConfigExport (
+  IN  CHAR16  *Path OPTIONAL,
+  OUT UINTN   *Size,
+  OUT VOID   **Buffer
+);
+// ConfigImport
+/// Import exported configuration, replacing the descendants of a configuration path
+/// @param Path   The configuration path to replace or NULL for root
+/// @param Size   The size, in bytes, of the exported configuration
+/// @param Buffer The exported configuration
+/// @return Whether the configuration was imported or not, the configuration path is left unchanged on error
+/// @retval EFI_INVALID_PARAMETER    If Buffer is NULL
+/// @retval EFI_UNSUPPORTED          If the configuration tree belongs to another image
+/// @retval EFI_NOT_READY            If a configuration transaction is open
+/// @retval EFI_ACCESS_DENIED        If the configuration path could not be replaced with a list
+/// @retval EFI_INCOMPATIBLE_VERSION If the exported configuration is for another version
+/// @retval EFI_VOLUME_CORRUPTED     If the exported configuration is malformed
+/// @retval EFI_OUT_OF_RESOURCES     If memory could not be allocated
+/// @retval EFI_SUCCESS              If the configuration was imported successfully
+EFI_STATUS
+EFIAPI
+ConfigImport (
+  IN CHAR16 *Path OPTIONAL,
+  IN UINTN   Size,
+  IN VOID   *Buffer
+);
+
+// ConfigKeyOpen
+/// Open a configuration key handle for a configuration path
+/// @param Path The path of the configuration value
+/// @param Key  On output, the configuration key handle, which must be closed with ConfigKeyClose
+/// @return Whether the configuration key handle was opened or not
+/// @retval EFI_INVALID_PARAMETER If Path or Key is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration key handle was opened successfully, the path does not need to exist yet
+EFI_STATUS
+EFIAPI
+ConfigKeyOpen (
+  IN  CHAR16      *Path,
+  OUT CONFIG_KEY **Key
+);
+// ConfigSKeyOpen
+/// Open a configuration key handle for a configuration path
+/// @param Path The path of the configuration value
+/// @param Key  On output, the configuration key handle, which must be closed with ConfigKeyClose
+/// @param ...  The argument list
+/// @return Whether the configuration key handle was opened or not
+/// @retval EFI_INVALID_PARAMETER If Path or Key is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration key handle was opened successfully, the path does not need to exist yet
+EFI_STATUS
+EFIAPI
+ConfigSKeyOpen (
+  IN  CHAR16      *Path,
+  OUT CONFIG_KEY **Key,
+  IN  ...
+);
+// ConfigVSKeyOpen
+/// Open a configuration key handle for a configuration path
+/// @param Path The path of the configuration value
+/// @param Key  On output, the configuration key handle, which must be closed with ConfigKeyClose
+/// @param Args The argument list
+/// @return Whether the configuration key handle was opened or not
+/// @retval EFI_INVALID_PARAMETER If Path or Key is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration key handle was opened successfully, the path does not need to exist yet
+EFI_STATUS
+EFIAPI
+ConfigVSKeyOpen (
+  IN  CHAR16      *Path,
+  OUT CONFIG_KEY **Key,
+  IN  VA_LIST      Args
+);
+// ConfigKeyClose
+/// Close a configuration key handle
+/// @param Key The configuration key handle to close
+/// @return Whether the configuration key handle was closed or not
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_SUCCESS           If the configuration key handle was closed successfully
+EFI_STATUS
+EFIAPI
+ConfigKeyClose (
+  IN CONFIG_KEY *Key
+);
+
+// ConfigKeyGetValue
+/// Get a configuration value with a configuration key handle
+/// @param Key   The configuration key handle
+/// @param Type  On output, the type of the configuration value
+/// @param Value On output, the value of the configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Key, Type, or Value is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigKeyGetValue (
+  IN  CONFIG_KEY   *Key,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value
+);
+// ConfigKeyGetBooleanWithDefault
+/// Get a boolean configuration value with default with a configuration key handle
+/// @param Key            The configuration key handle
+/// @param DefaultBoolean The default boolean configuration value
+/// @return The boolean configuration value
+BOOLEAN
+EFIAPI
+ConfigKeyGetBooleanWithDefault (
+  IN CONFIG_KEY *Key,
+  IN BOOLEAN     DefaultBoolean
+);
+// ConfigKeyGetIntegerWithDefault
+/// Get an integer configuration value with default with a configuration key handle
+/// @param Key            The configuration key handle
+/// @param DefaultInteger The default integer configuration value
+/// @return The integer configuration value
+INTN
+EFIAPI
+ConfigKeyGetIntegerWithDefault (
+  IN CONFIG_KEY *Key,
+  IN INTN        DefaultInteger
+);
+// ConfigKeyGetUnsignedWithDefault
+/// Get an unsigned integer configuration value with default with a configuration key handle
+/// @param Key             The configuration key handle
+/// @param DefaultUnsigned The default unsigned configuration value
+/// @return The unsigned integer configuration value
+UINTN
+EFIAPI
+ConfigKeyGetUnsignedWithDefault (
+  IN CONFIG_KEY *Key,
+  IN UINTN       DefaultUnsigned
+);
+// ConfigKeyGetStringWithDefault
+/// Get a string configuration value with default with a configuration key handle
+/// @param Key           The configuration key handle
+/// @param DefaultString The default string configuration value
+/// @return The string configuration value
+CHAR16 *
+EFIAPI
+ConfigKeyGetStringWithDefault (
+  IN CONFIG_KEY *Key,
+  IN CHAR16     *DefaultString
+);
+
+// ConfigKeySetValue
+/// Set a configuration value with a configuration key handle
+/// @param Key   The configuration key handle
+/// @param Type  The configuration type to set
+/// @param Value The configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Key or Value is NULL or Type is invalid
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigKeySetValue (
+  IN CONFIG_KEY   *Key,
+  IN CONFIG_TYPE   Type,
+  IN CONFIG_VALUE *Value
+);
+// ConfigKeySetBoolean
+/// Set a boolean configuration value with a configuration key handle
+/// @param Key     The configuration key handle
+/// @param Boolean The boolean configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigKeySetBoolean (
+  IN CONFIG_KEY *Key,
+  IN BOOLEAN     Boolean
+);
+// ConfigKeySetInteger
+/// Set an integer configuration value with a configuration key handle
+/// @param Key     The configuration key handle
+/// @param Integer The integer configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigKeySetInteger (
+  IN CONFIG_KEY *Key,
+  IN INTN        Integer
+);
+// ConfigKeySetUnsigned
+/// Set an unsigned integer configuration value with a configuration key handle
+/// @param Key      The configuration key handle
+/// @param Unsigned The unsigned integer configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigKeySetUnsigned (
+  IN CONFIG_KEY *Key,
+  IN UINTN       Unsigned
+);
+// ConfigKeySetString
+/// Set a string configuration value with a configuration key handle
+/// @param Key    The configuration key handle
+/// @param String The string configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Key or String is NULL
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigKeySetString (
+  IN CONFIG_KEY *Key,
+  IN CHAR16     *String
+);
+
+// ConfigSubscribe
+/// Subscribe to changes of configuration values under a configuration path prefix
+/// @param Prefix       The configuration path prefix, which does not need to exist yet, or NULL for root
+/// @param Notify       The change notification callback or NULL to only advance the subscription generation
+/// @param Context      The context passed to the change notification callback
+/// @param Subscription On output, the configuration change subscription, which must be freed with ConfigUnsubscribe
+/// @return Whether the configuration change subscription was created or not
+/// @retval EFI_INVALID_PARAMETER If Subscription is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration change subscription was created successfully
+EFI_STATUS
+EFIAPI
+ConfigSubscribe (
+  IN  CHAR16               *Prefix OPTIONAL,
+  IN  CONFIG_NOTIFY         Notify OPTIONAL,
+  IN  VOID                 *Context OPTIONAL,
+  OUT CONFIG_SUBSCRIPTION **Subscription
+);
+// ConfigUnsubscribe
+/// Free a configuration change subscription
+/// @param Subscription The configuration change subscription
+/// @return Whether the configuration change subscription was freed or not
+/// @retval EFI_INVALID_PARAMETER If Subscription is NULL
+/// @retval EFI_NOT_FOUND         If the configuration change subscription was not found
+/// @retval EFI_SUCCESS           If the configuration change subscription was freed successfully
+EFI_STATUS
+EFIAPI
+ConfigUnsubscribe (
+  IN CONFIG_SUBSCRIPTION *Subscription
+);
+// ConfigSubscriptionGeneration
+/// Get the change generation of a configuration change subscription
+/// @param Subscription The configuration change subscription
+/// @return The change generation, which differs from any previously returned generation if values under the prefix may have changed since, or zero if Subscription is NULL
+UINTN
+EFIAPI
+ConfigSubscriptionGeneration (
+  IN CONFIG_SUBSCRIPTION *Subscription
+);
+
+// ConfigSectionLoad
+/// Fill a native structure from a configuration section once, configuration values with another type than the schema are logged and replaced by the default
+/// @param Base       The base path of the configuration section or NULL for root
+/// @param Schema     The configuration section schema
+/// @param Count      The count of configuration section schema entries
+/// @param Structure  The native structure to fill, string and data fields point into the configuration until the values are changed or freed
+/// @param Mismatched On output, the count of configuration values with another type than the schema
+/// @return Whether the native structure was filled or not
+/// @retval EFI_INVALID_PARAMETER If Schema or Structure is NULL, Count is zero, or an entry has no Path or an invalid Type
+/// @retval EFI_SUCCESS           If the native structure was filled, every field is either the value or the default
+EFI_STATUS
+EFIAPI
+ConfigSectionLoad (
+  IN  CHAR16        *Base OPTIONAL,
+  IN  CONFIG_SCHEMA *Schema,
+  IN  UINTN          Count,
+  OUT VOID          *Structure,
+  OUT UINTN         *Mismatched OPTIONAL
+);
+// ConfigSectionBind
+/// Fill a native structure from a configuration section and fill it again whenever values in the section change
+/// @param Base      The base path of the configuration section or NULL for root
+/// @param Schema    The configuration section schema, which must stay valid until unbound
+/// @param Count     The count of configuration section schema entries
+/// @param Structure The native structure to fill, which must stay valid until unbound
+/// @param Section   On output, the bound configuration section, which must be unbound with ConfigSectionUnbind
+/// @return Whether the configuration section was bound or not
+/// @retval EFI_INVALID_PARAMETER If Schema, Structure, or Section is NULL, Count is zero, or an entry has no Path or an invalid Type
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration section was bound successfully
+EFI_STATUS
+EFIAPI
+ConfigSectionBind (
+  IN  CHAR16          *Base OPTIONAL,
+  IN  CONFIG_SCHEMA   *Schema,
+  IN  UINTN            Count,
+  OUT VOID            *Structure,
+  OUT CONFIG_SECTION **Section
+);
+// ConfigSectionRefresh
+/// Fill a bound native structure again if values in the section may have changed without notification, which happens when the configuration belongs to another image
+/// @param Section The bound configuration section
+/// @retval TRUE  If the native structure was filled again
+/// @retval FALSE If the section has not changed or Section is NULL
+BOOLEAN
+EFIAPI
+ConfigSectionRefresh (
+  IN CONFIG_SECTION *Section
+);
+// ConfigSectionUnbind
+/// Stop filling a bound native structure and free the bound configuration section
+/// @param Section The bound configuration section
+/// @return Whether the configuration section was unbound or not
+/// @retval EFI_INVALID_PARAMETER If Section is NULL
+/// @retval EFI_SUCCESS           If the configuration section was unbound successfully
+EFI_STATUS
+EFIAPI
+ConfigSectionUnbind (
+  IN CONFIG_SECTION *Section
+);
+
+// ConfigTransactionBegin
+/// Begin a configuration transaction, values set until it is committed are staged and only read back by this image, nested transactions are flattened into the outermost one, queries and sections read staged values like single lookups while child lists and iterators only see committed values
+/// @return Whether the configuration transaction began or not
+/// @retval EFI_UNSUPPORTED If the configuration tree belongs to another image, values are then set immediately
+/// @retval EFI_SUCCESS     If the configuration transaction began successfully
+EFI_STATUS
+EFIAPI
+ConfigTransactionBegin (
+  VOID
+);
+// ConfigTransactionCommit
+/// Commit a configuration transaction, the outermost commit merges the staged values into the configuration tree in staging order, publishes a new shared snapshot for other images and notifies each affected subscription once
+/// @return Whether the configuration transaction was committed or not
+/// @retval EFI_NOT_STARTED      If no configuration transaction is open
+/// @retval EFI_ACCESS_DENIED    If a staged value was for a configuration value that has children, the other values were still applied
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the configuration transaction was committed successfully
+EFI_STATUS
+EFIAPI
+ConfigTransactionCommit (
+  VOID
+);
+// ConfigTransactionAbort
+/// Abort a configuration transaction, discarding every value staged since the outermost transaction began
+/// @return Whether the configuration transaction was aborted or not
+/// @retval EFI_NOT_STARTED If no configuration transaction is open
+/// @retval EFI_SUCCESS     If the configuration transaction was aborted successfully
+EFI_STATUS
+EFIAPI
+ConfigTransactionAbort (
+  VOID
+);
+
+// ConfigLogStatistics
+/// Log the configuration lookup statistics with the most costly configuration paths first, only debug builds collect statistics
+VOID
+EFIAPI
+ConfigLogStatistics (
+  VOID
+);
+
 #endif // __CONFIG_LIBRARY_HEADER__
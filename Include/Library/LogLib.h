@@ -25,6 +25,78 @@
 // LOG_OUTPUT_ALL
 /// Log all output methods
 #define LOG_OUTPUT_ALL (LOG_OUTPUT_FILE | LOG_OUTPUT_CONSOLE)
+// LOG_OUTPUT_DEFERRED
+/// Log file output modifier to save the whole log in one pass when the log is finished or boot services exit instead of as it is printed
+#define LOG_OUTPUT_DEFERRED 0x4
+// LOG_OUTPUT_BINARY
+/// Log output modifier to record the format and arguments of prints and format the text only when it is needed, such as when the log is saved,
+///  which only applies while console output is disabled and file output is disabled or deferred, prints that are recorded return zero and
+///  the format strings are not copied so they must remain valid until the log is finished
+#define LOG_OUTPUT_BINARY 0x8
+
+// LOG_SPAN_INVALID
+/// An invalid timing span
+#define LOG_SPAN_INVALID ((UINTN)-1)
+
+// LOG_CAPACITY_MIN
+/// The minimum capacity of a bounded log - 64KB
+#define LOG_CAPACITY_MIN 0x10000
+
+// LOG_LEVEL_NONE
+/// Log level to log nothing
+#define LOG_LEVEL_NONE 0
+// LOG_LEVEL_ERROR
+/// Log level for errors
+#define LOG_LEVEL_ERROR 1
+// LOG_LEVEL_WARNING
+/// Log level for warnings
+#define LOG_LEVEL_WARNING 2
+// LOG_LEVEL_INFO
+/// Log level for information
+#define LOG_LEVEL_INFO 3
+// LOG_LEVEL_VERBOSE
+/// Log level for detailed information, such as every device or value found
+#define LOG_LEVEL_VERBOSE 4
+
+// LOG_MODULE_GENERAL
+/// Log module for anything without a module
+#define LOG_MODULE_GENERAL 0
+// LOG_MODULE_PLATFORM
+/// Log module for platform and device information
+#define LOG_MODULE_PLATFORM 1
+// LOG_MODULE_FILE
+/// Log module for file access
+#define LOG_MODULE_FILE 2
+// LOG_MODULE_CONFIG
+/// Log module for configuration
+#define LOG_MODULE_CONFIG 3
+// LOG_MODULE_GUI
+/// Log module for the graphical user interface
+#define LOG_MODULE_GUI 4
+// LOG_MODULE_XML
+/// Log module for XML parsing
+#define LOG_MODULE_XML 5
+// LOG_MODULE_COUNT
+/// The count of log modules, which is also used to mean all log modules
+#define LOG_MODULE_COUNT 6
+
+// PROJECT_LOG_LEVEL
+/// The build log level, prints with a higher log level are compiled out, this can be defined in the build options
+#if !defined(PROJECT_LOG_LEVEL)
+#if defined(PROJECT_DEBUG)
+#define PROJECT_LOG_LEVEL LOG_LEVEL_VERBOSE
+#else
+#define PROJECT_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+// gLogLevels
+/// The runtime log level of each log module
+extern UINT32 gLogLevels[LOG_MODULE_COUNT];
+
+// LOG_ENABLED
+/// Whether prints with a log level are enabled for a log module, checked before any arguments are evaluated
+#define LOG_ENABLED(Module, Level) (((Level) <= PROJECT_LOG_LEVEL) && ((Level) <= gLogLevels[(Module)]))
 
 #if defined(PROJECT_DEBUG)
 
@@ -40,11 +112,55 @@
 
 #endif
 
+#define LOG_LEVEL(Module, Level, ...) do { if (LOG_ENABLED(Module, Level)) { Log(__VA_ARGS__); } } while (FALSE)
+#define LOG2_LEVEL(Module, Level, ...) do { if (LOG_ENABLED(Module, Level)) { Log2(__VA_ARGS__); } } while (FALSE)
+#define LOG3_LEVEL(Module, Level, ...) do { if (LOG_ENABLED(Module, Level)) { Log3(__VA_ARGS__); } } while (FALSE)
+
+#if PROJECT_LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(Module, ...) LOG_LEVEL(Module, LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG2_ERROR(Module, ...) LOG2_LEVEL(Module, LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG3_ERROR(Module, ...) LOG3_LEVEL(Module, LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(Module, ...)
+#define LOG2_ERROR(Module, ...)
+#define LOG3_ERROR(Module, ...)
+#endif
+
+#if PROJECT_LOG_LEVEL >= LOG_LEVEL_WARNING
+#define LOG_WARNING(Module, ...) LOG_LEVEL(Module, LOG_LEVEL_WARNING, __VA_ARGS__)
+#define LOG2_WARNING(Module, ...) LOG2_LEVEL(Module, LOG_LEVEL_WARNING, __VA_ARGS__)
+#define LOG3_WARNING(Module, ...) LOG3_LEVEL(Module, LOG_LEVEL_WARNING, __VA_ARGS__)
+#else
+#define LOG_WARNING(Module, ...)
+#define LOG2_WARNING(Module, ...)
+#define LOG3_WARNING(Module, ...)
+#endif
+
+#if PROJECT_LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(Module, ...) LOG_LEVEL(Module, LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG2_INFO(Module, ...) LOG2_LEVEL(Module, LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG3_INFO(Module, ...) LOG3_LEVEL(Module, LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(Module, ...)
+#define LOG2_INFO(Module, ...)
+#define LOG3_INFO(Module, ...)
+#endif
+
+#if PROJECT_LOG_LEVEL >= LOG_LEVEL_VERBOSE
+#define LOG_VERBOSE(Module, ...) LOG_LEVEL(Module, LOG_LEVEL_VERBOSE, __VA_ARGS__)
+#define LOG2_VERBOSE(Module, ...) LOG2_LEVEL(Module, LOG_LEVEL_VERBOSE, __VA_ARGS__)
+#define LOG3_VERBOSE(Module, ...) LOG3_LEVEL(Module, LOG_LEVEL_VERBOSE, __VA_ARGS__)
+#else
+#define LOG_VERBOSE(Module, ...)
+#define LOG2_VERBOSE(Module, ...)
+#define LOG3_VERBOSE(Module, ...)
+#endif
+
 // Log
 /// Log formatted text to log and/or console
 /// @param Format The format specifier for formatting the text
 /// @param ...    The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 Log (
@@ -56,7 +172,7 @@ Log (
 /// @param Prefix The aligned prefix
 /// @param Format The format specifier for formatting the text
 /// @param ...    The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 Log2 (
@@ -70,7 +186,7 @@ Log2 (
 /// @param Prefix The aligned prefix
 /// @param Format The format specifier for formatting the text
 /// @param ...    The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 Log3 (
@@ -83,7 +199,7 @@ Log3 (
 /// Log formatted text to log and/or console
 /// @param Format The format specifier for formatting the text
 /// @param Args   The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 VLog (
@@ -95,7 +211,7 @@ VLog (
 /// @param Prefix The aligned prefix
 /// @param Format The format specifier for formatting the text
 /// @param Args   The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 VLog2 (
@@ -109,7 +225,7 @@ VLog2 (
 /// @param Prefix The aligned prefix
 /// @param Format The format specifier for formatting the text
 /// @param Args   The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 VLog3 (
@@ -118,6 +234,19 @@ VLog3 (
   CHAR16  *Format,
   VA_LIST  Args
 );
+// LogPrefix
+/// Format a log prefix into a buffer, so a prefix built from values stays aligned even when the print is recorded to be formatted later
+/// @param Prefix On output, the formatted prefix, which is truncated to the alignment width
+/// @param Format The format specifier for formatting the prefix
+/// @param ...    The parameters for the format string
+/// @return The formatted prefix, which is Prefix
+CHAR16 *
+EFIAPI
+LogPrefix (
+  OUT CHAR16  Prefix[LOG_PREFIX_WIDTH + 1],
+  IN  CHAR16 *Format,
+  ...
+);
 
 // SetLogOutput
 /// Set log output methods
@@ -136,6 +265,47 @@ SetLogOutput (
   IN UINT32 Outputs
 );
 
+// GetLogLevel
+/// Get the runtime log level of a log module
+/// @param Module The log module
+/// @return The log level of the log module or LOG_LEVEL_NONE if the log module is invalid
+UINT32
+EFIAPI
+GetLogLevel (
+  IN UINT32 Module
+);
+// SetLogLevel
+/// Set the runtime log level of a log module, prints with a higher log level for the log module are skipped before formatting
+/// @param Module The log module or LOG_MODULE_COUNT for all log modules
+/// @param Level  The log level, which is limited to the build log level
+/// @return Whether the log level was set or not
+/// @retval EFI_INVALID_PARAMETER If Module or Level is invalid
+/// @retval EFI_SUCCESS           If the log level was set
+EFI_STATUS
+EFIAPI
+SetLogLevel (
+  IN UINT32 Module,
+  IN UINT32 Level
+);
+// GetLogLevelName
+/// Get the name of a log level
+/// @param Level The log level
+/// @return The name of the log level or NULL if the log level is invalid
+CHAR16 *
+EFIAPI
+GetLogLevelName (
+  IN UINT32 Level
+);
+// GetLogModuleName
+/// Get the name of a log module
+/// @param Module The log module
+/// @return The name of the log module or NULL if the log module is invalid
+CHAR16 *
+EFIAPI
+GetLogModuleName (
+  IN UINT32 Module
+);
+
 // GetLogPath
 /// Get log file path for output
 /// @param Path On output, the path to the log file which needs freed
@@ -175,6 +345,48 @@ EFIAPI
 SaveLog (
   IN CHAR16 *Path
 );
+// GetLogContents
+/// Get the contiguous log contents without copying, for writing the whole log with a single write
+/// @param Contents On output, the log text, which is not null terminated, must not be changed or freed, and is only valid until the next log print
+/// @param Size     On output, the size, in bytes, of the log text
+/// @return Whether the log contents were returned or not
+/// @retval EFI_INVALID_PARAMETER If Contents or Size is NULL
+/// @retval EFI_NOT_FOUND         If the log is empty
+/// @retval EFI_SUCCESS           If the log contents were returned
+EFI_STATUS
+EFIAPI
+GetLogContents (
+  OUT CHAR16 **Contents,
+  OUT UINTN   *Size
+);
+// SetLogCapacity
+/// Bound the log contents so the oldest whole lines are discarded when the log is full, except the pinned text at the start of the log, such as the boot header
+/// @param Capacity The capacity, in bytes, of the log contents or zero for no bound
+/// @param Pinned   The size, in bytes, of text at the start of the log that is never discarded, which is rounded down to a whole line and can not change once text has been discarded
+/// @return Whether the log contents were bounded or not
+/// @retval EFI_INVALID_PARAMETER If Capacity is less than LOG_CAPACITY_MIN or Pinned is more than half of Capacity
+/// @retval EFI_SUCCESS           If the log contents were bounded
+EFI_STATUS
+EFIAPI
+SetLogCapacity (
+  IN UINTN Capacity,
+  IN UINTN Pinned
+);
+// GetLogLost
+/// Get the count of lines discarded from a bounded log
+/// @return The count of lines discarded
+UINT64
+EFIAPI
+GetLogLost (
+  VOID
+);
+// FlushLog
+/// Write any buffered log output to the console and log file now, such as before waiting for input
+VOID
+EFIAPI
+FlushLog (
+  VOID
+);
 
 // LOG_DATE
 /// Flag to log date
@@ -231,4 +443,34 @@ LogTimestamp (
   VOID
 );
 
+// BeginLogSpan
+/// Begin a timing span, which is nested inside any timing spans that are open
+/// @param Name The name of the timing span, which is copied and may be truncated
+/// @return The timing span to end or LOG_SPAN_INVALID if no more timing spans can be recorded
+UINTN
+EFIAPI
+BeginLogSpan (
+  IN CHAR16 *Name
+);
+// EndLogSpan
+/// End a timing span
+/// @param Span The timing span returned when it began, nothing happens if it is LOG_SPAN_INVALID
+VOID
+EFIAPI
+EndLogSpan (
+  IN UINTN Span
+);
+// SaveLogSpans
+/// Save the timing spans to a trace file in the Chrome trace event format
+/// @param Path The trace file path or NULL for the default trace file next to the default log file
+/// @return Whether the trace file was saved or not
+/// @retval EFI_NOT_FOUND        If there are no timing spans
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the trace file was saved
+EFI_STATUS
+EFIAPI
+SaveLogSpans (
+  IN CHAR16 *Path OPTIONAL
+);
+
 #endif // __LOG_LIBRARY_HEADER__
@@ -237,6 +237,32 @@ SetParseCallback (
   IN OUT LANG_PARSER   *Parser,
   IN     LANG_CALLBACK  Callback OPTIONAL
 );
+// SetParseTokenLimit
+/// Set the maximum size of the language parser token buffer
+/// @param Parser The language parser
+/// @param Limit  The maximum size, in bytes, of the token buffer or zero for no limit
+/// @return Whether the token buffer limit was set or not
+/// @retval EFI_INVALID_PARAMETER If Parser is NULL
+/// @retval EFI_SUCCESS           If the token buffer limit was set successfully
+EFI_STATUS
+EFIAPI
+SetParseTokenLimit (
+  IN OUT LANG_PARSER *Parser,
+  IN     UINTN        Limit
+);
+// GetParseTokenSize
+/// Get the allocated size of the language parser token buffer
+/// @param Parser The language parser
+/// @param Size   On output, the size, in bytes, of the allocated token buffer
+/// @return Whether the token buffer size was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Parser or Size is NULL
+/// @retval EFI_SUCCESS           If the token buffer size was retrieved successfully
+EFI_STATUS
+EFIAPI
+GetParseTokenSize (
+  IN  LANG_PARSER *Parser,
+  OUT UINTN       *Size
+);
 // SetParseState
 /// Set the language parser state
 /// @param Parser The language parser
@@ -86,6 +86,30 @@ StrniCmp (
   IN CHAR16 *Str2,
   IN UINTN   Count
 );
+// StrniHash
+/// Calculate a case-insensitive hash of a string
+/// @param Str   The string to hash
+/// @param Count The maximum count of characters to hash
+/// @return The case-insensitive hash of the string, strings equivalent with StrniCmp have the same hash
+UINT32
+EFIAPI
+StrniHash (
+  IN CHAR16 *Str,
+  IN UINTN   Count
+);
+// StrniFold
+/// Copy a string folded to upper case for case-insensitive comparison
+/// @param Destination On output, the folded string, which must have room for Count characters and a null terminator
+/// @param Source      The string to fold
+/// @param Count       The maximum count of characters to fold
+/// @return The count of characters folded, strings equivalent with StrniCmp have identical folded strings
+UINTN
+EFIAPI
+StrniFold (
+  OUT CHAR16 *Destination,
+  IN  CHAR16 *Source,
+  IN  UINTN   Count
+);
 
 // StriColl
 /// Performs a case-insensitive collation of two strings
@@ -483,7 +507,7 @@ ToBase64 (
 /// @param Size   On output, the size, in bytes, of the data
 /// @param Data   On output, the decoded data, which must be freed
 /// @return Whether the Base64 encoded string was converted to data or not
-/// @retval EFI_INVALID_PARAMETER If Base64, Size, or Data is NULL or *Data is not NULL
+/// @retval EFI_INVALID_PARAMETER If Base64, Size, or Data is NULL or *Data is not NULL or the Base64 encoded string is empty or invalid
 /// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
 /// @retval EFI_SUCCESS           If the Base64 string was converted to data successfully
 EFI_STATUS
@@ -493,6 +517,38 @@ FromBase64 (
   OUT UINTN   *Size,
   OUT VOID   **Data
 );
+// PackedBase64Size
+/// Get the count of packed Base64 characters for a decoded data size
+/// @param Size The size, in bytes, of the decoded data
+/// @return The count of packed Base64 characters, which have no padding
+UINTN
+EFIAPI
+PackedBase64Size (
+  IN UINTN Size
+);
+// PackBase64
+/// Measure a Base64 encoded string and pack its Base64 characters into bytes, anything that is not a Base64 character is skipped up to any padding
+/// @param Base64 The Base64 encoded string
+/// @param Buffer The buffer to receive the packed Base64 characters, which must hold the count of packed Base64 characters for the decoded data size, or NULL to only measure
+/// @return The size, in bytes, of the decoded data or zero if the Base64 encoded string is empty or invalid
+UINTN
+EFIAPI
+PackBase64 (
+  IN  CHAR16 *Base64,
+  OUT UINT8  *Buffer OPTIONAL
+);
+// UnpackBase64
+/// Decode packed Base64 characters, the data is never longer than the packed characters so the data may be decoded in place
+/// @param Packed The packed Base64 characters
+/// @param Data   The buffer to receive the decoded data, which may be the packed Base64 characters
+/// @param Size   The size, in bytes, of the decoded data
+VOID
+EFIAPI
+UnpackBase64 (
+  IN  UINT8 *Packed,
+  OUT UINT8 *Data,
+  IN  UINTN  Size
+);
 // AsciiToBase64
 /// Convert data to Base64 encoded ASCII string
 /// @param Size   The size, in bytes, of the data to encode
@@ -23,6 +23,54 @@ struct _XML_ATTRIBUTE {
   CHAR16 *Value;
 
 };
+// XML_LIMITS
+/// XML parser limits, a limit of zero is unlimited
+typedef struct _XML_LIMITS XML_LIMITS;
+struct _XML_LIMITS {
+
+  // MaxDepth
+  /// The maximum depth of nested tree nodes
+  UINTN MaxDepth;
+  // MaxNodes
+  /// The maximum count of tree nodes in the document
+  UINTN MaxNodes;
+  // MaxBytes
+  /// The maximum size, in bytes, of memory allocated for the document
+  UINTN MaxBytes;
+
+};
+// XML_USAGE
+/// XML parser memory usage
+typedef struct _XML_USAGE XML_USAGE;
+struct _XML_USAGE {
+
+  // NodeBytes
+  /// The size, in bytes, allocated for tree nodes, attributes and the tree stack
+  UINTN NodeBytes;
+  // StringBytes
+  /// The size, in bytes, allocated for tag names, attribute names and values
+  UINTN StringBytes;
+  // TokenBytes
+  /// The size, in bytes, allocated for the parser token buffer
+  UINTN TokenBytes;
+  // TotalBytes
+  /// The total size, in bytes, currently allocated
+  UINTN TotalBytes;
+  // PeakBytes
+  /// The peak total size, in bytes, allocated
+  UINTN PeakBytes;
+  // NodeCount
+  /// The count of tree nodes in the document
+  UINTN NodeCount;
+  // Depth
+  /// The current depth of nested tree nodes
+  UINTN Depth;
+  // PeakDepth
+  /// The peak depth of nested tree nodes
+  UINTN PeakDepth;
+
+};
+
 // XML_TREE
 /// XML document tree node
 typedef struct _XML_TREE XML_TREE;
@@ -36,6 +84,20 @@ typedef struct _XML_DOCUMENT XML_DOCUMENT;
 /// XML parser
 typedef struct _XML_PARSER XML_PARSER;
 
+// XML_STREAM_EVENT
+/// XML streaming parse event
+typedef enum _XML_STREAM_EVENT XML_STREAM_EVENT;
+enum _XML_STREAM_EVENT {
+
+  // XML_STREAM_OPEN
+  /// The tree node start tag and attributes are complete, sent before any child tree node is opened
+  XML_STREAM_OPEN = 0,
+  // XML_STREAM_CLOSE
+  /// The tree node and its value are complete, the tree node is freed after this event
+  XML_STREAM_CLOSE,
+
+};
+
 // XML_INSPECT
 /// XML document tree inspection callback
 /// @param Tree           The document tree node
@@ -64,6 +126,21 @@ typedef BOOLEAN
   IN XML_TREE      **Children OPTIONAL,
   IN VOID           *Context OPTIONAL
 );
+// XML_STREAM
+/// XML streaming parse callback
+/// @param Tree    The document tree node, which never has any child tree nodes linked
+/// @param Level   The level of generation of tree nodes, zero for the root
+/// @param Event   The streaming parse event for the tree node
+/// @param Context The context passed when streaming was set
+/// @return Whether parsing should continue or not, any error stops parsing and is returned from parsing
+typedef EFI_STATUS
+(EFIAPI
+*XML_STREAM) (
+  IN XML_TREE         *Tree,
+  IN UINTN             Level,
+  IN XML_STREAM_EVENT  Event,
+  IN VOID             *Context OPTIONAL
+);
 
 // XmlCreate
 /// Create an XML parser
@@ -100,12 +177,71 @@ XmlFree (
   IN XML_PARSER *Parser
 );
 
+// XmlSetLimits
+/// Set the limits of an XML parser, parsing fails with EFI_BUFFER_TOO_SMALL if a limit is exceeded
+/// @param Parser The XML parser
+/// @param Limits The XML parser limits or NULL to remove all limits
+/// @return Whether the XML parser limits were set or not
+/// @retval EFI_INVALID_PARAMETER If Parser is NULL
+/// @retval EFI_BUFFER_TOO_SMALL  If the current usage already exceeds the limits
+/// @retval EFI_SUCCESS           If the XML parser limits were set successfully
+EFI_STATUS
+EFIAPI
+XmlSetLimits (
+  IN OUT XML_PARSER *Parser,
+  IN     XML_LIMITS *Limits OPTIONAL
+);
+// XmlGetLimits
+/// Get the limits of an XML parser
+/// @param Parser The XML parser
+/// @param Limits On output, the XML parser limits
+/// @return Whether the XML parser limits were retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Parser or Limits is NULL
+/// @retval EFI_SUCCESS           If the XML parser limits were retrieved successfully
+EFI_STATUS
+EFIAPI
+XmlGetLimits (
+  IN  XML_PARSER *Parser,
+  OUT XML_LIMITS *Limits
+);
+// XmlGetUsage
+/// Get the memory usage of an XML parser for the current document
+/// @param Parser The XML parser
+/// @param Usage  On output, the XML parser memory usage
+/// @return Whether the XML parser memory usage was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Parser or Usage is NULL
+/// @retval EFI_SUCCESS           If the XML parser memory usage was retrieved successfully
+EFI_STATUS
+EFIAPI
+XmlGetUsage (
+  IN  XML_PARSER *Parser,
+  OUT XML_USAGE  *Usage
+);
+
+// XmlSetStream
+/// Set an XML parser to stream tree nodes to a callback while parsing instead of building the document tree
+/// @param Parser  The XML parser
+/// @param Stream  The streaming parse callback or NULL to build the document tree
+/// @param Context The context to pass to the streaming parse callback
+/// @return Whether the streaming parse callback was set or not
+/// @retval EFI_INVALID_PARAMETER If Parser is NULL
+/// @retval EFI_ACCESS_DENIED     If the XML parser is in the middle of a document
+/// @retval EFI_SUCCESS           If the streaming parse callback was set successfully
+EFI_STATUS
+EFIAPI
+XmlSetStream (
+  IN OUT XML_PARSER *Parser,
+  IN     XML_STREAM  Stream OPTIONAL,
+  IN     VOID       *Context OPTIONAL
+);
+
 // XmlParse
 /// Parse a buffer for XML and finish the XML document
 /// @param Parser An XML parser used to parse
 /// @param Size   The size, in bytes, of the buffer to parse
 /// @param Buffer The buffer to parse, the buffer may contain a leading byte order mark
 /// @return Whether the buffer was parsed or not
+/// @retval EFI_BUFFER_TOO_SMALL If a limit set with XmlSetLimits was exceeded
 EFI_STATUS
 EFIAPI
 XmlParse (
@@ -9,6 +9,7 @@
 #include <Library/LogLib.h>
 #include <Library/SmBiosLib.h>
 
+#include <Library/TimerLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 
 // GUI_CONFIG_FILE
@@ -17,6 +18,26 @@
 // GUI_ARCH_CONFIG_FILE
 /// Architecture specific configuration file
 #define CONFIG_ARCH_FILE PROJECT_ROOT_PATH L"\\" PROJECT_SAFE_NAME L"\\" PROJECT_SAFE_ARCH L"\\" PROJECT_SAFE_NAME L".xml"
+// CONFIG_CACHE_FILE
+/// Compiled configuration cache file
+#define CONFIG_CACHE_FILE PROJECT_ROOT_PATH L"\\" PROJECT_SAFE_NAME L"\\" PROJECT_SAFE_NAME L".cache"
+// CONFIG_ARCH_CACHE_FILE
+/// Architecture specific compiled configuration cache file
+#define CONFIG_ARCH_CACHE_FILE PROJECT_ROOT_PATH L"\\" PROJECT_SAFE_NAME L"\\" PROJECT_SAFE_ARCH L"\\" PROJECT_SAFE_NAME L".cache"
+
+// CONFIG_LOG_PATH
+/// The configuration path of the log settings
+#define CONFIG_LOG_PATH L"\\Log"
+
+// CONFIG_XML_MAX_DEPTH
+/// The maximum depth of nested configuration XML elements
+#define CONFIG_XML_MAX_DEPTH 64
+// CONFIG_XML_MAX_NODES
+/// The maximum count of configuration XML elements in one file
+#define CONFIG_XML_MAX_NODES 0x10000
+// CONFIG_XML_MAX_BYTES
+/// The maximum size, in bytes, of memory used to parse one configuration XML file
+#define CONFIG_XML_MAX_BYTES 0x1000000
 
 // CONFIG_PARSE
 /// Parse configuration information from XML document tree
@@ -124,15 +145,558 @@ struct _CONFIG_TREE {
   // Children
   /// The nodes that are children of this node
   CONFIG_TREE  *Children;
+  // Parent
+  /// The node that is the parent of this node
+  CONFIG_TREE  *Parent;
+  // HashNext
+  /// The next node in the same configuration tree index bucket
+  CONFIG_TREE  *HashNext;
   // Name
-  /// The name of this node
+  /// The name of this node, which is followed by the name folded to upper case
   CHAR16       *Name;
+  // Value
+  /// The value of this node
+  CONFIG_VALUE  Value;
   // Type
   /// The type of this node
   CONFIG_TYPE   Type;
+  // Hash
+  /// The case-insensitive hash of the name of this node
+  UINT32        Hash;
+  // Length
+  /// The length, in characters, of the name of this node
+  UINT32        Length;
+  // Encoded
+  /// Whether the data value of this node is still packed base64 text, which is decoded in place on first read
+  BOOLEAN       Encoded;
+
+};
+
+// CONFIG_SLAB_NODES
+/// The count of configuration tree nodes in each slab
+#define CONFIG_SLAB_NODES 0x80
+
+// CONFIG_SLAB
+/// Configuration tree node slab
+typedef struct _CONFIG_SLAB CONFIG_SLAB;
+struct _CONFIG_SLAB {
+
+  // Next
+  /// The previously allocated slab
+  CONFIG_SLAB *Next;
+  // Used
+  /// The count of nodes that have been handed out from this slab
+  UINTN        Used;
+  // Nodes
+  /// The configuration tree nodes
+  CONFIG_TREE  Nodes[CONFIG_SLAB_NODES];
+
+};
+
+// CONFIG_ARENA_SIZE
+/// The size, in bytes, of each configuration string arena block
+#define CONFIG_ARENA_SIZE 0x4000
+// CONFIG_ARENA_ALIGN
+/// The alignment, in bytes, of configuration string arena allocations
+#define CONFIG_ARENA_ALIGN sizeof(UINT64)
+// CONFIG_ARENA_FREE_CLASSES
+/// The count of configuration string arena free lists, one for each aligned size up to the size of storage given its own block
+#define CONFIG_ARENA_FREE_CLASSES ((CONFIG_ARENA_SIZE >> 2) / CONFIG_ARENA_ALIGN)
+
+// CONFIG_ARENA
+/// Configuration string arena block for names, strings and data
+typedef struct _CONFIG_ARENA CONFIG_ARENA;
+struct _CONFIG_ARENA {
+
+  // Next
+  /// The previously allocated block
+  CONFIG_ARENA *Next;
+  // Size
+  /// The size, in bytes, of the block storage
+  UINTN         Size;
+  // Used
+  /// The size, in bytes, of the block storage that has been handed out
+  UINTN         Used;
+
+};
+// CONFIG_ARENA_FREE
+/// Released configuration string arena storage available for reuse
+typedef struct _CONFIG_ARENA_FREE CONFIG_ARENA_FREE;
+struct _CONFIG_ARENA_FREE {
+
+  // Next
+  /// The next released storage of the same aligned size
+  CONFIG_ARENA_FREE *Next;
+
+};
+
+// CONFIG_FOLD_LENGTH
+/// The maximum length, in characters, of a path segment that is folded on the stack for comparison
+#define CONFIG_FOLD_LENGTH 64
+
+// CONFIG_KEY
+/// Resolved configuration key handle
+struct _CONFIG_KEY {
+
+  // Path
+  /// The path of the configuration value, used to resolve the key again after invalidation
+  CHAR16      *Path;
+  // Node
+  /// The resolved configuration tree node or NULL if not resolved
+  CONFIG_TREE *Node;
+  // Generation
+  /// The configuration tree generation when the node was resolved
+  UINTN        Generation;
+
+};
+// _CONFIG_SUBSCRIPTION
+/// Configuration change subscription for a configuration path prefix
+struct _CONFIG_SUBSCRIPTION {
+
+  // Next
+  /// The next configuration change subscription
+  CONFIG_SUBSCRIPTION *Next;
+  // Prefix
+  /// The configuration path prefix of the subscription
+  CHAR16              *Prefix;
+  // Node
+  /// The resolved configuration tree node of the prefix or NULL if not resolved
+  CONFIG_TREE         *Node;
+  // Resolution
+  /// The configuration tree generation when the node was resolved
+  UINTN                Resolution;
+  // Generation
+  /// The change generation of the subscription, advanced whenever values under the prefix change
+  UINTN                Generation;
+  // Notify
+  /// The change notification callback or NULL to only advance the generation
+  CONFIG_NOTIFY        Notify;
+  // Context
+  /// The context passed to the change notification callback
+  VOID                *Context;
+  // Snapshot
+  /// The shared configuration snapshot when the generation was last queried, if the configuration tree belongs to another image
+  VOID                *Snapshot;
+  // Pending
+  /// Whether a change under the prefix has not been notified yet
+  BOOLEAN              Pending;
+
+};
+// _CONFIG_SECTION
+/// Configuration section bound to a native structure
+struct _CONFIG_SECTION {
+
+  // Subscription
+  /// The configuration change subscription for the base path of the section
+  CONFIG_SUBSCRIPTION *Subscription;
+  // Base
+  /// The base path of the section, which follows the section
+  CHAR16              *Base;
+  // Schema
+  /// The configuration section schema
+  CONFIG_SCHEMA       *Schema;
+  // Count
+  /// The count of configuration section schema entries
+  UINTN                Count;
+  // Structure
+  /// The native structure to fill
+  VOID                *Structure;
+  // Generation
+  /// The change generation of the subscription when the native structure was last filled
+  UINTN                Generation;
+
+};
+
+// CONFIG_STAGE_BUCKETS
+/// The count of staged configuration value hash buckets, must be a power of two
+#define CONFIG_STAGE_BUCKETS 0x40
+// CONFIG_STAGE_PATH_LENGTH
+/// The maximum length, in characters, of a configuration path that is normalized on the stack to find a staged value
+#define CONFIG_STAGE_PATH_LENGTH 0x100
+
+// CONFIG_STAGED
+/// Configuration value staged by an open configuration transaction
+typedef struct _CONFIG_STAGED CONFIG_STAGED;
+struct _CONFIG_STAGED {
+
+  // Next
+  /// The next staged value in staging order
+  CONFIG_STAGED *Next;
+  // HashNext
+  /// The next staged value in the same hash bucket
+  CONFIG_STAGED *HashNext;
+  // Path
+  /// The path without leading or repeated separators, which is followed by the path folded to upper case
+  CHAR16        *Path;
+  // Folded
+  /// The path folded to upper case for comparison
+  CHAR16        *Folded;
+  // Length
+  /// The length, in characters, of the path
+  UINTN          Length;
+  // Hash
+  /// The case-insensitive hash of the path
+  UINT32         Hash;
+  // Type
+  /// The staged configuration type
+  CONFIG_TYPE    Type;
   // Value
-  /// The value of this node
-  CONFIG_VALUE  Value;
+  /// The staged configuration value, string and data storage is in the transaction arena until it is copied into the tree on commit
+  CONFIG_VALUE   Value;
+  // Encoded
+  /// Whether the staged data value is still packed base64 text
+  BOOLEAN        Encoded;
+
+};
+// CONFIG_TRANSACTION
+/// Configuration transaction state
+typedef struct _CONFIG_TRANSACTION CONFIG_TRANSACTION;
+struct _CONFIG_TRANSACTION {
+
+  // Depth
+  /// The nesting depth of open transactions, values are staged while not zero
+  UINTN           Depth;
+  // Arena
+  /// The arena blocks of the staged values and their paths, released when the transaction ends
+  CONFIG_ARENA   *Arena;
+  // First
+  /// The first staged value in staging order
+  CONFIG_STAGED  *First;
+  // Last
+  /// The link to which the next staged value is appended
+  CONFIG_STAGED **Last;
+  // Count
+  /// The count of staged values
+  UINTN           Count;
+  // Buckets
+  /// The staged values by path hash
+  CONFIG_STAGED  *Buckets[CONFIG_STAGE_BUCKETS];
+
+};
+
+// CONFIG_INDEX_MIN_SIZE
+/// The initial count of configuration tree index buckets, must be a power of two
+#define CONFIG_INDEX_MIN_SIZE 0x100
+
+// CONFIG_INDEXED_NAME_LENGTH
+/// The length, in characters, of a buffer large enough for a configuration path index node name
+#define CONFIG_INDEXED_NAME_LENGTH 24
+
+// CONFIG_CACHE_SIGNATURE
+/// The compiled configuration cache signature
+#define CONFIG_CACHE_SIGNATURE SIGNATURE_32('C', 'F', 'G', 'C')
+// CONFIG_CACHE_VERSION
+/// The compiled configuration cache format version, which must change whenever the format changes
+#define CONFIG_CACHE_VERSION 2
+// CONFIG_CACHE_ALIGN
+/// The alignment, in bytes, of compiled configuration cache records
+#define CONFIG_CACHE_ALIGN sizeof(UINT64)
+// CONFIG_CACHE_HASH_SEED
+/// The initial value of the compiled configuration cache key hash
+#define CONFIG_CACHE_HASH_SEED 0x811C9DC5
+// CONFIG_CACHE_HASH_PRIME
+/// The multiplier of the compiled configuration cache key hash
+#define CONFIG_CACHE_HASH_PRIME 0x01000193
+
+// CONFIG_CACHE_HEADER
+/// Compiled configuration cache header, followed by the source records and then the node records, an exported subtree has no source records and no key
+typedef struct _CONFIG_CACHE_HEADER CONFIG_CACHE_HEADER;
+struct _CONFIG_CACHE_HEADER {
+
+  // Signature
+  /// The compiled configuration cache signature
+  UINT32 Signature;
+  // Version
+  /// The compiled configuration cache format version
+  UINT32 Version;
+  // Key
+  /// The hash of the platform identity and the sources
+  UINT32 Key;
+  // SourceCount
+  /// The count of source records
+  UINT32 SourceCount;
+  // NodeCount
+  /// The count of node records, excluding the root node
+  UINT32 NodeCount;
+  // Size
+  /// The total size, in bytes, of the compiled configuration cache
+  UINT32 Size;
+
+};
+
+// CONFIG_CACHE_SOURCE
+/// Compiled configuration cache source record, followed by the terminated source path and then the terminated subtree path of a deferred include file
+typedef struct _CONFIG_CACHE_SOURCE CONFIG_CACHE_SOURCE;
+struct _CONFIG_CACHE_SOURCE {
+
+  // Length
+  /// The length, in characters, of the source path including the null terminator
+  UINT32 Length;
+  // Subtree
+  /// The length, in characters, of the subtree path including the null terminator if the source is an include file still deferred until the subtree is accessed, otherwise zero since the source is compiled into the cache
+  UINT32 Subtree;
+
+};
+
+// CONFIG_CACHE_NODE
+/// Compiled configuration cache node record, followed by the node name and then the value
+typedef struct _CONFIG_CACHE_NODE CONFIG_CACHE_NODE;
+struct _CONFIG_CACHE_NODE {
+
+  // Parent
+  /// The index of the parent node record, where zero is the root node and records are numbered from one
+  UINT32 Parent;
+  // Type
+  /// The configuration type of the node
+  UINT32 Type;
+  // Length
+  /// The length, in characters, of the node name, which is not terminated
+  UINT32 Length;
+  // Size
+  /// The size, in bytes, of the node value
+  UINT32 Size;
+
+};
+
+// CONFIG_SNAPSHOT_SIGNATURE
+/// The shared configuration snapshot signature
+#define CONFIG_SNAPSHOT_SIGNATURE SIGNATURE_32('C', 'F', 'G', 'S')
+// CONFIG_SNAPSHOT_VERSION
+/// The shared configuration snapshot format version
+#define CONFIG_SNAPSHOT_VERSION 3
+// CONFIG_SNAPSHOT_ALIGN
+/// The alignment of shared configuration snapshot values
+#define CONFIG_SNAPSHOT_ALIGN 8
+
+// CONFIG_SNAPSHOT_HEADER
+/// Shared configuration snapshot header, all offsets are relative to the header and the snapshot never changes once published except for Stale
+typedef struct _CONFIG_SNAPSHOT_HEADER CONFIG_SNAPSHOT_HEADER;
+struct _CONFIG_SNAPSHOT_HEADER {
+
+  // Signature
+  /// The shared configuration snapshot signature
+  UINT32          Signature;
+  // Version
+  /// The shared configuration snapshot format version
+  UINT32          Version;
+  // Size
+  /// The size, in bytes, of the whole snapshot
+  UINT32          Size;
+  // Stale
+  /// Whether the snapshot no longer reflects the configuration tree and must not be used anymore
+  volatile UINT32 Stale;
+  // NodeCount
+  /// The count of node records, including the root node record at index zero
+  UINT32          NodeCount;
+  // BucketCount
+  /// The count of index buckets, which is a power of two
+  UINT32          BucketCount;
+  // Nodes
+  /// The offset of the node records
+  UINT32          Nodes;
+  // Buckets
+  /// The offset of the index buckets, which hold the index of the first node record or zero if empty
+  UINT32          Buckets;
+
+};
+// CONFIG_SNAPSHOT_NODE
+/// Shared configuration snapshot node record, node record indices of zero mean none since the root is never a child
+typedef struct _CONFIG_SNAPSHOT_NODE CONFIG_SNAPSHOT_NODE;
+struct _CONFIG_SNAPSHOT_NODE {
+
+  // Number
+  /// The boolean, integer or unsigned integer value of the node
+  UINT64 Number;
+  // Parent
+  /// The index of the parent node record
+  UINT32 Parent;
+  // Children
+  /// The index of the first child node record
+  UINT32 Children;
+  // Next
+  /// The index of the next sibling node record
+  UINT32 Next;
+  // HashNext
+  /// The index of the next node record in the same index bucket
+  UINT32 HashNext;
+  // Type
+  /// The configuration type of the node
+  UINT32 Type;
+  // Hash
+  /// The case-insensitive hash of the node name
+  UINT32 Hash;
+  // Length
+  /// The length, in characters, of the node name
+  UINT32 Length;
+  // Name
+  /// The offset of the terminated node name
+  UINT32 Name;
+  // Value
+  /// The offset of the string or data value of the node
+  UINT32 Value;
+  // Size
+  /// The size, in bytes, of the string or decoded data value of the node
+  UINT32 Size;
+
+};
+// CONFIG_SNAPSHOT_BLOCK
+/// Published shared configuration snapshot owned by this image, the snapshot header follows
+typedef struct _CONFIG_SNAPSHOT_BLOCK CONFIG_SNAPSHOT_BLOCK;
+struct _CONFIG_SNAPSHOT_BLOCK {
+
+  // Next
+  /// The previous generation of published shared configuration snapshot, which is retired, only one previous generation is kept
+  CONFIG_SNAPSHOT_BLOCK *Next;
+  // Reserved
+  /// Keeps the snapshot header aligned
+  UINT64                 Reserved;
+
+};
+
+#if defined(PROJECT_DEBUG)
+
+// CONFIG_STAT_BUCKETS
+/// The count of configuration lookup statistics buckets, which must be a power of two
+#define CONFIG_STAT_BUCKETS 0x100
+// CONFIG_STAT_REPORT_COUNT
+/// The count of most costly configuration paths in the configuration lookup statistics report
+#define CONFIG_STAT_REPORT_COUNT 32
+
+// CONFIG_STAT
+/// Count a configuration statistic
+#define CONFIG_STAT(Counter) (++(mConfigStats.Counter))
+
+// CONFIG_STAT_PATH
+/// Configuration lookup statistics for one configuration path, the path follows
+typedef struct _CONFIG_STAT_PATH CONFIG_STAT_PATH;
+struct _CONFIG_STAT_PATH {
+
+  // Next
+  /// The next configuration path statistics in the same bucket
+  CONFIG_STAT_PATH *Next;
+  // Ticks
+  /// The performance counter ticks spent looking up the configuration path
+  UINT64            Ticks;
+  // Lookups
+  /// The count of lookups of the configuration path
+  UINTN             Lookups;
+  // Misses
+  /// The count of lookups of the configuration path that were not found
+  UINTN             Misses;
+  // Creates
+  /// The count of configuration tree nodes created by lookups of the configuration path
+  UINTN             Creates;
+  // Length
+  /// The length, in characters, of the configuration path
+  UINTN             Length;
+  // Hash
+  /// The case-insensitive hash of the configuration path
+  UINT32            Hash;
+
+};
+// CONFIG_STATS
+/// Configuration lookup statistics
+typedef struct _CONFIG_STATS CONFIG_STATS;
+struct _CONFIG_STATS {
+
+  // Ticks
+  /// The performance counter ticks spent looking up configuration paths
+  UINT64            Ticks;
+  // Lookups
+  /// The count of local configuration tree lookups
+  UINTN             Lookups;
+  // Misses
+  /// The count of local configuration tree lookups that were not found
+  UINTN             Misses;
+  // Creates
+  /// The count of configuration tree nodes created
+  UINTN             Creates;
+  // Snapshot
+  /// The count of reads from the shared configuration snapshot of another image
+  UINTN             Snapshot;
+  // Protocol
+  /// The count of calls through the configuration protocol of another image
+  UINTN             Protocol;
+  // Paths
+  /// The configuration path statistics buckets
+  CONFIG_STAT_PATH *Paths[CONFIG_STAT_BUCKETS];
+
+};
+
+#else
+
+#define CONFIG_STAT(Counter)
+
+#endif
+
+// CONFIG_PLATFORM_ARCH
+/// The platform identity key for the architecture
+#define CONFIG_PLATFORM_ARCH 0
+// CONFIG_PLATFORM_MANUFACTURER
+/// The platform identity key for the SMBIOS system manufacturer
+#define CONFIG_PLATFORM_MANUFACTURER 1
+// CONFIG_PLATFORM_PRODUCT
+/// The platform identity key for the SMBIOS system product name
+#define CONFIG_PLATFORM_PRODUCT 2
+// CONFIG_PLATFORM_COUNT
+/// The count of platform identity keys
+#define CONFIG_PLATFORM_COUNT 3
+
+// CONFIG_CONDITION_BUCKETS
+/// The count of compiled platform condition buckets, which must be a power of two
+#define CONFIG_CONDITION_BUCKETS 0x40
+
+// CONFIG_CONDITION
+/// Compiled platform condition from a configuration XML attribute
+typedef struct _CONFIG_CONDITION CONFIG_CONDITION;
+struct _CONFIG_CONDITION {
+
+  // Next
+  /// The next compiled platform condition in the same bucket
+  CONFIG_CONDITION *Next;
+  // Key
+  /// The platform identity key of the condition
+  UINTN             Key;
+  // Hash
+  /// The case-insensitive hash of the condition value
+  UINT32            Hash;
+  // Excluded
+  /// Whether the condition excludes elements from this platform
+  BOOLEAN           Excluded;
+  // Value
+  /// The condition value
+  CHAR16           *Value;
+
+};
+
+// CONFIG_INCLUDE
+/// Configuration include file bound to a subtree, which is loaded on first access to the subtree
+typedef struct _CONFIG_INCLUDE CONFIG_INCLUDE;
+struct _CONFIG_INCLUDE {
+
+  // Next
+  /// The next pending configuration include file
+  CONFIG_INCLUDE *Next;
+  // Subtree
+  /// The configuration path of the subtree to which the include file is bound
+  CHAR16         *Subtree;
+  // Path
+  /// The full device path string to the include file
+  CHAR16         *Path;
+
+};
+
+// CONFIG_PLATFORM_KEY
+/// Platform identity key that configuration XML attributes may be conditioned on
+typedef struct _CONFIG_PLATFORM_KEY CONFIG_PLATFORM_KEY;
+struct _CONFIG_PLATFORM_KEY {
+
+  // Name
+  /// The configuration XML attribute name
+  CHAR16  *Name;
+  // Exact
+  /// Whether the attribute value must match the whole identity, otherwise any part of the identity
+  BOOLEAN  Exact;
 
 };
 
@@ -154,9 +718,81 @@ struct _CONFIG_INSPECT {
 
 };
 
+// CONFIG_STREAM_FRAME
+/// Configuration XML streaming open element
+typedef struct _CONFIG_STREAM_FRAME CONFIG_STREAM_FRAME;
+struct _CONFIG_STREAM_FRAME {
+
+  // Path
+  /// The path to the configuration value or NULL if the element is skipped
+  CHAR16  *Path;
+  // Options
+  /// The options for the configuration value
+  UINTN    Options;
+  // ChildCount
+  /// The count of child elements opened so far
+  UINTN    ChildCount;
+  // Skip
+  /// Whether the element and its children are skipped since they are intended for a different platform
+  BOOLEAN  Skip;
+  // Typed
+  /// Whether the element is the first child and has a value type tag name, so it may be the value type of its parent
+  BOOLEAN  Typed;
+  // TypeName
+  /// The value type tag name of the deferred first child or NULL if there is no deferred first child
+  CHAR16  *TypeName;
+  // TypeValue
+  /// The value of the deferred first child
+  CHAR16  *TypeValue;
+  // TypePath
+  /// The path of the deferred first child if it turns out not to be the value type
+  CHAR16  *TypePath;
+
+};
+
+// CONFIG_STREAM
+/// Configuration XML streaming state, which only keeps the stack of open elements
+typedef struct _CONFIG_STREAM CONFIG_STREAM;
+struct _CONFIG_STREAM {
+
+  // Depth
+  /// The count of open elements
+  UINTN               Depth;
+  // Frames
+  /// The open elements by level
+  CONFIG_STREAM_FRAME Frames[CONFIG_XML_MAX_DEPTH];
+
+};
+
+// CONFIG_RESOLVER
+/// Configuration batch lookup state shared by queries and section schemas, which resolves the base path once and shares directory nodes between consecutive paths
+typedef struct _CONFIG_RESOLVER CONFIG_RESOLVER;
+struct _CONFIG_RESOLVER {
+
+  // Base
+  /// The base path of the configuration values or NULL for root
+  CHAR16      *Base;
+  // Root
+  /// The configuration tree node of the base path or NULL if not found or the configuration tree belongs to another image
+  CONFIG_TREE *Root;
+  // Parent
+  /// The configuration tree node of the current directory or NULL if not found
+  CONFIG_TREE *Parent;
+  // Directory
+  /// The current directory, which is the start of the last path that changed directory, or NULL before the first path
+  CHAR16      *Directory;
+  // DirectoryLength
+  /// The length, in characters, of the current directory including the trailing separator
+  UINTN        DirectoryLength;
+
+};
+
 // mConfigGuid
 /// The configuration protocol GUID
 STATIC EFI_GUID         mConfigGuid = { 0x2F4BD4A0, 0x227B, 0x4967, { 0x8B, 0xB0, 0xE6, 0xB7, 0xD5, 0xF9, 0x8F, 0x16 } };
+// mConfigSnapshotGuid
+/// The shared configuration snapshot configuration table unique identifier
+STATIC EFI_GUID         mConfigSnapshotGuid = { 0xC89CA85D, 0x2F05, 0x40E4, { 0xA2, 0x2F, 0x5D, 0x2F, 0x87, 0xC2, 0x27, 0xEF } };
 // mConfigHandle
 /// The configuration protocol handle
 STATIC EFI_HANDLE       mConfigHandle = NULL;
@@ -166,749 +802,4843 @@ STATIC CONFIG_PROTOCOL *mConfig = NULL;
 // mConfigTree
 /// The configuration tree root node
 STATIC CONFIG_TREE     *mConfigTree = NULL;
+// mConfigIndex
+/// The configuration tree index buckets of nodes hashed by parent and name
+STATIC CONFIG_TREE    **mConfigIndex = NULL;
+// mConfigIndexSize
+/// The count of configuration tree index buckets
+STATIC UINTN            mConfigIndexSize = 0;
+// mConfigIndexCount
+/// The count of configuration tree nodes, excluding the root node
+STATIC UINTN            mConfigIndexCount = 0;
+// mConfigSlabs
+/// The configuration tree node slabs, the first slab is the one currently handing out nodes
+STATIC CONFIG_SLAB     *mConfigSlabs = NULL;
+// mConfigFreeNodes
+/// The released configuration tree nodes available for reuse, linked by Next
+STATIC CONFIG_TREE     *mConfigFreeNodes = NULL;
+// mConfigArena
+/// The configuration string arena blocks, the first block is the one currently handing out storage
+STATIC CONFIG_ARENA    *mConfigArena = NULL;
+// mConfigArenaFree
+/// The released configuration string arena storage by aligned size, reused before storage is handed out from the current block
+STATIC CONFIG_ARENA_FREE *mConfigArenaFree[CONFIG_ARENA_FREE_CLASSES];
+// mConfigGeneration
+/// The configuration tree generation, advanced whenever configuration tree nodes are freed
+STATIC UINTN            mConfigGeneration = 0;
+// mConfigSubscriptions
+/// The configuration change subscriptions
+STATIC CONFIG_SUBSCRIPTION *mConfigSubscriptions = NULL;
+// mConfigLogSubscription
+/// The subscription to changes of the log settings
+STATIC CONFIG_SUBSCRIPTION *mConfigLogSubscription = NULL;
+// mConfigTransaction
+/// The configuration transaction state
+STATIC CONFIG_TRANSACTION   mConfigTransaction;
+// mConfigSnapshots
+/// The shared configuration snapshots published by this image, the first is the current one unless retired
+STATIC CONFIG_SNAPSHOT_BLOCK  *mConfigSnapshots = NULL;
+// mConfigSnapshot
+/// The current shared configuration snapshot, published by this image or by the image owning the configuration tree
+STATIC CONFIG_SNAPSHOT_HEADER *mConfigSnapshot = NULL;
+#if defined(PROJECT_DEBUG)
+// mConfigStats
+/// The configuration lookup statistics
+STATIC CONFIG_STATS            mConfigStats;
+#endif
+// mConfigCacheRecord
+/// Whether configuration source files are being recorded for the compiled configuration cache
+STATIC BOOLEAN          mConfigCacheRecord = FALSE;
+// mConfigCacheable
+/// Whether the recorded configuration source files can be checked by path for the compiled configuration cache
+STATIC BOOLEAN          mConfigCacheable = FALSE;
+// mConfigCacheSources
+/// The recorded configuration source file paths
+STATIC CHAR16         **mConfigCacheSources = NULL;
+// mConfigCacheSourceCount
+/// The count of recorded configuration source file paths
+STATIC UINTN            mConfigCacheSourceCount = 0;
+// mConfigIncludes
+/// The pending configuration include files that have not been loaded yet
+STATIC CONFIG_INCLUDE      *mConfigIncludes = NULL;
+// mConfigPlatformKeys
+/// The platform identity keys by index
+STATIC CONFIG_PLATFORM_KEY  mConfigPlatformKeys[CONFIG_PLATFORM_COUNT] = {
+  { L"arch", TRUE },
+  { L"manufacturer", FALSE },
+  { L"product", FALSE }
+};
+// mConfigPlatform
+/// The platform identity folded to upper case by key, evaluated once
+STATIC CHAR16              *mConfigPlatform[CONFIG_PLATFORM_COUNT] = { NULL };
+// mConfigPlatformReady
+/// Whether the platform identity has been evaluated
+STATIC BOOLEAN              mConfigPlatformReady = FALSE;
+// mConfigConditions
+/// The compiled platform conditions
+STATIC CONFIG_CONDITION    *mConfigConditions[CONFIG_CONDITION_BUCKETS] = { NULL };
 // mConfigAutoGroups
 /// The configuration auto group keys
 STATIC CHAR16          *mConfigAutoGroups[] = {
   L"\\CPU\\Package",
   L"\\Memory\\Slot"
 };
+// mConfigValueTypes
+/// The configuration XML tag names of value types
+STATIC CHAR16          *mConfigValueTypes[] = {
+  L"integer",
+  L"unsigned",
+  L"data",
+  L"boolean",
+  L"true",
+  L"false"
+};
 
-// ConfigFind
-/// Find a configuration tree node by path
-/// @param Path The path of the configuration tree node
-/// @param Tree On output, the address of the configuration tree node
-/// @return Whether the 
-STATIC EFI_STATUS
+// ConfigArenaAllocateFrom
+/// Allocate storage from a list of arena blocks
+/// @param Blocks On input, the current arena block, on output the arena block after allocation
+/// @param Size   The size, in bytes, of storage to allocate
+/// @return The allocated storage, which is released with the arena blocks, or NULL if memory could not be allocated
+STATIC VOID *
 EFIAPI
-ConfigFind2 (
-  IN  CHAR16        *Path OPTIONAL,
-  IN  BOOLEAN        Create,
-  OUT CONFIG_TREE ***Tree
+ConfigArenaAllocateFrom (
+  IN OUT CONFIG_ARENA **Blocks,
+  IN     UINTN          Size
 ) {
-  CONFIG_TREE **Node;
-  CHAR16       *Next;
-  CHAR16       *Name;
-  // Check parameters
-  if (Tree == NULL) {
-    return EFI_INVALID_PARAMETER;
-  }
-  // Check if there are any nodes
-  if (mConfigTree == NULL) {
-    if (Create) {
-      // Create new root node if needed
-      mConfigTree = (CONFIG_TREE *)AllocateZeroPool(sizeof(CONFIG_TREE));
-      if (mConfigTree == NULL) {
-        return EFI_OUT_OF_RESOURCES;
-      }
-      mConfigTree->Next = NULL;
-      mConfigTree->Children = NULL;
-      mConfigTree->Name = NULL;
-      mConfigTree->Type = CONFIG_TYPE_LIST;
-    } else {
-      // Not found
-      return EFI_NOT_FOUND;
-    }
-  }
-  // Check if searching for root could be NULL, "", or "\"
-  Node = &mConfigTree;
-  if (Path != NULL) {
-    if (*Path == L'\\') {
-      ++Path;
-    }
-    // Iterate through the configuration tree nodes
-    while (*Path != L'\0') {
-      // Check if there are any children
-      if (!Create && ((*Node)->Children == NULL)) {
-        if (StriCmp(Path, (*Node)->Name) == 0) {
-          break;
-        }
-        // Not found
-        return EFI_NOT_FOUND;
-      }
-      // Get the next node start
-      Next = StrStr(Path, L"\\");
-      if (Next == NULL) {
-        // Get the node name for which to search
-        Name = StrDup(Path);
-        // Set to end of path if not found
-        Path += StrLen(Path);
-      } else if (Next == Path) {
-        // Skip consecutive separators
-        ++Path;
-        continue;
-      } else {
-        // Get the node name for which to search
-        Name = StrnDup(Path, Next - Path);
-        // Set to after the separator
-        Path = Next + 1;
-      }
-      if (Name == NULL) {
-        return EFI_OUT_OF_RESOURCES;
+  CONFIG_ARENA *Arena;
+  VOID         *Storage;
+  Size = ALIGN_VALUE(Size, CONFIG_ARENA_ALIGN);
+  if ((*Blocks == NULL) || (((*Blocks)->Size - (*Blocks)->Used) < Size)) {
+    if (Size > (CONFIG_ARENA_SIZE >> 2)) {
+      // Give large values their own block so the current block keeps its free space
+      Arena = (CONFIG_ARENA *)AllocatePool(sizeof(CONFIG_ARENA) + Size);
+      if (Arena == NULL) {
+        return NULL;
       }
-      // Iterate through children for name
-      for (Node = &((*Node)->Children); *Node != NULL; Node = &((*Node)->Next)) {
-        // Try to match child name
-        if (((*Node)->Name != NULL) && (StriCmp(Name, (*Node)->Name) == 0)) {
-          break;
-        }
-      }
-      // Check if found
-      if (*Node == NULL) {
-        if (Create) {
-          // Create new node if needed
-          *Node = (CONFIG_TREE *)AllocateZeroPool(sizeof(CONFIG_TREE));
-          if (*Node == NULL) {
-            FreePool(Name);
-            return EFI_OUT_OF_RESOURCES;
-          }
-          (*Node)->Next = NULL;
-          (*Node)->Children = NULL;
-          (*Node)->Type = CONFIG_TYPE_LIST;
-          (*Node)->Name = Name;
-        } else {
-          // Not found
-          FreePool(Name);
-          return EFI_NOT_FOUND;
-        }
+      Arena->Size = Size;
+      Arena->Used = Size;
+      if (*Blocks == NULL) {
+        Arena->Next = NULL;
+        *Blocks = Arena;
       } else {
-        FreePool(Name);
+        Arena->Next = (*Blocks)->Next;
+        (*Blocks)->Next = Arena;
       }
+      return (VOID *)(Arena + 1);
     }
+    // Start a new block
+    Arena = (CONFIG_ARENA *)AllocatePool(sizeof(CONFIG_ARENA) + CONFIG_ARENA_SIZE);
+    if (Arena == NULL) {
+      return NULL;
+    }
+    Arena->Next = *Blocks;
+    Arena->Size = CONFIG_ARENA_SIZE;
+    Arena->Used = 0;
+    *Blocks = Arena;
   }
-  // Check if found
-  if (*Node == NULL) {
-    return EFI_NOT_FOUND;
-  }
-  // Return the tree node
-  *Tree = Node;
-  return EFI_SUCCESS;
+  Storage = (VOID *)(((UINT8 *)(*Blocks + 1)) + (*Blocks)->Used);
+  (*Blocks)->Used += Size;
+  return Storage;
 }
-// ConfigFind
-/// Find a configuration tree node by path
-/// @param Path The path of the configuration tree node
-/// @return The configuration tree node or NULL if not found
-STATIC EFI_STATUS
+// ConfigArenaAllocate
+/// Allocate storage from the configuration string arena, reusing released storage of the same aligned size first
+/// @param Size The size, in bytes, of storage to allocate
+/// @return The allocated storage, which is released with ConfigArenaFree or with the whole configuration tree, or NULL if memory could not be allocated
+STATIC VOID *
 EFIAPI
-ConfigFind (
-  IN  CHAR16       *Path OPTIONAL,
-  IN  BOOLEAN       Create,
-  OUT CONFIG_TREE **Tree
+ConfigArenaAllocate (
+  IN UINTN Size
 ) {
-  CONFIG_TREE **Node = NULL;
-  EFI_STATUS    Status;
-  Status = ConfigFind2(Path, Create, &Node);
-  if (!EFI_ERROR(Status) && (Node != NULL)) {
-    *Tree = *Node;
+  CONFIG_ARENA_FREE *Free;
+  UINTN              Index = ALIGN_VALUE(Size, CONFIG_ARENA_ALIGN) / CONFIG_ARENA_ALIGN;
+  if ((Index != 0) && (Index <= CONFIG_ARENA_FREE_CLASSES) && (mConfigArenaFree[Index - 1] != NULL)) {
+    Free = mConfigArenaFree[Index - 1];
+    mConfigArenaFree[Index - 1] = Free->Next;
+    return (VOID *)Free;
   }
-  return Status;
+  return ConfigArenaAllocateFrom(&mConfigArena, Size);
 }
-// ConfigTreeFree
-/// Free configuration tree node
-/// @param Tree The configuration tree node
-/// @return Whether the configuration tree node was freed or not
-/// @retval EFI_INVALID_PARAMETER If Tree is NULL
-/// @retval EFI_SUCCESS           If the node was freed successfully
-STATIC EFI_STATUS
+// ConfigArenaFree
+/// Release storage allocated from the configuration string arena for reuse
+/// @param Storage The storage allocated from the configuration string arena or NULL
+/// @param Size    The size, in bytes, of the value in the storage, which may be less than the size that was allocated
+STATIC VOID
 EFIAPI
-ConfigTreeFree (
-  IN CONFIG_TREE *Tree
+ConfigArenaFree (
+  IN VOID  *Storage OPTIONAL,
+  IN UINTN  Size
 ) {
-  // Check parameters
-  if (Tree == NULL) {
-    return EFI_INVALID_PARAMETER;
+  CONFIG_ARENA      **Link;
+  CONFIG_ARENA       *Arena;
+  CONFIG_ARENA_FREE  *Free;
+  UINTN               Index = ALIGN_VALUE(Size, CONFIG_ARENA_ALIGN) / CONFIG_ARENA_ALIGN;
+  if ((Storage == NULL) || (Index == 0)) {
+    return;
   }
-  if (Tree->Name != NULL) {
-    FreePool(Tree->Name);
-    Tree->Name = NULL;
+  if (Index <= CONFIG_ARENA_FREE_CLASSES) {
+    // Keep the storage for the next allocation of the same aligned size
+    Free = (CONFIG_ARENA_FREE *)Storage;
+    Free->Next = mConfigArenaFree[Index - 1];
+    mConfigArenaFree[Index - 1] = Free;
+    return;
   }
-  // Free value
-  switch (Tree->Type) {
-  case CONFIG_TYPE_STRING:
-    // Free string value
-    if (Tree->Value.String != NULL) {
-      FreePool(Tree->Value.String);
-      Tree->Value.String = NULL;
-    }
-    break;
-
-  case CONFIG_TYPE_DATA:
-    // Free data value
-    if (Tree->Value.Data.Data != NULL) {
-      FreePool(Tree->Value.Data.Data);
+  // Storage this large was given its own block, so free the whole block
+  for (Link = &mConfigArena; *Link != NULL; Link = &((*Link)->Next)) {
+    Arena = *Link;
+    if ((VOID *)(Arena + 1) == Storage) {
+      *Link = Arena->Next;
+      FreePool(Arena);
+      break;
     }
-
-  default:
-    // Set every thing else to empty
-    Tree->Value.Data.Size = 0;
-    Tree->Value.Data.Data = NULL;
-    break;
   }
-  // Free any children
-  if (Tree->Children != NULL) {
-    CONFIG_TREE *Child = Tree->Children;
-    while (Child != NULL) {
-      CONFIG_TREE *Tmp = Child;
-      Child = Tmp->Next;
-      ConfigTreeFree(Tmp);
-    }
-    Tree->Children = NULL;
+}
+// ConfigArenaRelease
+/// Release a list of arena blocks
+/// @param Blocks On input, the current arena block, on output NULL
+STATIC VOID
+EFIAPI
+ConfigArenaRelease (
+  IN OUT CONFIG_ARENA **Blocks
+) {
+  while (*Blocks != NULL) {
+    CONFIG_ARENA *Arena = *Blocks;
+    *Blocks = Arena->Next;
+    FreePool(Arena);
   }
-  // Free node
-  FreePool(Tree);
-  return EFI_SUCCESS;
 }
-
-// ConfigLoad
-/// Load configuration information from file
-/// @param Root If Path is NULL the file handle to use to load, otherwise the root file handle
-/// @param Path If Root is NULL the full device path string to the file, otherwise the root relative path
-/// @return Whether the configuration was loaded successfully or not
-/// @retval EFI_INVALID_PARAMETER If Root and Path are both NULL
-/// @retval EFI_NOT_FOUND         If the configuration file could not be opened
-/// @retval EFI_SUCCESS           If the configuration file was loaded successfully
-EFI_STATUS
+// ConfigArenaName
+/// Store a configuration tree node name and its folded form in the configuration string arena
+/// @param Name   The name, which does not need to be terminated
+/// @param Length The length, in characters, of the name
+/// @return The stored name, which is followed by the folded name, or NULL if memory could not be allocated
+STATIC CHAR16 *
 EFIAPI
-ConfigLoad (
-  IN EFI_FILE_HANDLE  Root OPTIONAL,
-  IN CHAR16          *Path OPTIONAL
+ConfigArenaName (
+  IN CHAR16 *Name,
+  IN UINTN   Length
 ) {
-  EFI_STATUS      Status;
-  EFI_FILE_HANDLE Handle = NULL;
-  // Check parameters
-  if ((Root == NULL) && (Path == NULL)) {
-    return EFI_INVALID_PARAMETER;
+  CHAR16 *Stored = (CHAR16 *)ConfigArenaAllocate(((Length + 1) << 1) * sizeof(CHAR16));
+  if (Stored != NULL) {
+    CopyMem(Stored, Name, Length * sizeof(CHAR16));
+    Stored[Length] = L'\0';
+    StrniFold(Stored + Length + 1, Name, Length);
   }
-  if (Path != NULL) {
-    // Open configuration file handle
-    Log2(L"Configuration:", L"\"%s\"\n", Path);
-    Status = FileHandleOpen(&Handle, Root, Path, EFI_FILE_MODE_READ, 0);
+  return Stored;
+}
+// ConfigNodeAllocate
+/// Allocate a configuration tree node from the node slabs
+/// @return The zeroed configuration tree node or NULL if memory could not be allocated
+STATIC CONFIG_TREE *
+EFIAPI
+ConfigNodeAllocate (
+  VOID
+) {
+  CONFIG_TREE *Node;
+  if (mConfigFreeNodes != NULL) {
+    // Reuse a released node
+    Node = mConfigFreeNodes;
+    mConfigFreeNodes = Node->Next;
   } else {
-    // Get file name of file handle
-    Status = FileHandleGetFileName(Root, &Path);
-    if (!EFI_ERROR(Status) && (Path != NULL)) {
-      // Open configuration file handle
-      Log2(L"Configuration:", L"\"%s\"\n", Path);
-      Status = FileHandleOpen(&Handle, Root, Path, EFI_FILE_MODE_READ, 0);
-      FreePool(Path);
+    if ((mConfigSlabs == NULL) || (mConfigSlabs->Used >= CONFIG_SLAB_NODES)) {
+      // Start a new slab
+      CONFIG_SLAB *Slab = (CONFIG_SLAB *)AllocatePool(sizeof(CONFIG_SLAB));
+      if (Slab == NULL) {
+        return NULL;
+      }
+      Slab->Next = mConfigSlabs;
+      Slab->Used = 0;
+      mConfigSlabs = Slab;
     }
+    Node = &(mConfigSlabs->Nodes[mConfigSlabs->Used++]);
   }
-  // If file handle is open parse configuration
-  if (!EFI_ERROR(Status) && (Handle != NULL)) {
-    UINT64 FileSize = 0;
-    UINTN  Size = 0;
-    // Get file size to read the configuration
-    Status = FileHandleGetSize(Handle, &FileSize);
-    if (!EFI_ERROR(Status)) {
-      if (FileSize == 0) {
-        // Assume not found if no file size
-        Status = EFI_NOT_FOUND;
-      } else {
-        // Allocate buffer to hold configuration string
-        VOID *Config = (VOID *)AllocateZeroPool(Size = (UINTN)FileSize);
-        if (Config == NULL) {
-          Status = EFI_OUT_OF_RESOURCES;
-        } else {
-          // Read configuration string from file
-          Status = FileHandleRead(Handle, &Size, (VOID *)Config);
-          if (!EFI_ERROR(Status)) {
-            Status = ConfigParse(Size, Config);
-          }
-          FreePool(Config);
-        }
+  ZeroMem(Node, sizeof(CONFIG_TREE));
+  return Node;
+}
+// ConfigNodeRelease
+/// Release a configuration tree node back to the node slabs for reuse
+/// @param Node The configuration tree node
+STATIC VOID
+EFIAPI
+ConfigNodeRelease (
+  IN CONFIG_TREE *Node
+) {
+  Node->Next = mConfigFreeNodes;
+  mConfigFreeNodes = Node;
+}
+// ConfigIndexBucket
+/// Get the configuration tree index bucket for a node
+/// @param Parent The parent of the configuration tree node
+/// @param Hash   The case-insensitive hash of the name of the configuration tree node
+/// @return The index of the configuration tree index bucket
+STATIC UINTN
+EFIAPI
+ConfigIndexBucket (
+  IN CONFIG_TREE *Parent,
+  IN UINT32       Hash
+) {
+  // Mix the parent address into the name hash so equal names under different parents spread out
+  Hash ^= (UINT32)(((UINTN)Parent) >> 4) * 0x9E3779B1;
+  return (UINTN)(Hash ^ (Hash >> 16)) & (mConfigIndexSize - 1);
+}
+// ConfigIndexAdd
+/// Add a configuration tree node and its descendants to the configuration tree index
+/// @param Tree The configuration tree node to add
+STATIC VOID
+EFIAPI
+ConfigIndexAdd (
+  IN CONFIG_TREE *Tree
+) {
+  CONFIG_TREE *Child;
+  UINTN        Bucket;
+  for (Child = Tree->Children; Child != NULL; Child = Child->Next) {
+    Bucket = ConfigIndexBucket(Tree, Child->Hash);
+    Child->HashNext = mConfigIndex[Bucket];
+    mConfigIndex[Bucket] = Child;
+    ConfigIndexAdd(Child);
+  }
+}
+// ConfigIndexFree
+/// Free the configuration tree index
+STATIC VOID
+EFIAPI
+ConfigIndexFree (
+  VOID
+) {
+  if (mConfigIndex != NULL) {
+    FreePool(mConfigIndex);
+    mConfigIndex = NULL;
+  }
+  mConfigIndexSize = 0;
+  mConfigIndexCount = 0;
+}
+// ConfigStorageFree
+/// Release the whole configuration tree, its index, node slabs and string arena at once
+STATIC VOID
+EFIAPI
+ConfigStorageFree (
+  VOID
+) {
+  mConfigTree = NULL;
+  mConfigFreeNodes = NULL;
+  ConfigIndexFree();
+  while (mConfigSlabs != NULL) {
+    CONFIG_SLAB *Slab = mConfigSlabs;
+    mConfigSlabs = Slab->Next;
+    FreePool(Slab);
+  }
+  ConfigArenaRelease(&mConfigArena);
+  ZeroMem(mConfigArenaFree, sizeof(mConfigArenaFree));
+}
+// ConfigIndexInsert
+/// Insert a configuration tree node into the configuration tree index
+/// @param Node The configuration tree node, which must already be linked to its parent
+STATIC VOID
+EFIAPI
+ConfigIndexInsert (
+  IN CONFIG_TREE *Node
+) {
+  UINTN Bucket;
+  // Grow the index when it becomes fully loaded
+  if (++mConfigIndexCount > mConfigIndexSize) {
+    UINTN         Size = (mConfigIndexSize == 0) ? CONFIG_INDEX_MIN_SIZE : (mConfigIndexSize << 1);
+    CONFIG_TREE **Index = (CONFIG_TREE **)AllocateZeroPool(Size * sizeof(CONFIG_TREE *));
+    CONFIG_TREE  *Top;
+    if (Index != NULL) {
+      // Rebuild the index from the tree, which already contains the node
+      if (mConfigIndex != NULL) {
+        FreePool(mConfigIndex);
       }
+      mConfigIndex = Index;
+      mConfigIndexSize = Size;
+      if (mConfigTree != NULL) {
+        ConfigIndexAdd(mConfigTree);
+      }
+      // A node built below a detached list is not reachable from the root yet
+      for (Top = Node; Top->Parent != NULL; Top = Top->Parent);
+      if (Top != mConfigTree) {
+        ConfigIndexAdd(Top);
+      }
+      return;
     }
-    // Close the file handle
-    FileHandleClose(Handle);
+    // Keep using the current index with longer chains, or search linearly without one
+  }
+  if (mConfigIndex != NULL) {
+    Bucket = ConfigIndexBucket(Node->Parent, Node->Hash);
+    Node->HashNext = mConfigIndex[Bucket];
+    mConfigIndex[Bucket] = Node;
   }
-  Log2(L"  Load status:", L"%r\n", Status);
-  return Status;
 }
-// ConfigParse
-/// Parse configuration information from string
-/// @param Size   The size, in bytes, of the configuration string
-/// @param Config The configuration string to parse
-/// @return Whether the configuration was parsed successfully or not
-/// @retval EFI_INVALID_PARAMETER If Config is NULL or Size is zero
-/// @retval EFI_SUCCESS           If the configuration string was parsed successfully
-EFI_STATUS
+// ConfigIndexRemove
+/// Remove a configuration tree node from the configuration tree index
+/// @param Node The configuration tree node to remove
+STATIC VOID
 EFIAPI
-ConfigParse (
-  IN UINTN  Size,
-  IN VOID  *Config
+ConfigIndexRemove (
+  IN CONFIG_TREE *Node
 ) {
-  EFI_STATUS  Status;
-  XML_PARSER *Parser = NULL;
-  // Check parameters
-  if ((Config == NULL) || (Size == 0)) {
-    return EFI_INVALID_PARAMETER;
+  CONFIG_TREE **Link;
+  if (Node->Parent == NULL) {
+    // The root node is never indexed
+    return;
   }
-  // Create XML parser
-  Status = XmlCreate(&Parser);
-  if (EFI_ERROR(Status)) {
-    return Status;
+  if (mConfigIndexCount > 0) {
+    --mConfigIndexCount;
   }
-  if (Parser == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  if (mConfigIndex != NULL) {
+    for (Link = &(mConfigIndex[ConfigIndexBucket(Node->Parent, Node->Hash)]); *Link != NULL; Link = &((*Link)->HashNext)) {
+      if (*Link == Node) {
+        *Link = Node->HashNext;
+        break;
+      }
+    }
   }
-  // Parse the XML buffer
-  Status = XmlParse(Parser, Size, Config);
-  if (!EFI_ERROR(Status)) {
-    XML_TREE *Tree = NULL;
-    // Get the XML document tree root node
-    Status = XmlGetTree(Parser, &Tree);
-    if (!EFI_ERROR(Status)) {
-      // Parse the configuration
-      Status = ConfigParseXml(Tree);
+  Node->HashNext = NULL;
+}
+// ConfigIndexMove
+/// Move the children of a configuration tree node below another configuration tree node without children, keeping them in the configuration tree index
+/// @param Parent The configuration tree node to receive the children
+/// @param From   The configuration tree node from which to move the children
+STATIC VOID
+EFIAPI
+ConfigIndexMove (
+  IN CONFIG_TREE *Parent,
+  IN CONFIG_TREE *From
+) {
+  CONFIG_TREE *Child;
+  UINTN        Bucket;
+  // Only the index entries of the children depend on their parent, so their descendants are not touched
+  for (Child = From->Children; Child != NULL; Child = Child->Next) {
+    ConfigIndexRemove(Child);
+    Child->Parent = Parent;
+  }
+  Parent->Children = From->Children;
+  From->Children = NULL;
+  // Add them back without growing the index since the count of indexed nodes is the same as before
+  for (Child = Parent->Children; Child != NULL; Child = Child->Next) {
+    ++mConfigIndexCount;
+    if (mConfigIndex != NULL) {
+      Bucket = ConfigIndexBucket(Parent, Child->Hash);
+      Child->HashNext = mConfigIndex[Bucket];
+      mConfigIndex[Bucket] = Child;
     }
   }
-  // Free the XML parser
-  XmlFree(Parser);
-  return Status;
 }
-
-// ConfigXmlInspector
-/// Configuration XML document tree inspection callback
-/// @param Tree           The document tree node
-/// @param Level          The level of generation of tree nodes, zero for the root
-/// @param LevelIndex     The index of the tree node relative to the previous level
-/// @param TagName        The tree node tag name
-/// @param Value          The tree node value
-/// @param AttributeCount The tree node attribute count
-/// @param Attributes     The tree node attributes
-/// @param ChildCount     The tree node child count
-/// @param Children       The tree node children
-/// @param Context        The context passed when inspection started
-/// @retval TRUE  If the inspection should continue
-/// @retval FALSE If the inspection should stop
+// ConfigNameIsEqual
+/// Check whether a configuration tree node has a name
+/// @param Node   The configuration tree node
+/// @param Name   The name, which does not need to be terminated
+/// @param Folded The name folded to upper case or NULL if the name was too long to fold
+/// @param Length The length, in characters, of the name
+/// @param Hash   The case-insensitive hash of the name
+/// @retval TRUE  If the configuration tree node has the name, ignoring case
+/// @retval FALSE If the configuration tree node does not have the name
 STATIC BOOLEAN
 EFIAPI
-ConfigXmlInspector (
-  IN XML_TREE       *Tree,
-  IN UINTN           Level,
-  IN UINTN           LevelIndex,
-  IN CHAR16         *TagName,
-  IN CHAR16         *Value OPTIONAL,
-  IN UINTN           AttributeCount,
-  IN XML_ATTRIBUTE **Attributes OPTIONAL,
-  IN UINTN           ChildCount,
-  IN XML_TREE      **Children OPTIONAL,
-  IN VOID           *Context OPTIONAL
+ConfigNameIsEqual (
+  IN CONFIG_TREE *Node,
+  IN CHAR16      *Name,
+  IN CHAR16      *Folded OPTIONAL,
+  IN UINTN        Length,
+  IN UINT32       Hash
 ) {
-  CONFIG_INSPECT *Parent = (CONFIG_INSPECT *)Context;
-  CONFIG_INSPECT  This = { 0, 0 };
-  UINTN           Index;
-  // Check parameters
-  if ((Tree == NULL) || (TagName == NULL)) {
-    return TRUE;
+  if ((Node->Hash != Hash) || (Node->Length != Length) || (Node->Name == NULL)) {
+    return FALSE;
   }
-  // Get attributes
-  if ((Attributes != NULL) && (AttributeCount > 0)) {
-    // Iterate through attributes
-    for (Index = 0; Index < AttributeCount; ++Index) {
-      if ((Attributes[Index] != NULL) && (Attributes[Index]->Name != NULL)) {
-        if (StriCmp(Attributes[Index]->Name, L"arch") == 0) {
-          // Check architectures match
-          if ((Attributes[Index]->Value == NULL) || (StriCmp(Attributes[Index]->Value, PROJECT_ARCH) != 0)) {
-            // Skip this tree node since it's intended for a different architecture
-            return TRUE;
-          }
-        } else if (StriCmp(Attributes[Index]->Name, L"manufacturer") == 0) {
-          // Check manufacturer matches
-          CHAR16 *NewManufacturer;
-          CHAR8  *Manufacturer = GetSmBiosManufacturer();
-          UINTN   Length = AsciiStrLen(Manufacturer) + 1;
-          NewManufacturer = (CHAR16 *)AllocateZeroPool(Length * sizeof(CHAR16));
-          if (NewManufacturer == NULL) {
-            return TRUE;
-          }
-          AsciiStrToUnicodeStrS(Manufacturer, NewManufacturer, Length);
-          if ((Attributes[Index]->Value == NULL) || (StriStr(NewManufacturer, Attributes[Index]->Value) != NULL)) {
-            // Skip this tree node since it's intended for a different manufacturer
-            FreePool(NewManufacturer);
-            return TRUE;
-          }
-          FreePool(NewManufacturer);
-        } else if (StriCmp(Attributes[Index]->Name, L"product") == 0) {
-          // Check product matches
-          CHAR16 *NewProductName;
-          CHAR8  *ProductName = GetSmBiosProductName();
-          UINTN   Length = AsciiStrLen(ProductName) + 1;
-          NewProductName = (CHAR16 *)AllocateZeroPool(Length * sizeof(CHAR16));
-          if (NewProductName == NULL) {
-            return TRUE;
-          }
-          AsciiStrToUnicodeStrS(ProductName, NewProductName, Length);
-          if ((Attributes[Index]->Value == NULL) || (StriStr(NewProductName, Attributes[Index]->Value) != NULL)) {
-            // Skip this tree node since it's intended for a different ProductName
-            FreePool(NewProductName);
-            return TRUE;
-          }
-          FreePool(NewProductName);
-        }
+  if (Folded != NULL) {
+    // Compare against the folded name stored after the name
+    return (CompareMem(Folded, Node->Name + Length + 1, Length * sizeof(CHAR16)) == 0);
+  }
+  return (StrniCmp(Name, Node->Name, Length) == 0);
+}
+// ConfigIndexFind
+/// Find a child configuration tree node by name
+/// @param Parent The parent configuration tree node
+/// @param Name   The name of the child, which does not need to be terminated
+/// @param Folded The name of the child folded to upper case or NULL if the name was too long to fold
+/// @param Length The length, in characters, of the name of the child
+/// @param Hash   The case-insensitive hash of the name of the child
+/// @return The child configuration tree node or NULL if not found
+STATIC CONFIG_TREE *
+EFIAPI
+ConfigIndexFind (
+  IN CONFIG_TREE *Parent,
+  IN CHAR16      *Name,
+  IN CHAR16      *Folded OPTIONAL,
+  IN UINTN        Length,
+  IN UINT32       Hash
+) {
+  CONFIG_TREE *Node;
+  if (mConfigIndex != NULL) {
+    // Search the index bucket
+    for (Node = mConfigIndex[ConfigIndexBucket(Parent, Hash)]; Node != NULL; Node = Node->HashNext) {
+      if ((Node->Parent == Parent) && ConfigNameIsEqual(Node, Name, Folded, Length, Hash)) {
+        return Node;
       }
     }
+    return NULL;
   }
-  // Check for group type
-  if (StriCmp(TagName, L"group") == 0) {
-    // Create the index of this group
-    CHAR16 *IndexPath = CatSPrint(NULL, L"%u", LevelIndex);
-    if (IndexPath != NULL) {
-      This.Path = FileMakePath((Parent == NULL) ? NULL : Parent->Path, IndexPath);
-      FreePool(IndexPath);
-    }
-  } else if ((Level == 1) && (ChildCount == 0) && (Value != NULL) && (StriCmp(TagName, L"include") == 0)) {
-    // Include another configuration
-    ConfigLoad(NULL, Value);
-    return TRUE;
-  } else if ((Parent != NULL) && ((Parent->Options & CONFIG_INSPECT_AUTO_GROUP) != 0)) {
-    // Auto group this partial path
-    CHAR16 *IndexPath = CatSPrint(NULL, L"%u\\%s", 0, TagName);
-    if (IndexPath != NULL) {
-      This.Path = FileMakePath((Parent == NULL) ? NULL : Parent->Path, IndexPath);
-      FreePool(IndexPath);
+  // Search the children without an index
+  for (Node = Parent->Children; Node != NULL; Node = Node->Next) {
+    if (ConfigNameIsEqual(Node, Name, Folded, Length, Hash)) {
+      return Node;
     }
-  } else {
-    // Create full path
-    This.Path = FileMakePath((Parent == NULL) ? NULL : Parent->Path, TagName);
   }
-  if (This.Path == NULL) {
-    return TRUE;
+  return NULL;
+}
+
+// ConfigSnapshotRetire
+/// Retire the current shared configuration snapshot published by this image because the configuration tree changed
+STATIC VOID
+EFIAPI
+ConfigSnapshotRetire (
+  VOID
+) {
+  // Only the image owning the configuration tree publishes snapshots
+  if ((mConfig != NULL) || (mConfigSnapshot == NULL)) {
+    return;
   }
-  // Get children
-  if ((Children != NULL) && (ChildCount > 0)) {
-    // Check for some built in types
-    if ((ChildCount == 1) && !XmlTreeHasChildren(Children[0])) {
-      CHAR16 *Name = NULL;
-      if (!EFI_ERROR(XmlTreeGetTag(Children[0], &Name)) && (Name != NULL)) {
-        // Check which type
-        if (StriCmp(Name, L"integer") == 0) {
-          // Integer value
-          Name = NULL;
-          if (!EFI_ERROR(XmlTreeGetValue(Children[0], &Name)) && (Name != NULL)) {
-            INTN Value = 1;
-            if (*Name == L'-') {
-              Value = -1;
-              ++Name;
-            }
-            if ((*Name == L'0') && ((Name[1] == L'x') || (Name[1] == L'X'))) {
-              Value *= (INTN)StrHexToUintn(Name + 2);
-              LOG(L"  %s=0x%0*X\n", This.Path, sizeof(UINTN) << 1, Value);
-            } else {
-              Value *= (INTN)StrDecimalToUintn(Name);
-              LOG(L"  %s=%d\n", This.Path, Value);
-            }
-            ConfigSetInteger(This.Path, Value);
-          }
-          FreePool(This.Path);
-          return TRUE;
-        } else if (StriCmp(Name, L"unsigned") == 0) {
-          // Unsigned integer value
-          Name = NULL;
-          if (!EFI_ERROR(XmlTreeGetValue(Children[0], &Name)) && (Name != NULL)) {
-            UINTN Value;
-            if ((*Name == L'0') && ((Name[1] == L'x') || (Name[1] == L'X'))) {
-              Value = StrHexToUintn(Name + 2);
-              LOG(L"  %s=0x%0*X\n", This.Path, sizeof(UINTN) << 1, Value);
-            } else {
-              Value = StrDecimalToUintn(Name);
-              LOG(L"  %s=%u\n", This.Path, Value);
-            }
-            ConfigSetUnsigned(This.Path, Value);
-          }
-          FreePool(This.Path);
-          return TRUE;
-        } else if (StriCmp(Name, L"data") == 0) {
-          // Data base64 value
-          UINTN  Size = 0;
-          VOID  *Data = NULL;
-          if (!EFI_ERROR(XmlTreeGetValue(Children[0], &Name)) && (Name != NULL)) {
-            if (!EFI_ERROR(FromBase64(Name, &Size, &Data)) && (Data != NULL)) {
-              if (Size > 0) {
-                LOG(L"  %s=%s\n", This.Path, Name);
-                ConfigSetData(This.Path, Size, Data);
-              }
-              FreePool(Data);
-            }
-          }
-          FreePool(This.Path);
-          return TRUE;
-        } else if (StriCmp(Name, L"boolean") == 0) {
-          // Boolean value
-          Name = NULL;
-          if (!EFI_ERROR(XmlTreeGetValue(Children[0], &Name)) && (Name != NULL)) {
-            BOOLEAN Value = ((*Name == L't') || (*Name == L'T') ||
-                             ((*Name == L'0') && ((Name[1] == L'x') || (Name[1] == L'X')) && (StrHexToUintn(Name + 2) != 0)) ||
-                             (StrDecimalToUintn(Name) != 0));
-            LOG(L"  %s=%s\n", This.Path, Value ? L"true" : L"false");
-            ConfigSetBoolean(This.Path, Value);
-          }
-          FreePool(This.Path);
-          return TRUE;
-        } else if (StriCmp(Name, L"true") == 0) {
-          // True
-          LOG(L"  %s=true\n", This.Path);
-          ConfigSetBoolean(This.Path, TRUE);
-          FreePool(This.Path);
-          return TRUE;
-        } else if (StriCmp(Name, L"false") == 0) {
-          // False
-          LOG(L"  %s=false\n", This.Path);
-          ConfigSetBoolean(This.Path, FALSE);
-          FreePool(This.Path);
-          return TRUE;
+  // Other images may still hold the snapshot so it is only marked stale and kept until finished
+  mConfigSnapshot->Stale = 1;
+  mConfigSnapshot = NULL;
+  gBS->InstallConfigurationTable(&mConfigSnapshotGuid, NULL);
+}
+// ConfigFindChild
+/// Find a configuration tree node by path relative to another configuration tree node
+/// @param Node   The configuration tree node from which to start
+/// @param Path   The relative path of the configuration tree node
+/// @param Create Whether to create the configuration tree nodes if not found
+/// @param Tree   On output, the configuration tree node
+/// @return Whether the configuration tree node was found or not
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_NOT_FOUND        If the configuration tree node was not found
+/// @retval EFI_SUCCESS          If the configuration tree node was found
+STATIC EFI_STATUS
+EFIAPI
+ConfigFindChild (
+  IN  CONFIG_TREE  *Node,
+  IN  CHAR16       *Path OPTIONAL,
+  IN  BOOLEAN       Create,
+  OUT CONFIG_TREE **Tree
+) {
+  CONFIG_TREE  *Child;
+  CONFIG_TREE **Last;
+  CHAR16       *Folded;
+  UINTN         Length;
+  UINT32        Hash;
+  CHAR16        Fold[CONFIG_FOLD_LENGTH + 1];
+  if (Path != NULL) {
+    if (*Path == L'\\') {
+      ++Path;
+    }
+    // Iterate through the configuration tree nodes
+    while (*Path != L'\0') {
+      // Skip consecutive and trailing separators
+      if (*Path == L'\\') {
+        ++Path;
+        continue;
+      }
+      // Check if there are any children
+      if (!Create && (Node->Children == NULL)) {
+        if (StriCmp(Path, Node->Name) == 0) {
+          break;
+        }
+        // Not found
+        return EFI_NOT_FOUND;
+      }
+      // Get the length and hash of the node name for which to search
+      for (Length = 0; (Path[Length] != L'\0') && (Path[Length] != L'\\'); ++Length);
+      Hash = StrniHash(Path, Length);
+      // Fold the node name once so candidates compare with plain memory comparison
+      Folded = NULL;
+      if (Length <= CONFIG_FOLD_LENGTH) {
+        StrniFold(Fold, Path, Length);
+        Folded = Fold;
+      }
+      // Find the child with the node name
+      Child = ConfigIndexFind(Node, Path, Folded, Length, Hash);
+      if (Child == NULL) {
+        if (!Create) {
+          // Not found
+          return EFI_NOT_FOUND;
+        }
+        // Create new node if needed
+        Child = ConfigNodeAllocate();
+        if (Child == NULL) {
+          return EFI_OUT_OF_RESOURCES;
         }
+        ConfigSnapshotRetire();
+        CONFIG_STAT(Creates);
+        Child->Name = ConfigArenaName(Path, Length);
+        if (Child->Name == NULL) {
+          ConfigNodeRelease(Child);
+          return EFI_OUT_OF_RESOURCES;
+        }
+        Child->Type = CONFIG_TYPE_LIST;
+        Child->Parent = Node;
+        Child->Hash = Hash;
+        Child->Length = (UINT32)Length;
+        // Append to the children and index the new node
+        for (Last = &(Node->Children); *Last != NULL; Last = &((*Last)->Next));
+        *Last = Child;
+        ConfigIndexInsert(Child);
       }
+      Node = Child;
+      // Set to the separator or end of path
+      Path += Length;
     }
-    // Check if this key is auto grouped
-    for (Index = 0; Index < ARRAY_SIZE(mConfigAutoGroups); ++Index) {
-      if (StriCmp(This.Path, mConfigAutoGroups[Index]) == 0) {
-        This.Options = CONFIG_INSPECT_AUTO_GROUP;
+  }
+  // Return the tree node
+  *Tree = Node;
+  return EFI_SUCCESS;
+}
+// ConfigIncludeIsBound
+/// Check whether a configuration path overlaps the subtree to which a pending configuration include file is bound
+/// @param Include  The pending configuration include file
+/// @param Segments The path segments of the configuration path, which may contain separators
+/// @param Count    The count of path segments
+/// @param Within   On output, whether the subtree is the configuration path or below it
+/// @retval TRUE  If the configuration path is within, or is an ancestor of, the subtree
+/// @retval FALSE If the configuration path is outside the subtree
+STATIC BOOLEAN
+EFIAPI
+ConfigIncludeIsBound (
+  IN  CONFIG_INCLUDE  *Include,
+  IN  CHAR16         **Segments,
+  IN  UINTN            Count,
+  OUT BOOLEAN         *Within
+) {
+  CHAR16 *Bound = Include->Subtree;
+  CHAR16 *Path;
+  UINTN   Index;
+  UINTN   Length;
+  UINTN   BoundLength;
+  *Within = FALSE;
+  // Compare each node name of the path with the subtree
+  for (Index = 0; Index < Count; ++Index) {
+    Path = Segments[Index];
+    if (Path == NULL) {
+      continue;
+    }
+    while (TRUE) {
+      while (*Path == L'\\') {
+        ++Path;
+      }
+      if (*Path == L'\0') {
         break;
       }
+      while (*Bound == L'\\') {
+        ++Bound;
+      }
+      if (*Bound == L'\0') {
+        // The path is below the subtree
+        return TRUE;
+      }
+      for (Length = 0; (Path[Length] != L'\0') && (Path[Length] != L'\\'); ++Length);
+      for (BoundLength = 0; (Bound[BoundLength] != L'\0') && (Bound[BoundLength] != L'\\'); ++BoundLength);
+      if ((Length != BoundLength) || (StrniCmp(Path, Bound, Length) != 0)) {
+        return FALSE;
+      }
+      Path += Length;
+      Bound += BoundLength;
     }
-    // Iterate through children
-    for (Index = 0; Index < ChildCount; ++Index) {
-      // Inspect each child
-      XmlTreeInspect(Children[Index], Level + 1, Index, ConfigXmlInspector, (VOID *)&This, FALSE);
-    }
-  } else if (Value != NULL) {
-    // Value
-    LOG(L"  %s=\"%s\"\n", This.Path, Value);
-    ConfigSetString(This.Path, Value);
   }
-  FreePool(This.Path);
+  // The path is the subtree or an ancestor of it
+  *Within = TRUE;
   return TRUE;
 }
-// ConfigParseXml
-/// Parse configuration information from XML document tree
-/// @param Tree The XML document tree to parse
-/// @return Whether the configuration was parsed successfully or not
-/// @retval EFI_INVALID_PARAMETER If Tree is NULL
-/// @retval EFI_SUCCESS           If the configuration was parsed successfully
-EFI_STATUS
+// ConfigIncludeLoad
+/// Load the pending configuration include files bound to subtrees overlapping a configuration path
+/// @param Segments The path segments of the configuration path, which may contain separators
+/// @param Count    The count of path segments
+STATIC VOID
 EFIAPI
-ConfigParseXml (
-  IN XML_TREE *Tree
+ConfigIncludeLoad (
+  IN CHAR16 **Segments,
+  IN UINTN    Count
 ) {
-  XML_TREE **Children = NULL;
-  CHAR16    *Name = NULL;
-  UINTN      Count = 0;
-  UINTN      Index;
-  // Check parameters
-  if (Tree == NULL) {
-    return EFI_INVALID_PARAMETER;
+  CONFIG_INCLUDE **Link = &mConfigIncludes;
+  CONFIG_INCLUDE  *Include;
+  BOOLEAN          Within;
+  while (*Link != NULL) {
+    Include = *Link;
+    if (!ConfigIncludeIsBound(Include, Segments, Count, &Within)) {
+      Link = &(Include->Next);
+      continue;
+    }
+    // Unlink before loading since loading looks up paths again
+    *Link = Include->Next;
+    Log2(L"Configuration include:", L"\"%s\" for \"%s\"\n", Include->Path, Include->Subtree);
+    ConfigLoad(NULL, Include->Path);
+    FreePool(Include);
+    // Loading may have changed the pending include files
+    Link = &mConfigIncludes;
   }
-  // Use configuration protocol if present
-  if ((mConfig != NULL) && (mConfig->Parse != NULL)) {
-    return mConfig->Parse(Tree);
+}
+// ConfigIncludeDrop
+/// Drop the pending configuration include files bound to subtrees at or below a configuration path
+/// @param Path The configuration path or NULL for root
+STATIC VOID
+EFIAPI
+ConfigIncludeDrop (
+  IN CHAR16 *Path OPTIONAL
+) {
+  CONFIG_INCLUDE **Link = &mConfigIncludes;
+  CONFIG_INCLUDE  *Include;
+  BOOLEAN          Within;
+  while (*Link != NULL) {
+    Include = *Link;
+    if (ConfigIncludeIsBound(Include, &Path, 1, &Within) && Within) {
+      *Link = Include->Next;
+      FreePool(Include);
+    } else {
+      Link = &(Include->Next);
+    }
   }
-  if (EFI_ERROR(XmlTreeGetTag(Tree, &Name)) || (Name == NULL) || (StriCmp(Name, L"configuration") != 0)) {
+}
+// ConfigIncludeBind
+/// Bind a configuration include file to a subtree so it is loaded on first access to the subtree
+/// @param Subtree The configuration path of the subtree
+/// @param Path    The full device path string to the include file
+/// @return Whether the configuration include file was bound or not
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the configuration include file was bound
+STATIC EFI_STATUS
+EFIAPI
+ConfigIncludeBind (
+  IN CHAR16 *Subtree,
+  IN CHAR16 *Path
+) {
+  CONFIG_INCLUDE **Last;
+  CONFIG_INCLUDE  *Include;
+  UINTN            SubtreeSize = StrSize(Subtree);
+  UINTN            PathSize = StrSize(Path);
+  // Allocate the include with both strings following
+  Include = (CONFIG_INCLUDE *)AllocateZeroPool(sizeof(CONFIG_INCLUDE) + SubtreeSize + PathSize);
+  if (Include == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Include->Subtree = (CHAR16 *)(Include + 1);
+  Include->Path = (CHAR16 *)(((UINT8 *)Include->Subtree) + SubtreeSize);
+  CopyMem(Include->Subtree, Subtree, SubtreeSize);
+  CopyMem(Include->Path, Path, PathSize);
+  // Keep the include files in document order so they load in the same order as they would have
+  for (Last = &mConfigIncludes; *Last != NULL; Last = &((*Last)->Next));
+  *Last = Include;
+  Log2(L"Configuration include:", L"\"%s\" deferred for \"%s\"\n", Path, Subtree);
+  return EFI_SUCCESS;
+}
+// ConfigStagePath
+/// Join configuration path segments into a path without leading or repeated separators
+/// @param Segments The path segments, which may contain separators or be NULL
+/// @param Count    The count of path segments
+/// @param Path     On output, the joined path, which must have room for the returned length and a null terminator, or NULL to only measure
+/// @return The length, in characters, of the joined path
+STATIC UINTN
+EFIAPI
+ConfigStagePath (
+  IN  CHAR16 **Segments,
+  IN  UINTN    Count,
+  OUT CHAR16  *Path OPTIONAL
+) {
+  CHAR16 *Segment;
+  UINTN   Length = 0;
+  UINTN   Index;
+  UINTN   Size;
+  for (Index = 0; Index < Count; ++Index) {
+    Segment = Segments[Index];
+    if (Segment == NULL) {
+      continue;
+    }
+    while (*Segment != L'\0') {
+      // Skip separators
+      if (*Segment == L'\\') {
+        ++Segment;
+        continue;
+      }
+      // Append the node name after a single separator
+      for (Size = 0; (Segment[Size] != L'\0') && (Segment[Size] != L'\\'); ++Size);
+      if (Length != 0) {
+        if (Path != NULL) {
+          Path[Length] = L'\\';
+        }
+        ++Length;
+      }
+      if (Path != NULL) {
+        CopyMem(Path + Length, Segment, Size * sizeof(CHAR16));
+      }
+      Length += Size;
+      Segment += Size;
+    }
+  }
+  if (Path != NULL) {
+    Path[Length] = L'\0';
+  }
+  return Length;
+}
+#if defined(PROJECT_DEBUG)
+// ConfigStatRecord
+/// Record a local configuration tree lookup in the configuration lookup statistics
+/// @param Segments The path segments of the configuration path looked up, which may contain separators or be NULL
+/// @param Count    The count of path segments
+/// @param Status   The status of the lookup
+/// @param Creates  The count of configuration tree nodes created by the lookup
+/// @param Ticks    The performance counter ticks spent in the lookup
+STATIC VOID
+EFIAPI
+ConfigStatRecord (
+  IN CHAR16     **Segments,
+  IN UINTN        Count,
+  IN EFI_STATUS   Status,
+  IN UINTN        Creates,
+  IN UINT64       Ticks
+) {
+  CONFIG_STAT_PATH  *Stat;
+  CONFIG_STAT_PATH **Bucket;
+  CHAR16            *Path;
+  UINTN              Length;
+  UINT32             Hash;
+  CHAR16             Buffer[CONFIG_STAGE_PATH_LENGTH + 2];
+  // Join the whole logical path so indexed and relative lookups are counted by the path that was actually read
+  Length = ConfigStagePath(Segments, Count, NULL) + 1;
+  Path = Buffer;
+  if (Length > (CONFIG_STAGE_PATH_LENGTH + 1)) {
+    Path = (CHAR16 *)AllocatePool((Length + 1) * sizeof(CHAR16));
+    if (Path == NULL) {
+      return;
+    }
+  }
+  Path[0] = L'\\';
+  ConfigStagePath(Segments, Count, Path + 1);
+  Hash = StrniHash(Path, Length);
+  // Find the statistics for the path
+  Bucket = &(mConfigStats.Paths[(Hash ^ (Hash >> 16)) & (CONFIG_STAT_BUCKETS - 1)]);
+  for (Stat = *Bucket; Stat != NULL; Stat = Stat->Next) {
+    if ((Stat->Hash == Hash) && (Stat->Length == Length) && (StrniCmp((CHAR16 *)(Stat + 1), Path, Length) == 0)) {
+      break;
+    }
+  }
+  if (Stat == NULL) {
+    Stat = (CONFIG_STAT_PATH *)AllocateZeroPool(sizeof(CONFIG_STAT_PATH) + ((Length + 1) * sizeof(CHAR16)));
+    if (Stat != NULL) {
+      Stat->Hash = Hash;
+      Stat->Length = Length;
+      CopyMem(Stat + 1, Path, Length * sizeof(CHAR16));
+      Stat->Next = *Bucket;
+      *Bucket = Stat;
+    }
+  }
+  // Count the lookup
+  ++(mConfigStats.Lookups);
+  mConfigStats.Ticks += Ticks;
+  if (Status == EFI_NOT_FOUND) {
+    ++(mConfigStats.Misses);
+  }
+  if (Stat != NULL) {
+    ++(Stat->Lookups);
+    Stat->Ticks += Ticks;
+    Stat->Creates += Creates;
+    if (Status == EFI_NOT_FOUND) {
+      ++(Stat->Misses);
+    }
+  }
+  if (Path != Buffer) {
+    FreePool(Path);
+  }
+}
+// ConfigStatFree
+/// Free the configuration lookup statistics
+STATIC VOID
+EFIAPI
+ConfigStatFree (
+  VOID
+) {
+  UINTN Index;
+  for (Index = 0; Index < CONFIG_STAT_BUCKETS; ++Index) {
+    while (mConfigStats.Paths[Index] != NULL) {
+      CONFIG_STAT_PATH *Stat = mConfigStats.Paths[Index];
+      mConfigStats.Paths[Index] = Stat->Next;
+      FreePool(Stat);
+    }
+  }
+  ZeroMem(&mConfigStats, sizeof(CONFIG_STATS));
+}
+#endif
+// ConfigFindRoot
+/// Find the configuration tree root node
+/// @param Create Whether to create the configuration tree root node if not found
+/// @param Tree   On output, the configuration tree root node
+/// @return Whether the configuration tree root node was found or not
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_NOT_FOUND        If the configuration tree root node was not found
+/// @retval EFI_SUCCESS          If the configuration tree root node was found
+STATIC EFI_STATUS
+EFIAPI
+ConfigFindRoot (
+  IN  BOOLEAN       Create,
+  OUT CONFIG_TREE **Tree
+) {
+  // Check if there are any nodes
+  if (mConfigTree == NULL) {
+    if (Create) {
+      // Create new root node if needed
+      mConfigTree = ConfigNodeAllocate();
+      if (mConfigTree == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+      mConfigTree->Type = CONFIG_TYPE_LIST;
+    } else {
+      // Not found
+      return EFI_NOT_FOUND;
+    }
+  }
+  *Tree = mConfigTree;
+  return EFI_SUCCESS;
+}
+// ConfigWalk
+/// Find a configuration tree node by path segments without recording the lookup in the configuration lookup statistics
+/// @param Segments The path segments of the configuration tree node, which may contain separators or be NULL
+/// @param Count    The count of path segments
+/// @param Create   Whether to create the configuration tree nodes if not found
+/// @param Tree     On output, the configuration tree node
+/// @return Whether the configuration tree node was found or not
+/// @retval EFI_INVALID_PARAMETER If Tree is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_NOT_FOUND         If the configuration tree node was not found
+/// @retval EFI_SUCCESS           If the configuration tree node was found
+STATIC EFI_STATUS
+EFIAPI
+ConfigWalk (
+  IN  CHAR16       **Segments,
+  IN  UINTN          Count,
+  IN  BOOLEAN        Create,
+  OUT CONFIG_TREE  **Tree
+) {
+  EFI_STATUS   Status;
+  CONFIG_TREE *Node = NULL;
+  UINTN        Index;
+  // Check parameters
+  if (Tree == NULL) {
     return EFI_INVALID_PARAMETER;
   }
-  // Inspect the XML tree
-  if (!EFI_ERROR(XmlTreeGetChildren(Tree, &Children, &Count)) && (Children != NULL) && (Count > 0)) {
-    for (Index = 0; Index < Count; ++Index) {
-      EFI_STATUS Status = XmlTreeInspect(Children[Index], 1, Index, ConfigXmlInspector, NULL, FALSE);
-      if (EFI_ERROR(Status)) {
-        FreePool(Children);
-        return Status;
+  // Load any include files bound to this path first
+  if ((mConfigIncludes != NULL) && (Segments != NULL)) {
+    ConfigIncludeLoad(Segments, Count);
+  }
+  // Find the root
+  Status = ConfigFindRoot(Create, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Find each segment relative to the previous, searching for root could be NULL, "", or "\"
+  for (Index = 0; Index < Count; ++Index) {
+    Status = ConfigFindChild(Node, Segments[Index], Create, &Node);
+    if (EFI_ERROR(Status)) {
+      return Status;
+    }
+  }
+  *Tree = Node;
+  return EFI_SUCCESS;
+}
+// ConfigFindSegments
+/// Find a configuration tree node by path segments
+/// @param Segments The path segments of the configuration tree node, which may contain separators or be NULL
+/// @param Count    The count of path segments
+/// @param Create   Whether to create the configuration tree nodes if not found
+/// @param Tree     On output, the configuration tree node
+/// @return Whether the configuration tree node was found or not
+/// @retval EFI_INVALID_PARAMETER If Tree is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_NOT_FOUND         If the configuration tree node was not found
+/// @retval EFI_SUCCESS           If the configuration tree node was found
+STATIC EFI_STATUS
+EFIAPI
+ConfigFindSegments (
+  IN  CHAR16       **Segments,
+  IN  UINTN          Count,
+  IN  BOOLEAN        Create,
+  OUT CONFIG_TREE  **Tree
+) {
+  EFI_STATUS Status;
+#if defined(PROJECT_DEBUG)
+  UINTN      Creates = mConfigStats.Creates;
+  UINT64     Start = GetPerformanceCounter();
+#endif
+  Status = ConfigWalk(Segments, Count, Create, Tree);
+#if defined(PROJECT_DEBUG)
+  if (Status != EFI_INVALID_PARAMETER) {
+    ConfigStatRecord(Segments, Count, Status, mConfigStats.Creates - Creates, GetPerformanceCounter() - Start);
+  }
+#endif
+  return Status;
+}
+// ConfigFind
+/// Find a configuration tree node by path
+/// @param Path   The path of the configuration tree node
+/// @param Create Whether to create the configuration tree nodes if not found
+/// @param Tree   On output, the configuration tree node
+/// @return Whether the configuration tree node was found or not
+/// @retval EFI_INVALID_PARAMETER If Tree is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_NOT_FOUND         If the configuration tree node was not found
+/// @retval EFI_SUCCESS           If the configuration tree node was found
+STATIC EFI_STATUS
+EFIAPI
+ConfigFind (
+  IN  CHAR16       *Path OPTIONAL,
+  IN  BOOLEAN       Create,
+  OUT CONFIG_TREE **Tree
+) {
+  return ConfigFindSegments(&Path, 1, Create, Tree);
+}
+// ConfigIndexedName
+/// Convert a configuration path index to a node name without formatting
+/// @param Index  The index to convert
+/// @param Buffer The buffer to receive the node name
+/// @return The node name, which is within Buffer
+STATIC CHAR16 *
+EFIAPI
+ConfigIndexedName (
+  IN UINTN  Index,
+  IN CHAR16 Buffer[CONFIG_INDEXED_NAME_LENGTH]
+) {
+  CHAR16 *Name = Buffer + (CONFIG_INDEXED_NAME_LENGTH - 1);
+  *Name = L'\0';
+  do {
+    *(--Name) = (CHAR16)(L'0' + (Index % 10));
+    Index /= 10;
+  } while (Index != 0);
+  return Name;
+}
+// ConfigFindIndexed
+/// Find a configuration tree node by base path, index and leaf path
+/// @param Path   The base path of the configuration tree node
+/// @param Index  The index of the child of the base path
+/// @param Leaf   The path relative to the indexed child or NULL for the indexed child
+/// @param Create Whether to create the configuration tree nodes if not found
+/// @param Tree   On output, the configuration tree node
+/// @return Whether the configuration tree node was found or not
+/// @retval EFI_INVALID_PARAMETER If Tree is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_NOT_FOUND         If the configuration tree node was not found
+/// @retval EFI_SUCCESS           If the configuration tree node was found
+STATIC EFI_STATUS
+EFIAPI
+ConfigFindIndexed (
+  IN  CHAR16       *Path OPTIONAL,
+  IN  UINTN         Index,
+  IN  CHAR16       *Leaf OPTIONAL,
+  IN  BOOLEAN       Create,
+  OUT CONFIG_TREE **Tree
+) {
+  CHAR16 *Segments[3];
+  CHAR16  Buffer[CONFIG_INDEXED_NAME_LENGTH];
+  // Find the base path, the indexed child and the leaf path as one lookup
+  Segments[0] = Path;
+  Segments[1] = ConfigIndexedName(Index, Buffer);
+  Segments[2] = Leaf;
+  return ConfigFindSegments(Segments, ARRAY_SIZE(Segments), Create, Tree);
+}
+// ConfigSubscriptionResolve
+/// Resolve the configuration tree node of a configuration change subscription prefix
+/// @param Subscription The configuration change subscription
+/// @return The configuration tree node or NULL if the configuration path prefix does not exist
+STATIC CONFIG_TREE *
+EFIAPI
+ConfigSubscriptionResolve (
+  IN CONFIG_SUBSCRIPTION *Subscription
+) {
+  // Resolve again if never resolved or configuration tree nodes were freed since, without loading include files
+  if ((Subscription->Node == NULL) || (Subscription->Resolution != mConfigGeneration)) {
+    Subscription->Node = NULL;
+    Subscription->Resolution = mConfigGeneration;
+    if ((mConfigTree == NULL) || EFI_ERROR(ConfigFindChild(mConfigTree, Subscription->Prefix, FALSE, &(Subscription->Node)))) {
+      Subscription->Node = NULL;
+    }
+  }
+  return Subscription->Node;
+}
+// ConfigNodeIsWithin
+/// Check whether a configuration tree node is another configuration tree node or one of its descendants
+/// @param Node     The configuration tree node
+/// @param Ancestor The possible ancestor configuration tree node
+/// @retval TRUE  If the node is the ancestor or below it
+/// @retval FALSE If the node is not below the ancestor
+STATIC BOOLEAN
+EFIAPI
+ConfigNodeIsWithin (
+  IN CONFIG_TREE *Node,
+  IN CONFIG_TREE *Ancestor
+) {
+  for (; Node != NULL; Node = Node->Parent) {
+    if (Node == Ancestor) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+// ConfigNotifyMark
+/// Mark the configuration change subscriptions affected by a change to a configuration tree node
+/// @param Node  The changed configuration tree node
+/// @param Freed Whether the configuration tree node and its descendants are about to be freed
+STATIC VOID
+EFIAPI
+ConfigNotifyMark (
+  IN CONFIG_TREE *Node,
+  IN BOOLEAN      Freed
+) {
+  CONFIG_SUBSCRIPTION *Subscription;
+  CONFIG_TREE         *Prefix;
+  for (Subscription = mConfigSubscriptions; Subscription != NULL; Subscription = Subscription->Next) {
+    Prefix = ConfigSubscriptionResolve(Subscription);
+    // A change below the prefix, or freeing an ancestor of the prefix, changes values under the prefix
+    if ((Prefix != NULL) && (ConfigNodeIsWithin(Node, Prefix) || (Freed && ConfigNodeIsWithin(Prefix, Node)))) {
+      Subscription->Pending = TRUE;
+    }
+  }
+}
+// ConfigNotifyPending
+/// Notify the marked configuration change subscriptions
+STATIC VOID
+EFIAPI
+ConfigNotifyPending (
+  VOID
+) {
+  CONFIG_SUBSCRIPTION *Subscription;
+  CONFIG_SUBSCRIPTION *Next;
+  for (Subscription = mConfigSubscriptions; Subscription != NULL; Subscription = Next) {
+    // The callback may unsubscribe its own subscription
+    Next = Subscription->Next;
+    if (Subscription->Pending) {
+      Subscription->Pending = FALSE;
+      ++(Subscription->Generation);
+      if (Subscription->Notify != NULL) {
+        Subscription->Notify(Subscription->Prefix, Subscription->Context);
+      }
+    }
+  }
+}
+// ConfigTreeGetValue
+/// Get the type and value of a configuration tree node, decoding a packed data value on first read
+/// @param Tree  The configuration tree node
+/// @param Type  On output, the type of the configuration value
+/// @param Value On output, the value of the configuration value
+STATIC VOID
+EFIAPI
+ConfigTreeGetValue (
+  IN  CONFIG_TREE  *Tree,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value
+) {
+  if (Tree->Encoded) {
+    UnpackBase64((UINT8 *)Tree->Value.Data.Data, (UINT8 *)Tree->Value.Data.Data, Tree->Value.Data.Size);
+    Tree->Encoded = FALSE;
+  }
+  *Type = Tree->Type;
+  CopyMem(Value, &(Tree->Value), sizeof(CONFIG_VALUE));
+}
+// ConfigTreeFreeValue
+/// Free the value of a configuration tree node, releasing string and data storage to the configuration string arena for reuse
+/// @param Tree The configuration tree node
+STATIC VOID
+EFIAPI
+ConfigTreeFreeValue (
+  IN CONFIG_TREE *Tree
+) {
+  // Release the storage of the previous value
+  if (Tree->Type == CONFIG_TYPE_STRING) {
+    if (Tree->Value.String != NULL) {
+      ConfigArenaFree(Tree->Value.String, StrSize(Tree->Value.String));
+    }
+  } else if (Tree->Type == CONFIG_TYPE_DATA) {
+    ConfigArenaFree(Tree->Value.Data.Data, Tree->Encoded ? PackedBase64Size(Tree->Value.Data.Size) : Tree->Value.Data.Size);
+  }
+  // Set every thing to empty
+  Tree->Value.Data.Size = 0;
+  Tree->Value.Data.Data = NULL;
+  Tree->Encoded = FALSE;
+}
+// ConfigValueIsValid
+/// Check a configuration value is valid to set
+/// @param Type  The configuration type
+/// @param Value The configuration value
+/// @retval TRUE  If the configuration value is valid
+/// @retval FALSE If the configuration value is NULL or Type is invalid
+STATIC BOOLEAN
+EFIAPI
+ConfigValueIsValid (
+  IN CONFIG_TYPE   Type,
+  IN CONFIG_VALUE *Value
+) {
+  if (Value == NULL) {
+    return FALSE;
+  }
+  switch (Type) {
+    case CONFIG_TYPE_BOOLEAN:
+    case CONFIG_TYPE_INTEGER:
+    case CONFIG_TYPE_UNSIGNED:
+      return TRUE;
+
+    case CONFIG_TYPE_STRING:
+      return (Value->String != NULL);
+
+    case CONFIG_TYPE_DATA:
+      return ((Value->Data.Data != NULL) && (Value->Data.Size != 0));
+
+    default:
+      break;
+  }
+  return FALSE;
+}
+// ConfigValueStore
+/// Store a configuration value in an arena, reusing the storage of the previous value when it is large enough
+/// @param Arena      The arena blocks in which to store the value or NULL for the configuration string arena
+/// @param Type       The configuration type to store
+/// @param Value      The configuration value to store, which must be valid
+/// @param Encoded    Whether the data value is measured base64 text to pack instead of data to copy, the data size is then the decoded size
+/// @param OldType    The type of the previous value
+/// @param OldValue   The previous value
+/// @param OldEncoded Whether the previous data value is still packed base64 text
+/// @param NewValue   On output, the stored configuration value
+/// @return Whether the configuration value was stored or not
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the configuration value was stored successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigValueStore (
+  IN OUT CONFIG_ARENA **Arena OPTIONAL,
+  IN     CONFIG_TYPE    Type,
+  IN     CONFIG_VALUE  *Value,
+  IN     BOOLEAN        Encoded,
+  IN     CONFIG_TYPE    OldType,
+  IN     CONFIG_VALUE  *OldValue,
+  IN     BOOLEAN        OldEncoded,
+  OUT    CONFIG_VALUE  *NewValue
+) {
+  UINTN Size;
+  if (Type == CONFIG_TYPE_STRING) {
+    // Duplicate string type, reusing the previous storage when it is large enough
+    Size = StrSize(Value->String);
+    if ((OldType == CONFIG_TYPE_STRING) && (OldValue->String != NULL) && (StrSize(OldValue->String) >= Size)) {
+      NewValue->String = OldValue->String;
+    } else {
+      NewValue->String = (CHAR16 *)((Arena == NULL) ? ConfigArenaAllocate(Size) : ConfigArenaAllocateFrom(Arena, Size));
+      if (NewValue->String == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+    }
+    CopyMem(NewValue->String, Value->String, Size);
+  } else if (Type == CONFIG_TYPE_DATA) {
+    // Duplicate data type, reusing the previous storage when it is large enough
+    Size = Encoded ? PackedBase64Size(Value->Data.Size) : Value->Data.Size;
+    NewValue->Data.Size = Value->Data.Size;
+    if ((OldType == CONFIG_TYPE_DATA) && (OldValue->Data.Data != NULL) &&
+        ((OldEncoded ? PackedBase64Size(OldValue->Data.Size) : OldValue->Data.Size) >= Size)) {
+      NewValue->Data.Data = OldValue->Data.Data;
+    } else {
+      NewValue->Data.Data = (Arena == NULL) ? ConfigArenaAllocate(Size) : ConfigArenaAllocateFrom(Arena, Size);
+      if (NewValue->Data.Data == NULL) {
+        return EFI_OUT_OF_RESOURCES;
       }
     }
+    if (Encoded) {
+      PackBase64((CHAR16 *)Value->Data.Data, (UINT8 *)NewValue->Data.Data);
+    } else {
+      CopyMem(NewValue->Data.Data, Value->Data.Data, Value->Data.Size);
+    }
+  } else {
+    // Copy all other types
+    CopyMem(NewValue, Value, sizeof(CONFIG_VALUE));
+  }
+  return EFI_SUCCESS;
+}
+// ConfigTreeStoreValue
+/// Store the value of a configuration tree node without notifying subscriptions
+/// @param Tree    The configuration tree node
+/// @param Type    The configuration type to set
+/// @param Value   The configuration value to set, which must be valid
+/// @param Encoded Whether the data value is measured base64 text to pack instead of data to copy, the data size is then the decoded size
+/// @return Whether the configuration value was stored or not
+/// @retval EFI_ACCESS_DENIED    If the configuration tree node has children
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the configuration value was stored successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigTreeStoreValue (
+  IN CONFIG_TREE  *Tree,
+  IN CONFIG_TYPE   Type,
+  IN CONFIG_VALUE *Value,
+  IN BOOLEAN       Encoded
+) {
+  EFI_STATUS   Status;
+  CONFIG_VALUE NewValue;
+  if (Tree->Children != NULL) {
+    return EFI_ACCESS_DENIED;
+  }
+  // Duplicate the new value before the previous value is freed
+  Status = ConfigValueStore(NULL, Type, Value, Encoded, Tree->Type, &(Tree->Value), Tree->Encoded, &NewValue);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Keep the previous storage if the new value reused it
+  if (((Type == CONFIG_TYPE_STRING) && (Tree->Type == CONFIG_TYPE_STRING) && (NewValue.String == Tree->Value.String)) ||
+      ((Type == CONFIG_TYPE_DATA) && (Tree->Type == CONFIG_TYPE_DATA) && (NewValue.Data.Data == Tree->Value.Data.Data))) {
+    ZeroMem(&(Tree->Value), sizeof(CONFIG_VALUE));
+  }
+  // Replace the previous value
+  ConfigTreeFreeValue(Tree);
+  Tree->Type = Type;
+  Tree->Encoded = (Encoded && (Type == CONFIG_TYPE_DATA));
+  CopyMem(&(Tree->Value), &NewValue, sizeof(CONFIG_VALUE));
+  return EFI_SUCCESS;
+}
+// ConfigTreeSetValue
+/// Set the value of a configuration tree node
+/// @param Tree    The configuration tree node
+/// @param Type    The configuration type to set
+/// @param Value   The configuration value to set, which must be valid
+/// @param Encoded Whether the data value is measured base64 text to pack instead of data to copy, the data size is then the decoded size
+/// @return Whether the configuration value was set or not
+/// @retval EFI_ACCESS_DENIED    If the configuration tree node has children
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the configuration value was set successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigTreeSetValue (
+  IN CONFIG_TREE  *Tree,
+  IN CONFIG_TYPE   Type,
+  IN CONFIG_VALUE *Value,
+  IN BOOLEAN       Encoded
+) {
+  EFI_STATUS Status = ConfigTreeStoreValue(Tree, Type, Value, Encoded);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  ConfigSnapshotRetire();
+  // Notify subscriptions to this value
+  if (mConfigSubscriptions != NULL) {
+    ConfigNotifyMark(Tree, FALSE);
+    ConfigNotifyPending();
+  }
+  return EFI_SUCCESS;
+}
+// ConfigTreeFree
+/// Free configuration tree node and its descendants back to the node slabs
+/// @param Tree The configuration tree node
+/// @return Whether the configuration tree node was freed or not
+/// @retval EFI_INVALID_PARAMETER If Tree is NULL
+/// @retval EFI_SUCCESS           If the node was freed successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigTreeFree (
+  IN CONFIG_TREE *Tree
+) {
+  CONFIG_TREE *Child;
+  // Check parameters
+  if (Tree == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Remove from the index
+  ConfigIndexRemove(Tree);
+  // Free any children
+  Child = Tree->Children;
+  while (Child != NULL) {
+    CONFIG_TREE *Tmp = Child;
+    Child = Tmp->Next;
+    ConfigTreeFree(Tmp);
+  }
+  // Release the name and value storage for reuse and the node back to the node slabs
+  ConfigTreeFreeValue(Tree);
+  if (Tree->Name != NULL) {
+    ConfigArenaFree(Tree->Name, ((Tree->Length + 1) << 1) * sizeof(CHAR16));
+  }
+  ConfigNodeRelease(Tree);
+  return EFI_SUCCESS;
+}
+
+// ConfigStageFold
+/// Join configuration path segments and fold the path to upper case to compare with staged values
+/// @param Segments The path segments, which may contain separators or be NULL
+/// @param Count    The count of path segments
+/// @param Buffer   The buffer to use if the path is not longer than CONFIG_STAGE_PATH_LENGTH
+/// @param Length   On output, the length, in characters, of the folded path
+/// @param Hash     On output, the case-insensitive hash of the path
+/// @return The folded path, which must be freed if it is not Buffer, or NULL if memory could not be allocated
+STATIC CHAR16 *
+EFIAPI
+ConfigStageFold (
+  IN  CHAR16 **Segments,
+  IN  UINTN    Count,
+  IN  CHAR16   Buffer[CONFIG_STAGE_PATH_LENGTH + 1],
+  OUT UINTN   *Length,
+  OUT UINT32  *Hash
+) {
+  CHAR16 *Folded = Buffer;
+  *Length = ConfigStagePath(Segments, Count, NULL);
+  if (*Length > CONFIG_STAGE_PATH_LENGTH) {
+    Folded = (CHAR16 *)AllocatePool((*Length + 1) * sizeof(CHAR16));
+    if (Folded == NULL) {
+      return NULL;
+    }
+  }
+  ConfigStagePath(Segments, Count, Folded);
+  *Hash = StrniHash(Folded, *Length);
+  StrniFold(Folded, Folded, *Length);
+  return Folded;
+}
+// ConfigStageFind
+/// Find the value staged by the open configuration transaction for a configuration path
+/// @param Segments The path segments, which may contain separators or be NULL
+/// @param Count    The count of path segments
+/// @return The staged value or NULL if no value is staged for the path
+STATIC CONFIG_STAGED *
+EFIAPI
+ConfigStageFind (
+  IN CHAR16 **Segments,
+  IN UINTN    Count
+) {
+  CONFIG_STAGED *Staged;
+  CHAR16        *Folded;
+  UINTN          Length;
+  UINT32         Hash;
+  CHAR16         Buffer[CONFIG_STAGE_PATH_LENGTH + 1];
+  if (mConfigTransaction.Count == 0) {
+    return NULL;
+  }
+  Folded = ConfigStageFold(Segments, Count, Buffer, &Length, &Hash);
+  if (Folded == NULL) {
+    return NULL;
+  }
+  for (Staged = mConfigTransaction.Buckets[Hash & (CONFIG_STAGE_BUCKETS - 1)]; Staged != NULL; Staged = Staged->HashNext) {
+    if ((Staged->Hash == Hash) && (Staged->Length == Length) && (CompareMem(Staged->Folded, Folded, Length * sizeof(CHAR16)) == 0)) {
+      break;
+    }
+  }
+  if (Folded != Buffer) {
+    FreePool(Folded);
+  }
+  return Staged;
+}
+// ConfigStageGetValue
+/// Get the value staged by the open configuration transaction for a configuration path, decoding a packed data value on first read
+/// @param Segments The path segments, which may contain separators or be NULL
+/// @param Count    The count of path segments
+/// @param Type     On output, the type of the staged value
+/// @param Value    On output, the staged value
+/// @retval TRUE  If a value is staged for the path
+/// @retval FALSE If no value is staged for the path so the configuration tree must be read
+STATIC BOOLEAN
+EFIAPI
+ConfigStageGetValue (
+  IN  CHAR16       **Segments,
+  IN  UINTN          Count,
+  OUT CONFIG_TYPE   *Type,
+  OUT CONFIG_VALUE  *Value
+) {
+  CONFIG_STAGED *Staged = ConfigStageFind(Segments, Count);
+  if ((Staged == NULL) || (Staged->Type == CONFIG_TYPE_UNKNOWN)) {
+    return FALSE;
+  }
+  if (Staged->Encoded) {
+    UnpackBase64((UINT8 *)Staged->Value.Data.Data, (UINT8 *)Staged->Value.Data.Data, Staged->Value.Data.Size);
+    Staged->Encoded = FALSE;
+  }
+  *Type = Staged->Type;
+  CopyMem(Value, &(Staged->Value), sizeof(CONFIG_VALUE));
+  return TRUE;
+}
+// ConfigStageValue
+/// Stage a configuration value in the open configuration transaction, replacing any value already staged for the path
+/// @param Segments The path segments, which may contain separators or be NULL
+/// @param Count    The count of path segments
+/// @param Type     The configuration type to stage
+/// @param Value    The configuration value to stage, which must be valid
+/// @param Encoded  Whether the data value is measured base64 text to pack instead of data to copy, the data size is then the decoded size
+/// @return Whether the configuration value was staged or not
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the configuration value was staged successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigStageValue (
+  IN CHAR16       **Segments,
+  IN UINTN          Count,
+  IN CONFIG_TYPE    Type,
+  IN CONFIG_VALUE  *Value,
+  IN BOOLEAN        Encoded
+) {
+  EFI_STATUS     Status;
+  CONFIG_STAGED *Staged;
+  CONFIG_VALUE   NewValue;
+  UINTN          Length;
+  Staged = ConfigStageFind(Segments, Count);
+  if (Staged == NULL) {
+    // Store the path and its folded form after the staged value
+    Length = ConfigStagePath(Segments, Count, NULL);
+    Staged = (CONFIG_STAGED *)ConfigArenaAllocateFrom(&(mConfigTransaction.Arena), sizeof(CONFIG_STAGED) + (((Length + 1) << 1) * sizeof(CHAR16)));
+    if (Staged == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    ZeroMem(Staged, sizeof(CONFIG_STAGED));
+    Staged->Path = (CHAR16 *)(Staged + 1);
+    Staged->Folded = Staged->Path + Length + 1;
+    Staged->Length = ConfigStagePath(Segments, Count, Staged->Path);
+    Staged->Hash = StrniHash(Staged->Path, Length);
+    Staged->Type = CONFIG_TYPE_UNKNOWN;
+    StrniFold(Staged->Folded, Staged->Path, Length);
+    // Append in staging order and add to the hash bucket
+    Staged->HashNext = mConfigTransaction.Buckets[Staged->Hash & (CONFIG_STAGE_BUCKETS - 1)];
+    mConfigTransaction.Buckets[Staged->Hash & (CONFIG_STAGE_BUCKETS - 1)] = Staged;
+    *(mConfigTransaction.Last) = Staged;
+    mConfigTransaction.Last = &(Staged->Next);
+    ++(mConfigTransaction.Count);
+  }
+  // The value storage goes into the transaction arena so a restaged or aborted value is released with the transaction
+  Status = ConfigValueStore(&(mConfigTransaction.Arena), Type, Value, Encoded, Staged->Type, &(Staged->Value), Staged->Encoded, &NewValue);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  Staged->Type = Type;
+  Staged->Encoded = (Encoded && (Type == CONFIG_TYPE_DATA));
+  CopyMem(&(Staged->Value), &NewValue, sizeof(CONFIG_VALUE));
+  return EFI_SUCCESS;
+}
+// ConfigStageDrop
+/// Drop the values staged by the open configuration transaction at or below a configuration path that is being freed
+/// @param Path The configuration path being freed or NULL for root
+STATIC VOID
+EFIAPI
+ConfigStageDrop (
+  IN CHAR16 *Path OPTIONAL
+) {
+  CONFIG_STAGED  *Staged;
+  CONFIG_STAGED **Link;
+  CONFIG_STAGED **HashLink;
+  CHAR16         *Folded;
+  UINTN           Length;
+  UINT32          Hash;
+  CHAR16          Buffer[CONFIG_STAGE_PATH_LENGTH + 1];
+  if (mConfigTransaction.Count == 0) {
+    return;
+  }
+  Folded = ConfigStageFold(&Path, 1, Buffer, &Length, &Hash);
+  if (Folded == NULL) {
+    return;
+  }
+  for (Link = &(mConfigTransaction.First); *Link != NULL;) {
+    Staged = *Link;
+    if ((Length == 0) ||
+        ((Staged->Length >= Length) && (CompareMem(Staged->Folded, Folded, Length * sizeof(CHAR16)) == 0) &&
+         ((Staged->Length == Length) || (Staged->Folded[Length] == L'\\')))) {
+      // Unlink from the hash bucket and the staging order
+      for (HashLink = &(mConfigTransaction.Buckets[Staged->Hash & (CONFIG_STAGE_BUCKETS - 1)]); *HashLink != Staged; HashLink = &((*HashLink)->HashNext));
+      *HashLink = Staged->HashNext;
+      *Link = Staged->Next;
+      --(mConfigTransaction.Count);
+    } else {
+      Link = &(Staged->Next);
+    }
+  }
+  mConfigTransaction.Last = Link;
+  if (Folded != Buffer) {
+    FreePool(Folded);
+  }
+}
+// ConfigStageReset
+/// Discard all values staged by the open configuration transaction and release the staging storage
+STATIC VOID
+EFIAPI
+ConfigStageReset (
+  VOID
+) {
+  ConfigArenaRelease(&(mConfigTransaction.Arena));
+  ZeroMem(mConfigTransaction.Buckets, sizeof(mConfigTransaction.Buckets));
+  mConfigTransaction.First = NULL;
+  mConfigTransaction.Last = &(mConfigTransaction.First);
+  mConfigTransaction.Count = 0;
+}
+// ConfigStageApply
+/// Merge the values staged by the open configuration transaction into the configuration tree in staging order, so new nodes are linked in the same order as direct writes
+/// @return Whether all the staged values were applied or not
+/// @retval EFI_ACCESS_DENIED    If a staged value is for a configuration tree node that has children
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If all the staged values were applied successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigStageApply (
+  VOID
+) {
+  EFI_STATUS     Status = EFI_SUCCESS;
+  EFI_STATUS     Result;
+  CONFIG_STAGED *Staged;
+  CONFIG_STAGED *Previous = NULL;
+  CONFIG_TREE   *Node = NULL;
+  CONFIG_TREE   *Parent;
+  UINTN          Shared;
+  UINTN          Index;
+  // Load any include files bound to the staged paths before any node is resolved
+  if (mConfigIncludes != NULL) {
+    for (Staged = mConfigTransaction.First; Staged != NULL; Staged = Staged->Next) {
+      ConfigIncludeLoad(&(Staged->Path), 1);
+    }
+  }
+  // Consecutive values usually share a path prefix with the previous value, so resolve only the rest of the path
+  for (Staged = mConfigTransaction.First; Staged != NULL; Previous = Staged, Staged = Staged->Next) {
+    // Staging the value failed so there is nothing to apply
+    if (Staged->Type == CONFIG_TYPE_UNKNOWN) {
+      Node = NULL;
+      continue;
+    }
+    Parent = NULL;
+    Shared = 0;
+    if ((Previous != NULL) && (Node != NULL)) {
+      // Find the end of the path prefix shared with the previous value
+      for (Index = 0; (Index < Previous->Length) && (Index < Staged->Length) && (Previous->Folded[Index] == Staged->Folded[Index]); ++Index) {
+        if (Staged->Folded[Index] == L'\\') {
+          Shared = Index + 1;
+        }
+      }
+      if ((Index == Previous->Length) && (Index < Staged->Length) && (Staged->Folded[Index] == L'\\')) {
+        // The previous value is an ancestor of this value
+        Parent = Node;
+        Shared = Index + 1;
+      } else if (Shared != 0) {
+        // Walk up from the previous node once for its own name and once for each name after the shared prefix
+        Parent = Node->Parent;
+        for (Index = Shared; Index < Previous->Length; ++Index) {
+          if (Previous->Folded[Index] == L'\\') {
+            Parent = Parent->Parent;
+          }
+        }
+      }
+    }
+    // Resolve the rest of the path from the shared prefix or the root
+    if (Parent == NULL) {
+      Shared = 0;
+      Result = ConfigFindRoot(TRUE, &Parent);
+      if (EFI_ERROR(Result)) {
+        return Result;
+      }
+    }
+    Result = ConfigFindChild(Parent, Staged->Path + Shared, TRUE, &Node);
+    if (EFI_ERROR(Result)) {
+      Node = NULL;
+    } else {
+      // Copy the staged value out of the transaction arena, which is released when the transaction ends
+      if (Staged->Encoded) {
+        UnpackBase64((UINT8 *)Staged->Value.Data.Data, (UINT8 *)Staged->Value.Data.Data, Staged->Value.Data.Size);
+        Staged->Encoded = FALSE;
+      }
+      Result = ConfigTreeStoreValue(Node, Staged->Type, &(Staged->Value), FALSE);
+      if (!EFI_ERROR(Result) && (mConfigSubscriptions != NULL)) {
+        ConfigNotifyMark(Node, FALSE);
+      }
+    }
+    // Keep the first error but apply every other value
+    if (EFI_ERROR(Result) && !EFI_ERROR(Status)) {
+      Status = Result;
+    }
+  }
+  return Status;
+}
+
+// ConfigLoad
+/// Load configuration information from file
+/// @param Root If Path is NULL the file handle to use to load, otherwise the root file handle
+/// @param Path If Root is NULL the full device path string to the file, otherwise the root relative path
+/// @return Whether the configuration was loaded successfully or not
+/// @retval EFI_INVALID_PARAMETER If Root and Path are both NULL
+/// @retval EFI_NOT_FOUND         If the configuration file could not be opened
+/// @retval EFI_SUCCESS           If the configuration file was loaded successfully
+EFI_STATUS
+EFIAPI
+ConfigLoad (
+  IN EFI_FILE_HANDLE  Root OPTIONAL,
+  IN CHAR16          *Path OPTIONAL
+) {
+  EFI_STATUS      Status;
+  EFI_FILE_HANDLE Handle = NULL;
+  // Check parameters
+  if ((Root == NULL) && (Path == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Record the source for the compiled configuration cache, even if it does not exist yet
+  if (mConfigCacheRecord) {
+    if ((Root != NULL) || (Path == NULL)) {
+      mConfigCacheable = FALSE;
+    } else if (StrList(&mConfigCacheSources, &mConfigCacheSourceCount, Path, 0, STR_LIST_NO_DUPLICATES | STR_LIST_CASE_INSENSITIVE) == EFI_OUT_OF_RESOURCES) {
+      mConfigCacheable = FALSE;
+    }
+  }
+  if (Path != NULL) {
+    // Open configuration file handle
+    Log2(L"Configuration:", L"\"%s\"\n", Path);
+    Status = FileHandleOpen(&Handle, Root, Path, EFI_FILE_MODE_READ, 0);
+  } else {
+    // Get file name of file handle
+    Status = FileHandleGetFileName(Root, &Path);
+    if (!EFI_ERROR(Status) && (Path != NULL)) {
+      // Open configuration file handle
+      Log2(L"Configuration:", L"\"%s\"\n", Path);
+      Status = FileHandleOpen(&Handle, Root, Path, EFI_FILE_MODE_READ, 0);
+      FreePool(Path);
+    }
+  }
+  // If file handle is open parse configuration
+  if (!EFI_ERROR(Status) && (Handle != NULL)) {
+    UINT64 FileSize = 0;
+    UINTN  Size = 0;
+    // Get file size to read the configuration
+    Status = FileHandleGetSize(Handle, &FileSize);
+    if (!EFI_ERROR(Status)) {
+      if (FileSize == 0) {
+        // Assume not found if no file size
+        Status = EFI_NOT_FOUND;
+      } else {
+        // Allocate buffer to hold configuration string
+        VOID *Config = (VOID *)AllocateZeroPool(Size = (UINTN)FileSize);
+        if (Config == NULL) {
+          Status = EFI_OUT_OF_RESOURCES;
+        } else {
+          // Read configuration string from file
+          Status = FileHandleRead(Handle, &Size, (VOID *)Config);
+          if (!EFI_ERROR(Status)) {
+            Status = ConfigParse(Size, Config);
+          }
+          FreePool(Config);
+        }
+      }
+    }
+    // Close the file handle
+    FileHandleClose(Handle);
+  }
+  Log2(L"  Load status:", L"%r\n", Status);
+  return Status;
+}
+
+// ConfigPlatformFold
+/// Duplicate a platform identity string folded to upper case
+/// @param Identity The platform identity string or NULL if unknown
+/// @return The folded platform identity, which must be freed, or NULL if unknown or memory could not be allocated
+STATIC CHAR16 *
+EFIAPI
+ConfigPlatformFold (
+  IN CHAR8 *Identity OPTIONAL
+) {
+  CHAR16 *Folded;
+  UINTN   Length;
+  if (Identity == NULL) {
+    return NULL;
+  }
+  Length = AsciiStrLen(Identity) + 1;
+  Folded = (CHAR16 *)AllocateZeroPool(Length * sizeof(CHAR16));
+  if (Folded != NULL) {
+    AsciiStrToUnicodeStrS(Identity, Folded, Length);
+    StrniFold(Folded, Folded, Length);
+  }
+  return Folded;
+}
+// ConfigPlatformInitialize
+/// Evaluate the platform identity for configuration XML conditions once
+STATIC VOID
+EFIAPI
+ConfigPlatformInitialize (
+  VOID
+) {
+  if (mConfigPlatformReady) {
+    return;
+  }
+  mConfigPlatformReady = TRUE;
+  mConfigPlatform[CONFIG_PLATFORM_ARCH] = StrDup(PROJECT_ARCH);
+  if (mConfigPlatform[CONFIG_PLATFORM_ARCH] != NULL) {
+    StrniFold(mConfigPlatform[CONFIG_PLATFORM_ARCH], mConfigPlatform[CONFIG_PLATFORM_ARCH], StrLen(PROJECT_ARCH));
+  }
+  mConfigPlatform[CONFIG_PLATFORM_MANUFACTURER] = ConfigPlatformFold(GetSmBiosManufacturer());
+  mConfigPlatform[CONFIG_PLATFORM_PRODUCT] = ConfigPlatformFold(GetSmBiosProductName());
+}
+// ConfigPlatformFree
+/// Free the platform identity and the compiled platform conditions
+STATIC VOID
+EFIAPI
+ConfigPlatformFree (
+  VOID
+) {
+  UINTN Index;
+  for (Index = 0; Index < CONFIG_PLATFORM_COUNT; ++Index) {
+    if (mConfigPlatform[Index] != NULL) {
+      FreePool(mConfigPlatform[Index]);
+      mConfigPlatform[Index] = NULL;
+    }
+  }
+  for (Index = 0; Index < CONFIG_CONDITION_BUCKETS; ++Index) {
+    while (mConfigConditions[Index] != NULL) {
+      CONFIG_CONDITION *Condition = mConfigConditions[Index];
+      mConfigConditions[Index] = Condition->Next;
+      FreePool(Condition);
+    }
+  }
+  mConfigPlatformReady = FALSE;
+}
+// ConfigXmlIsExcluded
+/// Check whether a configuration XML element attribute excludes the element from this platform
+/// @param Name  The attribute name
+/// @param Value The attribute value
+/// @retval TRUE  If the element is intended for a different platform
+/// @retval FALSE If the element is not excluded by the attribute
+STATIC BOOLEAN
+EFIAPI
+ConfigXmlIsExcluded (
+  IN CHAR16 *Name,
+  IN CHAR16 *Value OPTIONAL
+) {
+  CONFIG_CONDITION *Condition;
+  UINTN             Key;
+  UINTN             Length;
+  UINT32            Hash;
+  // Check the attribute is a platform identity key
+  for (Key = 0; Key < CONFIG_PLATFORM_COUNT; ++Key) {
+    if (StriCmp(Name, mConfigPlatformKeys[Key].Name) == 0) {
+      break;
+    }
+  }
+  if (Key >= CONFIG_PLATFORM_COUNT) {
+    return FALSE;
+  }
+  if (Value == NULL) {
+    return TRUE;
+  }
+  // Find the compiled condition
+  Length = StrLen(Value);
+  Hash = StrniHash(Value, Length);
+  for (Condition = mConfigConditions[(Hash ^ (UINT32)Key) & (CONFIG_CONDITION_BUCKETS - 1)]; Condition != NULL; Condition = Condition->Next) {
+    if ((Condition->Key == Key) && (Condition->Hash == Hash) && (StriCmp(Condition->Value, Value) == 0)) {
+      return Condition->Excluded;
+    }
+  }
+  // Compile the condition against the platform identity
+  ConfigPlatformInitialize();
+  Condition = (CONFIG_CONDITION *)AllocateZeroPool(sizeof(CONFIG_CONDITION) + ((Length + 1) * sizeof(CHAR16)));
+  if (Condition == NULL) {
+    return TRUE;
+  }
+  Condition->Value = (CHAR16 *)(Condition + 1);
+  StrniFold(Condition->Value, Value, Length);
+  Condition->Key = Key;
+  Condition->Hash = Hash;
+  if (mConfigPlatform[Key] == NULL) {
+    // Skip elements conditioned on an unknown identity
+    Condition->Excluded = TRUE;
+  } else if (mConfigPlatformKeys[Key].Exact) {
+    Condition->Excluded = (StrCmp(mConfigPlatform[Key], Condition->Value) != 0);
+  } else {
+    Condition->Excluded = (StrStr(mConfigPlatform[Key], Condition->Value) == NULL);
+  }
+  Condition->Next = mConfigConditions[(Hash ^ (UINT32)Key) & (CONFIG_CONDITION_BUCKETS - 1)];
+  mConfigConditions[(Hash ^ (UINT32)Key) & (CONFIG_CONDITION_BUCKETS - 1)] = Condition;
+  return Condition->Excluded;
+}
+// ConfigXmlMakePath
+/// Create the configuration path of a configuration XML element
+/// @param Parent     The configuration path of the parent element or NULL for the root
+/// @param Options    The options of the parent element
+/// @param TagName    The element tag name
+/// @param LevelIndex The index of the element relative to its parent
+/// @return The configuration path, which must be freed, or NULL if memory could not be allocated
+STATIC CHAR16 *
+EFIAPI
+ConfigXmlMakePath (
+  IN CHAR16 *Parent OPTIONAL,
+  IN UINTN   Options,
+  IN CHAR16 *TagName,
+  IN UINTN   LevelIndex
+) {
+  CHAR16 *IndexPath;
+  CHAR16 *Path;
+  // Check for group type
+  if (StriCmp(TagName, L"group") == 0) {
+    // Create the index of this group
+    IndexPath = CatSPrint(NULL, L"%u", LevelIndex);
+  } else if ((Parent != NULL) && ((Options & CONFIG_INSPECT_AUTO_GROUP) != 0)) {
+    // Auto group this partial path
+    IndexPath = CatSPrint(NULL, L"%u\\%s", 0, TagName);
+  } else {
+    // Create full path
+    return FileMakePath(Parent, TagName);
+  }
+  if (IndexPath == NULL) {
+    return NULL;
+  }
+  Path = FileMakePath(Parent, IndexPath);
+  FreePool(IndexPath);
+  return Path;
+}
+// ConfigXmlGetOptions
+/// Get the options of a configuration XML element with children
+/// @param Path The configuration path of the element
+/// @return The options for the children of the element
+STATIC UINTN
+EFIAPI
+ConfigXmlGetOptions (
+  IN CHAR16 *Path
+) {
+  UINTN Index;
+  // Check if this key is auto grouped
+  for (Index = 0; Index < ARRAY_SIZE(mConfigAutoGroups); ++Index) {
+    if (StriCmp(Path, mConfigAutoGroups[Index]) == 0) {
+      return CONFIG_INSPECT_AUTO_GROUP;
+    }
+  }
+  return 0;
+}
+// ConfigXmlIsValueType
+/// Check whether a configuration XML tag name is a value type
+/// @param TagName The tag name
+/// @retval TRUE  If the tag name is a value type
+/// @retval FALSE If the tag name is not a value type
+STATIC BOOLEAN
+EFIAPI
+ConfigXmlIsValueType (
+  IN CHAR16 *TagName
+) {
+  UINTN Index;
+  for (Index = 0; Index < ARRAY_SIZE(mConfigValueTypes); ++Index) {
+    if (StriCmp(TagName, mConfigValueTypes[Index]) == 0) {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+// ConfigSetEncodedData
+/// Set a data configuration value from base64 text, which is packed and only decoded when the value is first read
+/// @param Path   The path of the configuration value
+/// @param Base64 The base64 text
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If the base64 text is empty or invalid
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigSetEncodedData (
+  IN CHAR16 *Path,
+  IN CHAR16 *Base64
+) {
+  EFI_STATUS    Status;
+  CONFIG_TREE  *Node = NULL;
+  CONFIG_VALUE  Value;
+  UINT8        *Data;
+  // Measure the base64 text the same way for either owner of the configuration tree
+  Value.Data.Size = PackBase64(Base64, NULL);
+  Value.Data.Data = Base64;
+  if (Value.Data.Size == 0) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Decode now if another image owns the configuration tree
+  if (mConfig != NULL) {
+    Data = (UINT8 *)AllocatePool(PackedBase64Size(Value.Data.Size));
+    if (Data == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    PackBase64(Base64, Data);
+    UnpackBase64(Data, Data, Value.Data.Size);
+    Status = ConfigSetData(Path, Value.Data.Size, Data);
+    FreePool(Data);
+    return Status;
+  }
+  // Stage the value while a transaction is open
+  if (mConfigTransaction.Depth != 0) {
+    return ConfigStageValue(&Path, 1, CONFIG_TYPE_DATA, &Value, TRUE);
+  }
+  // Get configuration tree node
+  Status = ConfigFind(Path, TRUE, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (Node == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  return ConfigTreeSetValue(Node, CONFIG_TYPE_DATA, &Value, TRUE);
+}
+// ConfigXmlSetTypedValue
+/// Set a configuration value from a configuration XML value type element
+/// @param Path  The configuration path
+/// @param Type  The value type tag name
+/// @param Value The value type element value
+/// @retval TRUE  If the tag name was a value type, whether or not the value was valid
+/// @retval FALSE If the tag name was not a value type
+STATIC BOOLEAN
+EFIAPI
+ConfigXmlSetTypedValue (
+  IN CHAR16 *Path,
+  IN CHAR16 *Type,
+  IN CHAR16 *Value OPTIONAL
+) {
+  // Check which type
+  if (StriCmp(Type, L"integer") == 0) {
+    // Integer value
+    if (Value != NULL) {
+      INTN Integer = 1;
+      if (*Value == L'-') {
+        Integer = -1;
+        ++Value;
+      }
+      if ((*Value == L'0') && ((Value[1] == L'x') || (Value[1] == L'X'))) {
+        Integer *= (INTN)StrHexToUintn(Value + 2);
+        LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=0x%0*X\n", Path, sizeof(UINTN) << 1, Integer);
+      } else {
+        Integer *= (INTN)StrDecimalToUintn(Value);
+        LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=%d\n", Path, Integer);
+      }
+      ConfigSetInteger(Path, Integer);
+    }
+  } else if (StriCmp(Type, L"unsigned") == 0) {
+    // Unsigned integer value
+    if (Value != NULL) {
+      UINTN Unsigned;
+      if ((*Value == L'0') && ((Value[1] == L'x') || (Value[1] == L'X'))) {
+        Unsigned = StrHexToUintn(Value + 2);
+        LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=0x%0*X\n", Path, sizeof(UINTN) << 1, Unsigned);
+      } else {
+        Unsigned = StrDecimalToUintn(Value);
+        LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=%u\n", Path, Unsigned);
+      }
+      ConfigSetUnsigned(Path, Unsigned);
+    }
+  } else if (StriCmp(Type, L"data") == 0) {
+    // Data base64 value, kept encoded until first read
+    if ((Value != NULL) && !EFI_ERROR(ConfigSetEncodedData(Path, Value))) {
+      LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=%s\n", Path, Value);
+    }
+  } else if (StriCmp(Type, L"boolean") == 0) {
+    // Boolean value
+    if (Value != NULL) {
+      BOOLEAN Boolean = ((*Value == L't') || (*Value == L'T') ||
+                         ((*Value == L'0') && ((Value[1] == L'x') || (Value[1] == L'X')) && (StrHexToUintn(Value + 2) != 0)) ||
+                         (StrDecimalToUintn(Value) != 0));
+      LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=%s\n", Path, Boolean ? L"true" : L"false");
+      ConfigSetBoolean(Path, Boolean);
+    }
+  } else if (StriCmp(Type, L"true") == 0) {
+    // True
+    LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=true\n", Path);
+    ConfigSetBoolean(Path, TRUE);
+  } else if (StriCmp(Type, L"false") == 0) {
+    // False
+    LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=false\n", Path);
+    ConfigSetBoolean(Path, FALSE);
+  } else {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+// ConfigXmlInclude
+/// Include another configuration file from a configuration XML include element
+/// @param Tree  The include element, which may have a subtree attribute to defer loading until the subtree is first accessed
+/// @param Value The full device path string to the include file
+STATIC VOID
+EFIAPI
+ConfigXmlInclude (
+  IN XML_TREE *Tree,
+  IN CHAR16   *Value
+) {
+  XML_ATTRIBUTE *Subtree = NULL;
+  // A deferred include file is recorded by the compiled configuration cache as a binding and bound again when the cache is loaded
+  if (!EFI_ERROR(XmlTreeGetAttribute(Tree, L"subtree", &Subtree)) &&
+      (Subtree != NULL) && (Subtree->Value != NULL) && (*(Subtree->Value) != L'\0') &&
+      !EFI_ERROR(ConfigIncludeBind(Subtree->Value, Value))) {
+    return;
+  }
+  ConfigLoad(NULL, Value);
+}
+// ConfigXmlInspector
+/// Configuration XML document tree inspection callback
+/// @param Tree           The document tree node
+/// @param Level          The level of generation of tree nodes, zero for the root
+/// @param LevelIndex     The index of the tree node relative to the previous level
+/// @param TagName        The tree node tag name
+/// @param Value          The tree node value
+/// @param AttributeCount The tree node attribute count
+/// @param Attributes     The tree node attributes
+/// @param ChildCount     The tree node child count
+/// @param Children       The tree node children
+/// @param Context        The context passed when inspection started
+/// @retval TRUE  If the inspection should continue
+/// @retval FALSE If the inspection should stop
+STATIC BOOLEAN
+EFIAPI
+ConfigXmlInspector (
+  IN XML_TREE       *Tree,
+  IN UINTN           Level,
+  IN UINTN           LevelIndex,
+  IN CHAR16         *TagName,
+  IN CHAR16         *Value OPTIONAL,
+  IN UINTN           AttributeCount,
+  IN XML_ATTRIBUTE **Attributes OPTIONAL,
+  IN UINTN           ChildCount,
+  IN XML_TREE      **Children OPTIONAL,
+  IN VOID           *Context OPTIONAL
+) {
+  CONFIG_INSPECT *Parent = (CONFIG_INSPECT *)Context;
+  CONFIG_INSPECT  This = { 0, 0 };
+  UINTN           Index;
+  // Check parameters
+  if ((Tree == NULL) || (TagName == NULL)) {
+    return TRUE;
+  }
+  // Get attributes
+  if ((Attributes != NULL) && (AttributeCount > 0)) {
+    // Iterate through attributes
+    for (Index = 0; Index < AttributeCount; ++Index) {
+      if ((Attributes[Index] != NULL) && (Attributes[Index]->Name != NULL) &&
+          ConfigXmlIsExcluded(Attributes[Index]->Name, Attributes[Index]->Value)) {
+        // Skip this tree node since it's intended for a different platform
+        return TRUE;
+      }
+    }
+  }
+  if ((Level == 1) && (ChildCount == 0) && (Value != NULL) && (StriCmp(TagName, L"include") == 0)) {
+    // Include another configuration
+    ConfigXmlInclude(Tree, Value);
+    return TRUE;
+  }
+  // Create the path
+  This.Path = ConfigXmlMakePath((Parent == NULL) ? NULL : Parent->Path, (Parent == NULL) ? 0 : Parent->Options, TagName, LevelIndex);
+  if (This.Path == NULL) {
+    return TRUE;
+  }
+  // Get children
+  if ((Children != NULL) && (ChildCount > 0)) {
+    // Check for some built in types
+    if ((ChildCount == 1) && !XmlTreeHasChildren(Children[0])) {
+      CHAR16 *Name = NULL;
+      if (!EFI_ERROR(XmlTreeGetTag(Children[0], &Name)) && (Name != NULL)) {
+        CHAR16 *ChildValue = NULL;
+        if (EFI_ERROR(XmlTreeGetValue(Children[0], &ChildValue))) {
+          ChildValue = NULL;
+        }
+        if (ConfigXmlSetTypedValue(This.Path, Name, ChildValue)) {
+          FreePool(This.Path);
+          return TRUE;
+        }
+      }
+    }
+    // Check if this key is auto grouped
+    This.Options = ConfigXmlGetOptions(This.Path);
+    // Iterate through children
+    for (Index = 0; Index < ChildCount; ++Index) {
+      // Inspect each child
+      XmlTreeInspect(Children[Index], Level + 1, Index, ConfigXmlInspector, (VOID *)&This, FALSE);
+    }
+  } else if (Value != NULL) {
+    // Value
+    LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=\"%s\"\n", This.Path, Value);
+    ConfigSetString(This.Path, Value);
+  }
+  FreePool(This.Path);
+  return TRUE;
+}
+// ConfigXmlStreamFlush
+/// Set the deferred first child of a configuration XML streaming element as an ordinary value
+/// @param Frame The configuration XML streaming element
+STATIC VOID
+EFIAPI
+ConfigXmlStreamFlush (
+  IN OUT CONFIG_STREAM_FRAME *Frame
+) {
+  if ((Frame->TypePath != NULL) && (Frame->TypeValue != NULL)) {
+    // Value
+    LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=\"%s\"\n", Frame->TypePath, Frame->TypeValue);
+    ConfigSetString(Frame->TypePath, Frame->TypeValue);
+  }
+  if (Frame->TypeName != NULL) {
+    FreePool(Frame->TypeName);
+    Frame->TypeName = NULL;
+  }
+  if (Frame->TypeValue != NULL) {
+    FreePool(Frame->TypeValue);
+    Frame->TypeValue = NULL;
+  }
+  if (Frame->TypePath != NULL) {
+    FreePool(Frame->TypePath);
+    Frame->TypePath = NULL;
+  }
+}
+// ConfigXmlStreamFree
+/// Free a configuration XML streaming element
+/// @param Frame The configuration XML streaming element
+STATIC VOID
+EFIAPI
+ConfigXmlStreamFree (
+  IN OUT CONFIG_STREAM_FRAME *Frame
+) {
+  // Drop the deferred first child without setting it
+  if (Frame->TypeValue != NULL) {
+    FreePool(Frame->TypeValue);
+    Frame->TypeValue = NULL;
+  }
+  ConfigXmlStreamFlush(Frame);
+  if (Frame->Path != NULL) {
+    FreePool(Frame->Path);
+    Frame->Path = NULL;
+  }
+}
+// ConfigXmlStream
+/// Configuration XML streaming parse callback, which sets configuration values while parsing
+/// @param Tree    The document tree node
+/// @param Level   The level of generation of tree nodes, zero for the root
+/// @param Event   The streaming parse event for the tree node
+/// @param Context The configuration XML streaming state
+/// @return Whether parsing should continue or not
+/// @retval EFI_INVALID_PARAMETER If the root element is not a configuration
+/// @retval EFI_BUFFER_TOO_SMALL  If the elements are nested too deeply
+/// @retval EFI_SUCCESS           If parsing should continue
+STATIC EFI_STATUS
+EFIAPI
+ConfigXmlStream (
+  IN XML_TREE         *Tree,
+  IN UINTN             Level,
+  IN XML_STREAM_EVENT  Event,
+  IN VOID             *Context OPTIONAL
+) {
+  CONFIG_STREAM       *Stream = (CONFIG_STREAM *)Context;
+  CONFIG_STREAM_FRAME *Frame;
+  CONFIG_STREAM_FRAME *Parent;
+  CHAR16              *TagName = NULL;
+  CHAR16              *Value = NULL;
+  // Check parameters
+  if ((Tree == NULL) || (Stream == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Level >= ARRAY_SIZE(Stream->Frames)) {
+    return EFI_BUFFER_TOO_SMALL;
+  }
+  if (EFI_ERROR(XmlTreeGetTag(Tree, &TagName)) || (TagName == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Frame = &(Stream->Frames[Level]);
+  Parent = (Level == 0) ? NULL : &(Stream->Frames[Level - 1]);
+  if (Event == XML_STREAM_OPEN) {
+    XML_ATTRIBUTE **Attributes = NULL;
+    UINTN           Count = 0;
+    UINTN           LevelIndex;
+    ZeroMem(Frame, sizeof(CONFIG_STREAM_FRAME));
+    Stream->Depth = Level + 1;
+    if (Parent == NULL) {
+      // The root element must be the configuration
+      return (StriCmp(TagName, L"configuration") == 0) ? EFI_SUCCESS : EFI_INVALID_PARAMETER;
+    }
+    LevelIndex = Parent->ChildCount++;
+    // A second child means the deferred first child was not the value type of the parent
+    if (LevelIndex == 1) {
+      ConfigXmlStreamFlush(Parent);
+    }
+    // The first child may be the value type of the parent whether or not it is skipped
+    Frame->Typed = ((Level > 1) && (LevelIndex == 0) && ConfigXmlIsValueType(TagName));
+    Frame->Skip = Parent->Skip;
+    if (!Frame->Skip && !EFI_ERROR(XmlTreeGetAttributes(Tree, &Attributes, &Count)) && (Attributes != NULL)) {
+      // Iterate through attributes
+      while (Count-- > 0) {
+        if ((Attributes[Count] != NULL) && (Attributes[Count]->Name != NULL) &&
+            ConfigXmlIsExcluded(Attributes[Count]->Name, Attributes[Count]->Value)) {
+          // Skip this element since it's intended for a different platform
+          Frame->Skip = TRUE;
+          break;
+        }
+      }
+      FreePool(Attributes);
+    }
+    if (!Frame->Skip) {
+      // Create the path
+      Frame->Path = ConfigXmlMakePath(Parent->Path, Parent->Options, TagName, LevelIndex);
+      if (Frame->Path == NULL) {
+        Frame->Skip = TRUE;
+      } else {
+        Frame->Options = ConfigXmlGetOptions(Frame->Path);
+      }
+    }
+    return EFI_SUCCESS;
+  }
+  // Close the element
+  if (Parent != NULL) {
+    if (EFI_ERROR(XmlTreeGetValue(Tree, &Value))) {
+      Value = NULL;
+    }
+    if (Frame->Typed && (Frame->ChildCount == 0) && ((Parent->TypeName = StrDup(TagName)) != NULL)) {
+      // Defer the first child until it is known whether it is the only child
+      Parent->TypeValue = (Value == NULL) ? NULL : StrDup(Value);
+      Parent->TypePath = Frame->Path;
+      Frame->Path = NULL;
+    } else if (Frame->Path != NULL) {
+      if (Frame->ChildCount == 0) {
+        if ((Level == 1) && (Value != NULL) && (StriCmp(TagName, L"include") == 0)) {
+          // Include another configuration
+          ConfigXmlInclude(Tree, Value);
+        } else if (Value != NULL) {
+          // Value
+          LOG_VERBOSE(LOG_MODULE_CONFIG, L"  %s=\"%s\"\n", Frame->Path, Value);
+          ConfigSetString(Frame->Path, Value);
+        }
+      } else if ((Frame->ChildCount == 1) && (Frame->TypeName != NULL)) {
+        // The only child was the value type
+        ConfigXmlSetTypedValue(Frame->Path, Frame->TypeName, Frame->TypeValue);
+      }
+    }
+  }
+  ConfigXmlStreamFree(Frame);
+  Stream->Depth = Level;
+  return EFI_SUCCESS;
+}
+// ConfigParse
+/// Parse configuration information from string
+/// @param Size   The size, in bytes, of the configuration string
+/// @param Config The configuration string to parse
+/// @return Whether the configuration was parsed successfully or not
+/// @retval EFI_INVALID_PARAMETER If Config is NULL or Size is zero
+/// @retval EFI_SUCCESS           If the configuration string was parsed successfully
+EFI_STATUS
+EFIAPI
+ConfigParse (
+  IN UINTN  Size,
+  IN VOID  *Config
+) {
+  EFI_STATUS     Status;
+  XML_PARSER    *Parser = NULL;
+  CONFIG_STREAM *Stream = NULL;
+  XML_LIMITS     Limits = { CONFIG_XML_MAX_DEPTH, CONFIG_XML_MAX_NODES, CONFIG_XML_MAX_BYTES };
+  XML_USAGE      Usage;
+  // Check parameters
+  if ((Config == NULL) || (Size == 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create XML parser
+  Status = XmlCreate(&Parser);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (Parser == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Bound the memory used to parse the configuration
+  Status = XmlSetLimits(Parser, &Limits);
+  if (EFI_ERROR(Status)) {
+    XmlFree(Parser);
+    return Status;
+  }
+  // Set configuration values while parsing unless the configuration protocol needs the document tree
+  if ((mConfig == NULL) || (mConfig->Parse == NULL)) {
+    Stream = (CONFIG_STREAM *)AllocateZeroPool(sizeof(CONFIG_STREAM));
+    if (Stream == NULL) {
+      XmlFree(Parser);
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Status = XmlSetStream(Parser, ConfigXmlStream, (VOID *)Stream);
+    if (EFI_ERROR(Status)) {
+      FreePool(Stream);
+      XmlFree(Parser);
+      return Status;
+    }
+  }
+  // Parse the XML buffer
+  Status = XmlParse(Parser, Size, Config);
+  if (!EFI_ERROR(XmlGetUsage(Parser, &Usage))) {
+    LOG2_VERBOSE(LOG_MODULE_CONFIG, L"  XML usage:", L"%u nodes, %u bytes, %u peak bytes, %u depth\n", Usage.NodeCount, Usage.TotalBytes, Usage.PeakBytes, Usage.PeakDepth);
+  }
+  if (!EFI_ERROR(Status)) {
+    XML_TREE *Tree = NULL;
+    // Get the XML document tree root node
+    Status = XmlGetTree(Parser, &Tree);
+    if (!EFI_ERROR(Status)) {
+      if (Tree == NULL) {
+        Status = EFI_INVALID_PARAMETER;
+      } else if (Stream == NULL) {
+        // Parse the configuration
+        Status = ConfigParseXml(Tree);
+      }
+    }
+  }
+  // Free the XML parser
+  XmlFree(Parser);
+  // Free any elements left open by a parse error
+  if (Stream != NULL) {
+    while (Stream->Depth > 0) {
+      ConfigXmlStreamFree(&(Stream->Frames[--(Stream->Depth)]));
+    }
+    FreePool(Stream);
+  }
+  return Status;
+}
+
+// ConfigParseXml
+/// Parse configuration information from XML document tree
+/// @param Tree The XML document tree to parse
+/// @return Whether the configuration was parsed successfully or not
+/// @retval EFI_INVALID_PARAMETER If Tree is NULL
+/// @retval EFI_SUCCESS           If the configuration was parsed successfully
+EFI_STATUS
+EFIAPI
+ConfigParseXml (
+  IN XML_TREE *Tree
+) {
+  XML_TREE **Children = NULL;
+  CHAR16    *Name = NULL;
+  UINTN      Count = 0;
+  UINTN      Index;
+  // Check parameters
+  if (Tree == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Use configuration protocol if present
+  if ((mConfig != NULL) && (mConfig->Parse != NULL)) {
+    CONFIG_STAT(Protocol);
+    return mConfig->Parse(Tree);
+  }
+  if (EFI_ERROR(XmlTreeGetTag(Tree, &Name)) || (Name == NULL) || (StriCmp(Name, L"configuration") != 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Inspect the XML tree
+  if (!EFI_ERROR(XmlTreeGetChildren(Tree, &Children, &Count)) && (Children != NULL) && (Count > 0)) {
+    for (Index = 0; Index < Count; ++Index) {
+      EFI_STATUS Status = XmlTreeInspect(Children[Index], 1, Index, ConfigXmlInspector, NULL, FALSE);
+      if (EFI_ERROR(Status)) {
+        FreePool(Children);
+        return Status;
+      }
+    }
+  }
+  if (Children != NULL) {
+    FreePool(Children);
+  }
+  return EFI_SUCCESS;
+}
+
+// ConfigCacheHash
+/// Accumulate a compiled configuration cache key hash
+/// @param Hash   The hash to accumulate
+/// @param Buffer The buffer to hash
+/// @param Size   The size, in bytes, of the buffer
+/// @return The accumulated hash
+STATIC UINT32
+EFIAPI
+ConfigCacheHash (
+  IN UINT32  Hash,
+  IN VOID   *Buffer OPTIONAL,
+  IN UINTN   Size
+) {
+  UINT8 *Bytes = (UINT8 *)Buffer;
+  if (Bytes != NULL) {
+    while (Size-- > 0) {
+      Hash = (Hash ^ *Bytes++) * CONFIG_CACHE_HASH_PRIME;
+    }
+  }
+  return Hash;
+}
+// ConfigCacheKey
+/// Get the compiled configuration cache key for the platform identity and configuration sources
+/// @param Sources The configuration source file paths
+/// @param Count   The count of configuration source file paths
+/// @return The compiled configuration cache key
+STATIC UINT32
+EFIAPI
+ConfigCacheKey (
+  IN CHAR16 **Sources,
+  IN UINTN    Count
+) {
+  UINT32 Hash = CONFIG_CACHE_HASH_SEED;
+  UINTN  Index;
+  // Hash the platform identity used by conditional configuration nodes
+  ConfigPlatformInitialize();
+  for (Index = 0; Index < CONFIG_PLATFORM_COUNT; ++Index) {
+    Hash = ConfigCacheHash(Hash, mConfigPlatform[Index], (mConfigPlatform[Index] == NULL) ? 0 : StrSize(mConfigPlatform[Index]));
+  }
+  // Hash each source path with its size and modification time, missing sources hash only their path
+  for (Index = 0; Index < Count; ++Index) {
+    EFI_FILE_HANDLE  Handle = NULL;
+    Hash = ConfigCacheHash(Hash, Sources[Index], StrSize(Sources[Index]));
+    if (!EFI_ERROR(FileHandleOpen(&Handle, NULL, Sources[Index], EFI_FILE_MODE_READ, 0)) && (Handle != NULL)) {
+      EFI_FILE_INFO *Info = FileHandleGetInfo(Handle);
+      if (Info != NULL) {
+        Hash = ConfigCacheHash(Hash, &(Info->FileSize), sizeof(Info->FileSize));
+        Hash = ConfigCacheHash(Hash, &(Info->ModificationTime), sizeof(Info->ModificationTime));
+        FreePool(Info);
+      }
+      FileHandleClose(Handle);
+    }
+  }
+  return Hash;
+}
+// ConfigCacheNodeSize
+/// Get the size of the value of a configuration tree node in a compiled configuration cache node record
+/// @param Tree The configuration tree node
+/// @return The size, in bytes, of the value
+STATIC UINTN
+EFIAPI
+ConfigCacheNodeSize (
+  IN CONFIG_TREE *Tree
+) {
+  switch (Tree->Type) {
+    case CONFIG_TYPE_BOOLEAN:
+    case CONFIG_TYPE_INTEGER:
+    case CONFIG_TYPE_UNSIGNED:
+      return sizeof(UINT64);
+
+    case CONFIG_TYPE_STRING:
+      return (Tree->Value.String == NULL) ? 0 : StrSize(Tree->Value.String);
+
+    case CONFIG_TYPE_DATA:
+      return (Tree->Value.Data.Data == NULL) ? 0 : Tree->Value.Data.Size;
+
+    default:
+      break;
+  }
+  return 0;
+}
+// ConfigCacheWriteNodes
+/// Write the compiled configuration cache node records for the children of a configuration tree node
+/// @param Tree   The configuration tree node
+/// @param Parent The index of the node record of the configuration tree node
+/// @param Buffer The compiled configuration cache buffer or NULL to only measure the node records
+/// @param Offset On input, the offset of the next record, on output, the offset after the written records
+/// @param Count  On input, the count of written node records, on output, the count after the written records
+STATIC VOID
+EFIAPI
+ConfigCacheWriteNodes (
+  IN     CONFIG_TREE *Tree,
+  IN     UINT32       Parent,
+  IN     UINT8       *Buffer OPTIONAL,
+  IN OUT UINTN       *Offset,
+  IN OUT UINT32      *Count
+) {
+  CONFIG_TREE *Child;
+  for (Child = Tree->Children; Child != NULL; Child = Child->Next) {
+    UINTN Size = ConfigCacheNodeSize(Child);
+    if (Buffer != NULL) {
+      CONFIG_CACHE_NODE *Record = (CONFIG_CACHE_NODE *)(Buffer + *Offset);
+      UINT8             *Value = (UINT8 *)(Record + 1) + (Child->Length * sizeof(CHAR16));
+      UINT64             Number;
+      Record->Parent = Parent;
+      Record->Type = (UINT32)Child->Type;
+      Record->Length = Child->Length;
+      Record->Size = (UINT32)Size;
+      CopyMem(Record + 1, Child->Name, Child->Length * sizeof(CHAR16));
+      // Numbers are copied since the value follows the name without alignment
+      switch (Child->Type) {
+        case CONFIG_TYPE_BOOLEAN:
+          Number = Child->Value.Boolean ? 1 : 0;
+          CopyMem(Value, &Number, sizeof(UINT64));
+          break;
+
+        case CONFIG_TYPE_INTEGER:
+          Number = (UINT64)(INT64)Child->Value.Integer;
+          CopyMem(Value, &Number, sizeof(UINT64));
+          break;
+
+        case CONFIG_TYPE_UNSIGNED:
+          Number = (UINT64)Child->Value.Unsigned;
+          CopyMem(Value, &Number, sizeof(UINT64));
+          break;
+
+        case CONFIG_TYPE_STRING:
+        case CONFIG_TYPE_DATA:
+          if (Child->Encoded) {
+            // The cache holds decoded data so cached loads never decode
+            UnpackBase64((UINT8 *)Child->Value.Data.Data, Value, Size);
+          } else if (Size > 0) {
+            CopyMem(Value, (Child->Type == CONFIG_TYPE_STRING) ? (VOID *)Child->Value.String : Child->Value.Data.Data, Size);
+          }
+          break;
+
+        default:
+          break;
+      }
+    }
+    *Offset += ALIGN_VALUE(sizeof(CONFIG_CACHE_NODE) + (Child->Length * sizeof(CHAR16)) + Size, CONFIG_CACHE_ALIGN);
+    // Write the children after this node so parents always precede their children
+    ConfigCacheWriteNodes(Child, ++(*Count), Buffer, Offset, Count);
+  }
+}
+// ConfigCacheSave
+/// Save the configuration tree to a compiled configuration cache file
+/// @param Path The path of the compiled configuration cache file
+/// @return Whether the compiled configuration cache file was saved or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_UNSUPPORTED       If the configuration sources could not be recorded by path
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the compiled configuration cache file was saved successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigCacheSave (
+  IN CHAR16 *Path
+) {
+  EFI_STATUS           Status;
+  EFI_FILE_HANDLE      Handle = NULL;
+  CONFIG_CACHE_HEADER *Header;
+  CONFIG_CACHE_SOURCE *Source;
+  CONFIG_INCLUDE      *Include;
+  UINT8               *Buffer;
+  UINTN                Offset;
+  UINTN                Size;
+  UINTN                SourceSize;
+  UINTN                SubtreeSize;
+  UINTN                Index;
+  UINTN                Bindings = 0;
+  UINT32               Count = 0;
+  // Check parameters
+  if (Path == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (!mConfigCacheable || (mConfigCacheSources == NULL) || (mConfigCacheSourceCount == 0) || (mConfigTree == NULL)) {
+    return EFI_UNSUPPORTED;
+  }
+  // Measure the compiled configuration cache, with the include files that are still deferred after the compiled sources
+  Size = sizeof(CONFIG_CACHE_HEADER);
+  for (Index = 0; Index < mConfigCacheSourceCount; ++Index) {
+    Size += ALIGN_VALUE(sizeof(CONFIG_CACHE_SOURCE) + StrSize(mConfigCacheSources[Index]), CONFIG_CACHE_ALIGN);
+  }
+  for (Include = mConfigIncludes; Include != NULL; Include = Include->Next) {
+    Size += ALIGN_VALUE(sizeof(CONFIG_CACHE_SOURCE) + StrSize(Include->Path) + StrSize(Include->Subtree), CONFIG_CACHE_ALIGN);
+    ++Bindings;
+  }
+  ConfigCacheWriteNodes(mConfigTree, 0, NULL, &Size, &Count);
+  if (Size > MAX_UINT32) {
+    return EFI_UNSUPPORTED;
+  }
+  Buffer = (UINT8 *)AllocateZeroPool(Size);
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Write the header
+  Header = (CONFIG_CACHE_HEADER *)Buffer;
+  Header->Signature = CONFIG_CACHE_SIGNATURE;
+  Header->Version = CONFIG_CACHE_VERSION;
+  Header->Key = ConfigCacheKey(mConfigCacheSources, mConfigCacheSourceCount);
+  Header->SourceCount = (UINT32)(mConfigCacheSourceCount + Bindings);
+  Header->NodeCount = Count;
+  Header->Size = (UINT32)Size;
+  // Write the source records, the key only covers the compiled sources since deferred include files are read when they are loaded
+  Offset = sizeof(CONFIG_CACHE_HEADER);
+  for (Index = 0; Index < mConfigCacheSourceCount; ++Index) {
+    Source = (CONFIG_CACHE_SOURCE *)(Buffer + Offset);
+    SourceSize = StrSize(mConfigCacheSources[Index]);
+    Source->Length = (UINT32)(SourceSize / sizeof(CHAR16));
+    CopyMem(Source + 1, mConfigCacheSources[Index], SourceSize);
+    Offset += ALIGN_VALUE(sizeof(CONFIG_CACHE_SOURCE) + SourceSize, CONFIG_CACHE_ALIGN);
+  }
+  for (Include = mConfigIncludes; Include != NULL; Include = Include->Next) {
+    Source = (CONFIG_CACHE_SOURCE *)(Buffer + Offset);
+    SourceSize = StrSize(Include->Path);
+    SubtreeSize = StrSize(Include->Subtree);
+    Source->Length = (UINT32)(SourceSize / sizeof(CHAR16));
+    Source->Subtree = (UINT32)(SubtreeSize / sizeof(CHAR16));
+    CopyMem(Source + 1, Include->Path, SourceSize);
+    CopyMem(((UINT8 *)(Source + 1)) + SourceSize, Include->Subtree, SubtreeSize);
+    Offset += ALIGN_VALUE(sizeof(CONFIG_CACHE_SOURCE) + SourceSize + SubtreeSize, CONFIG_CACHE_ALIGN);
+  }
+  // Write the node records
+  Count = 0;
+  ConfigCacheWriteNodes(mConfigTree, 0, Buffer, &Offset, &Count);
+  // Write the compiled configuration cache file
+  Status = FileHandleOpen(&Handle, NULL, Path, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_CREATE, 0);
+  if (!EFI_ERROR(Status)) {
+    // Make sure the file size is zero ie truncate
+    Status = FileHandleSetSize(Handle, 0);
+    if (!EFI_ERROR(Status)) {
+      Status = FileHandleWrite(Handle, &Size, Buffer);
+    }
+    FileHandleClose(Handle);
+  }
+  FreePool(Buffer);
+  Log2(L"  Cache save status:", L"%r\n", Status);
+  return Status;
+}
+// ConfigCacheParseNodes
+/// Build configuration tree nodes from compiled configuration cache node records
+/// @param Root   The configuration tree node below which to build, which must be a list without children
+/// @param Size   The size, in bytes, of the compiled configuration cache
+/// @param Buffer The compiled configuration cache
+/// @param Offset The offset of the first node record
+/// @param Count  The count of node records
+/// @return Whether the configuration tree nodes were built or not, a partially built subtree is left in place on error
+/// @retval EFI_VOLUME_CORRUPTED If the node records are malformed
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the configuration tree nodes were built successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigCacheParseNodes (
+  IN CONFIG_TREE *Root,
+  IN UINTN        Size,
+  IN UINT8       *Buffer,
+  IN UINTN        Offset,
+  IN UINT32       Count
+) {
+  EFI_STATUS    Status = EFI_SUCCESS;
+  CONFIG_TREE **Nodes;
+  CONFIG_TREE **Tails;
+  UINTN         Index;
+  // Every node record is at least a header so the count is bounded by the size
+  if ((Offset > Size) || (Count > ((Size - Offset) / sizeof(CONFIG_CACHE_NODE)))) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+  // Allocate the tables of nodes and their last children by record index
+  Nodes = (CONFIG_TREE **)AllocateZeroPool((((UINTN)Count + 1) << 1) * sizeof(CONFIG_TREE *));
+  if (Nodes == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Tails = Nodes + (Count + 1);
+  Nodes[0] = Root;
+  // Build each node after its parent
+  for (Index = 1; !EFI_ERROR(Status) && (Index <= Count); ++Index) {
+    CONFIG_CACHE_NODE *Record = (CONFIG_CACHE_NODE *)(Buffer + Offset);
+    CONFIG_TREE       *Node;
+    UINT8             *Value;
+    UINTN              RecordSize;
+    UINT64             Number = 0;
+    // Check the record is within the cache and its parent is a list that was already built
+    if ((Size - Offset) < sizeof(CONFIG_CACHE_NODE)) {
+      Status = EFI_VOLUME_CORRUPTED;
+      break;
+    }
+    RecordSize = sizeof(CONFIG_CACHE_NODE) + ((UINTN)Record->Length * sizeof(CHAR16)) + Record->Size;
+    if ((Record->Length == 0) || (Record->Length > (Size - Offset)) || (Record->Size > (Size - Offset)) ||
+        (RecordSize > (Size - Offset)) || (Record->Parent >= Index) || (Nodes[Record->Parent]->Type != CONFIG_TYPE_LIST)) {
+      Status = EFI_VOLUME_CORRUPTED;
+      break;
+    }
+    Value = (UINT8 *)(Record + 1) + (Record->Length * sizeof(CHAR16));
+    // Check the value matches the type
+    switch (Record->Type) {
+      case CONFIG_TYPE_LIST:
+        Status = (Record->Size == 0) ? EFI_SUCCESS : EFI_VOLUME_CORRUPTED;
+        break;
+
+      case CONFIG_TYPE_BOOLEAN:
+      case CONFIG_TYPE_INTEGER:
+      case CONFIG_TYPE_UNSIGNED:
+        Status = (Record->Size == sizeof(UINT64)) ? EFI_SUCCESS : EFI_VOLUME_CORRUPTED;
+        if (!EFI_ERROR(Status)) {
+          CopyMem(&Number, Value, sizeof(UINT64));
+        }
+        break;
+
+      case CONFIG_TYPE_STRING:
+        Status = ((Record->Size >= sizeof(CHAR16)) && ((Record->Size % sizeof(CHAR16)) == 0) &&
+                  (((CHAR16 *)Value)[(Record->Size / sizeof(CHAR16)) - 1] == L'\0')) ? EFI_SUCCESS : EFI_VOLUME_CORRUPTED;
+        break;
+
+      case CONFIG_TYPE_DATA:
+        Status = (Record->Size > 0) ? EFI_SUCCESS : EFI_VOLUME_CORRUPTED;
+        break;
+
+      default:
+        Status = EFI_VOLUME_CORRUPTED;
+        break;
+    }
+    if (EFI_ERROR(Status)) {
+      break;
+    }
+    // Create the node with its name
+    Node = ConfigNodeAllocate();
+    if (Node == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      break;
+    }
+    Node->Name = ConfigArenaName((CHAR16 *)(Record + 1), Record->Length);
+    if (Node->Name == NULL) {
+      ConfigNodeRelease(Node);
+      Status = EFI_OUT_OF_RESOURCES;
+      break;
+    }
+    Node->Type = (CONFIG_TYPE)Record->Type;
+    Node->Parent = Nodes[Record->Parent];
+    Node->Hash = StrniHash(Node->Name, Record->Length);
+    Node->Length = Record->Length;
+    // Set the decoded value
+    switch (Node->Type) {
+      case CONFIG_TYPE_BOOLEAN:
+        Node->Value.Boolean = (Number != 0);
+        break;
+
+      case CONFIG_TYPE_INTEGER:
+        Node->Value.Integer = (INTN)(INT64)Number;
+        break;
+
+      case CONFIG_TYPE_UNSIGNED:
+        Node->Value.Unsigned = (UINTN)Number;
+        break;
+
+      case CONFIG_TYPE_STRING:
+      case CONFIG_TYPE_DATA:
+        Node->Value.Data.Data = ConfigArenaAllocate(Record->Size);
+        if (Node->Value.Data.Data == NULL) {
+          Status = EFI_OUT_OF_RESOURCES;
+          break;
+        }
+        CopyMem(Node->Value.Data.Data, Value, Record->Size);
+        if (Node->Type == CONFIG_TYPE_DATA) {
+          Node->Value.Data.Size = Record->Size;
+        }
+        break;
+
+      default:
+        break;
+    }
+    if (EFI_ERROR(Status)) {
+      ConfigNodeRelease(Node);
+      break;
+    }
+    // Append to the children of the parent and index the new node
+    if (Tails[Record->Parent] == NULL) {
+      Node->Parent->Children = Node;
+    } else {
+      Tails[Record->Parent]->Next = Node;
+    }
+    Tails[Record->Parent] = Node;
+    Nodes[Index] = Node;
+    ConfigIndexInsert(Node);
+    Offset += ALIGN_VALUE(RecordSize, CONFIG_CACHE_ALIGN);
+  }
+  if (!EFI_ERROR(Status) && (Offset != Size)) {
+    Status = EFI_VOLUME_CORRUPTED;
+  }
+  FreePool(Nodes);
+  return Status;
+}
+// ConfigCacheParse
+/// Build the configuration tree from a compiled configuration cache
+/// @param Size   The size, in bytes, of the compiled configuration cache
+/// @param Buffer The compiled configuration cache
+/// @return Whether the configuration tree was built or not
+/// @retval EFI_INCOMPATIBLE_VERSION If the compiled configuration cache is for another version, platform or sources
+/// @retval EFI_VOLUME_CORRUPTED     If the compiled configuration cache is malformed
+/// @retval EFI_OUT_OF_RESOURCES     If memory could not be allocated
+/// @retval EFI_SUCCESS              If the configuration tree was built successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigCacheParse (
+  IN UINTN  Size,
+  IN UINT8 *Buffer
+) {
+  EFI_STATUS            Status;
+  CONFIG_CACHE_HEADER  *Header = (CONFIG_CACHE_HEADER *)Buffer;
+  CONFIG_TREE          *Root = NULL;
+  CHAR16              **Sources;
+  CHAR16              **Bindings;
+  UINTN                 SourceCount = 0;
+  UINTN                 BindingCount = 0;
+  UINTN                 Offset;
+  UINTN                 Index;
+  UINT32                Key;
+  // Check the header
+  if ((Size < sizeof(CONFIG_CACHE_HEADER)) || (Header->Signature != CONFIG_CACHE_SIGNATURE) ||
+      (Header->Version != CONFIG_CACHE_VERSION)) {
+    return EFI_INCOMPATIBLE_VERSION;
+  }
+  if ((Header->Size != Size) || (Header->SourceCount == 0)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+  // Get the compiled source paths and the deferred include file bindings, which are pairs of source and subtree paths
+  Sources = (CHAR16 **)AllocateZeroPool(Header->SourceCount * 3 * sizeof(CHAR16 *));
+  if (Sources == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Bindings = Sources + Header->SourceCount;
+  Offset = sizeof(CONFIG_CACHE_HEADER);
+  for (Index = 0; Index < Header->SourceCount; ++Index) {
+    CONFIG_CACHE_SOURCE *Source = (CONFIG_CACHE_SOURCE *)(Buffer + Offset);
+    CHAR16              *Path = (CHAR16 *)(Source + 1);
+    if (((Size - Offset) < sizeof(CONFIG_CACHE_SOURCE)) || (Source->Length == 0) ||
+        (((Size - Offset - sizeof(CONFIG_CACHE_SOURCE)) / sizeof(CHAR16)) < ((UINTN)Source->Length + Source->Subtree)) ||
+        (Path[Source->Length - 1] != L'\0') || ((Source->Subtree != 0) && (Path[Source->Length + Source->Subtree - 1] != L'\0'))) {
+      FreePool(Sources);
+      return EFI_VOLUME_CORRUPTED;
+    }
+    if (Source->Subtree == 0) {
+      Sources[SourceCount++] = Path;
+    } else {
+      Bindings[BindingCount++] = Path;
+      Bindings[BindingCount++] = Path + Source->Length;
+    }
+    Offset += ALIGN_VALUE(sizeof(CONFIG_CACHE_SOURCE) + (((UINTN)Source->Length + Source->Subtree) * sizeof(CHAR16)), CONFIG_CACHE_ALIGN);
+    if (Offset > Size) {
+      FreePool(Sources);
+      return EFI_VOLUME_CORRUPTED;
+    }
+  }
+  // Check the sources and platform are the ones the cache was compiled for
+  Key = ConfigCacheKey(Sources, SourceCount);
+  if ((SourceCount == 0) || (Key != Header->Key)) {
+    FreePool(Sources);
+    return (SourceCount == 0) ? EFI_VOLUME_CORRUPTED : EFI_INCOMPATIBLE_VERSION;
+  }
+  // Create the root node and build the node records below it
+  Status = ConfigFind(NULL, TRUE, &Root);
+  if (!EFI_ERROR(Status)) {
+    Status = ConfigCacheParseNodes(Root, Size, Buffer, Offset, Header->NodeCount);
+  }
+  // Bind the include files that were still deferred when the cache was compiled
+  for (Index = 0; !EFI_ERROR(Status) && (Index < BindingCount); Index += 2) {
+    Status = ConfigIncludeBind(Bindings[Index + 1], Bindings[Index]);
+  }
+  FreePool(Sources);
+  // Discard a partially built tree
+  if (EFI_ERROR(Status)) {
+    ConfigFree();
+  }
+  return Status;
+}
+// ConfigCacheLoad
+/// Load the configuration tree from a compiled configuration cache file with one read and no parsing
+/// @param Path The path of the compiled configuration cache file
+/// @return Whether the compiled configuration cache file was loaded or not
+/// @retval EFI_INVALID_PARAMETER    If Path is NULL
+/// @retval EFI_UNSUPPORTED          If the configuration tree is not empty
+/// @retval EFI_NOT_FOUND            If the compiled configuration cache file was not found
+/// @retval EFI_INCOMPATIBLE_VERSION If the compiled configuration cache is for another version, platform or sources
+/// @retval EFI_VOLUME_CORRUPTED     If the compiled configuration cache is malformed
+/// @retval EFI_OUT_OF_RESOURCES     If memory could not be allocated
+/// @retval EFI_SUCCESS              If the compiled configuration cache file was loaded successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigCacheLoad (
+  IN CHAR16 *Path
+) {
+  EFI_STATUS      Status;
+  EFI_FILE_HANDLE Handle = NULL;
+  UINT64          FileSize = 0;
+  // Check parameters
+  if (Path == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // The cache only describes a whole configuration tree
+  if (mConfigTree != NULL) {
+    return EFI_UNSUPPORTED;
+  }
+  // Open compiled configuration cache file handle
+  Status = FileHandleOpen(&Handle, NULL, Path, EFI_FILE_MODE_READ, 0);
+  if (EFI_ERROR(Status) || (Handle == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+  Log2(L"Configuration cache:", L"\"%s\"\n", Path);
+  // Read the whole cache at once
+  Status = FileHandleGetSize(Handle, &FileSize);
+  if (!EFI_ERROR(Status)) {
+    if ((FileSize < sizeof(CONFIG_CACHE_HEADER)) || (FileSize > MAX_UINT32)) {
+      Status = EFI_VOLUME_CORRUPTED;
+    } else {
+      UINTN  Size = (UINTN)FileSize;
+      UINT8 *Buffer = (UINT8 *)AllocatePool(Size);
+      if (Buffer == NULL) {
+        Status = EFI_OUT_OF_RESOURCES;
+      } else {
+        Status = FileHandleRead(Handle, &Size, Buffer);
+        if (!EFI_ERROR(Status)) {
+          Status = ConfigCacheParse(Size, Buffer);
+        }
+        FreePool(Buffer);
+      }
+    }
+  }
+  FileHandleClose(Handle);
+  Log2(L"  Cache load status:", L"%r\n", Status);
+  if (!EFI_ERROR(Status)) {
+    ConfigSnapshotRetire();
+  }
+  // Notify subscriptions to any of the loaded values
+  if (!EFI_ERROR(Status) && (mConfigSubscriptions != NULL) && (mConfigTree != NULL)) {
+    ConfigNotifyMark(mConfigTree, FALSE);
+    ConfigNotifyPending();
+  }
+  return Status;
+}
+// ConfigLoadCached
+/// Load configuration information from the compiled configuration cache file or else the configuration file, which is then compiled
+/// @param Path      The full device path string to the configuration file
+/// @param CachePath The full device path string to the compiled configuration cache file
+/// @return Whether the configuration was loaded successfully or not
+/// @retval EFI_NOT_FOUND If the configuration file could not be opened
+/// @retval EFI_SUCCESS   If the configuration was loaded successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigLoadCached (
+  IN CHAR16 *Path,
+  IN CHAR16 *CachePath
+) {
+  EFI_STATUS Status;
+  // Try the compiled configuration cache first
+  if (!EFI_ERROR(ConfigCacheLoad(CachePath))) {
+    return EFI_SUCCESS;
+  }
+  // Record every source loaded while parsing the configuration file
+  mConfigCacheable = (mConfigTree == NULL);
+  mConfigCacheRecord = TRUE;
+  Status = ConfigLoad(NULL, Path);
+  mConfigCacheRecord = FALSE;
+  if (!EFI_ERROR(Status)) {
+    // Compile the loaded configuration for the next boot
+    ConfigCacheSave(CachePath);
+  }
+  // Free the recorded sources
+  if (mConfigCacheSources != NULL) {
+    StrListFree(mConfigCacheSources, mConfigCacheSourceCount);
+    mConfigCacheSources = NULL;
+  }
+  mConfigCacheSourceCount = 0;
+  mConfigCacheable = FALSE;
+  return Status;
+}
+
+// ConfigSnapshotBucket
+/// Get the shared configuration snapshot index bucket for a node name under a parent node record
+/// @param Parent The index of the parent node record
+/// @param Hash   The case-insensitive hash of the node name
+/// @param Count  The count of index buckets, which is a power of two
+/// @return The index bucket
+STATIC UINT32
+EFIAPI
+ConfigSnapshotBucket (
+  IN UINT32 Parent,
+  IN UINT32 Hash,
+  IN UINT32 Count
+) {
+  Hash ^= Parent * 0x9E3779B1;
+  return (Hash ^ (Hash >> 16)) & (Count - 1);
+}
+// ConfigSnapshotValueSize
+/// Get the size of the string or data value of a configuration tree node in a shared configuration snapshot
+/// @param Tree The configuration tree node
+/// @return The size, in bytes, of the string or decoded data value, or zero for any other type
+STATIC UINTN
+EFIAPI
+ConfigSnapshotValueSize (
+  IN CONFIG_TREE *Tree
+) {
+  if ((Tree->Type == CONFIG_TYPE_STRING) || (Tree->Type == CONFIG_TYPE_DATA)) {
+    return ConfigCacheNodeSize(Tree);
+  }
+  return 0;
+}
+// ConfigSnapshotMeasure
+/// Measure the shared configuration snapshot node records and strings for the descendants of a configuration tree node
+/// @param Tree  The configuration tree node
+/// @param Count On input, the count of node records, on output, the count including the descendants
+/// @param Size  On input, the size of the strings and values, on output, the size including the descendants
+STATIC VOID
+EFIAPI
+ConfigSnapshotMeasure (
+  IN     CONFIG_TREE *Tree,
+  IN OUT UINTN       *Count,
+  IN OUT UINTN       *Size
+) {
+  CONFIG_TREE *Child;
+  for (Child = Tree->Children; Child != NULL; Child = Child->Next) {
+    ++(*Count);
+    *Size += ALIGN_VALUE((Child->Length + 1) * sizeof(CHAR16), CONFIG_SNAPSHOT_ALIGN) + ALIGN_VALUE(ConfigSnapshotValueSize(Child), CONFIG_SNAPSHOT_ALIGN);
+    ConfigSnapshotMeasure(Child, Count, Size);
+  }
+}
+// ConfigSnapshotWrite
+/// Write the shared configuration snapshot node records for the descendants of a configuration tree node
+/// @param Tree   The configuration tree node
+/// @param Index  The index of the node record of the configuration tree node
+/// @param Header The shared configuration snapshot
+/// @param Count  On input, the count of written node records, on output, the count after the written records
+/// @param Offset On input, the offset of the next string or value, on output, the offset after the written strings and values
+STATIC VOID
+EFIAPI
+ConfigSnapshotWrite (
+  IN     CONFIG_TREE            *Tree,
+  IN     UINT32                  Index,
+  IN     CONFIG_SNAPSHOT_HEADER *Header,
+  IN OUT UINT32                 *Count,
+  IN OUT UINTN                  *Offset
+) {
+  CONFIG_SNAPSHOT_NODE *Nodes = (CONFIG_SNAPSHOT_NODE *)(((UINT8 *)Header) + Header->Nodes);
+  UINT32               *Buckets = (UINT32 *)(((UINT8 *)Header) + Header->Buckets);
+  UINT32               *Last = &(Nodes[Index].Children);
+  CONFIG_TREE          *Child;
+  for (Child = Tree->Children; Child != NULL; Child = Child->Next) {
+    UINT32                ChildIndex = (*Count)++;
+    CONFIG_SNAPSHOT_NODE *Record = &(Nodes[ChildIndex]);
+    UINT32                Bucket = ConfigSnapshotBucket(Index, Child->Hash, Header->BucketCount);
+    UINTN                 Size;
+    Record->Parent = Index;
+    Record->Type = (UINT32)Child->Type;
+    Record->Hash = Child->Hash;
+    Record->Length = Child->Length;
+    // The name terminator is already zero
+    Record->Name = (UINT32)*Offset;
+    CopyMem(((UINT8 *)Header) + *Offset, Child->Name, Child->Length * sizeof(CHAR16));
+    *Offset += ALIGN_VALUE((Child->Length + 1) * sizeof(CHAR16), CONFIG_SNAPSHOT_ALIGN);
+    switch (Child->Type) {
+      case CONFIG_TYPE_BOOLEAN:
+        Record->Number = Child->Value.Boolean ? 1 : 0;
+        break;
+
+      case CONFIG_TYPE_INTEGER:
+        Record->Number = (UINT64)(INT64)Child->Value.Integer;
+        break;
+
+      case CONFIG_TYPE_UNSIGNED:
+        Record->Number = (UINT64)Child->Value.Unsigned;
+        break;
+
+      case CONFIG_TYPE_STRING:
+      case CONFIG_TYPE_DATA:
+        Size = ConfigSnapshotValueSize(Child);
+        Record->Size = (UINT32)Size;
+        if (Size > 0) {
+          // Readers cannot write to the snapshot so packed data is decoded as it is copied
+          Record->Value = (UINT32)*Offset;
+          if (Child->Encoded) {
+            UnpackBase64((UINT8 *)Child->Value.Data.Data, ((UINT8 *)Header) + *Offset, Size);
+          } else {
+            CopyMem(((UINT8 *)Header) + *Offset, (Child->Type == CONFIG_TYPE_STRING) ? (VOID *)Child->Value.String : Child->Value.Data.Data, Size);
+          }
+          *Offset += ALIGN_VALUE(Size, CONFIG_SNAPSHOT_ALIGN);
+        }
+        break;
+
+      default:
+        break;
+    }
+    // Link the record as the last child of the parent and into the index
+    *Last = ChildIndex;
+    Last = &(Record->Next);
+    Record->HashNext = Buckets[Bucket];
+    Buckets[Bucket] = ChildIndex;
+    ConfigSnapshotWrite(Child, ChildIndex, Header, Count, Offset);
+  }
+}
+// ConfigSnapshotPublish
+/// Publish a shared configuration snapshot of the configuration tree for other images to read directly
+STATIC VOID
+EFIAPI
+ConfigSnapshotPublish (
+  VOID
+) {
+  CONFIG_SNAPSHOT_BLOCK  *Block;
+  CONFIG_SNAPSHOT_HEADER *Header;
+  UINTN                   Count = 1;
+  UINTN                   Strings = 0;
+  UINTN                   Offset;
+  UINTN                   Size;
+  UINT32                  BucketCount;
+  UINT32                  Written = 1;
+  // Only publish if this image owns the configuration tree and the current snapshot is retired
+  if ((mConfig != NULL) || (mConfigSnapshot != NULL) || (mConfigTree == NULL)) {
+    return;
+  }
+  // Include files that are not loaded yet are only loaded by lookups in this image
+  if (mConfigIncludes != NULL) {
+    return;
+  }
+  // Measure the snapshot
+  ConfigSnapshotMeasure(mConfigTree, &Count, &Strings);
+  for (BucketCount = 0x10; BucketCount < Count; BucketCount <<= 1);
+  Offset = sizeof(CONFIG_SNAPSHOT_HEADER) + (Count * sizeof(CONFIG_SNAPSHOT_NODE)) + ALIGN_VALUE(BucketCount * sizeof(UINT32), CONFIG_SNAPSHOT_ALIGN);
+  Size = Offset + Strings;
+  if (Size > MAX_UINT32) {
+    return;
+  }
+  Block = (CONFIG_SNAPSHOT_BLOCK *)AllocateZeroPool(sizeof(CONFIG_SNAPSHOT_BLOCK) + Size);
+  if (Block == NULL) {
+    return;
+  }
+  // Write the header and the root node record
+  Header = (CONFIG_SNAPSHOT_HEADER *)(Block + 1);
+  Header->Signature = CONFIG_SNAPSHOT_SIGNATURE;
+  Header->Version = CONFIG_SNAPSHOT_VERSION;
+  Header->Size = (UINT32)Size;
+  Header->NodeCount = (UINT32)Count;
+  Header->BucketCount = BucketCount;
+  Header->Nodes = sizeof(CONFIG_SNAPSHOT_HEADER);
+  Header->Buckets = (UINT32)(sizeof(CONFIG_SNAPSHOT_HEADER) + (Count * sizeof(CONFIG_SNAPSHOT_NODE)));
+  ((CONFIG_SNAPSHOT_NODE *)(Header + 1))->Type = (UINT32)mConfigTree->Type;
+  // Write the node records
+  ConfigSnapshotWrite(mConfigTree, 0, Header, &Written, &Offset);
+  // Publish the snapshot
+  if (EFI_ERROR(gBS->InstallConfigurationTable(&mConfigSnapshotGuid, Header))) {
+    FreePool(Block);
+    return;
+  }
+  // Keep only the previous generation, which other images may still hold until they see it is stale
+  if (mConfigSnapshots != NULL) {
+    while (mConfigSnapshots->Next != NULL) {
+      CONFIG_SNAPSHOT_BLOCK *Retired = mConfigSnapshots->Next;
+      mConfigSnapshots->Next = Retired->Next;
+      FreePool(Retired);
+    }
+  }
+  Block->Next = mConfigSnapshots;
+  mConfigSnapshots = Block;
+  mConfigSnapshot = Header;
+}
+// ConfigSnapshotFree
+/// Withdraw and free the shared configuration snapshots published by this image
+STATIC VOID
+EFIAPI
+ConfigSnapshotFree (
+  VOID
+) {
+  ConfigSnapshotRetire();
+  while (mConfigSnapshots != NULL) {
+    CONFIG_SNAPSHOT_BLOCK *Block = mConfigSnapshots;
+    mConfigSnapshots = Block->Next;
+    FreePool(Block);
+  }
+  mConfigSnapshot = NULL;
+}
+// ConfigSnapshotGet
+/// Get the current shared configuration snapshot published by the image owning the configuration tree
+/// @return The shared configuration snapshot or NULL if this image owns the configuration tree or there is no current snapshot
+STATIC CONFIG_SNAPSHOT_HEADER *
+EFIAPI
+ConfigSnapshotGet (
+  VOID
+) {
+  CONFIG_SNAPSHOT_HEADER *Header;
+  UINTN                   Index;
+  if (mConfig == NULL) {
+    return NULL;
+  }
+  // Keep using the snapshot until the owner retires it
+  if ((mConfigSnapshot != NULL) && (mConfigSnapshot->Stale == 0)) {
+    return mConfigSnapshot;
+  }
+  mConfigSnapshot = NULL;
+  if ((gST == NULL) || (gST->ConfigurationTable == NULL)) {
+    return NULL;
+  }
+  // Find the current snapshot in the configuration tables
+  for (Index = 0; Index < gST->NumberOfTableEntries; ++Index) {
+    if (!CompareGuid(&(gST->ConfigurationTable[Index].VendorGuid), &mConfigSnapshotGuid)) {
+      continue;
+    }
+    Header = (CONFIG_SNAPSHOT_HEADER *)(gST->ConfigurationTable[Index].VendorTable);
+    if ((Header != NULL) && (Header->Signature == CONFIG_SNAPSHOT_SIGNATURE) && (Header->Version == CONFIG_SNAPSHOT_VERSION) &&
+        (Header->Stale == 0) && (Header->NodeCount != 0) && (Header->BucketCount != 0) && ((Header->BucketCount & (Header->BucketCount - 1)) == 0) &&
+        (Header->Nodes >= sizeof(CONFIG_SNAPSHOT_HEADER)) && (Header->Buckets >= Header->Nodes) &&
+        (((UINT64)Header->Buckets + ((UINT64)Header->BucketCount * sizeof(UINT32))) <= Header->Size) &&
+        ((Header->Buckets - Header->Nodes) / sizeof(CONFIG_SNAPSHOT_NODE) >= Header->NodeCount)) {
+      mConfigSnapshot = Header;
+    }
+    break;
+  }
+  return mConfigSnapshot;
+}
+// ConfigSnapshotFind
+/// Find a shared configuration snapshot node record by path
+/// @param Header The shared configuration snapshot
+/// @param Start  The index of the node record from which the path is relative, zero for root
+/// @param Path   The path of the configuration tree node or NULL for the start node
+/// @return The node record or NULL if not found
+STATIC CONFIG_SNAPSHOT_NODE *
+EFIAPI
+ConfigSnapshotFind (
+  IN CONFIG_SNAPSHOT_HEADER *Header,
+  IN UINT32                  Start,
+  IN CHAR16                 *Path OPTIONAL
+) {
+  CONFIG_SNAPSHOT_NODE *Nodes = (CONFIG_SNAPSHOT_NODE *)(((UINT8 *)Header) + Header->Nodes);
+  UINT32               *Buckets = (UINT32 *)(((UINT8 *)Header) + Header->Buckets);
+  UINT32                Index = Start;
+  UINT32                Candidate;
+  UINT32                Hash;
+  UINTN                 Length;
+  if (Path != NULL) {
+    while (*Path != L'\0') {
+      // Skip separators
+      if (*Path == L'\\') {
+        ++Path;
+        continue;
+      }
+      // Find the child with the node name through the index
+      for (Length = 0; (Path[Length] != L'\0') && (Path[Length] != L'\\'); ++Length);
+      Hash = StrniHash(Path, Length);
+      for (Candidate = Buckets[ConfigSnapshotBucket(Index, Hash, Header->BucketCount)]; Candidate != 0; Candidate = Nodes[Candidate].HashNext) {
+        if ((Candidate >= Header->NodeCount) || (Nodes[Candidate].Name >= Header->Size)) {
+          return NULL;
+        }
+        if ((Nodes[Candidate].Parent == Index) && (Nodes[Candidate].Hash == Hash) && (Nodes[Candidate].Length == Length) &&
+            (StrniCmp((CHAR16 *)(((UINT8 *)Header) + Nodes[Candidate].Name), Path, Length) == 0)) {
+          break;
+        }
+      }
+      if (Candidate == 0) {
+        return NULL;
+      }
+      Index = Candidate;
+      Path += Length;
+    }
+  }
+  if (Index >= Header->NodeCount) {
+    return NULL;
+  }
+  return &(Nodes[Index]);
+}
+// ConfigSnapshotRecordValue
+/// Get the configuration value of a shared configuration snapshot node record
+/// @param Header The shared configuration snapshot
+/// @param Record The node record
+/// @param Type   On output, the type of the configuration value
+/// @param Value  On output, the value of the configuration value, which points into the snapshot
+STATIC VOID
+EFIAPI
+ConfigSnapshotRecordValue (
+  IN  CONFIG_SNAPSHOT_HEADER *Header,
+  IN  CONFIG_SNAPSHOT_NODE   *Record,
+  OUT CONFIG_TYPE            *Type,
+  OUT CONFIG_VALUE           *Value
+) {
+  VOID *Data = (Record->Size == 0) ? NULL : (VOID *)(((UINT8 *)Header) + Record->Value);
+  *Type = (CONFIG_TYPE)Record->Type;
+  ZeroMem(Value, sizeof(CONFIG_VALUE));
+  switch (Record->Type) {
+    case CONFIG_TYPE_BOOLEAN:
+      Value->Boolean = (Record->Number != 0);
+      break;
+
+    case CONFIG_TYPE_INTEGER:
+      Value->Integer = (INTN)(INT64)Record->Number;
+      break;
+
+    case CONFIG_TYPE_UNSIGNED:
+      Value->Unsigned = (UINTN)Record->Number;
+      break;
+
+    case CONFIG_TYPE_STRING:
+      Value->String = (CHAR16 *)Data;
+      break;
+
+    case CONFIG_TYPE_DATA:
+      Value->Data.Size = Record->Size;
+      Value->Data.Data = Data;
+      break;
+
+    default:
+      break;
+  }
+}
+// ConfigSnapshotGetValue
+/// Get a configuration value from a shared configuration snapshot
+/// @param Header The shared configuration snapshot
+/// @param Path   The path of the configuration value
+/// @param Type   On output, the type of the configuration value
+/// @param Value  On output, the value of the configuration value, which points into the snapshot
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_NOT_FOUND If the configuration value was not found
+/// @retval EFI_SUCCESS   If the configuration value was retrieved successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigSnapshotGetValue (
+  IN  CONFIG_SNAPSHOT_HEADER *Header,
+  IN  CHAR16                 *Path,
+  OUT CONFIG_TYPE            *Type,
+  OUT CONFIG_VALUE           *Value
+) {
+  CONFIG_SNAPSHOT_NODE *Record = ConfigSnapshotFind(Header, 0, Path);
+  if (Record == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  ConfigSnapshotRecordValue(Header, Record, Type, Value);
+  return EFI_SUCCESS;
+}
+// ConfigSnapshotGetList
+/// Get a list of names for the children of a configuration path from a shared configuration snapshot
+/// @param Header The shared configuration snapshot
+/// @param Path   The configuration path of which to get child names or NULL for root
+/// @param List   On output, the string list of names of children
+/// @param Count  On output, the count of strings in the list
+/// @return Whether the string list was returned or not
+/// @retval EFI_NOT_FOUND If the configuration path was not found or has no children
+/// @retval EFI_SUCCESS   If the string list was returned successfully
+STATIC EFI_STATUS
+EFIAPI
+ConfigSnapshotGetList (
+  IN  CONFIG_SNAPSHOT_HEADER   *Header,
+  IN  CHAR16                   *Path OPTIONAL,
+  OUT CHAR16                 ***List,
+  OUT UINTN                    *Count
+) {
+  CONFIG_SNAPSHOT_NODE *Nodes = (CONFIG_SNAPSHOT_NODE *)(((UINT8 *)Header) + Header->Nodes);
+  CONFIG_SNAPSHOT_NODE *Record = ConfigSnapshotFind(Header, 0, Path);
+  UINT32                Index;
+  if ((Record == NULL) || (Record->Type != CONFIG_TYPE_LIST)) {
+    return EFI_NOT_FOUND;
+  }
+  // Add the child node names to the list
+  for (Index = Record->Children; (Index != 0) && (Index < Header->NodeCount); Index = Nodes[Index].Next) {
+    StrList(List, Count, (CHAR16 *)(((UINT8 *)Header) + Nodes[Index].Name), 0, STR_LIST_NO_DUPLICATES | STR_LIST_CASE_INSENSITIVE | STR_LIST_SORTED);
+  }
+  if ((*Count == 0) || (*List == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+  return EFI_SUCCESS;
+}
+
+// ConfigFree
+/// Free all configuration values
+/// @return Whether the configuration values were freed or not
+/// @retval EFI_SUCCESS If the configuration values were freed
+EFI_STATUS
+EFIAPI
+ConfigFree (
+  VOID
+) {
+  return ConfigPartialFree(NULL);
+}
+// ConfigPartialFree
+/// Free configuration values with a configuration path
+/// @param Path The configuration path to use as root to free or NULL for root (same as ConfigFree)
+/// @return Whether the configuration values were freed or not
+/// @retval EFI_SUCCESS If the configuration values were freed
+EFI_STATUS
+EFIAPI
+ConfigPartialFree (
+  IN CHAR16 *Path OPTIONAL
+) {
+  CONFIG_TREE **Link;
+  CONFIG_TREE  *Node = NULL;
+  EFI_STATUS    Status;
+  // Use configuration protocol if present
+  if ((mConfig != NULL) && (mConfig->Free != NULL)) {
+    CONFIG_STAT(Protocol);
+    return mConfig->Free(Path);
+  }
+  // Drop include files that would only have been loaded into the freed subtree and values staged within it
+  ConfigIncludeDrop(Path);
+  ConfigStageDrop(Path);
+  // Find the configuration tree node
+  Status = ConfigFind(Path, FALSE, &Node);
+  if (EFI_ERROR(Status) || (Node == NULL)) {
+    return (Status == EFI_NOT_FOUND) ? EFI_SUCCESS : Status;
+  }
+  // Mark subscriptions to the freed values while the nodes still exist
+  if (mConfigSubscriptions != NULL) {
+    ConfigNotifyMark(Node, TRUE);
+  }
+  // Invalidate any resolved configuration keys and the shared snapshot
+  ++mConfigGeneration;
+  ConfigSnapshotRetire();
+  if (Node == mConfigTree) {
+    // The whole tree is being freed so release all the storage at once instead of every node
+    ConfigStorageFree();
+    Status = EFI_SUCCESS;
+  } else {
+    // Replace the node with the next
+    for (Link = &(Node->Parent->Children); *Link != NULL; Link = &((*Link)->Next)) {
+      if (*Link == Node) {
+        *Link = Node->Next;
+        break;
+      }
+    }
+    // Free the node
+    Status = ConfigTreeFree(Node);
+  }
+  ConfigNotifyPending();
+  return Status;
+}
+// ConfigSPartialFree
+/// Free configuration values with a configuration path
+/// @param Path The configuration path to use as root to free
+/// @param ...  The argument list
+/// @return Whether the configuration values were freed or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration values were freed
+EFI_STATUS
+EFIAPI
+ConfigSPartialFree (
+  IN CHAR16 *Path,
+  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Path);
+  Status = ConfigVSPartialFree(Path, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSPartialFree
+/// Free configuration values with a configuration path
+/// @param Path The configuration path to use as root to free
+/// @param Args The argument list
+/// @return Whether the configuration values were freed or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration values were freed
+EFI_STATUS
+EFIAPI
+ConfigVSPartialFree (
+  IN CHAR16  *Path,
+  IN VA_LIST  Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if (Path == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Free the partial path
+  Status = ConfigPartialFree(FullPath);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetList
+/// Get a list of names for the children of the configuration path
+/// @param Path  The configuration path of which to get child names or NULL for root
+/// @param List  On output, the string list of names of children
+/// @param Count On output, the count of strings in the list
+/// @return Whether the string list was returned or not
+/// @retval EFI_INVALID_PARAMETER If List or Count is NULL or *List is not NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the stirng list
+/// @retval EFI_NOT_FOUND         If the configuration path was not found
+/// @retval EFI_SUCCESS           If the string list was returned successfully
+EFI_STATUS
+EFIAPI
+ConfigGetList (
+  IN  CHAR16   *Path OPTIONAL,
+  OUT CHAR16 ***List,
+  OUT UINTN    *Count
+) {
+  EFI_STATUS   Status;
+  CONFIG_TREE *Node;
+  // Check parameters
+  if ((List == NULL) || (*List != NULL) || (Count == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Read the shared snapshot or else use configuration protocol if present
+  if (mConfig != NULL) {
+    CONFIG_SNAPSHOT_HEADER *Snapshot = ConfigSnapshotGet();
+    if (Snapshot != NULL) {
+      CONFIG_STAT(Snapshot);
+      return ConfigSnapshotGetList(Snapshot, Path, List, Count);
+    }
+    if (mConfig->GetList != NULL) {
+      CONFIG_STAT(Protocol);
+      return mConfig->GetList(Path, List, Count);
+    }
+  }
+  // Get the configuration tree node
+  Status = ConfigFind(Path, FALSE, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if ((Node == NULL) || (Node->Type != CONFIG_TYPE_LIST)) {
+    return EFI_NOT_FOUND;
+  }
+  // Add the child node names to the list
+  for (Node = Node->Children; Node != NULL; Node = Node->Next) {
+    if (Node->Name != NULL) {
+      StrList(List, Count, Node->Name, 0, STR_LIST_NO_DUPLICATES | STR_LIST_CASE_INSENSITIVE | STR_LIST_SORTED);
+    }
+  }
+  if ((*Count == 0) || (*List == NULL)) {
+    return EFI_NOT_FOUND;
+  }
+  return EFI_SUCCESS;
+}
+// ConfigSGetList
+/// Get a list of names for the children of the configuration path
+/// @param Path  The configuration path of which to get child names or NULL for root
+/// @param List  On output, the string list of names of children
+/// @param Count On output, the count of strings in the list
+/// @param ...   The argument list
+/// @return Whether the string list was returned or not
+/// @retval EFI_INVALID_PARAMETER If Path, List, or Count is NULL or *List is not NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the stirng list
+/// @retval EFI_NOT_FOUND         If the configuration path was not found
+/// @retval EFI_ACCESS_DENIED     If the configuration path is protected
+/// @retval EFI_SUCCESS           If the string list was returned successfully
+EFI_STATUS
+EFIAPI
+ConfigSGetList (
+  IN  CHAR16   *Path,
+  OUT CHAR16 ***List,
+  OUT UINTN    *Count,
+  IN  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Count);
+  Status = ConfigVSGetList(Path, List, Count, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSGetList
+/// Get a list of names for the children of the configuration path
+/// @param Path  The configuration path of which to get child names
+/// @param List  On output, the string list of names of children
+/// @param Count On output, the count of strings in the list
+/// @param Args  The argument list
+/// @return Whether the string list was returned or not
+/// @retval EFI_INVALID_PARAMETER If Path, List, or Count is NULL or *List is not NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the stirng list
+/// @retval EFI_NOT_FOUND         If the configuration path was not found
+/// @retval EFI_ACCESS_DENIED     If the configuration path is protected
+/// @retval EFI_SUCCESS           If the string list was returned successfully
+EFI_STATUS
+EFIAPI
+ConfigVSGetList (
+  IN  CHAR16    *Path,
+  OUT CHAR16  ***List,
+  OUT UINTN     *Count,
+  IN  VA_LIST    Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if ((Path == NULL) || (List == NULL) || (*List != NULL) || (Count == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Get the list
+  Status = ConfigGetList(FullPath, List, Count);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetType
+/// Get the type of a configuration value
+/// @param Path The path of the configuration value of which to get the type
+/// @param Type On output, the configuration value type
+/// @retval EFI_INVALID_PARAMETER If Path or Type is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetType (
+  IN  CHAR16      *Path,
+  OUT CONFIG_TYPE *Type
+) {
+  EFI_STATUS   Status;
+  CONFIG_TREE *Node;
+  CONFIG_VALUE Value;
+  // Check parameters
+  if ((Path == NULL) || (Type == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Values staged by an open transaction are newer than the configuration tree
+  if (ConfigStageGetValue(&Path, 1, Type, &Value)) {
+    return EFI_SUCCESS;
+  }
+  // Get configuration tree node
+  Status = ConfigFind(Path, FALSE, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (Node == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  // Return type
+  *Type = Node->Type;
+  return EFI_SUCCESS;
+}
+// ConfigSGetType
+/// Get the type of a configuration value
+/// @param Path The path of the configuration value of which to get the type
+/// @param Type On output, the configuration value type
+/// @param ...  The argument list
+/// @retval EFI_INVALID_PARAMETER If Path or Type is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigSGetType (
+  IN  CHAR16      *Path,
+  OUT CONFIG_TYPE *Type,
+  IN  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Type);
+  Status = ConfigVSGetType(Path, Type, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSGetType
+/// Get the type of a configuration value
+/// @param Path The path of the configuration value of which to get the type
+/// @param Type On output, the configuration value type
+/// @param Args The argument list
+/// @retval EFI_INVALID_PARAMETER If Path or Type is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigVSGetType (
+  IN  CHAR16      *Path,
+  OUT CONFIG_TYPE *Type,
+  IN  VA_LIST      Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if ((Path == NULL) || (Type == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Get the list
+  Status = ConfigGetType(FullPath, Type);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetValue
+/// Get a configuration value
+/// @param Path  The path of the configuration value
+/// @param Type  On output, the type of the configuration value
+/// @param Value On output, the value of the configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, Type, or Value is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetValue (
+  IN  CHAR16       *Path,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value
+) {
+  EFI_STATUS   Status;
+  CONFIG_TREE *Node;
+  // Check parameters
+  if ((Path == NULL) || (Type == NULL) || (Value == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Read the shared snapshot or else use configuration protocol if present
+  if (mConfig != NULL) {
+    CONFIG_SNAPSHOT_HEADER *Snapshot = ConfigSnapshotGet();
+    if (Snapshot != NULL) {
+      CONFIG_STAT(Snapshot);
+      return ConfigSnapshotGetValue(Snapshot, Path, Type, Value);
+    }
+    if (mConfig->GetValue != NULL) {
+      CONFIG_STAT(Protocol);
+      return mConfig->GetValue(Path, Type, Value);
+    }
+  }
+  // Values staged by an open transaction are newer than the configuration tree
+  if (ConfigStageGetValue(&Path, 1, Type, Value)) {
+    return EFI_SUCCESS;
+  }
+  // Get configuration tree node
+  Status = ConfigFind(Path, FALSE, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (Node == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  // Return type and value
+  ConfigTreeGetValue(Node, Type, Value);
+  return EFI_SUCCESS;
+}
+// ConfigSGetValue
+/// Get a configuration value
+/// @param Path  The path of the configuration value
+/// @param Type  On output, the type of the configuration value
+/// @param Value On output, the value of the configuration value
+/// @param ...   The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, Type, or Value is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigSGetValue (
+  IN  CHAR16       *Path,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value,
+  IN  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Type);
+  Status = ConfigVSGetValue(Path, Type, Value, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSGetValue
+/// Get a configuration value
+/// @param Path  The path of the configuration value
+/// @param Type  On output, the type of the configuration value
+/// @param Value On output, the value of the configuration value
+/// @param Args  The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, Type, or Value is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigVSGetValue (
+  IN  CHAR16       *Path,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value,
+  IN  VA_LIST       Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if ((Path == NULL) || (Type == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Get the value
+  Status = ConfigGetValue(FullPath, Type, Value);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetBoolean
+/// Get a boolean configuration value
+/// @param Path    The path of the configuration value
+/// @param Boolean On output, the boolean configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or Boolean is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetBoolean (
+  IN  CHAR16  *Path,
+  OUT BOOLEAN *Boolean
+) {
+  EFI_STATUS   Status;
+  CONFIG_VALUE Value;
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  // Check parameters
+  if ((Path == NULL) || (Boolean == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Get the configuration value
+  Status = ConfigGetValue(Path, &Type, &Value);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Check type matches
+  if (Type != CONFIG_TYPE_BOOLEAN) {
+    return EFI_ABORTED;
+  }
+  *Boolean = Value.Boolean;
+  return EFI_SUCCESS;
+}
+// ConfigSGetBoolean
+/// Get a boolean configuration value
+/// @param Path    The path of the configuration value
+/// @param Boolean On output, the boolean configuration value
+/// @param ...     The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or Boolean is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigSGetBoolean (
+  IN  CHAR16  *Path,
+  OUT BOOLEAN *Boolean,
+  IN  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Boolean);
+  Status = ConfigVSGetBoolean(Path, Boolean, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSGetBoolean
+/// Get a boolean configuration value
+/// @param Path    The path of the configuration value
+/// @param Boolean On output, the boolean configuration value
+/// @param Args    The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or Boolean is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigVSGetBoolean (
+  IN  CHAR16  *Path,
+  OUT BOOLEAN *Boolean,
+  IN  VA_LIST  Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if ((Path == NULL) || (Boolean == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Get the value
+  Status = ConfigGetBoolean(FullPath, Boolean);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetInteger
+/// Get an integer configuration value
+/// @param Path    The path of the configuration value
+/// @param Integer On output, the integer configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or Integer is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetInteger (
+  IN  CHAR16 *Path,
+  OUT INTN   *Integer
+) {
+  EFI_STATUS   Status;
+  CONFIG_VALUE Value;
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  // Check parameters
+  if ((Path == NULL) || (Integer == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Get the configuration value
+  Status = ConfigGetValue(Path, &Type, &Value);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Check type matches
+  if (Type != CONFIG_TYPE_INTEGER) {
+    return EFI_ABORTED;
+  }
+  *Integer = Value.Integer;
+  return EFI_SUCCESS;
+}
+// ConfigSGetInteger
+/// Get an integer configuration value
+/// @param Path    The path of the configuration value
+/// @param Integer On output, the integer configuration value
+/// @param ...     The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or Integer is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigSGetInteger (
+  IN  CHAR16 *Path,
+  OUT INTN   *Integer,
+  IN  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Integer);
+  Status = ConfigVSGetInteger(Path, Integer, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSGetInteger
+/// Get an integer configuration value
+/// @param Path    The path of the configuration value
+/// @param Integer On output, the integer configuration value
+/// @param Args    The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or Integer is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigVSGetInteger (
+  IN  CHAR16  *Path,
+  OUT INTN    *Integer,
+  IN  VA_LIST  Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if ((Path == NULL) || (Integer == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Get the value
+  Status = ConfigGetInteger(FullPath, Integer);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetUnsigned
+/// Get an unsigned integer configuration value
+/// @param Path    The path of the configuration value
+/// @param Unsigned On output, the unsigned integer configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or Unsigned is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetUnsigned (
+  IN  CHAR16 *Path,
+  OUT UINTN  *Unsigned
+) {
+  EFI_STATUS   Status;
+  CONFIG_VALUE Value;
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  // Check parameters
+  if ((Path == NULL) || (Unsigned == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Get the configuration value
+  Status = ConfigGetValue(Path, &Type, &Value);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Check type matches
+  if (Type != CONFIG_TYPE_UNSIGNED) {
+    return EFI_ABORTED;
+  }
+  *Unsigned = Value.Unsigned;
+  return EFI_SUCCESS;
+}
+// ConfigSGetUnsigned
+/// Get an unsigned integer configuration value
+/// @param Path    The path of the configuration value
+/// @param Unsigned On output, the unsigned integer configuration value
+/// @param ...      The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or Unsigned is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigSGetUnsigned (
+  IN  CHAR16 *Path,
+  OUT UINTN  *Unsigned,
+  IN  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Unsigned);
+  Status = ConfigVSGetUnsigned(Path, Unsigned, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSGetUnsigned
+/// Get an unsigned integer configuration value
+/// @param Path     The path of the configuration value
+/// @param Unsigned On output, the unsigned integer configuration value
+/// @param Args     The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or Unsigned is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigVSGetUnsigned (
+  IN  CHAR16  *Path,
+  OUT UINTN   *Unsigned,
+  IN  VA_LIST  Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if ((Path == NULL) || (Unsigned == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Get the value
+  Status = ConfigGetInteger(FullPath, Unsigned);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetString
+/// Get a string configuration value
+/// @param Path   The path of the configuration value
+/// @param String On output, the string configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetString (
+  IN  CHAR16  *Path,
+  OUT CHAR16 **String
+) {
+  EFI_STATUS   Status;
+  CONFIG_VALUE Value;
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  // Check parameters
+  if ((Path == NULL) || (String == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Get the configuration value
+  Status = ConfigGetValue(Path, &Type, &Value);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Check type matches
+  if (Type != CONFIG_TYPE_STRING) {
+    return EFI_ABORTED;
+  }
+  *String = Value.String;
+  return EFI_SUCCESS;
+}
+// ConfigSGetString
+/// Get a string configuration value
+/// @param Path   The path of the configuration value
+/// @param String On output, the string configuration value
+/// @param ...    The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigSGetString (
+  IN  CHAR16  *Path,
+  OUT CHAR16 **String,
+  IN  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, String);
+  Status = ConfigVSGetString(Path, String, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSGetString
+/// Get a string configuration value
+/// @param Path   The path of the configuration value
+/// @param String On output, the string configuration value
+/// @param Args   The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigVSGetString (
+  IN  CHAR16   *Path,
+  OUT CHAR16  **String,
+  IN  VA_LIST   Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if ((Path == NULL) || (String == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Get the value
+  Status = ConfigGetString(FullPath, String);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetData
+/// Get a data configuration value
+/// @param Path The path of the configuration value
+/// @param Size On output, the data configuration value size in bytes
+/// @param Data On output, the data configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, Size, or Data is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetData (
+  IN  CHAR16  *Path,
+  OUT UINTN   *Size,
+  OUT VOID   **Data
+) {
+  EFI_STATUS   Status;
+  CONFIG_VALUE Value;
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  // Check parameters
+  if ((Path == NULL) || (Size == NULL) || (Data == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Get the configuration value
+  Status = ConfigGetValue(Path, &Type, &Value);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Check type matches
+  if (Type != CONFIG_TYPE_DATA) {
+    return EFI_ABORTED;
+  }
+  *Size = Value.Data.Size;
+  *Data = Value.Data.Data;
+  return EFI_SUCCESS;
+}
+// ConfigSGetData
+/// Get a data configuration value
+/// @param Path The path of the configuration value
+/// @param Size On output, the data configuration value size in bytes
+/// @param Data On output, the data configuration value
+/// @param ...  The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, Size, or Data is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigSGetData (
+  IN  CHAR16  *Path,
+  OUT UINTN   *Size,
+  OUT VOID   **Data,
+  IN  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Data);
+  Status = ConfigVSGetData(Path, Size, Data, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSGetData
+/// Get a data configuration value
+/// @param Path The path of the configuration value
+/// @param Size On output, the data configuration value size in bytes
+/// @param Data On output, the data configuration value
+/// @param Args The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, Size, or Data is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value path was not found
+/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigVSGetData (
+  IN  CHAR16   *Path,
+  OUT UINTN    *Size,
+  OUT VOID    **Data,
+  IN  VA_LIST   Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if ((Path == NULL) || (Size == NULL) || (Data == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Get the value
+  Status = ConfigGetData(FullPath, Size, Data);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetValueWithDefault
+/// Get a configuration value with a default fallback value
+/// @param Path         The path of the configuration value
+/// @param DefaultType  The default type of the configuration value
+/// @param DefaultValue The default value of the configuration value
+/// @param Type         On output, the type of the configuration value
+/// @param Value        On output, the value of the configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, DefaultValue, Type or Value is NULL or DefaultType is invalid
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigGetValueWithDefault (
+  IN  CHAR16       *Path,
+  IN  CONFIG_TYPE   DefaultType,
+  IN  CONFIG_VALUE *DefaultValue,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value
+) {
+  // Check parameters
+  if ((Path == NULL) || (DefaultValue == NULL) || (Type == NULL) || (Value == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Check default type is valid
+  switch (DefaultType) {
+    case CONFIG_TYPE_BOOLEAN:
+    case CONFIG_TYPE_INTEGER:
+    case CONFIG_TYPE_UNSIGNED:
+    case CONFIG_TYPE_STRING:
+    case CONFIG_TYPE_DATA:
+      break;
+
+    default:
+      return EFI_INVALID_PARAMETER;
+  }
+  // Get value
+  if (EFI_ERROR(ConfigGetValue(Path, Type, Value))) {
+    // Set default value
+    *Type = DefaultType;
+    CopyMem(Value, DefaultValue, sizeof(CONFIG_VALUE));
+  }
+  return EFI_SUCCESS;
+}
+// ConfigSGetValueWithDefault
+/// Get a configuration value with a default fallback value
+/// @param Path         The path of the configuration value
+/// @param DefaultType  The default type of the configuration value
+/// @param DefaultValue The default value of the configuration value
+/// @param Type         On output, the type of the configuration value
+/// @param Value        On output, the value of the configuration value
+/// @param ...          The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, DefaultValue, Type or Value is NULL or DefaultType is invalid
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigSGetValueWithDefault (
+  IN  CHAR16       *Path,
+  IN  CONFIG_TYPE   DefaultType,
+  IN  CONFIG_VALUE *DefaultValue,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value,
+  IN  ...
+) {
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Value);
+  Status = ConfigVSGetValueWithDefault(Path, DefaultType, DefaultValue, Type, Value, Args);
+  VA_END(Args);
+  return Status;
+}
+// ConfigVSGetValueWithDefault
+/// Get a configuration value with a default fallback value
+/// @param Path         The path of the configuration value
+/// @param DefaultType  The default type of the configuration value
+/// @param DefaultValue The default value of the configuration value
+/// @param Type         On output, the type of the configuration value
+/// @param Value        On output, the value of the configuration value
+/// @param Args         The argument list
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Path, DefaultValue, Type or Value is NULL or DefaultType is invalid
+/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigVSGetValueWithDefault (
+  IN  CHAR16       *Path,
+  IN  CONFIG_TYPE   DefaultType,
+  IN  CONFIG_VALUE *DefaultValue,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value,
+  IN  VA_LIST       Args
+) {
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
+  // Check parameters
+  if ((Path == NULL) || (DefaultValue == NULL) || (Type == NULL) || (Value == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Get the value
+  Status = ConfigGetValueWithDefault(FullPath, DefaultType, DefaultValue, Type, Value);
+  FreePool(FullPath);
+  return Status;
+}
+
+// ConfigGetBooleanWithDefault
+/// Get a boolean configuration value with default
+/// @param Path           The path of the configuration value
+/// @param DefaultBoolean The default boolean configuration value
+/// @return The boolean configuration value
+BOOLEAN
+EFIAPI
+ConfigGetBooleanWithDefault (
+  IN CHAR16  *Path,
+  IN BOOLEAN  DefaultBoolean
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_BOOLEAN)) {
+    return DefaultBoolean;
+  }
+  return Value.Boolean;
+}
+// ConfigSGetBooleanWithDefault
+/// Get a boolean configuration value with default
+/// @param Path           The path of the configuration value
+/// @param DefaultBoolean The default boolean configuration value
+/// @param ...            The argument list
+/// @return The boolean configuration value
+BOOLEAN
+EFIAPI
+ConfigSGetBooleanWithDefault (
+  IN CHAR16  *Path,
+  IN BOOLEAN  DefaultBoolean,
+  IN ...
+) {
+  BOOLEAN Result;
+  VA_LIST Args;
+  VA_START(Args, DefaultBoolean);
+  Result = ConfigVSGetBooleanWithDefault(Path, DefaultBoolean, Args);
+  VA_END(Args);
+  return Result;
+}
+// ConfigVSGetBooleanWithDefault
+/// Get a boolean configuration value with default
+/// @param Path           The path of the configuration value
+/// @param DefaultBoolean The default boolean configuration value
+/// @param Args           The argument list
+/// @return The boolean configuration value
+BOOLEAN
+EFIAPI
+ConfigVSGetBooleanWithDefault (
+  IN CHAR16  *Path,
+  IN BOOLEAN  DefaultBoolean,
+  IN VA_LIST  Args
+) {
+  BOOLEAN  Result;
+  CHAR16  *FullPath;
+  // Check parameters
+  if (Path == NULL) {
+    return DefaultBoolean;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return DefaultBoolean;
+  }
+  // Get the value
+  Result = ConfigGetBooleanWithDefault(FullPath, DefaultBoolean);
+  FreePool(FullPath);
+  return Result;
+}
+
+// ConfigGetIntegerWithDefault
+/// Get an integer configuration value with default
+/// @param Path           The path of the configuration value
+/// @param DefaultInteger The default integer configuration value
+/// @return The integer configuration value
+INTN
+EFIAPI
+ConfigGetIntegerWithDefault (
+  IN CHAR16 *Path,
+  IN INTN    DefaultInteger
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_INTEGER)) {
+    return DefaultInteger;
+  }
+  return Value.Integer;
+}
+// ConfigSGetIntegerWithDefault
+/// Get an integer configuration value with default
+/// @param Path           The path of the configuration value
+/// @param DefaultInteger The default integer configuration value
+/// @param ...            The argument list
+/// @return The integer configuration value
+INTN
+EFIAPI
+ConfigSGetIntegerWithDefault (
+  IN CHAR16 *Path,
+  IN INTN    DefaultInteger,
+  IN ...
+) {
+  INTN    Result;
+  VA_LIST Args;
+  VA_START(Args, DefaultInteger);
+  Result = ConfigVSGetIntegerWithDefault(Path, DefaultInteger, Args);
+  VA_END(Args);
+  return Result;
+}
+// ConfigVSGetIntegerWithDefault
+/// Get an integer configuration value with default
+/// @param Path           The path of the configuration value
+/// @param DefaultInteger The default integer configuration value
+/// @param Args           The argument list
+/// @return The integer configuration value
+INTN
+EFIAPI
+ConfigVSGetIntegerWithDefault (
+  IN CHAR16  *Path,
+  IN INTN     DefaultInteger,
+  IN VA_LIST  Args
+) {
+  INTN    Result;
+  CHAR16 *FullPath;
+  // Check parameters
+  if (Path == NULL) {
+    return DefaultInteger;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return DefaultInteger;
+  }
+  // Get the value
+  Result = ConfigGetIntegerWithDefault(FullPath, DefaultInteger);
+  FreePool(FullPath);
+  return Result;
+}
+
+// ConfigGetUnsignedWithDefault
+/// Get an unsigned integer configuration value with default
+/// @param Path           The path of the configuration value
+/// @param DefaulUnsigned The default unsigned configuration value
+/// @return The unsigned integer configuration value
+UINTN
+EFIAPI
+ConfigGetUnsignedWithDefault (
+  IN CHAR16 *Path,
+  IN UINTN   DefaultUnsigned
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_UNSIGNED)) {
+    return DefaultUnsigned;
+  }
+  return Value.Unsigned;
+}
+// ConfigSGetUnsignedWithDefault
+/// Get an unsigned integer configuration value with default
+/// @param Path           The path of the configuration value
+/// @param DefaulUnsigned The default unsigned configuration value
+/// @param ...            The argument list
+/// @return The unsigned integer configuration value
+UINTN
+EFIAPI
+ConfigSGetUnsignedWithDefault (
+  IN CHAR16 *Path,
+  IN UINTN   DefaultUnsigned,
+  IN ...
+) {
+  UINTN   Result;
+  VA_LIST Args;
+  VA_START(Args, DefaultUnsigned);
+  Result = ConfigVSGetUnsignedWithDefault(Path, DefaultUnsigned, Args);
+  VA_END(Args);
+  return Result;
+}
+// ConfigVSGetUnsignedWithDefault
+/// Get an unsigned integer configuration value with default
+/// @param Path           The path of the configuration value
+/// @param DefaulUnsigned The default unsigned configuration value
+/// @param Args           The argument list
+/// @return The unsigned integer configuration value
+UINTN
+EFIAPI
+ConfigVSGetUnsignedWithDefault (
+  IN CHAR16  *Path,
+  IN UINTN    DefaultUnsigned,
+  IN VA_LIST  Args
+) {
+  UINTN   Result;
+  CHAR16 *FullPath;
+  // Check parameters
+  if (Path == NULL) {
+    return DefaultUnsigned;
+  }
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return DefaultUnsigned;
+  }
+  // Get the value
+  Result = ConfigGetUnsignedWithDefault(FullPath, DefaultUnsigned);
+  FreePool(FullPath);
+  return Result;
+}
+
+// ConfigGetStringWithDefault
+/// Get a string configuration value with default
+/// @param Path          The path of the configuration value
+/// @param DefaultString The default string configuration value
+/// @return The string configuration value
+CHAR16 *
+EFIAPI
+ConfigGetStringWithDefault (
+  IN CHAR16 *Path,
+  IN CHAR16 *DefaultString
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_STRING)) {
+    return DefaultString;
+  }
+  return Value.String;
+}
+// ConfigSGetStringWithDefault
+/// Get a string configuration value with default
+/// @param Path          The path of the configuration value
+/// @param DefaultString The default string configuration value
+/// @param ...           The argument list
+/// @return The string configuration value
+CHAR16 *
+EFIAPI
+ConfigSGetStringWithDefault (
+  IN CHAR16 *Path,
+  IN CHAR16 *DefaultString,
+  IN ...
+) {
+  CHAR16  *Result;
+  VA_LIST  Args;
+  VA_START(Args, DefaultString);
+  Result = ConfigVSGetStringWithDefault(Path, DefaultString, Args);
+  VA_END(Args);
+  return Result;
+}
+// ConfigVSGetStringWithDefault
+/// Get a string configuration value with default
+/// @param Path          The path of the configuration value
+/// @param DefaultString The default string configuration value
+/// @param Args          The argument list
+/// @return The string configuration value
+CHAR16 *
+EFIAPI
+ConfigVSGetStringWithDefault (
+  IN CHAR16  *Path,
+  IN CHAR16  *DefaultString,
+  IN VA_LIST  Args
+) {
+  CHAR16 *Result;
+  CHAR16 *FullPath;
+  // Check parameters
+  if (Path == NULL) {
+    return DefaultString;
   }
-  if (Children != NULL) {
-    FreePool(Children);
+  // Create the path from the argument list
+  FullPath = CatVSPrint(NULL, Path, Args);
+  if (FullPath == NULL) {
+    return DefaultString;
   }
-  return EFI_SUCCESS;
+  // Get the value
+  Result = ConfigGetStringWithDefault(FullPath, DefaultString);
+  FreePool(FullPath);
+  return Result;
 }
 
-// ConfigFree
-/// Free all configuration values
-/// @return Whether the configuration values were freed or not
-/// @retval EFI_SUCCESS If the configuration values were freed
-EFI_STATUS
-EFIAPI
-ConfigFree (
-  VOID
-) {
-  return ConfigPartialFree(NULL);
-}
-// ConfigPartialFree
-/// Free configuration values with a configuration path
-/// @param Path The configuration path to use as root to free or NULL for root (same as ConfigFree)
-/// @return Whether the configuration values were freed or not
-/// @retval EFI_SUCCESS If the configuration values were freed
-EFI_STATUS
+// ConfigGetDataWithDefault
+/// Get a data configuration value with default
+/// @param Path        The path of the configuration value
+/// @param DefaultSize The default data configuration value size
+/// @param DefaultData The default data configuration value
+/// @param Size        On output, the data configuration value size
+/// @return The data configuration value
+VOID *
 EFIAPI
-ConfigPartialFree (
-  IN CHAR16 *Path OPTIONAL
+ConfigGetDataWithDefault (
+  IN  CHAR16 *Path,
+  IN  UINTN   DefaultSize,
+  IN  VOID   *DefaultData,
+  OUT UINTN  *Size
 ) {
-  CONFIG_TREE **Tree = NULL;
-  CONFIG_TREE  *Node;
-  EFI_STATUS    Status;
-  // Use configuration protocol if present
-  if ((mConfig != NULL) && (mConfig->Free != NULL)) {
-    return mConfig->Free(Path);
-  }
-  // Find the address of the configuration tree node
-  Status = ConfigFind2(Path, FALSE, &Tree);
-  if (EFI_ERROR(Status) || (Tree == NULL) || (*Tree == NULL)) {
-    return (Status == EFI_NOT_FOUND) ? EFI_SUCCESS : Status;
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_DATA)) {
+    *Size = DefaultSize;
+    return DefaultData;
   }
-  // Replace the node with the next
-  Node = *Tree;
-  *Tree = Node->Next;
-  // Free the node
-  return ConfigTreeFree(Node);
+  *Size = Value.Data.Size;
+  return Value.Data.Data;
 }
-// ConfigSPartialFree
-/// Free configuration values with a configuration path
-/// @param Path The configuration path to use as root to free
-/// @param ...  The argument list
-/// @return Whether the configuration values were freed or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
-/// @retval EFI_SUCCESS           If the configuration values were freed
-EFI_STATUS
+// ConfigSGetDataWithDefault
+/// Get a data configuration value with default
+/// @param Path        The path of the configuration value
+/// @param DefaultSize The default data configuration value size
+/// @param DefaultData The default data configuration value
+/// @param Size        On output, the data configuration value size
+/// @param ...         The argument list
+/// @return The data configuration value
+VOID *
 EFIAPI
-ConfigSPartialFree (
-  IN CHAR16 *Path,
-  ...
+ConfigSGetDataWithDefault (
+  IN  CHAR16 *Path,
+  IN  UINTN   DefaultSize,
+  IN  VOID   *DefaultData,
+  OUT UINTN  *Size,
+  IN  ...
 ) {
-  EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, Path);
-  Status = ConfigVSPartialFree(Path, Args);
+  VOID    *Result;
+  VA_LIST  Args;
+  VA_START(Args, Size);
+  Result = ConfigVSGetDataWithDefault(Path, DefaultSize, DefaultData, Size, Args);
   VA_END(Args);
-  return Status;
+  return Result;
 }
-// ConfigVSPartialFree
-/// Free configuration values with a configuration path
-/// @param Path The configuration path to use as root to free
-/// @param Args The argument list
-/// @return Whether the configuration values were freed or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
-/// @retval EFI_SUCCESS           If the configuration values were freed
-EFI_STATUS
+// ConfigVSGetDataWithDefault
+/// Get a data configuration value with default
+/// @param Path        The path of the configuration value
+/// @param DefaultSize The default data configuration value size
+/// @param DefaultData The default data configuration value
+/// @param Size        On output, the data configuration value size
+/// @param Args        The argument list
+/// @return The data configuration value
+VOID *
 EFIAPI
-ConfigVSPartialFree (
-  IN CHAR16  *Path,
-  IN VA_LIST  Args
+ConfigVSGetDataWithDefault (
+  IN  CHAR16  *Path,
+  IN  UINTN    DefaultSize,
+  IN  VOID    *DefaultData,
+  OUT UINTN   *Size,
+  IN  VA_LIST  Args
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
+  VOID   *Result;
+  CHAR16 *FullPath;
   // Check parameters
-  if (Path == NULL) {
-    return EFI_INVALID_PARAMETER;
+  if ((Path == NULL) || (Size == NULL)) {
+    *Size = DefaultSize;
+    return DefaultData;
   }
   // Create the path from the argument list
   FullPath = CatVSPrint(NULL, Path, Args);
   if (FullPath == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+    *Size = DefaultSize;
+    return DefaultData;
   }
-  // Free the partial path
-  Status = ConfigPartialFree(FullPath);
+  // Get the value
+  Result = ConfigGetDataWithDefault(FullPath, DefaultSize, DefaultData, Size);
   FreePool(FullPath);
-  return Status;
+  return Result;
 }
 
-// ConfigGetList
-/// Get a list of names for the children of the configuration path
-/// @param Path  The configuration path of which to get child names or NULL for root
-/// @param List  On output, the string list of names of children
-/// @param Count On output, the count of strings in the list
-/// @return Whether the string list was returned or not
-/// @retval EFI_INVALID_PARAMETER If List or Count is NULL or *List is not NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the stirng list
-/// @retval EFI_NOT_FOUND         If the configuration path was not found
-/// @retval EFI_SUCCESS           If the string list was returned successfully
+// ConfigSetValue
+/// Set a configuration value
+/// @param Path  The path of the configuration value
+/// @param Type  The configuration type to set
+/// @param Value The configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or Value is NULL or Type is invalid
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigGetList (
-  IN  CHAR16   *Path OPTIONAL,
-  OUT CHAR16 ***List,
-  OUT UINTN    *Count
+ConfigSetValue (
+  IN CHAR16       *Path,
+  IN CONFIG_TYPE   Type,
+  IN CONFIG_VALUE *Value
 ) {
   EFI_STATUS   Status;
-  CONFIG_TREE *Node;
+  CONFIG_TREE *Node = NULL;
   // Check parameters
-  if ((List == NULL) || (*List != NULL) || (Count == NULL)) {
+  if ((Path == NULL) || !ConfigValueIsValid(Type, Value)) {
     return EFI_INVALID_PARAMETER;
   }
   // Use configuration protocol if present
-  if ((mConfig != NULL) && (mConfig->GetList != NULL)) {
-    return mConfig->GetList(Path, List, Count);
+  if ((mConfig != NULL) && (mConfig->SetValue != NULL)) {
+    CONFIG_STAT(Protocol);
+    return mConfig->SetValue(Path, Type, Value);
   }
-  // Get the configuration tree node
-  Status = ConfigFind(Path, FALSE, &Node);
+  // Stage the value while a transaction is open
+  if (mConfigTransaction.Depth != 0) {
+    return ConfigStageValue(&Path, 1, Type, Value, FALSE);
+  }
+  // Get configuration tree node
+  Status = ConfigFind(Path, TRUE, &Node);
   if (EFI_ERROR(Status)) {
     return Status;
   }
-  if ((Node == NULL) || (Node->Type != CONFIG_TYPE_LIST)) {
-    return EFI_NOT_FOUND;
-  }
-  // Add the child node names to the list
-  for (Node = Node->Children; Node != NULL; Node = Node->Next) {
-    if (Node->Name != NULL) {
-      StrList(List, Count, Node->Name, 0, STR_LIST_NO_DUPLICATES | STR_LIST_CASE_INSENSITIVE | STR_LIST_SORTED);
-    }
-  }
-  if ((*Count == 0) || (*List == NULL)) {
+  if (Node == NULL) {
     return EFI_NOT_FOUND;
   }
-  return EFI_SUCCESS;
+  // Set type and value
+  return ConfigTreeSetValue(Node, Type, Value, FALSE);
 }
-// ConfigSGetList
-/// Get a list of names for the children of the configuration path
-/// @param Path  The configuration path of which to get child names or NULL for root
-/// @param List  On output, the string list of names of children
-/// @param Count On output, the count of strings in the list
+// ConfigSSetValue
+/// Set a configuration value
+/// @param Path  The path of the configuration value
+/// @param Type  The configuration type to set
+/// @param Value The configuration value to set
 /// @param ...   The argument list
-/// @return Whether the string list was returned or not
-/// @retval EFI_INVALID_PARAMETER If Path, List, or Count is NULL or *List is not NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the stirng list
-/// @retval EFI_NOT_FOUND         If the configuration path was not found
-/// @retval EFI_ACCESS_DENIED     If the configuration path is protected
-/// @retval EFI_SUCCESS           If the string list was returned successfully
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or Value is NULL or Type is invalid
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSGetList (
-  IN  CHAR16   *Path,
-  OUT CHAR16 ***List,
-  OUT UINTN    *Count,
-  IN  ...
+ConfigSSetValue (
+  IN CHAR16       *Path,
+  IN CONFIG_TYPE   Type,
+  IN CONFIG_VALUE *Value,
+  IN ...
 ) {
   EFI_STATUS Status;
   VA_LIST    Args;
-  VA_START(Args, Count);
-  Status = ConfigVSGetList(Path, List, Count, Args);
+  VA_START(Args, Value);
+  Status = ConfigVSSetValue(Path, Type, Value, Args);
   VA_END(Args);
   return Status;
 }
-// ConfigVSGetList
-/// Get a list of names for the children of the configuration path
-/// @param Path  The configuration path of which to get child names
-/// @param List  On output, the string list of names of children
-/// @param Count On output, the count of strings in the list
+// ConfigVSSetValue
+/// Set a configuration value
+/// @param Path  The path of the configuration value
+/// @param Type  The configuration type to set
+/// @param Value The configuration value to set
 /// @param Args  The argument list
-/// @return Whether the string list was returned or not
-/// @retval EFI_INVALID_PARAMETER If Path, List, or Count is NULL or *List is not NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for the stirng list
-/// @retval EFI_NOT_FOUND         If the configuration path was not found
-/// @retval EFI_ACCESS_DENIED     If the configuration path is protected
-/// @retval EFI_SUCCESS           If the string list was returned successfully
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or Value is NULL or Type is invalid
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigVSGetList (
-  IN  CHAR16    *Path,
-  OUT CHAR16  ***List,
-  OUT UINTN     *Count,
-  IN  VA_LIST    Args
+ConfigVSSetValue (
+  IN CHAR16       *Path,
+  IN CONFIG_TYPE   Type,
+  IN CONFIG_VALUE *Value,
+  IN VA_LIST       Args
 ) {
   EFI_STATUS  Status;
   CHAR16     *FullPath;
   // Check parameters
-  if ((Path == NULL) || (List == NULL) || (*List != NULL) || (Count == NULL)) {
+  if ((Path == NULL) || (Value == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
   // Create the path from the argument list
@@ -916,86 +5646,73 @@ ConfigVSGetList (
   if (FullPath == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Get the list
-  Status = ConfigGetList(FullPath, List, Count);
+  // Set the value
+  Status = ConfigSetValue(FullPath, Type, Value);
   FreePool(FullPath);
   return Status;
 }
 
-// ConfigGetType
-/// Get the type of a configuration value
-/// @param Path The path of the configuration value of which to get the type
-/// @param Type On output, the configuration value type
-/// @retval EFI_INVALID_PARAMETER If Path or Type is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value was not found
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSetBoolean
+/// Set a boolean configuration value
+/// @param Path    The path of the configuration value
+/// @param Boolean The boolean configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigGetType (
-  IN  CHAR16      *Path,
-  OUT CONFIG_TYPE *Type
+ConfigSetBoolean (
+  IN CHAR16  *Path,
+  IN BOOLEAN  Boolean
 ) {
-  EFI_STATUS   Status;
-  CONFIG_TREE *Node;
-  // Check parameters
-  if ((Path == NULL) || (Type == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
-  // Get configuration tree node
-  Status = ConfigFind(Path, FALSE, &Node);
-  if (EFI_ERROR(Status)) {
-    return Status;
-  }
-  if (Node == NULL) {
-    return EFI_NOT_FOUND;
-  }
-  // Return type
-  *Type = Node->Type;
-  return EFI_SUCCESS;
+  CONFIG_VALUE Value;
+  Value.Boolean = Boolean;
+  return ConfigSetValue(Path, CONFIG_TYPE_BOOLEAN, &Value);
 }
-// ConfigSGetType
-/// Get the type of a configuration value
-/// @param Path The path of the configuration value of which to get the type
-/// @param Type On output, the configuration value type
-/// @param ...  The argument list
-/// @retval EFI_INVALID_PARAMETER If Path or Type is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value was not found
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSSetBoolean
+/// Set a boolean configuration value
+/// @param Path    The path of the configuration value
+/// @param Boolean The boolean configuration value to set
+/// @param ...     The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSGetType (
-  IN  CHAR16      *Path,
-  OUT CONFIG_TYPE *Type,
-  IN  ...
+ConfigSSetBoolean (
+  IN CHAR16  *Path,
+  IN BOOLEAN  Boolean,
+  IN ...
 ) {
   EFI_STATUS Status;
   VA_LIST    Args;
-  VA_START(Args, Type);
-  Status = ConfigVSGetType(Path, Type, Args);
+  VA_START(Args, Boolean);
+  Status = ConfigVSSetBoolean(Path, Boolean, Args);
   VA_END(Args);
   return Status;
 }
-// ConfigVSGetType
-/// Get the type of a configuration value
-/// @param Path The path of the configuration value of which to get the type
-/// @param Type On output, the configuration value type
-/// @param Args The argument list
-/// @retval EFI_INVALID_PARAMETER If Path or Type is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value was not found
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigVSSetBoolean
+/// Set a boolean configuration value
+/// @param Path    The path of the configuration value
+/// @param Boolean The boolean configuration value to set
+/// @param Args    The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigVSGetType (
-  IN  CHAR16      *Path,
-  OUT CONFIG_TYPE *Type,
-  IN  VA_LIST      Args
+ConfigVSSetBoolean (
+  IN CHAR16  *Path,
+  IN BOOLEAN  Boolean,
+  IN VA_LIST  Args
 ) {
   EFI_STATUS  Status;
   CHAR16     *FullPath;
   // Check parameters
-  if ((Path == NULL) || (Type == NULL)) {
+  if (Path == NULL) {
     return EFI_INVALID_PARAMETER;
   }
   // Create the path from the argument list
@@ -1003,100 +5720,73 @@ ConfigVSGetType (
   if (FullPath == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Get the list
-  Status = ConfigGetType(FullPath, Type);
+  // Set the value
+  Status = ConfigSetBoolean(FullPath, Boolean);
   FreePool(FullPath);
   return Status;
 }
 
-// ConfigGetValue
-/// Get a configuration value
-/// @param Path  The path of the configuration value
-/// @param Type  On output, the type of the configuration value
-/// @param Value On output, the value of the configuration value
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path, Type, or Value is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value was not found
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSetInteger
+/// Set an integer configuration value
+/// @param Path    The path of the configuration value
+/// @param Integer The integer configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigGetValue (
-  IN  CHAR16       *Path,
-  OUT CONFIG_TYPE  *Type,
-  OUT CONFIG_VALUE *Value
+ConfigSetInteger (
+  IN CHAR16 *Path,
+  IN INTN    Integer
 ) {
-  EFI_STATUS   Status;
-  CONFIG_TREE *Node;
-  // Check parameters
-  if ((Path == NULL) || (Type == NULL) || (Value == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
-  // Use configuration protocol if present
-  if ((mConfig != NULL) && (mConfig->GetValue != NULL)) {
-    return mConfig->GetValue(Path, Type, Value);
-  }
-  // Get configuration tree node
-  Status = ConfigFind(Path, FALSE, &Node);
-  if (EFI_ERROR(Status)) {
-    return Status;
-  }
-  if (Node == NULL) {
-    return EFI_NOT_FOUND;
-  }
-  // Return type and value
-  *Type = Node->Type;
-  CopyMem(Value, &(Node->Value), sizeof(CONFIG_VALUE));
-  return EFI_SUCCESS;
+  CONFIG_VALUE Value;
+  Value.Integer = Integer;
+  return ConfigSetValue(Path, CONFIG_TYPE_INTEGER, &Value);
 }
-// ConfigSGetValue
-/// Get a configuration value
-/// @param Path  The path of the configuration value
-/// @param Type  On output, the type of the configuration value
-/// @param Value On output, the value of the configuration value
-/// @param ...   The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path, Type, or Value is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value was not found
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSSetInteger
+/// Set an integer configuration value
+/// @param Path    The path of the configuration value
+/// @param Integer The integer configuration value to set
+/// @param ...     The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSGetValue (
-  IN  CHAR16       *Path,
-  OUT CONFIG_TYPE  *Type,
-  OUT CONFIG_VALUE *Value,
-  IN  ...
+ConfigSSetInteger (
+  IN CHAR16 *Path,
+  IN INTN    Integer,
+  IN ...
 ) {
   EFI_STATUS Status;
   VA_LIST    Args;
-  VA_START(Args, Type);
-  Status = ConfigVSGetValue(Path, Type, Value, Args);
+  VA_START(Args, Integer);
+  Status = ConfigVSSetInteger(Path, Integer, Args);
   VA_END(Args);
   return Status;
 }
-// ConfigVSGetValue
-/// Get a configuration value
-/// @param Path  The path of the configuration value
-/// @param Type  On output, the type of the configuration value
-/// @param Value On output, the value of the configuration value
-/// @param Args  The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path, Type, or Value is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value was not found
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigVSSetInteger
+/// Set an integer configuration value
+/// @param Path    The path of the configuration value
+/// @param Integer The integer configuration value to set
+/// @param Args    The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigVSGetValue (
-  IN  CHAR16       *Path,
-  OUT CONFIG_TYPE  *Type,
-  OUT CONFIG_VALUE *Value,
-  IN  VA_LIST       Args
+ConfigVSSetInteger (
+  IN CHAR16  *Path,
+  IN INTN     Integer,
+  IN VA_LIST  Args
 ) {
   EFI_STATUS  Status;
   CHAR16     *FullPath;
   // Check parameters
-  if ((Path == NULL) || (Type == NULL)) {
+  if (Path == NULL) {
     return EFI_INVALID_PARAMETER;
   }
   // Create the path from the argument list
@@ -1104,93 +5794,73 @@ ConfigVSGetValue (
   if (FullPath == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Get the value
-  Status = ConfigGetValue(FullPath, Type, Value);
+  // Set the value
+  Status = ConfigSetInteger(FullPath, Integer);
   FreePool(FullPath);
   return Status;
 }
 
-// ConfigGetBoolean
-/// Get a boolean configuration value
-/// @param Path    The path of the configuration value
-/// @param Boolean On output, the boolean configuration value
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or Boolean is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
-EFI_STATUS
-EFIAPI
-ConfigGetBoolean (
-  IN  CHAR16  *Path,
-  OUT BOOLEAN *Boolean
-) {
-  EFI_STATUS   Status;
-  CONFIG_VALUE Value;
-  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
-  // Check parameters
-  if ((Path == NULL) || (Boolean == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
-  // Get the configuration value
-  Status = ConfigGetValue(Path, &Type, &Value);
-  if (EFI_ERROR(Status)) {
-    return Status;
-  }
-  // Check type matches
-  if (Type != CONFIG_TYPE_BOOLEAN) {
-    return EFI_ABORTED;
-  }
-  *Boolean = Value.Boolean;
-  return EFI_SUCCESS;
+// ConfigSetUnsigned
+/// Set an unsigned integer configuration value
+/// @param Path     The path of the configuration value
+/// @param Unsigned The unsigned integer configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetUnsigned (
+  IN CHAR16 *Path,
+  IN UINTN   Unsigned
+) {
+  CONFIG_VALUE Value;
+  Value.Unsigned = Unsigned;
+  return ConfigSetValue(Path, CONFIG_TYPE_UNSIGNED, &Value);
 }
-// ConfigSGetBoolean
-/// Get a boolean configuration value
-/// @param Path    The path of the configuration value
-/// @param Boolean On output, the boolean configuration value
-/// @param ...     The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or Boolean is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSSetUnsigned
+/// Set an unsigned integer configuration value
+/// @param Path     The path of the configuration value
+/// @param Unsigned The unsigned integer configuration value to set
+/// @param ...      The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSGetBoolean (
-  IN  CHAR16  *Path,
-  OUT BOOLEAN *Boolean,
-  IN  ...
+ConfigSSetUnsigned (
+  IN CHAR16 *Path,
+  IN UINTN   Unsigned,
+  IN ...
 ) {
   EFI_STATUS Status;
   VA_LIST    Args;
-  VA_START(Args, Boolean);
-  Status = ConfigVSGetBoolean(Path, Boolean, Args);
+  VA_START(Args, Unsigned);
+  Status = ConfigVSSetUnsigned(Path, Unsigned, Args);
   VA_END(Args);
   return Status;
 }
-// ConfigVSGetBoolean
-/// Get a boolean configuration value
-/// @param Path    The path of the configuration value
-/// @param Boolean On output, the boolean configuration value
-/// @param Args    The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or Boolean is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigVSSetUnsigned
+/// Set an unsigned integer configuration value
+/// @param Path     The path of the configuration value
+/// @param Unsigned The unsigned integer configuration value to set
+/// @param Args     The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigVSGetBoolean (
-  IN  CHAR16  *Path,
-  OUT BOOLEAN *Boolean,
-  IN  VA_LIST  Args
+ConfigVSSetUnsigned (
+  IN CHAR16  *Path,
+  IN UINTN    Unsigned,
+  IN VA_LIST  Args
 ) {
   EFI_STATUS  Status;
   CHAR16     *FullPath;
   // Check parameters
-  if ((Path == NULL) || (Boolean == NULL)) {
+  if (Path == NULL) {
     return EFI_INVALID_PARAMETER;
   }
   // Create the path from the argument list
@@ -1198,93 +5868,73 @@ ConfigVSGetBoolean (
   if (FullPath == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Get the value
-  Status = ConfigGetBoolean(FullPath, Boolean);
+  // Set the value
+  Status = ConfigSetUnsigned(FullPath, Unsigned);
   FreePool(FullPath);
   return Status;
 }
 
-// ConfigGetInteger
-/// Get an integer configuration value
-/// @param Path    The path of the configuration value
-/// @param Integer On output, the integer configuration value
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or Integer is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSetString
+/// Set a string configuration value
+/// @param Path   The path of the configuration value
+/// @param String The string configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigGetInteger (
-  IN  CHAR16 *Path,
-  OUT INTN   *Integer
+ConfigSetString (
+  IN CHAR16 *Path,
+  IN CHAR16 *String
 ) {
-  EFI_STATUS   Status;
   CONFIG_VALUE Value;
-  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
-  // Check parameters
-  if ((Path == NULL) || (Integer == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
-  // Get the configuration value
-  Status = ConfigGetValue(Path, &Type, &Value);
-  if (EFI_ERROR(Status)) {
-    return Status;
-  }
-  // Check type matches
-  if (Type != CONFIG_TYPE_INTEGER) {
-    return EFI_ABORTED;
-  }
-  *Integer = Value.Integer;
-  return EFI_SUCCESS;
+  Value.String = String;
+  return ConfigSetValue(Path, CONFIG_TYPE_STRING, &Value);
 }
-// ConfigSGetInteger
-/// Get an integer configuration value
-/// @param Path    The path of the configuration value
-/// @param Integer On output, the integer configuration value
-/// @param ...     The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or Integer is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSSetString
+/// Set a string configuration value
+/// @param Path   The path of the configuration value
+/// @param String The string configuration value to set
+/// @param ...    The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSGetInteger (
-  IN  CHAR16 *Path,
-  OUT INTN   *Integer,
-  IN  ...
+ConfigSSetString (
+  IN CHAR16 *Path,
+  IN CHAR16 *String,
+  IN ...
 ) {
   EFI_STATUS Status;
   VA_LIST    Args;
-  VA_START(Args, Integer);
-  Status = ConfigVSGetInteger(Path, Integer, Args);
+  VA_START(Args, String);
+  Status = ConfigVSSetString(Path, String, Args);
   VA_END(Args);
   return Status;
 }
-// ConfigVSGetInteger
-/// Get an integer configuration value
-/// @param Path    The path of the configuration value
-/// @param Integer On output, the integer configuration value
-/// @param Args    The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or Integer is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigVSSetString
+/// Set a string configuration value
+/// @param Path   The path of the configuration value
+/// @param String The string configuration value to set
+/// @param Args   The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigVSGetInteger (
-  IN  CHAR16  *Path,
-  OUT INTN    *Integer,
-  IN  VA_LIST  Args
+ConfigVSSetString (
+  IN CHAR16  *Path,
+  IN CHAR16  *String,
+  IN VA_LIST  Args
 ) {
   EFI_STATUS  Status;
   CHAR16     *FullPath;
   // Check parameters
-  if ((Path == NULL) || (Integer == NULL)) {
+  if ((Path == NULL) || (String == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
   // Create the path from the argument list
@@ -1292,93 +5942,80 @@ ConfigVSGetInteger (
   if (FullPath == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Get the value
-  Status = ConfigGetInteger(FullPath, Integer);
+  // Set the value
+  Status = ConfigSetString(FullPath, String);
   FreePool(FullPath);
   return Status;
 }
 
-// ConfigGetUnsigned
-/// Get an unsigned integer configuration value
-/// @param Path    The path of the configuration value
-/// @param Unsigned On output, the unsigned integer configuration value
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or Unsigned is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSetData
+/// Set a data configuration value
+/// @param Path The path of the configuration value
+/// @param Size The size of the data configuration value
+/// @param Data The data configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or Data is NULL or Size is zero
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigGetUnsigned (
-  IN  CHAR16 *Path,
-  OUT UINTN  *Unsigned
+ConfigSetData (
+  IN CHAR16 *Path,
+  IN UINTN   Size,
+  IN VOID   *Data
 ) {
-  EFI_STATUS   Status;
   CONFIG_VALUE Value;
-  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
-  // Check parameters
-  if ((Path == NULL) || (Unsigned == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
-  // Get the configuration value
-  Status = ConfigGetValue(Path, &Type, &Value);
-  if (EFI_ERROR(Status)) {
-    return Status;
-  }
-  // Check type matches
-  if (Type != CONFIG_TYPE_UNSIGNED) {
-    return EFI_ABORTED;
-  }
-  *Unsigned = Value.Unsigned;
-  return EFI_SUCCESS;
+  Value.Data.Size = Size;
+  Value.Data.Data = Data;
+  return ConfigSetValue(Path, CONFIG_TYPE_DATA, &Value);
 }
-// ConfigSGetUnsigned
-/// Get an unsigned integer configuration value
-/// @param Path    The path of the configuration value
-/// @param Unsigned On output, the unsigned integer configuration value
-/// @param ...      The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or Unsigned is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSSetData
+/// Set a data configuration value
+/// @param Path The path of the configuration value
+/// @param Size The size of the data configuration value
+/// @param Data The data configuration value to set
+/// @param ...  The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or Data is NULL or Size is zero
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSGetUnsigned (
-  IN  CHAR16 *Path,
-  OUT UINTN  *Unsigned,
-  IN  ...
+ConfigSSetData (
+  IN CHAR16 *Path,
+  IN UINTN   Size,
+  IN VOID   *Data,
+  IN ...
 ) {
   EFI_STATUS Status;
   VA_LIST    Args;
-  VA_START(Args, Unsigned);
-  Status = ConfigVSGetUnsigned(Path, Unsigned, Args);
+  VA_START(Args, Data);
+  Status = ConfigVSSetData(Path, Size, Data, Args);
   VA_END(Args);
   return Status;
 }
-// ConfigVSGetUnsigned
-/// Get an unsigned integer configuration value
-/// @param Path     The path of the configuration value
-/// @param Unsigned On output, the unsigned integer configuration value
-/// @param Args     The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or Unsigned is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigVSSetData
+/// Set a data configuration value
+/// @param Path The path of the configuration value
+/// @param Size The size of the data configuration value
+/// @param Data The data configuration value to set
+/// @param Args The argument list
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or Data is NULL or Size is zero
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigVSGetUnsigned (
-  IN  CHAR16  *Path,
-  OUT UINTN   *Unsigned,
-  IN  VA_LIST  Args
+ConfigVSSetData (
+  IN CHAR16  *Path,
+  IN UINTN    Size,
+  IN VOID    *Data,
+  IN VA_LIST  Args
 ) {
   EFI_STATUS  Status;
   CHAR16     *FullPath;
   // Check parameters
-  if ((Path == NULL) || (Unsigned == NULL)) {
+  if ((Path == NULL) || (Data == NULL) || (Size == 0)) {
     return EFI_INVALID_PARAMETER;
   }
   // Create the path from the argument list
@@ -1386,1195 +6023,1999 @@ ConfigVSGetUnsigned (
   if (FullPath == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Get the value
-  Status = ConfigGetInteger(FullPath, Unsigned);
+  // Set the value
+  Status = ConfigSetData(FullPath, Size, Data);
   FreePool(FullPath);
   return Status;
 }
 
-// ConfigGetString
-/// Get a string configuration value
-/// @param Path   The path of the configuration value
-/// @param String On output, the string configuration value
+// ConfigIndexedPath
+/// Create the full configuration path from a base path, index and leaf path
+/// @param Path  The base path of the configuration value
+/// @param Index The index of the child of the base path
+/// @param Leaf  The path relative to the indexed child or NULL for the indexed child
+/// @return The full configuration path, which must be freed, or NULL if memory could not be allocated
+STATIC CHAR16 *
+EFIAPI
+ConfigIndexedPath (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL
+) {
+  if (Leaf == NULL) {
+    return CatSPrint(NULL, L"%s\\%u", Path, Index);
+  }
+  return CatSPrint(NULL, L"%s\\%u\\%s", Path, Index, Leaf);
+}
+// ConfigSegmentsPath
+/// Create the full configuration path from path segments
+/// @param Segments The path segments of the configuration value
+/// @param Count    The count of path segments
+/// @return The full configuration path, which must be freed, or NULL if memory could not be allocated
+STATIC CHAR16 *
+EFIAPI
+ConfigSegmentsPath (
+  IN CHAR16 **Segments,
+  IN UINTN    Count
+) {
+  CHAR16 *FullPath = NULL;
+  CHAR16 *Tmp;
+  UINTN   Index;
+  for (Index = 0; Index < Count; ++Index) {
+    Tmp = CatSPrint(FullPath, L"\\%s", Segments[Index]);
+    if (FullPath != NULL) {
+      FreePool(FullPath);
+    }
+    FullPath = Tmp;
+    if (FullPath == NULL) {
+      break;
+    }
+  }
+  return FullPath;
+}
+
+// ConfigGetIndexedValue
+/// Get a configuration value by base path, index and leaf path
+/// @param Path  The base path of the configuration value
+/// @param Index The index of the child of the base path
+/// @param Leaf  The path relative to the indexed child or NULL for the indexed child
+/// @param Type  On output, the type of the configuration value
+/// @param Value On output, the value of the configuration value
 /// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
+/// @retval EFI_INVALID_PARAMETER If Path, Type, or Value is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
 /// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
 EFI_STATUS
 EFIAPI
-ConfigGetString (
-  IN  CHAR16  *Path,
-  OUT CHAR16 **String
+ConfigGetIndexedValue (
+  IN  CHAR16       *Path,
+  IN  UINTN         Index,
+  IN  CHAR16       *Leaf OPTIONAL,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value
 ) {
   EFI_STATUS   Status;
+  CONFIG_TREE *Node = NULL;
+  CHAR16      *FullPath;
+  CHAR16      *Segments[3];
+  CHAR16       Buffer[CONFIG_INDEXED_NAME_LENGTH];
+  // Check parameters
+  if ((Path == NULL) || (Type == NULL) || (Value == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // The configuration tree belongs to another image so create the full path
+  if (mConfig != NULL) {
+    FullPath = ConfigIndexedPath(Path, Index, Leaf);
+    if (FullPath == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Status = ConfigGetValue(FullPath, Type, Value);
+    FreePool(FullPath);
+    return Status;
+  }
+  // Values staged by an open transaction are newer than the configuration tree
+  if (mConfigTransaction.Count != 0) {
+    Segments[0] = Path;
+    Segments[1] = ConfigIndexedName(Index, Buffer);
+    Segments[2] = Leaf;
+    if (ConfigStageGetValue(Segments, ARRAY_SIZE(Segments), Type, Value)) {
+      return EFI_SUCCESS;
+    }
+  }
+  // Get configuration tree node
+  Status = ConfigFindIndexed(Path, Index, Leaf, FALSE, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Return type and value
+  ConfigTreeGetValue(Node, Type, Value);
+  return EFI_SUCCESS;
+}
+// ConfigGetIndexedBooleanWithDefault
+/// Get a boolean configuration value by base path, index and leaf path with default
+/// @param Path           The base path of the configuration value
+/// @param Index          The index of the child of the base path
+/// @param Leaf           The path relative to the indexed child or NULL for the indexed child
+/// @param DefaultBoolean The default boolean configuration value
+/// @return The boolean configuration value
+BOOLEAN
+EFIAPI
+ConfigGetIndexedBooleanWithDefault (
+  IN CHAR16  *Path,
+  IN UINTN    Index,
+  IN CHAR16  *Leaf OPTIONAL,
+  IN BOOLEAN  DefaultBoolean
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetIndexedValue(Path, Index, Leaf, &Type, &Value)) || (Type != CONFIG_TYPE_BOOLEAN)) {
+    return DefaultBoolean;
+  }
+  return Value.Boolean;
+}
+// ConfigGetIndexedIntegerWithDefault
+/// Get an integer configuration value by base path, index and leaf path with default
+/// @param Path           The base path of the configuration value
+/// @param Index          The index of the child of the base path
+/// @param Leaf           The path relative to the indexed child or NULL for the indexed child
+/// @param DefaultInteger The default integer configuration value
+/// @return The integer configuration value
+INTN
+EFIAPI
+ConfigGetIndexedIntegerWithDefault (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN INTN    DefaultInteger
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetIndexedValue(Path, Index, Leaf, &Type, &Value)) || (Type != CONFIG_TYPE_INTEGER)) {
+    return DefaultInteger;
+  }
+  return Value.Integer;
+}
+// ConfigGetIndexedUnsignedWithDefault
+/// Get an unsigned integer configuration value by base path, index and leaf path with default
+/// @param Path            The base path of the configuration value
+/// @param Index           The index of the child of the base path
+/// @param Leaf            The path relative to the indexed child or NULL for the indexed child
+/// @param DefaultUnsigned The default unsigned configuration value
+/// @return The unsigned integer configuration value
+UINTN
+EFIAPI
+ConfigGetIndexedUnsignedWithDefault (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN UINTN   DefaultUnsigned
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
   CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetIndexedValue(Path, Index, Leaf, &Type, &Value)) || (Type != CONFIG_TYPE_UNSIGNED)) {
+    return DefaultUnsigned;
+  }
+  return Value.Unsigned;
+}
+// ConfigGetIndexedStringWithDefault
+/// Get a string configuration value by base path, index and leaf path with default
+/// @param Path          The base path of the configuration value
+/// @param Index         The index of the child of the base path
+/// @param Leaf          The path relative to the indexed child or NULL for the indexed child
+/// @param DefaultString The default string configuration value
+/// @return The string configuration value
+CHAR16 *
+EFIAPI
+ConfigGetIndexedStringWithDefault (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN CHAR16 *DefaultString
+) {
   CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigGetIndexedValue(Path, Index, Leaf, &Type, &Value)) || (Type != CONFIG_TYPE_STRING)) {
+    return DefaultString;
+  }
+  return Value.String;
+}
+
+// ConfigSetIndexedValue
+/// Set a configuration value by base path, index and leaf path
+/// @param Path  The base path of the configuration value
+/// @param Index The index of the child of the base path
+/// @param Leaf  The path relative to the indexed child or NULL for the indexed child
+/// @param Type  The configuration type to set
+/// @param Value The configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path or Value is NULL or Type is invalid
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetIndexedValue (
+  IN CHAR16       *Path,
+  IN UINTN         Index,
+  IN CHAR16       *Leaf OPTIONAL,
+  IN CONFIG_TYPE   Type,
+  IN CONFIG_VALUE *Value
+) {
+  EFI_STATUS   Status;
+  CONFIG_TREE *Node = NULL;
+  CHAR16      *FullPath;
+  CHAR16      *Segments[3];
+  CHAR16       Buffer[CONFIG_INDEXED_NAME_LENGTH];
   // Check parameters
-  if ((Path == NULL) || (String == NULL)) {
+  if ((Path == NULL) || !ConfigValueIsValid(Type, Value)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Get the configuration value
-  Status = ConfigGetValue(Path, &Type, &Value);
-  if (EFI_ERROR(Status)) {
+  // The configuration tree belongs to another image so create the full path
+  if (mConfig != NULL) {
+    FullPath = ConfigIndexedPath(Path, Index, Leaf);
+    if (FullPath == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Status = ConfigSetValue(FullPath, Type, Value);
+    FreePool(FullPath);
     return Status;
   }
-  // Check type matches
-  if (Type != CONFIG_TYPE_STRING) {
-    return EFI_ABORTED;
+  // Stage the value while a transaction is open
+  if (mConfigTransaction.Depth != 0) {
+    Segments[0] = Path;
+    Segments[1] = ConfigIndexedName(Index, Buffer);
+    Segments[2] = Leaf;
+    return ConfigStageValue(Segments, ARRAY_SIZE(Segments), Type, Value, FALSE);
   }
-  *String = Value.String;
-  return EFI_SUCCESS;
+  // Get configuration tree node
+  Status = ConfigFindIndexed(Path, Index, Leaf, TRUE, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Set type and value
+  return ConfigTreeSetValue(Node, Type, Value, FALSE);
 }
-// ConfigSGetString
-/// Get a string configuration value
-/// @param Path   The path of the configuration value
-/// @param String On output, the string configuration value
-/// @param ...    The argument list
-/// @return Whether the configuration value was retrieved or not
+// ConfigSetIndexedBoolean
+/// Set a boolean configuration value by base path, index and leaf path
+/// @param Path    The base path of the configuration value
+/// @param Index   The index of the child of the base path
+/// @param Leaf    The path relative to the indexed child or NULL for the indexed child
+/// @param Boolean The boolean configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetIndexedBoolean (
+  IN CHAR16  *Path,
+  IN UINTN    Index,
+  IN CHAR16  *Leaf OPTIONAL,
+  IN BOOLEAN  Boolean
+) {
+  CONFIG_VALUE Value;
+  Value.Boolean = Boolean;
+  return ConfigSetIndexedValue(Path, Index, Leaf, CONFIG_TYPE_BOOLEAN, &Value);
+}
+// ConfigSetIndexedInteger
+/// Set an integer configuration value by base path, index and leaf path
+/// @param Path    The base path of the configuration value
+/// @param Index   The index of the child of the base path
+/// @param Leaf    The path relative to the indexed child or NULL for the indexed child
+/// @param Integer The integer configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetIndexedInteger (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN INTN    Integer
+) {
+  CONFIG_VALUE Value;
+  Value.Integer = Integer;
+  return ConfigSetIndexedValue(Path, Index, Leaf, CONFIG_TYPE_INTEGER, &Value);
+}
+// ConfigSetIndexedUnsigned
+/// Set an unsigned integer configuration value by base path, index and leaf path
+/// @param Path     The base path of the configuration value
+/// @param Index    The index of the child of the base path
+/// @param Leaf     The path relative to the indexed child or NULL for the indexed child
+/// @param Unsigned The unsigned integer configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
+EFI_STATUS
+EFIAPI
+ConfigSetIndexedUnsigned (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN UINTN   Unsigned
+) {
+  CONFIG_VALUE Value;
+  Value.Unsigned = Unsigned;
+  return ConfigSetIndexedValue(Path, Index, Leaf, CONFIG_TYPE_UNSIGNED, &Value);
+}
+// ConfigSetIndexedString
+/// Set a string configuration value by base path, index and leaf path
+/// @param Path   The base path of the configuration value
+/// @param Index  The index of the child of the base path
+/// @param Leaf   The path relative to the indexed child or NULL for the indexed child
+/// @param String The string configuration value to set
+/// @return Whether the configuration value was set or not
 /// @retval EFI_INVALID_PARAMETER If Path or String is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSGetString (
-  IN  CHAR16  *Path,
-  OUT CHAR16 **String,
-  IN  ...
+ConfigSetIndexedString (
+  IN CHAR16 *Path,
+  IN UINTN   Index,
+  IN CHAR16 *Leaf OPTIONAL,
+  IN CHAR16 *String
 ) {
-  EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, String);
-  Status = ConfigVSGetString(Path, String, Args);
-  VA_END(Args);
-  return Status;
+  CONFIG_VALUE Value;
+  Value.String = String;
+  return ConfigSetIndexedValue(Path, Index, Leaf, CONFIG_TYPE_STRING, &Value);
 }
-// ConfigVSGetString
-/// Get a string configuration value
-/// @param Path   The path of the configuration value
-/// @param String On output, the string configuration value
-/// @param Args   The argument list
+
+// ConfigGetSegmentsValue
+/// Get a configuration value by path segments
+/// @param Segments The path segments of the configuration value, which may contain separators
+/// @param Count    The count of path segments
+/// @param Type     On output, the type of the configuration value
+/// @param Value    On output, the value of the configuration value
 /// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_INVALID_PARAMETER If Segments, Type, or Value is NULL or Count is zero
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
 /// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
 EFI_STATUS
 EFIAPI
-ConfigVSGetString (
-  IN  CHAR16   *Path,
-  OUT CHAR16  **String,
-  IN  VA_LIST   Args
+ConfigGetSegmentsValue (
+  IN  CHAR16       **Segments,
+  IN  UINTN          Count,
+  OUT CONFIG_TYPE   *Type,
+  OUT CONFIG_VALUE  *Value
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
+  EFI_STATUS   Status;
+  CONFIG_TREE *Node = NULL;
+  CHAR16      *FullPath;
   // Check parameters
-  if ((Path == NULL) || (String == NULL)) {
+  if ((Segments == NULL) || (Count == 0) || (Type == NULL) || (Value == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  // The configuration tree belongs to another image so create the full path
+  if (mConfig != NULL) {
+    FullPath = ConfigSegmentsPath(Segments, Count);
+    if (FullPath == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Status = ConfigGetValue(FullPath, Type, Value);
+    FreePool(FullPath);
+    return Status;
   }
-  // Get the value
-  Status = ConfigGetString(FullPath, String);
-  FreePool(FullPath);
-  return Status;
+  // Values staged by an open transaction are newer than the configuration tree
+  if (ConfigStageGetValue(Segments, Count, Type, Value)) {
+    return EFI_SUCCESS;
+  }
+  // Get configuration tree node
+  Status = ConfigFindSegments(Segments, Count, FALSE, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  // Return type and value
+  ConfigTreeGetValue(Node, Type, Value);
+  return EFI_SUCCESS;
 }
-
-// ConfigGetData
-/// Get a data configuration value
-/// @param Path The path of the configuration value
-/// @param Size On output, the data configuration value size in bytes
-/// @param Data On output, the data configuration value
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path, Size, or Data is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigSetSegmentsValue
+/// Set a configuration value by path segments
+/// @param Segments The path segments of the configuration value, which may contain separators
+/// @param Count    The count of path segments
+/// @param Type     The configuration type to set
+/// @param Value    The configuration value to set
+/// @return Whether the configuration value was set or not
+/// @retval EFI_INVALID_PARAMETER If Segments or Value is NULL, Count is zero or Type is invalid
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
+/// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigGetData (
-  IN  CHAR16  *Path,
-  OUT UINTN   *Size,
-  OUT VOID   **Data
+ConfigSetSegmentsValue (
+  IN CHAR16       **Segments,
+  IN UINTN          Count,
+  IN CONFIG_TYPE    Type,
+  IN CONFIG_VALUE  *Value
 ) {
   EFI_STATUS   Status;
-  CONFIG_VALUE Value;
-  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_TREE *Node = NULL;
+  CHAR16      *FullPath;
   // Check parameters
-  if ((Path == NULL) || (Size == NULL) || (Data == NULL)) {
+  if ((Segments == NULL) || (Count == 0) || !ConfigValueIsValid(Type, Value)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Get the configuration value
-  Status = ConfigGetValue(Path, &Type, &Value);
+  // The configuration tree belongs to another image so create the full path
+  if (mConfig != NULL) {
+    FullPath = ConfigSegmentsPath(Segments, Count);
+    if (FullPath == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Status = ConfigSetValue(FullPath, Type, Value);
+    FreePool(FullPath);
+    return Status;
+  }
+  // Stage the value while a transaction is open
+  if (mConfigTransaction.Depth != 0) {
+    return ConfigStageValue(Segments, Count, Type, Value, FALSE);
+  }
+  // Get configuration tree node
+  Status = ConfigFindSegments(Segments, Count, TRUE, &Node);
   if (EFI_ERROR(Status)) {
     return Status;
   }
-  // Check type matches
-  if (Type != CONFIG_TYPE_DATA) {
-    return EFI_ABORTED;
+  // Set type and value
+  return ConfigTreeSetValue(Node, Type, Value, FALSE);
+}
+
+// ConfigQueryStore
+/// Store a configuration query result in the output of its descriptor
+/// @param Query The configuration query descriptor
+/// @param Value The configuration value of the expected type
+STATIC VOID
+EFIAPI
+ConfigQueryStore (
+  IN CONFIG_QUERY *Query,
+  IN CONFIG_VALUE *Value
+) {
+  switch (Query->Type) {
+    case CONFIG_TYPE_BOOLEAN:
+      *((BOOLEAN *)(Query->Value)) = Value->Boolean;
+      break;
+
+    case CONFIG_TYPE_INTEGER:
+      *((INTN *)(Query->Value)) = Value->Integer;
+      break;
+
+    case CONFIG_TYPE_UNSIGNED:
+      *((UINTN *)(Query->Value)) = Value->Unsigned;
+      break;
+
+    case CONFIG_TYPE_STRING:
+      *((CHAR16 **)(Query->Value)) = Value->String;
+      break;
+
+    case CONFIG_TYPE_DATA:
+      CopyMem(Query->Value, &(Value->Data), sizeof(CONFIG_DATA));
+      break;
+
+    default:
+      break;
   }
-  *Size = Value.Data.Size;
-  *Data = Value.Data.Data;
-  return EFI_SUCCESS;
 }
-// ConfigSGetData
-/// Get a data configuration value
-/// @param Path The path of the configuration value
-/// @param Size On output, the data configuration value size in bytes
-/// @param Data On output, the data configuration value
-/// @param ...  The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path, Size, or Data is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
-EFI_STATUS
+// ConfigResolverStart
+/// Start a configuration batch lookup relative to a common base path
+/// @param Base     The base path of the configuration values or NULL for root
+/// @param Resolver On output, the configuration batch lookup state
+STATIC VOID
 EFIAPI
-ConfigSGetData (
-  IN  CHAR16  *Path,
-  OUT UINTN   *Size,
-  OUT VOID   **Data,
-  IN  ...
+ConfigResolverStart (
+  IN  CHAR16          *Base OPTIONAL,
+  OUT CONFIG_RESOLVER *Resolver
 ) {
-  EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, Data);
-  Status = ConfigVSGetData(Path, Size, Data, Args);
-  VA_END(Args);
-  return Status;
+  ZeroMem(Resolver, sizeof(CONFIG_RESOLVER));
+  Resolver->Base = Base;
+  // Resolve the base path once, which is recorded with each path, the configuration tree belongs to another image if the protocol is present
+  if ((mConfig == NULL) && EFI_ERROR(ConfigWalk(&Base, 1, FALSE, &(Resolver->Root)))) {
+    Resolver->Root = NULL;
+  }
 }
-// ConfigVSGetData
-/// Get a data configuration value
-/// @param Path The path of the configuration value
-/// @param Size On output, the data configuration value size in bytes
-/// @param Data On output, the data configuration value
-/// @param Args The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path, Size, or Data is NULL
-/// @retval EFI_NOT_FOUND         If the configuration value path was not found
-/// @retval EFI_ABORTED           If the configuration value type does not match
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigResolverGetValue
+/// Get a configuration value relative to the base path of a configuration batch lookup, a value staged by an open transaction is read before the configuration tree
+/// @param Resolver The configuration batch lookup state
+/// @param Path     The path of the configuration value relative to the base path
+/// @param Type     On output, the type of the configuration value or CONFIG_TYPE_UNKNOWN if not found
+/// @param Value    On output, the configuration value
+STATIC VOID
+EFIAPI
+ConfigResolverGetValue (
+  IN  CONFIG_RESOLVER *Resolver,
+  IN  CHAR16          *Path,
+  OUT CONFIG_TYPE     *Type,
+  OUT CONFIG_VALUE    *Value
+) {
+  CONFIG_TREE *Node;
+  CHAR16      *FullPath;
+  CHAR16      *Segments[2];
+  UINTN        Length;
+#if defined(PROJECT_DEBUG)
+  UINT64       Start = GetPerformanceCounter();
+#endif
+  *Type = CONFIG_TYPE_UNKNOWN;
+  if (mConfig != NULL) {
+    // Create the full path for the configuration protocol
+    FullPath = (Resolver->Base == NULL) ? CatSPrint(NULL, L"\\%s", Path) : CatSPrint(NULL, L"%s\\%s", Resolver->Base, Path);
+    if ((FullPath == NULL) || EFI_ERROR(ConfigGetValue(FullPath, Type, Value))) {
+      *Type = CONFIG_TYPE_UNKNOWN;
+    }
+    if (FullPath != NULL) {
+      FreePool(FullPath);
+    }
+    return;
+  }
+  // Values staged by an open transaction are newer than the configuration tree
+  Segments[0] = Resolver->Base;
+  Segments[1] = Path;
+  if (((mConfigTransaction.Count == 0) || !ConfigStageGetValue(Segments, ARRAY_SIZE(Segments), Type, Value)) && (Resolver->Root != NULL)) {
+    // Consecutive paths in the same directory share the directory node
+    for (Length = StrLen(Path); (Length > 0) && (Path[Length - 1] != L'\\'); --Length);
+    if ((Resolver->Directory == NULL) || (Length != Resolver->DirectoryLength) || (StrniCmp(Resolver->Directory, Path, Length) != 0)) {
+      CHAR16 *Name = Path;
+      UINTN   NameLength;
+      Resolver->Directory = Path;
+      Resolver->DirectoryLength = Length;
+      // Find each directory node name relative to the previous
+      Resolver->Parent = Resolver->Root;
+      while ((Resolver->Parent != NULL) && (Name < (Path + Length))) {
+        if (*Name == L'\\') {
+          ++Name;
+          continue;
+        }
+        for (NameLength = 0; ((Name + NameLength) < (Path + Length)) && (Name[NameLength] != L'\\'); ++NameLength);
+        Resolver->Parent = ConfigIndexFind(Resolver->Parent, Name, NULL, NameLength, StrniHash(Name, NameLength));
+        Name += NameLength;
+      }
+    }
+    // Find the leaf relative to the directory node
+    if ((Resolver->Parent != NULL) && !EFI_ERROR(ConfigFindChild(Resolver->Parent, Path + Length, FALSE, &Node)) && (Node != NULL)) {
+      ConfigTreeGetValue(Node, Type, Value);
+    }
+  }
+#if defined(PROJECT_DEBUG)
+  // Record the lookup of the full path
+  ConfigStatRecord(Segments, ARRAY_SIZE(Segments), (*Type == CONFIG_TYPE_UNKNOWN) ? EFI_NOT_FOUND : EFI_SUCCESS, 0, GetPerformanceCounter() - Start);
+#endif
+}
+// ConfigQuery
+/// Get many configuration values relative to a common base path at once
+/// @param Base    The base path of the configuration values or NULL for root
+/// @param Queries The configuration query descriptors
+/// @param Count   The count of configuration query descriptors
+/// @param Found   On output, the count of configuration values found with the expected type
+/// @return Whether the configuration values were retrieved or not, every output is set to either the value or the default
+/// @retval EFI_INVALID_PARAMETER If Queries is NULL, Count is zero, or a descriptor has no Path or Value or an invalid Type
+/// @retval EFI_SUCCESS           If the configuration values were retrieved successfully
 EFI_STATUS
 EFIAPI
-ConfigVSGetData (
-  IN  CHAR16   *Path,
-  OUT UINTN    *Size,
-  OUT VOID    **Data,
-  IN  VA_LIST   Args
+ConfigQuery (
+  IN  CHAR16       *Base OPTIONAL,
+  IN  CONFIG_QUERY *Queries,
+  IN  UINTN         Count,
+  OUT UINTN        *Found OPTIONAL
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
+  CONFIG_RESOLVER Resolver;
+  CONFIG_TYPE     Type;
+  CONFIG_VALUE    Value;
+  UINTN           Index;
+  UINTN           Matched = 0;
   // Check parameters
-  if ((Path == NULL) || (Size == NULL) || (Data == NULL)) {
+  if ((Queries == NULL) || (Count == 0)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  for (Index = 0; Index < Count; ++Index) {
+    if ((Queries[Index].Path == NULL) || (Queries[Index].Value == NULL) ||
+        (Queries[Index].Type <= CONFIG_TYPE_LIST) || (Queries[Index].Type > CONFIG_TYPE_DATA)) {
+      return EFI_INVALID_PARAMETER;
+    }
   }
-  // Get the value
-  Status = ConfigGetData(FullPath, Size, Data);
-  FreePool(FullPath);
-  return Status;
+  ConfigResolverStart(Base, &Resolver);
+  for (Index = 0; Index < Count; ++Index) {
+    ConfigResolverGetValue(&Resolver, Queries[Index].Path, &Type, &Value);
+    // Store the value or the default
+    if (Type == Queries[Index].Type) {
+      ConfigQueryStore(&(Queries[Index]), &Value);
+      ++Matched;
+    } else {
+      ConfigQueryStore(&(Queries[Index]), &(Queries[Index].Default));
+    }
+  }
+  if (Found != NULL) {
+    *Found = Matched;
+  }
+  return EFI_SUCCESS;
 }
 
-// ConfigGetValueWithDefault
-/// Get a configuration value with a default fallback value
-/// @param Path         The path of the configuration value
-/// @param DefaultType  The default type of the configuration value
-/// @param DefaultValue The default value of the configuration value
-/// @param Type         On output, the type of the configuration value
-/// @param Value        On output, the value of the configuration value
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path, DefaultValue, Type or Value is NULL or DefaultType is invalid
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigIteratorStart
+/// Start enumerating the children of a configuration path
+/// @param Path     The configuration path of which to enumerate children or NULL for root, which must stay valid until finished
+/// @param Iterator On output, the configuration child enumeration positioned before the first child, which must be finished with ConfigIteratorFinish
+/// @return Whether the enumeration was started or not
+/// @retval EFI_INVALID_PARAMETER If Iterator is NULL
+/// @retval EFI_NOT_FOUND         If the configuration path was not found or is not a list
+/// @retval EFI_SUCCESS           If the enumeration was started successfully
 EFI_STATUS
 EFIAPI
-ConfigGetValueWithDefault (
-  IN  CHAR16       *Path,
-  IN  CONFIG_TYPE   DefaultType,
-  IN  CONFIG_VALUE *DefaultValue,
-  OUT CONFIG_TYPE  *Type,
-  OUT CONFIG_VALUE *Value
+ConfigIteratorStart (
+  IN  CHAR16          *Path OPTIONAL,
+  OUT CONFIG_ITERATOR *Iterator
 ) {
+  EFI_STATUS   Status;
+  CONFIG_TREE *Parent = NULL;
   // Check parameters
-  if ((Path == NULL) || (DefaultValue == NULL) || (Type == NULL) || (Value == NULL)) {
+  if (Iterator == NULL) {
     return EFI_INVALID_PARAMETER;
   }
-  // Check default type is valid
-  switch (DefaultType) {
-    case CONFIG_TYPE_BOOLEAN:
-    case CONFIG_TYPE_INTEGER:
-    case CONFIG_TYPE_UNSIGNED:
-    case CONFIG_TYPE_STRING:
-    case CONFIG_TYPE_DATA:
-      break;
-
-    default:
-      return EFI_INVALID_PARAMETER;
+  ZeroMem(Iterator, sizeof(CONFIG_ITERATOR));
+  Iterator->Path = Path;
+  Iterator->Generation = mConfigGeneration;
+  // Walk the shared snapshot records or else the child names from the configuration protocol
+  if (mConfig != NULL) {
+    CONFIG_SNAPSHOT_HEADER *Snapshot = ConfigSnapshotGet();
+    if (Snapshot != NULL) {
+      CONFIG_SNAPSHOT_NODE *Record = ConfigSnapshotFind(Snapshot, 0, Path);
+      CONFIG_STAT(Snapshot);
+      if ((Record == NULL) || (Record->Type != CONFIG_TYPE_LIST)) {
+        return EFI_NOT_FOUND;
+      }
+      Iterator->Snapshot = Snapshot;
+      Iterator->Parent = Record;
+      return EFI_SUCCESS;
+    }
+    return ConfigGetList(Path, &(Iterator->List), &(Iterator->Count));
   }
-  // Get value
-  if (EFI_ERROR(ConfigGetValue(Path, Type, Value))) {
-    // Set default value
-    *Type = DefaultType;
-    CopyMem(Value, DefaultValue, sizeof(CONFIG_VALUE));
+  // Resolve the configuration tree node once, the children are walked in place
+  Status = ConfigFind(Path, FALSE, &Parent);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if ((Parent == NULL) || (Parent->Type != CONFIG_TYPE_LIST)) {
+    return EFI_NOT_FOUND;
   }
+  Iterator->Parent = Parent;
   return EFI_SUCCESS;
 }
-// ConfigSGetValueWithDefault
-/// Get a configuration value with a default fallback value
-/// @param Path         The path of the configuration value
-/// @param DefaultType  The default type of the configuration value
-/// @param DefaultValue The default value of the configuration value
-/// @param Type         On output, the type of the configuration value
-/// @param Value        On output, the value of the configuration value
-/// @param ...          The argument list
-/// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path, DefaultValue, Type or Value is NULL or DefaultType is invalid
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
-/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+// ConfigIteratorNext
+/// Advance a configuration child enumeration to the next child and get its name, type and value
+/// @param Iterator The configuration child enumeration
+/// @return Whether there was another child or not
+/// @retval EFI_INVALID_PARAMETER If Iterator is NULL
+/// @retval EFI_ABORTED           If configuration values were freed since the enumeration started
+/// @retval EFI_NOT_FOUND         If there are no more children
+/// @retval EFI_SUCCESS           If the enumeration advanced to the next child
 EFI_STATUS
 EFIAPI
-ConfigSGetValueWithDefault (
-  IN  CHAR16       *Path,
-  IN  CONFIG_TYPE   DefaultType,
-  IN  CONFIG_VALUE *DefaultValue,
-  OUT CONFIG_TYPE  *Type,
-  OUT CONFIG_VALUE *Value,
-  IN  ...
+ConfigIteratorNext (
+  IN OUT CONFIG_ITERATOR *Iterator
 ) {
-  EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, Value);
-  Status = ConfigVSGetValueWithDefault(Path, DefaultType, DefaultValue, Type, Value, Args);
-  VA_END(Args);
-  return Status;
+  // Check parameters
+  if (Iterator == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Iterator->Name = NULL;
+  Iterator->Type = CONFIG_TYPE_UNKNOWN;
+  ZeroMem(&(Iterator->Value), sizeof(CONFIG_VALUE));
+  if (Iterator->Snapshot != NULL) {
+    // The snapshot records are never freed while published so a retired snapshot remains a consistent view
+    CONFIG_SNAPSHOT_HEADER *Header = (CONFIG_SNAPSHOT_HEADER *)Iterator->Snapshot;
+    CONFIG_SNAPSHOT_NODE   *Nodes = (CONFIG_SNAPSHOT_NODE *)(((UINT8 *)Header) + Header->Nodes);
+    CONFIG_SNAPSHOT_NODE   *Record = (CONFIG_SNAPSHOT_NODE *)((Iterator->Node == NULL) ? Iterator->Parent : Iterator->Node);
+    UINT32                  Index = (Iterator->Node == NULL) ? Record->Children : Record->Next;
+    if ((Index == 0) || (Index >= Header->NodeCount) || (Nodes[Index].Name >= Header->Size)) {
+      Iterator->Node = NULL;
+      Iterator->Parent = NULL;
+      return EFI_NOT_FOUND;
+    }
+    Record = &(Nodes[Index]);
+    Iterator->Node = Record;
+    Iterator->Name = (CHAR16 *)(((UINT8 *)Header) + Record->Name);
+    ConfigSnapshotRecordValue(Header, Record, &(Iterator->Type), &(Iterator->Value));
+    return EFI_SUCCESS;
+  }
+  if (Iterator->List != NULL) {
+    CHAR16 *FullPath;
+    // Get the value of the next child name through the configuration protocol
+    if (Iterator->Index >= Iterator->Count) {
+      return EFI_NOT_FOUND;
+    }
+    Iterator->Name = Iterator->List[Iterator->Index++];
+    FullPath = CatSPrint(NULL, L"%s\\%s", (Iterator->Path == NULL) ? L"" : Iterator->Path, Iterator->Name);
+    if ((FullPath == NULL) || EFI_ERROR(ConfigGetValue(FullPath, &(Iterator->Type), &(Iterator->Value)))) {
+      Iterator->Type = CONFIG_TYPE_UNKNOWN;
+    }
+    if (FullPath != NULL) {
+      FreePool(FullPath);
+    }
+    return EFI_SUCCESS;
+  }
+  if (Iterator->Parent == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  // The walked nodes may no longer exist if configuration values were freed
+  if (Iterator->Generation != mConfigGeneration) {
+    Iterator->Node = NULL;
+    Iterator->Parent = NULL;
+    return EFI_ABORTED;
+  }
+  Iterator->Node = (Iterator->Node == NULL) ? ((CONFIG_TREE *)Iterator->Parent)->Children : ((CONFIG_TREE *)Iterator->Node)->Next;
+  if (Iterator->Node == NULL) {
+    Iterator->Parent = NULL;
+    return EFI_NOT_FOUND;
+  }
+  Iterator->Name = ((CONFIG_TREE *)Iterator->Node)->Name;
+  ConfigTreeGetValue((CONFIG_TREE *)Iterator->Node, &(Iterator->Type), &(Iterator->Value));
+  return EFI_SUCCESS;
 }
-// ConfigVSGetValueWithDefault
-/// Get a configuration value with a default fallback value
-/// @param Path         The path of the configuration value
-/// @param DefaultType  The default type of the configuration value
-/// @param DefaultValue The default value of the configuration value
-/// @param Type         On output, the type of the configuration value
-/// @param Value        On output, the value of the configuration value
-/// @param Args         The argument list
+// ConfigIteratorFinish
+/// Finish a configuration child enumeration
+/// @param Iterator The configuration child enumeration
+VOID
+EFIAPI
+ConfigIteratorFinish (
+  IN OUT CONFIG_ITERATOR *Iterator
+) {
+  if (Iterator == NULL) {
+    return;
+  }
+  if (Iterator->List != NULL) {
+    StrListFree(Iterator->List, Iterator->Count);
+  }
+  ZeroMem(Iterator, sizeof(CONFIG_ITERATOR));
+}
+// ConfigIteratorGetValue
+/// Get a configuration value relative to the current child of a configuration child enumeration
+/// @param Iterator The configuration child enumeration
+/// @param Path     The path relative to the current child or NULL for the current child
+/// @param Type     On output, the type of the configuration value
+/// @param Value    On output, the value of the configuration value
 /// @return Whether the configuration value was retrieved or not
-/// @retval EFI_INVALID_PARAMETER If Path, DefaultValue, Type or Value is NULL or DefaultType is invalid
-/// @retval EFI_ACCESS_DENIED     If the configuration value is protected
+/// @retval EFI_INVALID_PARAMETER If Iterator, Type, or Value is NULL or there is no current child
+/// @retval EFI_ABORTED           If configuration values were freed since the enumeration started
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
 /// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
 EFI_STATUS
 EFIAPI
-ConfigVSGetValueWithDefault (
-  IN  CHAR16       *Path,
-  IN  CONFIG_TYPE   DefaultType,
-  IN  CONFIG_VALUE *DefaultValue,
-  OUT CONFIG_TYPE  *Type,
-  OUT CONFIG_VALUE *Value,
-  IN  VA_LIST       Args
+ConfigIteratorGetValue (
+  IN  CONFIG_ITERATOR *Iterator,
+  IN  CHAR16          *Path OPTIONAL,
+  OUT CONFIG_TYPE     *Type,
+  OUT CONFIG_VALUE    *Value
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
+  EFI_STATUS   Status;
+  CONFIG_TREE *Node = NULL;
+#if defined(PROJECT_DEBUG)
+  CHAR16      *Segments[3];
+  UINT64       Start;
+#endif
   // Check parameters
-  if ((Path == NULL) || (DefaultValue == NULL) || (Type == NULL) || (Value == NULL)) {
+  if ((Iterator == NULL) || (Iterator->Name == NULL) || (Type == NULL) || (Value == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  if (Iterator->Snapshot != NULL) {
+    // Find relative to the current record
+    CONFIG_SNAPSHOT_HEADER *Header = (CONFIG_SNAPSHOT_HEADER *)Iterator->Snapshot;
+    CONFIG_SNAPSHOT_NODE   *Nodes = (CONFIG_SNAPSHOT_NODE *)(((UINT8 *)Header) + Header->Nodes);
+    CONFIG_SNAPSHOT_NODE   *Record = ConfigSnapshotFind(Header, (UINT32)(((CONFIG_SNAPSHOT_NODE *)Iterator->Node) - Nodes), Path);
+    if (Record == NULL) {
+      return EFI_NOT_FOUND;
+    }
+    ConfigSnapshotRecordValue(Header, Record, Type, Value);
+    return EFI_SUCCESS;
   }
-  // Get the value
-  Status = ConfigGetValueWithDefault(FullPath, DefaultType, DefaultValue, Type, Value);
-  FreePool(FullPath);
-  return Status;
+  if (Iterator->List != NULL) {
+    CHAR16 *FullPath;
+    // Create the full path for the configuration protocol
+    if (Path == NULL) {
+      *Type = Iterator->Type;
+      CopyMem(Value, &(Iterator->Value), sizeof(CONFIG_VALUE));
+      return (Iterator->Type == CONFIG_TYPE_UNKNOWN) ? EFI_NOT_FOUND : EFI_SUCCESS;
+    }
+    FullPath = CatSPrint(NULL, L"%s\\%s\\%s", (Iterator->Path == NULL) ? L"" : Iterator->Path, Iterator->Name, Path);
+    if (FullPath == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Status = ConfigGetValue(FullPath, Type, Value);
+    FreePool(FullPath);
+    return Status;
+  }
+  if (Iterator->Node == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (Iterator->Generation != mConfigGeneration) {
+    return EFI_ABORTED;
+  }
+  // Find relative to the current child node
+#if defined(PROJECT_DEBUG)
+  Start = GetPerformanceCounter();
+#endif
+  Status = ConfigFindChild((CONFIG_TREE *)Iterator->Node, Path, FALSE, &Node);
+  if (!EFI_ERROR(Status) && (Node == NULL)) {
+    Status = EFI_NOT_FOUND;
+  }
+#if defined(PROJECT_DEBUG)
+  // Record the lookup of the full path below the enumerated path
+  Segments[0] = Iterator->Path;
+  Segments[1] = Iterator->Name;
+  Segments[2] = Path;
+  ConfigStatRecord(Segments, ARRAY_SIZE(Segments), Status, 0, GetPerformanceCounter() - Start);
+#endif
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  ConfigTreeGetValue(Node, Type, Value);
+  return EFI_SUCCESS;
 }
-
-// ConfigGetBooleanWithDefault
-/// Get a boolean configuration value with default
-/// @param Path           The path of the configuration value
+// ConfigIteratorGetBooleanWithDefault
+/// Get a boolean configuration value relative to the current child of a configuration child enumeration with default
+/// @param Iterator       The configuration child enumeration
+/// @param Path           The path relative to the current child or NULL for the current child
 /// @param DefaultBoolean The default boolean configuration value
 /// @return The boolean configuration value
 BOOLEAN
 EFIAPI
-ConfigGetBooleanWithDefault (
-  IN CHAR16  *Path,
-  IN BOOLEAN  DefaultBoolean
+ConfigIteratorGetBooleanWithDefault (
+  IN CONFIG_ITERATOR *Iterator,
+  IN CHAR16          *Path OPTIONAL,
+  IN BOOLEAN          DefaultBoolean
 ) {
   CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
   CONFIG_VALUE Value;
-  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_BOOLEAN)) {
+  if (EFI_ERROR(ConfigIteratorGetValue(Iterator, Path, &Type, &Value)) || (Type != CONFIG_TYPE_BOOLEAN)) {
     return DefaultBoolean;
   }
   return Value.Boolean;
 }
-// ConfigSGetBooleanWithDefault
-/// Get a boolean configuration value with default
-/// @param Path           The path of the configuration value
-/// @param DefaultBoolean The default boolean configuration value
-/// @param ...            The argument list
-/// @return The boolean configuration value
-BOOLEAN
-EFIAPI
-ConfigSGetBooleanWithDefault (
-  IN CHAR16  *Path,
-  IN BOOLEAN  DefaultBoolean,
-  IN ...
-) {
-  BOOLEAN Result;
-  VA_LIST Args;
-  VA_START(Args, DefaultBoolean);
-  Result = ConfigVSGetBooleanWithDefault(Path, DefaultBoolean, Args);
-  VA_END(Args);
-  return Result;
-}
-// ConfigVSGetBooleanWithDefault
-/// Get a boolean configuration value with default
-/// @param Path           The path of the configuration value
-/// @param DefaultBoolean The default boolean configuration value
-/// @param Args           The argument list
-/// @return The boolean configuration value
-BOOLEAN
-EFIAPI
-ConfigVSGetBooleanWithDefault (
-  IN CHAR16  *Path,
-  IN BOOLEAN  DefaultBoolean,
-  IN VA_LIST  Args
-) {
-  BOOLEAN  Result;
-  CHAR16  *FullPath;
-  // Check parameters
-  if (Path == NULL) {
-    return DefaultBoolean;
-  }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return DefaultBoolean;
-  }
-  // Get the value
-  Result = ConfigGetBooleanWithDefault(FullPath, DefaultBoolean);
-  FreePool(FullPath);
-  return Result;
-}
-
-// ConfigGetIntegerWithDefault
-/// Get an integer configuration value with default
-/// @param Path           The path of the configuration value
+// ConfigIteratorGetIntegerWithDefault
+/// Get an integer configuration value relative to the current child of a configuration child enumeration with default
+/// @param Iterator       The configuration child enumeration
+/// @param Path           The path relative to the current child or NULL for the current child
 /// @param DefaultInteger The default integer configuration value
 /// @return The integer configuration value
 INTN
 EFIAPI
-ConfigGetIntegerWithDefault (
-  IN CHAR16 *Path,
-  IN INTN    DefaultInteger
+ConfigIteratorGetIntegerWithDefault (
+  IN CONFIG_ITERATOR *Iterator,
+  IN CHAR16          *Path OPTIONAL,
+  IN INTN             DefaultInteger
 ) {
   CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
   CONFIG_VALUE Value;
-  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_INTEGER)) {
+  if (EFI_ERROR(ConfigIteratorGetValue(Iterator, Path, &Type, &Value)) || (Type != CONFIG_TYPE_INTEGER)) {
     return DefaultInteger;
   }
   return Value.Integer;
 }
-// ConfigSGetIntegerWithDefault
-/// Get an integer configuration value with default
-/// @param Path           The path of the configuration value
-/// @param DefaultInteger The default integer configuration value
-/// @param ...            The argument list
-/// @return The integer configuration value
-INTN
-EFIAPI
-ConfigSGetIntegerWithDefault (
-  IN CHAR16 *Path,
-  IN INTN    DefaultInteger,
-  IN ...
-) {
-  INTN    Result;
-  VA_LIST Args;
-  VA_START(Args, DefaultInteger);
-  Result = ConfigVSGetIntegerWithDefault(Path, DefaultInteger, Args);
-  VA_END(Args);
-  return Result;
-}
-// ConfigVSGetIntegerWithDefault
-/// Get an integer configuration value with default
-/// @param Path           The path of the configuration value
-/// @param DefaultInteger The default integer configuration value
-/// @param Args           The argument list
-/// @return The integer configuration value
-INTN
-EFIAPI
-ConfigVSGetIntegerWithDefault (
-  IN CHAR16  *Path,
-  IN INTN     DefaultInteger,
-  IN VA_LIST  Args
-) {
-  INTN    Result;
-  CHAR16 *FullPath;
-  // Check parameters
-  if (Path == NULL) {
-    return DefaultInteger;
-  }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return DefaultInteger;
-  }
-  // Get the value
-  Result = ConfigGetIntegerWithDefault(FullPath, DefaultInteger);
-  FreePool(FullPath);
-  return Result;
-}
-
-// ConfigGetUnsignedWithDefault
-/// Get an unsigned integer configuration value with default
-/// @param Path           The path of the configuration value
-/// @param DefaulUnsigned The default unsigned configuration value
+// ConfigIteratorGetUnsignedWithDefault
+/// Get an unsigned integer configuration value relative to the current child of a configuration child enumeration with default
+/// @param Iterator        The configuration child enumeration
+/// @param Path            The path relative to the current child or NULL for the current child
+/// @param DefaultUnsigned The default unsigned integer configuration value
 /// @return The unsigned integer configuration value
 UINTN
 EFIAPI
-ConfigGetUnsignedWithDefault (
-  IN CHAR16 *Path,
-  IN UINTN   DefaultUnsigned
+ConfigIteratorGetUnsignedWithDefault (
+  IN CONFIG_ITERATOR *Iterator,
+  IN CHAR16          *Path OPTIONAL,
+  IN UINTN            DefaultUnsigned
 ) {
   CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
   CONFIG_VALUE Value;
-  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_UNSIGNED)) {
+  if (EFI_ERROR(ConfigIteratorGetValue(Iterator, Path, &Type, &Value)) || (Type != CONFIG_TYPE_UNSIGNED)) {
     return DefaultUnsigned;
   }
   return Value.Unsigned;
 }
-// ConfigSGetUnsignedWithDefault
-/// Get an unsigned integer configuration value with default
-/// @param Path           The path of the configuration value
-/// @param DefaulUnsigned The default unsigned configuration value
-/// @param ...            The argument list
-/// @return The unsigned integer configuration value
-UINTN
-EFIAPI
-ConfigSGetUnsignedWithDefault (
-  IN CHAR16 *Path,
-  IN UINTN   DefaultUnsigned,
-  IN ...
-) {
-  UINTN   Result;
-  VA_LIST Args;
-  VA_START(Args, DefaultUnsigned);
-  Result = ConfigVSGetUnsignedWithDefault(Path, DefaultUnsigned, Args);
-  VA_END(Args);
-  return Result;
-}
-// ConfigVSGetUnsignedWithDefault
-/// Get an unsigned integer configuration value with default
-/// @param Path           The path of the configuration value
-/// @param DefaulUnsigned The default unsigned configuration value
-/// @param Args           The argument list
-/// @return The unsigned integer configuration value
-UINTN
-EFIAPI
-ConfigVSGetUnsignedWithDefault (
-  IN CHAR16  *Path,
-  IN UINTN    DefaultUnsigned,
-  IN VA_LIST  Args
-) {
-  UINTN   Result;
-  CHAR16 *FullPath;
-  // Check parameters
-  if (Path == NULL) {
-    return DefaultUnsigned;
-  }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return DefaultUnsigned;
-  }
-  // Get the value
-  Result = ConfigGetUnsignedWithDefault(FullPath, DefaultUnsigned);
-  FreePool(FullPath);
-  return Result;
-}
-
-// ConfigGetStringWithDefault
-/// Get a string configuration value with default
-/// @param Path          The path of the configuration value
+// ConfigIteratorGetStringWithDefault
+/// Get a string configuration value relative to the current child of a configuration child enumeration with default
+/// @param Iterator      The configuration child enumeration
+/// @param Path          The path relative to the current child or NULL for the current child
 /// @param DefaultString The default string configuration value
 /// @return The string configuration value
 CHAR16 *
 EFIAPI
-ConfigGetStringWithDefault (
-  IN CHAR16 *Path,
-  IN CHAR16 *DefaultString
+ConfigIteratorGetStringWithDefault (
+  IN CONFIG_ITERATOR *Iterator,
+  IN CHAR16          *Path OPTIONAL,
+  IN CHAR16          *DefaultString
 ) {
   CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
   CONFIG_VALUE Value;
-  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_STRING)) {
+  if (EFI_ERROR(ConfigIteratorGetValue(Iterator, Path, &Type, &Value)) || (Type != CONFIG_TYPE_STRING)) {
     return DefaultString;
   }
   return Value.String;
 }
-// ConfigSGetStringWithDefault
-/// Get a string configuration value with default
-/// @param Path          The path of the configuration value
-/// @param DefaultString The default string configuration value
-/// @param ...           The argument list
-/// @return The string configuration value
-CHAR16 *
+
+// ConfigExport
+/// Export the descendants of a configuration path so they can be stored and imported on another boot
+/// @param Path   The configuration path to export or NULL for root
+/// @param Size   On output, the size, in bytes, of the exported configuration
+/// @param Buffer On output, the exported configuration, which must be freed
+/// @return Whether the configuration was exported or not
+/// @retval EFI_INVALID_PARAMETER If Size or Buffer is NULL or *Buffer is not NULL
+/// @retval EFI_UNSUPPORTED       If the configuration tree belongs to another image or is too large
+/// @retval EFI_NOT_FOUND         If the configuration path was not found or is not a list
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration was exported successfully
+EFI_STATUS
 EFIAPI
-ConfigSGetStringWithDefault (
-  IN CHAR16 *Path,
-  IN CHAR16 *DefaultString,
-  IN ...
+ConfigExport (
+  IN  CHAR16  *Path OPTIONAL,
+  OUT UINTN   *Size,
+  OUT VOID   **Buffer
 ) {
-  CHAR16  *Result;
-  VA_LIST  Args;
-  VA_START(Args, DefaultString);
-  Result = ConfigVSGetStringWithDefault(Path, DefaultString, Args);
-  VA_END(Args);
-  return Result;
+  EFI_STATUS           Status;
+  CONFIG_TREE         *Node = NULL;
+  CONFIG_CACHE_HEADER *Header;
+  UINTN                Offset = sizeof(CONFIG_CACHE_HEADER);
+  UINT32               Count = 0;
+  // Check parameters
+  if ((Size == NULL) || (Buffer == NULL) || (*Buffer != NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (mConfig != NULL) {
+    return EFI_UNSUPPORTED;
+  }
+  // Get configuration tree node
+  Status = ConfigFind(Path, FALSE, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if ((Node == NULL) || (Node->Type != CONFIG_TYPE_LIST)) {
+    return EFI_NOT_FOUND;
+  }
+  // Measure and write the node records in the compiled configuration cache format
+  ConfigCacheWriteNodes(Node, 0, NULL, &Offset, &Count);
+  if (Offset > MAX_UINT32) {
+    return EFI_UNSUPPORTED;
+  }
+  Header = (CONFIG_CACHE_HEADER *)AllocateZeroPool(Offset);
+  if (Header == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Header->Signature = CONFIG_CACHE_SIGNATURE;
+  Header->Version = CONFIG_CACHE_VERSION;
+  Header->NodeCount = Count;
+  Header->Size = (UINT32)Offset;
+  Offset = sizeof(CONFIG_CACHE_HEADER);
+  Count = 0;
+  ConfigCacheWriteNodes(Node, 0, (UINT8 *)Header, &Offset, &Count);
+  *Size = Header->Size;
+  *Buffer = Header;
+  return EFI_SUCCESS;
 }
-// ConfigVSGetStringWithDefault
-/// Get a string configuration value with default
-/// @param Path          The path of the configuration value
-/// @param DefaultString The default string configuration value
-/// @param Args          The argument list
-/// @return The string configuration value
-CHAR16 *
+// ConfigImport
+/// Import exported configuration, replacing the descendants of a configuration path
+/// @param Path   The configuration path to replace or NULL for root
+/// @param Size   The size, in bytes, of the exported configuration
+/// @param Buffer The exported configuration
+/// @return Whether the configuration was imported or not, the configuration path is left unchanged on error
+/// @retval EFI_INVALID_PARAMETER    If Buffer is NULL
+/// @retval EFI_UNSUPPORTED          If the configuration tree belongs to another image
+/// @retval EFI_NOT_READY            If a configuration transaction is open
+/// @retval EFI_ACCESS_DENIED        If the configuration path could not be replaced with a list
+/// @retval EFI_INCOMPATIBLE_VERSION If the exported configuration is for another version
+/// @retval EFI_VOLUME_CORRUPTED     If the exported configuration is malformed
+/// @retval EFI_OUT_OF_RESOURCES     If memory could not be allocated
+/// @retval EFI_SUCCESS              If the configuration was imported successfully
+EFI_STATUS
 EFIAPI
-ConfigVSGetStringWithDefault (
-  IN CHAR16  *Path,
-  IN CHAR16  *DefaultString,
-  IN VA_LIST  Args
+ConfigImport (
+  IN CHAR16 *Path OPTIONAL,
+  IN UINTN   Size,
+  IN VOID   *Buffer
 ) {
-  CHAR16 *Result;
-  CHAR16 *FullPath;
+  EFI_STATUS           Status;
+  CONFIG_TREE         *Node = NULL;
+  CONFIG_TREE         *Detached;
+  CONFIG_TREE         *Child;
+  CONFIG_CACHE_HEADER *Header = (CONFIG_CACHE_HEADER *)Buffer;
   // Check parameters
-  if (Path == NULL) {
-    return DefaultString;
+  if (Buffer == NULL) {
+    return EFI_INVALID_PARAMETER;
   }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return DefaultString;
+  if (mConfig != NULL) {
+    return EFI_UNSUPPORTED;
   }
-  // Get the value
-  Result = ConfigGetStringWithDefault(FullPath, DefaultString);
-  FreePool(FullPath);
-  return Result;
+  // Replacing a subtree cannot be staged, so wait for the transaction to end
+  if (mConfigTransaction.Depth != 0) {
+    return EFI_NOT_READY;
+  }
+  // Check the header
+  if ((Size < sizeof(CONFIG_CACHE_HEADER)) || (Header->Signature != CONFIG_CACHE_SIGNATURE) ||
+      (Header->Version != CONFIG_CACHE_VERSION)) {
+    return EFI_INCOMPATIBLE_VERSION;
+  }
+  if ((Header->Size != Size) || (Header->SourceCount != 0) || (Header->Key != 0)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+  // Build the node records below a detached list so a malformed export leaves the existing values in place
+  Detached = ConfigNodeAllocate();
+  if (Detached == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Detached->Type = CONFIG_TYPE_LIST;
+  Status = ConfigCacheParseNodes(Detached, Size, (UINT8 *)Buffer, sizeof(CONFIG_CACHE_HEADER), Header->NodeCount);
+  if (!EFI_ERROR(Status)) {
+    // Include files bound within the subtree would only be replaced
+    ConfigIncludeDrop(Path);
+    Status = ConfigFind(Path, TRUE, &Node);
+    if (!EFI_ERROR(Status) && (Node == NULL)) {
+      Status = EFI_ACCESS_DENIED;
+    }
+  }
+  if (EFI_ERROR(Status)) {
+    ConfigTreeFree(Detached);
+    return Status;
+  }
+  // Free the previous value or descendants of the configuration path
+  if (mConfigSubscriptions != NULL) {
+    ConfigNotifyMark(Node, TRUE);
+  }
+  ++mConfigGeneration;
+  while (Node->Children != NULL) {
+    Child = Node->Children;
+    Node->Children = Child->Next;
+    ConfigTreeFree(Child);
+  }
+  ConfigTreeFreeValue(Node);
+  Node->Type = CONFIG_TYPE_LIST;
+  // Move the imported nodes below the configuration path
+  ConfigIndexMove(Node, Detached);
+  ConfigNodeRelease(Detached);
+  ConfigSnapshotRetire();
+  // Notify subscriptions to any of the imported values
+  if (mConfigSubscriptions != NULL) {
+    ConfigNotifyMark(Node, FALSE);
+    ConfigNotifyPending();
+  }
+  return EFI_SUCCESS;
 }
 
-// ConfigGetDataWithDefault
-/// Get a data configuration value with default
-/// @param Path        The path of the configuration value
-/// @param DefaultSize The default data configuration value size
-/// @param DefaultData The default data configuration value
-/// @param Size        On output, the data configuration value size
-/// @return The data configuration value
-VOID *
+// ConfigKeyResolve
+/// Resolve the configuration tree node of a configuration key
+/// @param Key The configuration key
+/// @return The configuration tree node or NULL if the configuration path was not found
+STATIC CONFIG_TREE *
 EFIAPI
-ConfigGetDataWithDefault (
-  IN  CHAR16 *Path,
-  IN  UINTN   DefaultSize,
-  IN  VOID   *DefaultData,
-  OUT UINTN  *Size
+ConfigKeyResolve (
+  IN CONFIG_KEY *Key
 ) {
-  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
-  CONFIG_VALUE Value;
-  if (EFI_ERROR(ConfigGetValue(Path, &Type, &Value)) || (Type != CONFIG_TYPE_DATA)) {
-    *Size = DefaultSize;
-    return DefaultData;
+  // Resolve again if never resolved or configuration tree nodes were freed since
+  if ((Key->Node == NULL) || (Key->Generation != mConfigGeneration)) {
+    Key->Node = NULL;
+    Key->Generation = mConfigGeneration;
+    if (EFI_ERROR(ConfigFind(Key->Path, FALSE, &(Key->Node)))) {
+      Key->Node = NULL;
+    }
   }
-  *Size = Value.Data.Size;
-  return Value.Data.Data;
+  return Key->Node;
 }
-// ConfigSGetDataWithDefault
-/// Get a data configuration value with default
-/// @param Path        The path of the configuration value
-/// @param DefaultSize The default data configuration value size
-/// @param DefaultData The default data configuration value
-/// @param Size        On output, the data configuration value size
-/// @param ...         The argument list
-/// @return The data configuration value
-VOID *
+
+// ConfigKeyOpen
+/// Open a configuration key handle for a configuration path
+/// @param Path The path of the configuration value
+/// @param Key  On output, the configuration key handle, which must be closed with ConfigKeyClose
+/// @return Whether the configuration key handle was opened or not
+/// @retval EFI_INVALID_PARAMETER If Path or Key is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration key handle was opened successfully, the path does not need to exist yet
+EFI_STATUS
 EFIAPI
-ConfigSGetDataWithDefault (
-  IN  CHAR16 *Path,
-  IN  UINTN   DefaultSize,
-  IN  VOID   *DefaultData,
-  OUT UINTN  *Size,
+ConfigKeyOpen (
+  IN  CHAR16      *Path,
+  OUT CONFIG_KEY **Key
+) {
+  CONFIG_KEY *NewKey;
+  // Check parameters
+  if ((Path == NULL) || (Key == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Allocate the key
+  NewKey = (CONFIG_KEY *)AllocateZeroPool(sizeof(CONFIG_KEY));
+  if (NewKey == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  NewKey->Path = StrDup(Path);
+  if (NewKey->Path == NULL) {
+    FreePool(NewKey);
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Resolve the key now if possible, otherwise on first use
+  NewKey->Node = NULL;
+  if (mConfig == NULL) {
+    ConfigKeyResolve(NewKey);
+  }
+  *Key = NewKey;
+  return EFI_SUCCESS;
+}
+// ConfigSKeyOpen
+/// Open a configuration key handle for a configuration path
+/// @param Path The path of the configuration value
+/// @param Key  On output, the configuration key handle, which must be closed with ConfigKeyClose
+/// @param ...  The argument list
+/// @return Whether the configuration key handle was opened or not
+/// @retval EFI_INVALID_PARAMETER If Path or Key is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration key handle was opened successfully, the path does not need to exist yet
+EFI_STATUS
+EFIAPI
+ConfigSKeyOpen (
+  IN  CHAR16      *Path,
+  OUT CONFIG_KEY **Key,
   IN  ...
 ) {
-  VOID    *Result;
-  VA_LIST  Args;
-  VA_START(Args, Size);
-  Result = ConfigVSGetDataWithDefault(Path, DefaultSize, DefaultData, Size, Args);
+  EFI_STATUS Status;
+  VA_LIST    Args;
+  VA_START(Args, Key);
+  Status = ConfigVSKeyOpen(Path, Key, Args);
   VA_END(Args);
-  return Result;
+  return Status;
 }
-// ConfigVSGetDataWithDefault
-/// Get a data configuration value with default
-/// @param Path        The path of the configuration value
-/// @param DefaultSize The default data configuration value size
-/// @param DefaultData The default data configuration value
-/// @param Size        On output, the data configuration value size
-/// @param Args        The argument list
-/// @return The data configuration value
-VOID *
+// ConfigVSKeyOpen
+/// Open a configuration key handle for a configuration path
+/// @param Path The path of the configuration value
+/// @param Key  On output, the configuration key handle, which must be closed with ConfigKeyClose
+/// @param Args The argument list
+/// @return Whether the configuration key handle was opened or not
+/// @retval EFI_INVALID_PARAMETER If Path or Key is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration key handle was opened successfully, the path does not need to exist yet
+EFI_STATUS
 EFIAPI
-ConfigVSGetDataWithDefault (
-  IN  CHAR16  *Path,
-  IN  UINTN    DefaultSize,
-  IN  VOID    *DefaultData,
-  OUT UINTN   *Size,
-  IN  VA_LIST  Args
+ConfigVSKeyOpen (
+  IN  CHAR16      *Path,
+  OUT CONFIG_KEY **Key,
+  IN  VA_LIST      Args
 ) {
-  VOID   *Result;
-  CHAR16 *FullPath;
+  EFI_STATUS  Status;
+  CHAR16     *FullPath;
   // Check parameters
-  if ((Path == NULL) || (Size == NULL)) {
-    *Size = DefaultSize;
-    return DefaultData;
+  if ((Path == NULL) || (Key == NULL)) {
+    return EFI_INVALID_PARAMETER;
   }
   // Create the path from the argument list
   FullPath = CatVSPrint(NULL, Path, Args);
   if (FullPath == NULL) {
-    *Size = DefaultSize;
-    return DefaultData;
+    return EFI_OUT_OF_RESOURCES;
   }
-  // Get the value
-  Result = ConfigGetDataWithDefault(FullPath, DefaultSize, DefaultData, Size);
+  // Open the key
+  Status = ConfigKeyOpen(FullPath, Key);
   FreePool(FullPath);
-  return Result;
+  return Status;
 }
-
-// ConfigSetValue
-/// Set a configuration value
-/// @param Path  The path of the configuration value
-/// @param Type  The configuration type to set
-/// @param Value The configuration value to set
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path or Value is NULL or Type is invalid
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
+// ConfigKeyClose
+/// Close a configuration key handle
+/// @param Key The configuration key handle to close
+/// @return Whether the configuration key handle was closed or not
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_SUCCESS           If the configuration key handle was closed successfully
 EFI_STATUS
 EFIAPI
-ConfigSetValue (
-  IN CHAR16       *Path,
-  IN CONFIG_TYPE   Type,
-  IN CONFIG_VALUE *Value
+ConfigKeyClose (
+  IN CONFIG_KEY *Key
 ) {
-  EFI_STATUS   Status;
-  CONFIG_TREE *Node = NULL;
   // Check parameters
-  if ((Path == NULL) || (Value == NULL)) {
+  if (Key == NULL) {
     return EFI_INVALID_PARAMETER;
   }
-  switch (Type) {
-    case CONFIG_TYPE_BOOLEAN:
-    case CONFIG_TYPE_INTEGER:
-    case CONFIG_TYPE_UNSIGNED:
-      break;
-
-    case CONFIG_TYPE_STRING:
-      if (Value->String != NULL) {
-        break;
-      } else
-
-    case CONFIG_TYPE_DATA:
-      if ((Value->Data.Data != NULL) && (Value->Data.Size != 0)) {
-        break;
-      }
+  if (Key->Path != NULL) {
+    FreePool(Key->Path);
+    Key->Path = NULL;
+  }
+  Key->Node = NULL;
+  FreePool(Key);
+  return EFI_SUCCESS;
+}
 
-    default:
-      return EFI_INVALID_PARAMETER;
+// ConfigKeyGetValue
+/// Get a configuration value with a configuration key handle
+/// @param Key   The configuration key handle
+/// @param Type  On output, the type of the configuration value
+/// @param Value On output, the value of the configuration value
+/// @return Whether the configuration value was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Key, Type, or Value is NULL
+/// @retval EFI_NOT_FOUND         If the configuration value was not found
+/// @retval EFI_SUCCESS           If the configuration value was retrieved successfully
+EFI_STATUS
+EFIAPI
+ConfigKeyGetValue (
+  IN  CONFIG_KEY   *Key,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value
+) {
+  CONFIG_TREE *Node;
+  // Check parameters
+  if ((Key == NULL) || (Type == NULL) || (Value == NULL)) {
+    return EFI_INVALID_PARAMETER;
   }
-  // Use configuration protocol if present
-  if ((mConfig != NULL) && (mConfig->SetValue != NULL)) {
-    return mConfig->SetValue(Path, Type, Value);
+  // The configuration tree belongs to another image so use the path
+  if (mConfig != NULL) {
+    return ConfigGetValue(Key->Path, Type, Value);
   }
-  // Get configuration tree node
-  Status = ConfigFind(Path, TRUE, &Node);
-  if (EFI_ERROR(Status)) {
-    return Status;
+  // Values staged by an open transaction are newer than the configuration tree
+  if (ConfigStageGetValue(&(Key->Path), 1, Type, Value)) {
+    return EFI_SUCCESS;
   }
+  // Get the resolved configuration tree node
+  Node = ConfigKeyResolve(Key);
   if (Node == NULL) {
     return EFI_NOT_FOUND;
   }
-  if (Node->Children != NULL) {
-    return EFI_ACCESS_DENIED;
+  // Return type and value
+  ConfigTreeGetValue(Node, Type, Value);
+  return EFI_SUCCESS;
+}
+// ConfigKeyGetBooleanWithDefault
+/// Get a boolean configuration value with default with a configuration key handle
+/// @param Key            The configuration key handle
+/// @param DefaultBoolean The default boolean configuration value
+/// @return The boolean configuration value
+BOOLEAN
+EFIAPI
+ConfigKeyGetBooleanWithDefault (
+  IN CONFIG_KEY *Key,
+  IN BOOLEAN     DefaultBoolean
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigKeyGetValue(Key, &Type, &Value)) || (Type != CONFIG_TYPE_BOOLEAN)) {
+    return DefaultBoolean;
   }
-  // Set type and value
-  Node->Type = Type;
-  if (Type == CONFIG_TYPE_STRING) {
-    // Duplicate string type
-    Node->Value.String = StrDup(Value->String);
-    if (Node->Value.String == NULL) {
-      return EFI_OUT_OF_RESOURCES;
-    }
-  } else if (Type == CONFIG_TYPE_DATA) {
-    // Duplicate data type
-    Node->Value.Data.Size = Value->Data.Size;
-    Node->Value.Data.Data = AllocateZeroPool(Value->Data.Size);
-    if (Node->Value.Data.Data == NULL) {
-      return EFI_OUT_OF_RESOURCES;
-    }
-    CopyMem(Node->Value.Data.Data, Value->Data.Data, Value->Data.Size);
-  } else {
-    // Copy all other types
-    CopyMem(&(Node->Value), Value, sizeof(CONFIG_VALUE));
+  return Value.Boolean;
+}
+// ConfigKeyGetIntegerWithDefault
+/// Get an integer configuration value with default with a configuration key handle
+/// @param Key            The configuration key handle
+/// @param DefaultInteger The default integer configuration value
+/// @return The integer configuration value
+INTN
+EFIAPI
+ConfigKeyGetIntegerWithDefault (
+  IN CONFIG_KEY *Key,
+  IN INTN        DefaultInteger
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigKeyGetValue(Key, &Type, &Value)) || (Type != CONFIG_TYPE_INTEGER)) {
+    return DefaultInteger;
   }
-  return EFI_SUCCESS;
+  return Value.Integer;
 }
-// ConfigSSetValue
-/// Set a configuration value
-/// @param Path  The path of the configuration value
-/// @param Type  The configuration type to set
-/// @param Value The configuration value to set
-/// @param ...   The argument list
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path or Value is NULL or Type is invalid
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
-EFI_STATUS
+// ConfigKeyGetUnsignedWithDefault
+/// Get an unsigned integer configuration value with default with a configuration key handle
+/// @param Key             The configuration key handle
+/// @param DefaultUnsigned The default unsigned configuration value
+/// @return The unsigned integer configuration value
+UINTN
+EFIAPI
+ConfigKeyGetUnsignedWithDefault (
+  IN CONFIG_KEY *Key,
+  IN UINTN       DefaultUnsigned
+) {
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigKeyGetValue(Key, &Type, &Value)) || (Type != CONFIG_TYPE_UNSIGNED)) {
+    return DefaultUnsigned;
+  }
+  return Value.Unsigned;
+}
+// ConfigKeyGetStringWithDefault
+/// Get a string configuration value with default with a configuration key handle
+/// @param Key           The configuration key handle
+/// @param DefaultString The default string configuration value
+/// @return The string configuration value
+CHAR16 *
 EFIAPI
-ConfigSSetValue (
-  IN CHAR16       *Path,
-  IN CONFIG_TYPE   Type,
-  IN CONFIG_VALUE *Value,
-  IN ...
+ConfigKeyGetStringWithDefault (
+  IN CONFIG_KEY *Key,
+  IN CHAR16     *DefaultString
 ) {
-  EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, Value);
-  Status = ConfigVSSetValue(Path, Type, Value, Args);
-  VA_END(Args);
-  return Status;
+  CONFIG_TYPE  Type = CONFIG_TYPE_UNKNOWN;
+  CONFIG_VALUE Value;
+  if (EFI_ERROR(ConfigKeyGetValue(Key, &Type, &Value)) || (Type != CONFIG_TYPE_STRING)) {
+    return DefaultString;
+  }
+  return Value.String;
 }
-// ConfigVSSetValue
-/// Set a configuration value
-/// @param Path  The path of the configuration value
+
+// ConfigKeySetValue
+/// Set a configuration value with a configuration key handle
+/// @param Key   The configuration key handle
 /// @param Type  The configuration type to set
 /// @param Value The configuration value to set
-/// @param Args  The argument list
 /// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path or Value is NULL or Type is invalid
+/// @retval EFI_INVALID_PARAMETER If Key or Value is NULL or Type is invalid
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
 /// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigVSSetValue (
-  IN CHAR16       *Path,
+ConfigKeySetValue (
+  IN CONFIG_KEY   *Key,
   IN CONFIG_TYPE   Type,
-  IN CONFIG_VALUE *Value,
-  IN VA_LIST       Args
+  IN CONFIG_VALUE *Value
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
+  CONFIG_TREE *Node;
   // Check parameters
-  if ((Path == NULL) || (Value == NULL)) {
+  if ((Key == NULL) || !ConfigValueIsValid(Type, Value)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  // Create the configuration value by path if the key is not resolved or a transaction is open
+  Node = ((mConfig == NULL) && (mConfigTransaction.Depth == 0)) ? ConfigKeyResolve(Key) : NULL;
+  if (Node == NULL) {
+    return ConfigSetValue(Key->Path, Type, Value);
   }
-  // Set the value
-  Status = ConfigSetValue(FullPath, Type, Value);
-  FreePool(FullPath);
-  return Status;
+  // Set type and value
+  return ConfigTreeSetValue(Node, Type, Value, FALSE);
 }
-
-// ConfigSetBoolean
-/// Set a boolean configuration value
-/// @param Path    The path of the configuration value
+// ConfigKeySetBoolean
+/// Set a boolean configuration value with a configuration key handle
+/// @param Key     The configuration key handle
 /// @param Boolean The boolean configuration value to set
 /// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
 /// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
 /// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSetBoolean (
-  IN CHAR16  *Path,
-  IN BOOLEAN  Boolean
+ConfigKeySetBoolean (
+  IN CONFIG_KEY *Key,
+  IN BOOLEAN     Boolean
 ) {
   CONFIG_VALUE Value;
   Value.Boolean = Boolean;
-  return ConfigSetValue(Path, CONFIG_TYPE_BOOLEAN, &Value);
+  return ConfigKeySetValue(Key, CONFIG_TYPE_BOOLEAN, &Value);
 }
-// ConfigSSetBoolean
-/// Set a boolean configuration value
-/// @param Path    The path of the configuration value
-/// @param Boolean The boolean configuration value to set
-/// @param ...     The argument list
+// ConfigKeySetInteger
+/// Set an integer configuration value with a configuration key handle
+/// @param Key     The configuration key handle
+/// @param Integer The integer configuration value to set
 /// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
 /// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
 /// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSSetBoolean (
-  IN CHAR16  *Path,
-  IN BOOLEAN  Boolean,
-  IN ...
+ConfigKeySetInteger (
+  IN CONFIG_KEY *Key,
+  IN INTN        Integer
 ) {
-  EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, Boolean);
-  Status = ConfigVSSetBoolean(Path, Boolean, Args);
-  VA_END(Args);
-  return Status;
+  CONFIG_VALUE Value;
+  Value.Integer = Integer;
+  return ConfigKeySetValue(Key, CONFIG_TYPE_INTEGER, &Value);
 }
-// ConfigVSSetBoolean
-/// Set a boolean configuration value
-/// @param Path    The path of the configuration value
-/// @param Boolean The boolean configuration value to set
-/// @param Args    The argument list
+// ConfigKeySetUnsigned
+/// Set an unsigned integer configuration value with a configuration key handle
+/// @param Key      The configuration key handle
+/// @param Unsigned The unsigned integer configuration value to set
 /// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_INVALID_PARAMETER If Key is NULL
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
 /// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
 /// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigVSSetBoolean (
-  IN CHAR16  *Path,
-  IN BOOLEAN  Boolean,
-  IN VA_LIST  Args
+ConfigKeySetUnsigned (
+  IN CONFIG_KEY *Key,
+  IN UINTN       Unsigned
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
-  // Check parameters
-  if (Path == NULL) {
-    return EFI_INVALID_PARAMETER;
-  }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-  // Set the value
-  Status = ConfigSetBoolean(FullPath, Boolean);
-  FreePool(FullPath);
-  return Status;
+  CONFIG_VALUE Value;
+  Value.Unsigned = Unsigned;
+  return ConfigKeySetValue(Key, CONFIG_TYPE_UNSIGNED, &Value);
 }
-
-// ConfigSetInteger
-/// Set an integer configuration value
-/// @param Path    The path of the configuration value
-/// @param Integer The integer configuration value to set
+// ConfigKeySetString
+/// Set a string configuration value with a configuration key handle
+/// @param Key    The configuration key handle
+/// @param String The string configuration value to set
 /// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_INVALID_PARAMETER If Key or String is NULL
+/// @retval EFI_ACCESS_DENIED     If the configuration value has children
 /// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
 /// @retval EFI_SUCCESS           If the configuration value was set successfully
 EFI_STATUS
 EFIAPI
-ConfigSetInteger (
-  IN CHAR16 *Path,
-  IN INTN    Integer
+ConfigKeySetString (
+  IN CONFIG_KEY *Key,
+  IN CHAR16     *String
 ) {
   CONFIG_VALUE Value;
-  Value.Integer = Integer;
-  return ConfigSetValue(Path, CONFIG_TYPE_INTEGER, &Value);
+  Value.String = String;
+  return ConfigKeySetValue(Key, CONFIG_TYPE_STRING, &Value);
 }
-// ConfigSSetInteger
-/// Set an integer configuration value
-/// @param Path    The path of the configuration value
-/// @param Integer The integer configuration value to set
-/// @param ...     The argument list
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
-EFI_STATUS
+
+// ConfigProtocolGetList
+/// Get a list of names for the children of the configuration path for another image
+/// @param Path  The configuration path of which to get child names or NULL for root
+/// @param List  On output, the string list of names of children
+/// @param Count On output, the count of strings in the list
+/// @return Whether the string list was returned or not
+STATIC EFI_STATUS
 EFIAPI
-ConfigSSetInteger (
-  IN CHAR16 *Path,
-  IN INTN    Integer,
-  IN ...
+ConfigProtocolGetList (
+  IN  CHAR16   *Path OPTIONAL,
+  OUT CHAR16 ***List,
+  OUT UINTN    *Count
 ) {
-  EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, Integer);
-  Status = ConfigVSSetInteger(Path, Integer, Args);
-  VA_END(Args);
-  return Status;
+  // Another image is reading through the protocol because the snapshot was retired, so publish a new one for its next reads
+  if (mConfigTransaction.Depth == 0) {
+    ConfigSnapshotPublish();
+  }
+  return ConfigGetList(Path, List, Count);
 }
-// ConfigVSSetInteger
-/// Set an integer configuration value
-/// @param Path    The path of the configuration value
-/// @param Integer The integer configuration value to set
-/// @param Args    The argument list
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
+// ConfigProtocolGetValue
+/// Get a configuration value for another image
+/// @param Path  The path of the configuration value
+/// @param Type  On output, the type of the configuration value
+/// @param Value On output, the value of the configuration value
+/// @return Whether the configuration value was retrieved or not
+STATIC EFI_STATUS
+EFIAPI
+ConfigProtocolGetValue (
+  IN  CHAR16       *Path,
+  OUT CONFIG_TYPE  *Type,
+  OUT CONFIG_VALUE *Value
+) {
+  EFI_STATUS   Status;
+  CONFIG_TREE *Node = NULL;
+  // Check parameters
+  if ((Path == NULL) || (Type == NULL) || (Value == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Another image is reading through the protocol because the snapshot was retired, so publish a new one for its next reads
+  if (mConfigTransaction.Depth == 0) {
+    ConfigSnapshotPublish();
+  }
+  // Read the configuration tree directly since values staged by an open transaction are not visible to other images
+  Status = ConfigFind(Path, FALSE, &Node);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+  if (Node == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  ConfigTreeGetValue(Node, Type, Value);
+  return EFI_SUCCESS;
+}
+
+// mConfigProtocol
+/// The configuration protocol
+STATIC CONFIG_PROTOCOL mConfigProtocol = {
+  ConfigParseXml,
+  ConfigPartialFree,
+  ConfigProtocolGetList,
+  ConfigProtocolGetValue,
+  ConfigSetValue,
+};
+
+// ConfigSubscribe
+/// Subscribe to changes of configuration values under a configuration path prefix
+/// @param Prefix       The configuration path prefix, which does not need to exist yet, or NULL for root
+/// @param Notify       The change notification callback or NULL to only advance the subscription generation
+/// @param Context      The context passed to the change notification callback
+/// @param Subscription On output, the configuration change subscription, which must be freed with ConfigUnsubscribe
+/// @return Whether the configuration change subscription was created or not
+/// @retval EFI_INVALID_PARAMETER If Subscription is NULL
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration change subscription was created successfully
 EFI_STATUS
 EFIAPI
-ConfigVSSetInteger (
-  IN CHAR16  *Path,
-  IN INTN     Integer,
-  IN VA_LIST  Args
+ConfigSubscribe (
+  IN  CHAR16               *Prefix OPTIONAL,
+  IN  CONFIG_NOTIFY         Notify OPTIONAL,
+  IN  VOID                 *Context OPTIONAL,
+  OUT CONFIG_SUBSCRIPTION **Subscription
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
+  CONFIG_SUBSCRIPTION *NewSubscription;
+  UINTN                Size;
   // Check parameters
-  if (Path == NULL) {
+  if (Subscription == NULL) {
     return EFI_INVALID_PARAMETER;
   }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
+  if (Prefix == NULL) {
+    Prefix = L"";
+  }
+  // Allocate the subscription with the prefix following
+  Size = StrSize(Prefix);
+  NewSubscription = (CONFIG_SUBSCRIPTION *)AllocateZeroPool(sizeof(CONFIG_SUBSCRIPTION) + Size);
+  if (NewSubscription == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Set the value
-  Status = ConfigSetInteger(FullPath, Integer);
-  FreePool(FullPath);
-  return Status;
+  NewSubscription->Prefix = (CHAR16 *)(NewSubscription + 1);
+  CopyMem(NewSubscription->Prefix, Prefix, Size);
+  NewSubscription->Notify = Notify;
+  NewSubscription->Context = Context;
+  NewSubscription->Generation = 1;
+  // Add the subscription
+  NewSubscription->Next = mConfigSubscriptions;
+  mConfigSubscriptions = NewSubscription;
+  *Subscription = NewSubscription;
+  return EFI_SUCCESS;
+}
+// ConfigUnsubscribe
+/// Free a configuration change subscription
+/// @param Subscription The configuration change subscription
+/// @return Whether the configuration change subscription was freed or not
+/// @retval EFI_INVALID_PARAMETER If Subscription is NULL
+/// @retval EFI_NOT_FOUND         If the configuration change subscription was not found
+/// @retval EFI_SUCCESS           If the configuration change subscription was freed successfully
+EFI_STATUS
+EFIAPI
+ConfigUnsubscribe (
+  IN CONFIG_SUBSCRIPTION *Subscription
+) {
+  CONFIG_SUBSCRIPTION **Link;
+  // Check parameters
+  if (Subscription == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Remove the subscription
+  for (Link = &mConfigSubscriptions; *Link != NULL; Link = &((*Link)->Next)) {
+    if (*Link == Subscription) {
+      *Link = Subscription->Next;
+      FreePool(Subscription);
+      return EFI_SUCCESS;
+    }
+  }
+  return EFI_NOT_FOUND;
+}
+// ConfigSubscriptionGeneration
+/// Get the change generation of a configuration change subscription
+/// @param Subscription The configuration change subscription
+/// @return The change generation, which differs from any previously returned generation if values under the prefix may have changed since, or zero if Subscription is NULL
+UINTN
+EFIAPI
+ConfigSubscriptionGeneration (
+  IN CONFIG_SUBSCRIPTION *Subscription
+) {
+  if (Subscription == NULL) {
+    return 0;
+  }
+  // Changes made by the image owning the configuration tree are only observed as a new shared snapshot, so without one always report a change
+  if (mConfig != NULL) {
+    CONFIG_SNAPSHOT_HEADER *Snapshot = ConfigSnapshotGet();
+    if ((Snapshot == NULL) || (Snapshot != Subscription->Snapshot)) {
+      Subscription->Snapshot = Snapshot;
+      ++(Subscription->Generation);
+    }
+  }
+  return Subscription->Generation;
+}
+
+// ConfigSchemaIsValid
+/// Check a configuration section schema is valid
+/// @param Schema The configuration section schema
+/// @param Count  The count of configuration section schema entries
+/// @retval TRUE  If the configuration section schema is valid
+/// @retval FALSE If Schema is NULL, Count is zero, or an entry has no Path or an invalid Type
+STATIC BOOLEAN
+EFIAPI
+ConfigSchemaIsValid (
+  IN CONFIG_SCHEMA *Schema,
+  IN UINTN          Count
+) {
+  UINTN Index;
+  if ((Schema == NULL) || (Count == 0)) {
+    return FALSE;
+  }
+  for (Index = 0; Index < Count; ++Index) {
+    if ((Schema[Index].Path == NULL) || (Schema[Index].Type <= CONFIG_TYPE_LIST) || (Schema[Index].Type > CONFIG_TYPE_DATA)) {
+      return FALSE;
+    }
+  }
+  return TRUE;
+}
+// ConfigSchemaFill
+/// Fill a native structure from a configuration section
+/// @param Base      The base path of the configuration section or NULL for root
+/// @param Schema    The configuration section schema, which must be valid
+/// @param Count     The count of configuration section schema entries
+/// @param Structure The native structure to fill
+/// @return The count of configuration values with another type than the schema
+STATIC UINTN
+EFIAPI
+ConfigSchemaFill (
+  IN  CHAR16        *Base OPTIONAL,
+  IN  CONFIG_SCHEMA *Schema,
+  IN  UINTN          Count,
+  OUT VOID          *Structure
+) {
+  CONFIG_RESOLVER Resolver;
+  CONFIG_TYPE     Type;
+  CONFIG_VALUE    Value;
+  UINT8          *Field;
+  UINTN           Index;
+  UINTN           Mismatched = 0;
+  ConfigResolverStart(Base, &Resolver);
+  for (Index = 0; Index < Count; ++Index) {
+    ConfigResolverGetValue(&Resolver, Schema[Index].Path, &Type, &Value);
+    // Use the default for a missing value or one with another type, which is reported
+    if (Type != Schema[Index].Type) {
+      if ((Type != CONFIG_TYPE_UNKNOWN) && (Type != CONFIG_TYPE_LIST)) {
+        Log2(L"Configuration type mismatch:", L"%s\\%s\n", (Base == NULL) ? L"" : Base, Schema[Index].Path);
+        ++Mismatched;
+      }
+      ZeroMem(&Value, sizeof(CONFIG_VALUE));
+      switch (Schema[Index].Type) {
+        case CONFIG_TYPE_BOOLEAN:
+          Value.Boolean = (Schema[Index].Default != 0);
+          break;
+
+        case CONFIG_TYPE_INTEGER:
+          Value.Integer = (INTN)Schema[Index].Default;
+          break;
+
+        case CONFIG_TYPE_UNSIGNED:
+          Value.Unsigned = Schema[Index].Default;
+          break;
+
+        case CONFIG_TYPE_STRING:
+          Value.String = Schema[Index].DefaultString;
+          break;
+
+        default:
+          break;
+      }
+    }
+    // Store the native field
+    Field = ((UINT8 *)Structure) + Schema[Index].Offset;
+    switch (Schema[Index].Type) {
+      case CONFIG_TYPE_BOOLEAN:
+        *((BOOLEAN *)Field) = Value.Boolean;
+        break;
+
+      case CONFIG_TYPE_INTEGER:
+        *((INTN *)Field) = Value.Integer;
+        break;
+
+      case CONFIG_TYPE_UNSIGNED:
+        *((UINTN *)Field) = Value.Unsigned;
+        break;
+
+      case CONFIG_TYPE_STRING:
+        *((CHAR16 **)Field) = Value.String;
+        break;
+
+      case CONFIG_TYPE_DATA:
+        CopyMem(Field, &(Value.Data), sizeof(CONFIG_DATA));
+        break;
+
+      default:
+        break;
+    }
+  }
+  return Mismatched;
 }
-
-// ConfigSetUnsigned
-/// Set an unsigned integer configuration value
-/// @param Path     The path of the configuration value
-/// @param Unsigned The unsigned integer configuration value to set
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
+// ConfigSectionLoad
+/// Fill a native structure from a configuration section once, configuration values with another type than the schema are logged and replaced by the default
+/// @param Base       The base path of the configuration section or NULL for root
+/// @param Schema     The configuration section schema
+/// @param Count      The count of configuration section schema entries
+/// @param Structure  The native structure to fill, string and data fields point into the configuration until the values are changed or freed
+/// @param Mismatched On output, the count of configuration values with another type than the schema
+/// @return Whether the native structure was filled or not
+/// @retval EFI_INVALID_PARAMETER If Schema or Structure is NULL, Count is zero, or an entry has no Path or an invalid Type
+/// @retval EFI_SUCCESS           If the native structure was filled, every field is either the value or the default
 EFI_STATUS
 EFIAPI
-ConfigSetUnsigned (
-  IN CHAR16 *Path,
-  IN UINTN   Unsigned
+ConfigSectionLoad (
+  IN  CHAR16        *Base OPTIONAL,
+  IN  CONFIG_SCHEMA *Schema,
+  IN  UINTN          Count,
+  OUT VOID          *Structure,
+  OUT UINTN         *Mismatched OPTIONAL
 ) {
-  CONFIG_VALUE Value;
-  Value.Unsigned = Unsigned;
-  return ConfigSetValue(Path, CONFIG_TYPE_UNSIGNED, &Value);
+  UINTN Result;
+  // Check parameters
+  if ((Structure == NULL) || !ConfigSchemaIsValid(Schema, Count)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  Result = ConfigSchemaFill(Base, Schema, Count, Structure);
+  if (Mismatched != NULL) {
+    *Mismatched = Result;
+  }
+  return EFI_SUCCESS;
 }
-// ConfigSSetUnsigned
-/// Set an unsigned integer configuration value
-/// @param Path     The path of the configuration value
-/// @param Unsigned The unsigned integer configuration value to set
-/// @param ...      The argument list
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
-EFI_STATUS
+// ConfigSectionNotify
+/// Fill a bound native structure again when values in the section change
+/// @param Prefix  The base path of the section
+/// @param Context The bound configuration section
+STATIC VOID
 EFIAPI
-ConfigSSetUnsigned (
-  IN CHAR16 *Path,
-  IN UINTN   Unsigned,
-  IN ...
+ConfigSectionNotify (
+  IN CHAR16 *Prefix,
+  IN VOID   *Context OPTIONAL
 ) {
-  EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, Unsigned);
-  Status = ConfigVSSetUnsigned(Path, Unsigned, Args);
-  VA_END(Args);
-  return Status;
+  CONFIG_SECTION *Section = (CONFIG_SECTION *)Context;
+  if (Section != NULL) {
+    Section->Generation = ConfigSubscriptionGeneration(Section->Subscription);
+    ConfigSchemaFill(Section->Base, Section->Schema, Section->Count, Section->Structure);
+  }
 }
-// ConfigVSSetUnsigned
-/// Set an unsigned integer configuration value
-/// @param Path     The path of the configuration value
-/// @param Unsigned The unsigned integer configuration value to set
-/// @param Args     The argument list
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
+// ConfigSectionBind
+/// Fill a native structure from a configuration section and fill it again whenever values in the section change
+/// @param Base      The base path of the configuration section or NULL for root
+/// @param Schema    The configuration section schema, which must stay valid until unbound
+/// @param Count     The count of configuration section schema entries
+/// @param Structure The native structure to fill, which must stay valid until unbound
+/// @param Section   On output, the bound configuration section, which must be unbound with ConfigSectionUnbind
+/// @return Whether the configuration section was bound or not
+/// @retval EFI_INVALID_PARAMETER If Schema, Structure, or Section is NULL, Count is zero, or an entry has no Path or an invalid Type
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the configuration section was bound successfully
 EFI_STATUS
 EFIAPI
-ConfigVSSetUnsigned (
-  IN CHAR16  *Path,
-  IN UINTN    Unsigned,
-  IN VA_LIST  Args
+ConfigSectionBind (
+  IN  CHAR16          *Base OPTIONAL,
+  IN  CONFIG_SCHEMA   *Schema,
+  IN  UINTN            Count,
+  OUT VOID            *Structure,
+  OUT CONFIG_SECTION **Section
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
+  EFI_STATUS      Status;
+  CONFIG_SECTION *NewSection;
+  UINTN           Size;
   // Check parameters
-  if (Path == NULL) {
+  if ((Structure == NULL) || (Section == NULL) || !ConfigSchemaIsValid(Schema, Count)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
+  // Allocate the section with the base path following
+  Size = (Base == NULL) ? 0 : StrSize(Base);
+  NewSection = (CONFIG_SECTION *)AllocateZeroPool(sizeof(CONFIG_SECTION) + Size);
+  if (NewSection == NULL) {
     return EFI_OUT_OF_RESOURCES;
   }
-  // Set the value
-  Status = ConfigSetUnsigned(FullPath, Unsigned);
-  FreePool(FullPath);
-  return Status;
+  if (Base != NULL) {
+    NewSection->Base = (CHAR16 *)(NewSection + 1);
+    CopyMem(NewSection->Base, Base, Size);
+  }
+  NewSection->Schema = Schema;
+  NewSection->Count = Count;
+  NewSection->Structure = Structure;
+  // Subscribe to the section before filling so no change is missed
+  Status = ConfigSubscribe(NewSection->Base, ConfigSectionNotify, NewSection, &(NewSection->Subscription));
+  if (EFI_ERROR(Status)) {
+    FreePool(NewSection);
+    return Status;
+  }
+  NewSection->Generation = ConfigSubscriptionGeneration(NewSection->Subscription);
+  ConfigSchemaFill(NewSection->Base, Schema, Count, Structure);
+  *Section = NewSection;
+  return EFI_SUCCESS;
+}
+// ConfigSectionRefresh
+/// Fill a bound native structure again if values in the section may have changed without notification, which happens when the configuration belongs to another image
+/// @param Section The bound configuration section
+/// @retval TRUE  If the native structure was filled again
+/// @retval FALSE If the section has not changed or Section is NULL
+BOOLEAN
+EFIAPI
+ConfigSectionRefresh (
+  IN CONFIG_SECTION *Section
+) {
+  UINTN Generation;
+  if (Section == NULL) {
+    return FALSE;
+  }
+  Generation = ConfigSubscriptionGeneration(Section->Subscription);
+  if (Generation == Section->Generation) {
+    return FALSE;
+  }
+  Section->Generation = Generation;
+  ConfigSchemaFill(Section->Base, Section->Schema, Section->Count, Section->Structure);
+  return TRUE;
+}
+// ConfigSectionUnbind
+/// Stop filling a bound native structure and free the bound configuration section
+/// @param Section The bound configuration section
+/// @return Whether the configuration section was unbound or not
+/// @retval EFI_INVALID_PARAMETER If Section is NULL
+/// @retval EFI_SUCCESS           If the configuration section was unbound successfully
+EFI_STATUS
+EFIAPI
+ConfigSectionUnbind (
+  IN CONFIG_SECTION *Section
+) {
+  if (Section == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  ConfigUnsubscribe(Section->Subscription);
+  FreePool(Section);
+  return EFI_SUCCESS;
 }
 
-// ConfigSetString
-/// Set a string configuration value
-/// @param Path   The path of the configuration value
-/// @param String The string configuration value to set
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
+// ConfigTransactionBegin
+/// Begin a configuration transaction, values set until it is committed are staged and only read back by this image, nested transactions are flattened into the outermost one, queries and sections read staged values like single lookups while child lists and iterators only see committed values
+/// @return Whether the configuration transaction began or not
+/// @retval EFI_UNSUPPORTED If the configuration tree belongs to another image, values are then set immediately
+/// @retval EFI_SUCCESS     If the configuration transaction began successfully
 EFI_STATUS
 EFIAPI
-ConfigSetString (
-  IN CHAR16 *Path,
-  IN CHAR16 *String
+ConfigTransactionBegin (
+  VOID
 ) {
-  CONFIG_VALUE Value;
-  Value.String = String;
-  return ConfigSetValue(Path, CONFIG_TYPE_STRING, &Value);
+  // The image owning the configuration tree applies protocol sets immediately
+  if (mConfig != NULL) {
+    return EFI_UNSUPPORTED;
+  }
+  if (mConfigTransaction.Depth++ == 0) {
+    ConfigStageReset();
+  }
+  return EFI_SUCCESS;
 }
-// ConfigSSetString
-/// Set a string configuration value
-/// @param Path   The path of the configuration value
-/// @param String The string configuration value to set
-/// @param ...    The argument list
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
+// ConfigTransactionCommit
+/// Commit a configuration transaction, the outermost commit merges the staged values into the configuration tree in staging order, publishes a new shared snapshot for other images and notifies each affected subscription once
+/// @return Whether the configuration transaction was committed or not
+/// @retval EFI_NOT_STARTED      If no configuration transaction is open
+/// @retval EFI_ACCESS_DENIED    If a staged value was for a configuration value that has children, the other values were still applied
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the configuration transaction was committed successfully
 EFI_STATUS
 EFIAPI
-ConfigSSetString (
-  IN CHAR16 *Path,
-  IN CHAR16 *String,
-  IN ...
+ConfigTransactionCommit (
+  VOID
 ) {
   EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, String);
-  Status = ConfigVSSetString(Path, String, Args);
-  VA_END(Args);
+  if (mConfigTransaction.Depth == 0) {
+    return EFI_NOT_STARTED;
+  }
+  // Only the outermost commit applies the staged values
+  if (--(mConfigTransaction.Depth) != 0) {
+    return EFI_SUCCESS;
+  }
+  if (mConfigTransaction.Count == 0) {
+    ConfigStageReset();
+    return EFI_SUCCESS;
+  }
+  // Other images keep reading the previous snapshot until the whole transaction is applied
+  Status = ConfigStageApply();
+  ConfigStageReset();
+  ConfigSnapshotRetire();
+  ConfigSnapshotPublish();
+  // Notify each affected subscription once for the whole transaction
+  ConfigNotifyPending();
   return Status;
 }
-// ConfigVSSetString
-/// Set a string configuration value
-/// @param Path   The path of the configuration value
-/// @param String The string configuration value to set
-/// @param Args   The argument list
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path or String is NULL
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
+// ConfigTransactionAbort
+/// Abort a configuration transaction, discarding every value staged since the outermost transaction began
+/// @return Whether the configuration transaction was aborted or not
+/// @retval EFI_NOT_STARTED If no configuration transaction is open
+/// @retval EFI_SUCCESS     If the configuration transaction was aborted successfully
 EFI_STATUS
 EFIAPI
-ConfigVSSetString (
-  IN CHAR16  *Path,
-  IN CHAR16  *String,
-  IN VA_LIST  Args
+ConfigTransactionAbort (
+  VOID
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
-  // Check parameters
-  if ((Path == NULL) || (String == NULL)) {
-    return EFI_INVALID_PARAMETER;
-  }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  if (mConfigTransaction.Depth == 0) {
+    return EFI_NOT_STARTED;
   }
-  // Set the value
-  Status = ConfigSetString(FullPath, String);
-  FreePool(FullPath);
-  return Status;
+  --(mConfigTransaction.Depth);
+  ConfigStageReset();
+  return EFI_SUCCESS;
 }
 
-// ConfigSetData
-/// Set a data configuration value
-/// @param Path The path of the configuration value
-/// @param Size The size of the data configuration value
-/// @param Data The data configuration value to set
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path or Data is NULL or Size is zero
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
-EFI_STATUS
+// ConfigLogStatistics
+/// Log the configuration lookup statistics with the most costly configuration paths first, only debug builds collect statistics
+VOID
 EFIAPI
-ConfigSetData (
-  IN CHAR16 *Path,
-  IN UINTN   Size,
-  IN VOID   *Data
+ConfigLogStatistics (
+  VOID
 ) {
-  CONFIG_VALUE Value;
-  Value.Data.Size = Size;
-  Value.Data.Data = Data;
-  return ConfigSetValue(Path, CONFIG_TYPE_DATA, &Value);
+#if defined(PROJECT_DEBUG)
+  CONFIG_STAT_PATH *Top[CONFIG_STAT_REPORT_COUNT];
+  CONFIG_STAT_PATH *Stat;
+  UINTN             Count = 0;
+  UINTN             Paths = 0;
+  UINTN             Index;
+  UINTN             Insert;
+  Log2(L"Configuration lookups:", L"%u local, %u snapshot, %u protocol\n", mConfigStats.Lookups, mConfigStats.Snapshot, mConfigStats.Protocol);
+  Log2(L"  Misses:", L"%u\n", mConfigStats.Misses);
+  Log2(L"  Creates:", L"%u\n", mConfigStats.Creates);
+  Log2(L"  Time:", L"%luus\n", DivU64x32(GetTimeInNanoSecond(mConfigStats.Ticks), 1000));
+  // Keep the most costly paths in order
+  for (Index = 0; Index < CONFIG_STAT_BUCKETS; ++Index) {
+    for (Stat = mConfigStats.Paths[Index]; Stat != NULL; Stat = Stat->Next) {
+      ++Paths;
+      for (Insert = Count; (Insert > 0) && (Top[Insert - 1]->Ticks < Stat->Ticks); --Insert) {
+        if (Insert < CONFIG_STAT_REPORT_COUNT) {
+          Top[Insert] = Top[Insert - 1];
+        }
+      }
+      if (Insert < CONFIG_STAT_REPORT_COUNT) {
+        Top[Insert] = Stat;
+        if (Count < CONFIG_STAT_REPORT_COUNT) {
+          ++Count;
+        }
+      }
+    }
+  }
+  Log2(L"  Paths:", L"%u\n", Paths);
+  for (Index = 0; Index < Count; ++Index) {
+    Log(L"    %6luus %6u lookups %6u misses %4u creates %s\n", DivU64x32(GetTimeInNanoSecond(Top[Index]->Ticks), 1000),
+        Top[Index]->Lookups, Top[Index]->Misses, Top[Index]->Creates, (CHAR16 *)(Top[Index] + 1));
+  }
+#endif
 }
-// ConfigSSetData
-/// Set a data configuration value
-/// @param Path The path of the configuration value
-/// @param Size The size of the data configuration value
-/// @param Data The data configuration value to set
-/// @param ...  The argument list
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path or Data is NULL or Size is zero
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
-EFI_STATUS
+
+// ConfigLogLevelGet
+/// Get a log level from a configuration value, which is either the name or the number of the log level
+/// @param Path  The path of the configuration value
+/// @param Level On output, the log level
+/// @retval TRUE  If the configuration value was a valid log level
+/// @retval FALSE If the configuration value was not found or was not a valid log level
+STATIC BOOLEAN
 EFIAPI
-ConfigSSetData (
-  IN CHAR16 *Path,
-  IN UINTN   Size,
-  IN VOID   *Data,
-  IN ...
+ConfigLogLevelGet (
+  IN  CHAR16 *Path,
+  OUT UINT32 *Level
 ) {
-  EFI_STATUS Status;
-  VA_LIST    Args;
-  VA_START(Args, Data);
-  Status = ConfigVSSetData(Path, Size, Data, Args);
-  VA_END(Args);
-  return Status;
+  CHAR16 *Name = NULL;
+  CHAR16 *LevelName;
+  UINTN   Unsigned = 0;
+  UINT32  Index;
+  // Log level by name
+  if (!EFI_ERROR(ConfigGetString(Path, &Name)) && (Name != NULL)) {
+    for (Index = LOG_LEVEL_NONE; (LevelName = GetLogLevelName(Index)) != NULL; ++Index) {
+      if (StriCmp(Name, LevelName) == 0) {
+        *Level = Index;
+        return TRUE;
+      }
+    }
+    return FALSE;
+  }
+  // Log level by number
+  if (!EFI_ERROR(ConfigGetUnsigned(Path, &Unsigned)) && (Unsigned <= LOG_LEVEL_VERBOSE)) {
+    *Level = (UINT32)Unsigned;
+    return TRUE;
+  }
+  return FALSE;
 }
-// ConfigVSSetData
-/// Set a data configuration value
-/// @param Path The path of the configuration value
-/// @param Size The size of the data configuration value
-/// @param Data The data configuration value to set
-/// @param Args The argument list
-/// @return Whether the configuration value was set or not
-/// @retval EFI_INVALID_PARAMETER If Path or Data is NULL or Size is zero
-/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated for configuration data
-/// @retval EFI_SUCCESS           If the configuration value was set successfully
-EFI_STATUS
+// ConfigLogSettingsLoad
+/// Set the log settings from the configuration, \Log\Level for every log module then \Log\Modules\<Name> for each log module,
+///  and \Log\Capacity and \Log\Pinned, in KB, to bound the log
+STATIC VOID
 EFIAPI
-ConfigVSSetData (
-  IN CHAR16  *Path,
-  IN UINTN    Size,
-  IN VOID    *Data,
-  IN VA_LIST  Args
+ConfigLogSettingsLoad (
+  VOID
 ) {
-  EFI_STATUS  Status;
-  CHAR16     *FullPath;
-  // Check parameters
-  if ((Path == NULL) || (Data == NULL) || (Size == 0)) {
-    return EFI_INVALID_PARAMETER;
+  CHAR16 Path[64];
+  UINTN  Capacity;
+  UINTN  Pinned;
+  UINT32 Module;
+  UINT32 Level;
+  // Bound the log, keeping the pinned boot header
+  Capacity = ConfigGetUnsignedWithDefault(CONFIG_LOG_PATH L"\\Capacity", 0);
+  Pinned = ConfigGetUnsignedWithDefault(CONFIG_LOG_PATH L"\\Pinned", 0);
+  if (EFI_ERROR(SetLogCapacity(Capacity * 1024, Pinned * 1024))) {
+    Log2(L"Log capacity:", L"Invalid, %u KB with %u KB pinned\n", Capacity, Pinned);
   }
-  // Create the path from the argument list
-  FullPath = CatVSPrint(NULL, Path, Args);
-  if (FullPath == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  // Set the log levels
+  if (ConfigLogLevelGet(CONFIG_LOG_PATH L"\\Level", &Level)) {
+    SetLogLevel(LOG_MODULE_COUNT, Level);
+  }
+  for (Module = 0; Module < LOG_MODULE_COUNT; ++Module) {
+    UnicodeSPrint(Path, sizeof(Path), CONFIG_LOG_PATH L"\\Modules\\%s", GetLogModuleName(Module));
+    if (ConfigLogLevelGet(Path, &Level)) {
+      SetLogLevel(Module, Level);
+    }
   }
-  // Set the value
-  Status = ConfigSetData(FullPath, Size, Data);
-  FreePool(FullPath);
-  return Status;
 }
-
-// mConfigProtocol
-/// The configuration protocol
-STATIC CONFIG_PROTOCOL mConfigProtocol = {
-  ConfigParseXml,
-  ConfigPartialFree,
-  ConfigGetList,
-  ConfigGetValue,
-  ConfigSetValue,
-};
+// ConfigLogSettingsNotify
+/// Notification of changes to the log settings
+/// @param Prefix  The configuration path prefix of the subscription under which values changed
+/// @param Context The context passed when subscribing
+STATIC VOID
+EFIAPI
+ConfigLogSettingsNotify (
+  IN CHAR16 *Prefix,
+  IN VOID   *Context OPTIONAL
+) {
+  ConfigLogSettingsLoad();
+}
 
 // ConfigLibInitialize
 /// Configuration library initialize use
@@ -2586,24 +8027,34 @@ ConfigLibInitialize (
   VOID
 ) {
   EFI_STATUS Status;
+  UINTN      Span;
   // Check if configuration protocol is already installed
   mConfig = NULL;
   if (!EFI_ERROR(gBS->LocateProtocol(&mConfigGuid, NULL, (VOID **)&mConfig)) && (mConfig != NULL)) {
+    // Each image has its own log levels
+    ConfigLogSettingsLoad();
     return EFI_SUCCESS;
   }
   // Load configuration
-  Status = ConfigLoad(NULL, CONFIG_FILE);
+  Span = BeginLogSpan(L"ConfigLoad");
+  Status = ConfigLoadCached(CONFIG_FILE, CONFIG_CACHE_FILE);
   if (EFI_ERROR(Status)) {
     // If not found then load architecture configuration
-    Status = ConfigLoad(NULL, CONFIG_ARCH_FILE);
+    Status = ConfigLoadCached(CONFIG_ARCH_FILE, CONFIG_ARCH_CACHE_FILE);
   }
+  EndLogSpan(Span);
+  // Set the log settings and follow changes to them
+  ConfigLogSettingsLoad();
+  ConfigSubscribe(CONFIG_LOG_PATH, ConfigLogSettingsNotify, NULL, &mConfigLogSubscription);
   // Install configuration protocol
   mConfigHandle = NULL;
   mConfigProtocol.Parse = ConfigParseXml;
   mConfigProtocol.Free = ConfigPartialFree;
-  mConfigProtocol.GetList = ConfigGetList;
-  mConfigProtocol.GetValue = ConfigGetValue;
+  mConfigProtocol.GetList = ConfigProtocolGetList;
+  mConfigProtocol.GetValue = ConfigProtocolGetValue;
   mConfigProtocol.SetValue = ConfigSetValue;
+  // Publish the shared snapshot so other images can read without protocol calls
+  ConfigSnapshotPublish();
   return gBS->InstallMultipleProtocolInterfaces(&mConfigHandle, &mConfigGuid, (VOID *)&mConfigProtocol, NULL);
 }
 
@@ -2622,6 +8073,22 @@ ConfigLibFinish (
     gBS->UninstallMultipleProtocolInterfaces(mConfigHandle, &mConfigGuid, (VOID *)&mConfigProtocol, NULL);
     mConfigHandle = NULL;
   }
+  // Stop following changes to the log settings
+  if (mConfigLogSubscription != NULL) {
+    ConfigUnsubscribe(mConfigLogSubscription);
+    mConfigLogSubscription = NULL;
+  }
+  // Withdraw the shared snapshots
+  ConfigSnapshotFree();
+#if defined(PROJECT_DEBUG)
+  // Free the configuration lookup statistics
+  ConfigStatFree();
+#endif
+  // Free the platform identity and compiled conditions
+  ConfigPlatformFree();
+  // Discard any values staged by a transaction left open
+  mConfigTransaction.Depth = 0;
+  ConfigStageReset();
   // Free all configuration tree nodes
   return ConfigFree();
 }
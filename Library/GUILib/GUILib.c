@@ -120,7 +120,7 @@ GUIGraphicsInitialize (
         switch (Info->PixelFormat) {
           case PixelBlueGreenRedReserved8BitPerColor:
           case PixelRedGreenBlueReserved8BitPerColor:
-            LOG2(L"  Mode:", L"%u (%u x %u)\n",  Mode, Info->HorizontalResolution, Info->VerticalResolution);
+            LOG2_VERBOSE(LOG_MODULE_GUI, L"  Mode:", L"%u (%u x %u)\n",  Mode, Info->HorizontalResolution, Info->VerticalResolution);
             // Direct access to draw in framebuffer
             if (((Info->HorizontalResolution > BestWidth) && (Info->VerticalResolution > BestHeight)) ||
                 ((Info->HorizontalResolution * Info->VerticalResolution) > (BestWidth * BestHeight))) {
@@ -212,9 +212,12 @@ GUIRun (
   VOID
 ) {
   EFI_STATUS Status;
+  UINTN      Span;
 
   // Initialize the GUI graphics engine
+  Span = BeginLogSpan(L"GUIGraphicsInitialize");
   Status = GUIGraphicsInitialize();
+  EndLogSpan(Span);
 
   // Finish the GUI graphics engine
   GUIGraphicsFinish();
@@ -14,27 +14,120 @@
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
 
-// LOG_CHUNK_SIZE
-/// The size of a log chunk - 32KB
-#define LOG_CHUNK_SIZE (0x8000 - OFFSET_OF(LOG_CHUNK, Text))
+#include <Guid/EventGroup.h>
+
+// LOG_CONTENTS_MIN_PAGES
+/// The count of pages first allocated for the log contents, which grow by doubling - 32KB
+#define LOG_CONTENTS_MIN_PAGES 8
+// LOG_PRINT_MAX_LENGTH
+/// The maximum length, in characters, of a single log print
+#define LOG_PRINT_MAX_LENGTH 0x1000
+// LOG_LOST_MAX_LENGTH
+/// The maximum length, in characters, of the line that replaces the text discarded from a bounded log
+#define LOG_LOST_MAX_LENGTH 48
+// LOG_RECORDS_PAGES
+/// The count of pages for each block of log records - 64KB
+#define LOG_RECORDS_PAGES 16
+// LOG_RECORDS_SIZE
+/// The size, in bytes, of the records and copied arguments each block of log records can hold
+#define LOG_RECORDS_SIZE (EFI_PAGES_TO_SIZE(LOG_RECORDS_PAGES) - OFFSET_OF(LOG_RECORDS, Records))
 // LOG_DEFAULT_FILE
 /// The default log file
 #define LOG_DEFAULT_FILE PROJECT_ROOT_PATH L"\\" PROJECT_SAFE_NAME L"\\" PROJECT_SAFE_ARCH L"\\" PROJECT_SAFE_NAME L".log"
+// LOG_SPANS_FILE
+/// The default timing spans trace file
+#define LOG_SPANS_FILE PROJECT_ROOT_PATH L"\\" PROJECT_SAFE_NAME L"\\" PROJECT_SAFE_ARCH L"\\" PROJECT_SAFE_NAME L".trace.json"
+// LOG_SPAN_MAX
+/// The count of timing spans that can be recorded
+#define LOG_SPAN_MAX 0x200
+// LOG_SPAN_NAME_LENGTH
+/// The length, in characters, of a timing span name including the null terminator, longer names are truncated
+#define LOG_SPAN_NAME_LENGTH 0x40
+// LOG_SPAN_ESCAPED_SIZE
+/// The size, in bytes, of a timing span name escaped for JSON including the null terminator, each character escapes to at most six
+#define LOG_SPAN_ESCAPED_SIZE (((LOG_SPAN_NAME_LENGTH - 1) * 6) + 1)
+// LOG_SPAN_EVENT_SIZE
+/// The maximum size, in bytes, of the trace event of one timing span including its escaped name
+#define LOG_SPAN_EVENT_SIZE (0x100 + LOG_SPAN_ESCAPED_SIZE)
+// LOG_BUFFER_SIZE
+/// The size of the log file write-behind buffer, which is larger than the largest single log print - 64KB
+#define LOG_BUFFER_SIZE 0x10000
+// LOG_FLUSH_INTERVAL
+/// The amount of time in between flushing the log file write-behind buffer - 1 second
+#define LOG_FLUSH_INTERVAL 10000000
+// LOG_CONSOLE_SIZE
+/// The count of characters the console output buffer holds
+#define LOG_CONSOLE_SIZE 0x1000
+// LOG_CONSOLE_PIECE
+/// The maximum count of characters written to the console at once since some firmware freak out about larger
+#define LOG_CONSOLE_PIECE 255
+// LOG_CONSOLE_LINES
+/// The count of buffered lines after which the console output buffer is written
+#define LOG_CONSOLE_LINES 16
+// LOG_CONSOLE_INTERVAL
+/// The longest amount of time that output waits in the console output buffer - 50 milliseconds
+#define LOG_CONSOLE_INTERVAL 500000
+
+// LOG_RECORD
+/// A print recorded to be formatted later
+typedef struct _LOG_RECORD LOG_RECORD;
+struct _LOG_RECORD {
+
+  // Size
+  /// The size, in bytes, of the record and its arguments
+  UINTN   Size;
+  // Width
+  /// The alignment width of the prefix
+  UINTN   Width;
+  // Prefix
+  /// The copied aligned prefix or NULL
+  CHAR16 *Prefix;
+  // Format
+  /// The format specifier for formatting the text or NULL
+  CHAR16 *Format;
+  // Arguments
+  /// The arguments for the format specifier as a BASE_LIST, any strings or structures the arguments point to are copied to the end of the block
+  UINTN   Arguments[0];
 
-// LOG_CHUNK
-/// A chunk of the log
-typedef struct _LOG_CHUNK LOG_CHUNK;
-struct _LOG_CHUNK {
+};
+
+// LOG_RECORDS
+/// A block of log records
+typedef struct _LOG_RECORDS LOG_RECORDS;
+struct _LOG_RECORDS {
 
   // Next
-  /// The next chunk
-  LOG_CHUNK *Next;
+  /// The next block of records
+  LOG_RECORDS *Next;
   // Size
-  /// The in use size of the chunk
-  UINTN      Size;
-  // Text
-  /// The chunk text
-  CHAR16     Text[0];
+  /// The in use size, in bytes, of the records which grow from the start of the block
+  UINTN        Size;
+  // Limit
+  /// The offset of the copied arguments which grow down from the end of the block
+  UINTN        Limit;
+  // Records
+  /// The records and copied arguments
+  UINT64       Records[0];
+
+};
+
+// LOG_SPAN
+/// A timing span
+typedef struct _LOG_SPAN LOG_SPAN;
+struct _LOG_SPAN {
+
+  // Name
+  /// The copied name of the timing span, since the image that began it may be unloaded before the timing spans are saved
+  CHAR16 Name[LOG_SPAN_NAME_LENGTH];
+  // Begin
+  /// The performance counter when the timing span began
+  UINT64 Begin;
+  // End
+  /// The performance counter when the timing span ended or zero if it has not ended
+  UINT64 End;
+  // Depth
+  /// The count of timing spans that were open when the timing span began
+  UINTN  Depth;
 
 };
 
@@ -53,6 +146,25 @@ typedef UINTN
   IN     CHAR16  *Format,
   IN     VA_LIST  Args
 );
+// LOG_VPRINT_PREFIX
+/// Print to the log with an aligned prefix and variable arguments list
+/// @param Outputs The log output methods to use for printing
+/// @param Path    The log file path for use file output method
+/// @param Width   The alignment width
+/// @param Prefix  The aligned prefix
+/// @param Format  The format specifier for formatting the text
+/// @param Args    The variable arguments list for formatting
+/// @return The count of characters printed to the log
+typedef UINTN
+(EFIAPI
+*LOG_VPRINT_PREFIX) (
+  IN OUT UINT32  *Outputs,
+  IN     CHAR16  *Path OPTIONAL,
+  IN     UINTN    Width,
+  IN     CHAR16  *Prefix OPTIONAL,
+  IN     CHAR16  *Format OPTIONAL,
+  IN     VA_LIST  Args
+);
 // LOG_GET_START
 /// Get the performance counter start
 /// @return The performance counter start
@@ -74,6 +186,71 @@ typedef EFI_STATUS
   IN CHAR16 *Path
 );
 
+// LOG_SET_CAPACITY
+/// Bound the log contents
+/// @param Capacity The capacity, in bytes, of the log contents or zero for no bound
+/// @param Pinned   The size, in bytes, of text at the start of the log that is never discarded
+/// @return Whether the log contents were bounded or not
+typedef EFI_STATUS
+(EFIAPI
+*LOG_SET_CAPACITY) (
+  IN UINTN Capacity,
+  IN UINTN Pinned
+);
+// LOG_GET_LOST
+/// Get the count of lines discarded from a bounded log
+/// @return The count of lines discarded
+typedef UINT64
+(EFIAPI
+*LOG_GET_LOST) (
+  VOID
+);
+// LOG_SPAN_BEGIN
+/// Begin a timing span
+/// @param Name The name of the timing span
+/// @return The timing span or LOG_SPAN_INVALID if no more timing spans can be recorded
+typedef UINTN
+(EFIAPI
+*LOG_SPAN_BEGIN) (
+  IN CHAR16 *Name
+);
+// LOG_SPAN_END
+/// End a timing span
+/// @param Span The timing span
+typedef VOID
+(EFIAPI
+*LOG_SPAN_END) (
+  IN UINTN Span
+);
+// LOG_SAVE_SPANS
+/// Save the timing spans to a trace file
+/// @param Path The trace file path
+/// @return Whether the trace file was saved or not
+typedef EFI_STATUS
+(EFIAPI
+*LOG_SAVE_SPANS) (
+  IN CHAR16 *Path
+);
+// LOG_FLUSH
+/// Write any buffered log output now
+typedef VOID
+(EFIAPI
+*LOG_FLUSH) (
+  VOID
+);
+
+// LOG_GET_CONTENTS
+/// Get the contiguous log contents
+/// @param Contents On output, the log text
+/// @param Size     On output, the size, in bytes, of the log text
+/// @return Whether the log contents were returned or not
+typedef EFI_STATUS
+(EFIAPI
+*LOG_GET_CONTENTS) (
+  OUT CHAR16 **Contents,
+  OUT UINTN   *Size
+);
+
 // LOG_PROTOCOL
 /// Log protocol
 typedef struct _LOG_PROTOCOL LOG_PROTOCOL;
@@ -81,13 +258,37 @@ struct _LOG_PROTOCOL {
 
   // VPrint
   /// Print to the log with variable arguments list
-  LOG_VPRINT    VPrint;
+  LOG_VPRINT        VPrint;
   // GetStart
   /// Get the performance counter start
-  LOG_GET_START GetStart;
+  LOG_GET_START     GetStart;
   // Save
   /// Save the log to file
-  LOG_SAVE      Save;
+  LOG_SAVE          Save;
+  // GetContents
+  /// Get the contiguous log contents
+  LOG_GET_CONTENTS  GetContents;
+  // VPrintPrefix
+  /// Print to the log with an aligned prefix and variable arguments list
+  LOG_VPRINT_PREFIX VPrintPrefix;
+  // Flush
+  /// Write any buffered log output now
+  LOG_FLUSH         Flush;
+  // SetCapacity
+  /// Bound the log contents
+  LOG_SET_CAPACITY  SetCapacity;
+  // GetLost
+  /// Get the count of lines discarded from a bounded log
+  LOG_GET_LOST      GetLost;
+  // SpanBegin
+  /// Begin a timing span
+  LOG_SPAN_BEGIN    SpanBegin;
+  // SpanEnd
+  /// End a timing span
+  LOG_SPAN_END      SpanEnd;
+  // SaveSpans
+  /// Save the timing spans to a trace file
+  LOG_SAVE_SPANS    SaveSpans;
 
 };
 
@@ -100,12 +301,116 @@ STATIC CHAR16       *mLogPath = NULL;
 // mLogCounterStart
 /// Log performance counter start
 STATIC UINT64        mLogCounterStart = 0;
-// mLogChunks
-/// Log contents chunks
-STATIC LOG_CHUNK    *mLogChunks = NULL;
-// mLogChunk
-/// Log current contents chunk
-STATIC LOG_CHUNK    *mLogChunk = NULL;
+// mLogContents
+/// Log contents, which are contiguous so they can be exported or saved without gathering
+STATIC CHAR16       *mLogContents = NULL;
+// mLogContentsSize
+/// The size, in bytes, of the log contents, which is where the next print is appended
+STATIC UINTN         mLogContentsSize = 0;
+// mLogContentsPages
+/// The count of pages allocated for the log contents
+STATIC UINTN         mLogContentsPages = 0;
+// mLogCapacity
+/// The capacity, in bytes, of the log contents, or zero if the log contents are not bounded
+STATIC UINTN         mLogCapacity = 0;
+// mLogPinned
+/// The size, in bytes, of text at the start of the log to keep when the log contents are bounded
+STATIC UINTN         mLogPinned = 0;
+// mLogKept
+/// The size, in bytes, of the kept text at the start of the log, which is the pinned text rounded down to a whole line
+STATIC UINTN         mLogKept = 0;
+// mLogLost
+/// The count of lines discarded from the log contents
+STATIC UINT64        mLogLost = 0;
+// mLogLostSize
+/// The size, in bytes, of the line after the kept text that tells how many lines were lost
+STATIC UINTN         mLogLostSize = 0;
+// mLogRecords
+/// The first block of log records waiting to be formatted
+STATIC LOG_RECORDS  *mLogRecords = NULL;
+// mLogRecordsLast
+/// The last block of log records, to which records are appended
+STATIC LOG_RECORDS  *mLogRecordsLast = NULL;
+// mLogFile
+/// The open log file handle to which buffered output is written
+STATIC EFI_FILE_HANDLE  mLogFile = NULL;
+// mLogFilePath
+/// The path of the open log file
+STATIC CHAR16          *mLogFilePath = NULL;
+// mLogBuffer
+/// The write-behind buffer for the open log file
+STATIC UINT8           *mLogBuffer = NULL;
+// mLogBufferSize
+/// The size, in bytes, of output waiting in the write-behind buffer
+STATIC UINTN            mLogBufferSize = 0;
+// mLogFileStatus
+/// The status of writing the log file, an error from a flush outside of printing stops file output
+STATIC EFI_STATUS       mLogFileStatus = EFI_SUCCESS;
+// mLogFileBusy
+/// Whether the write-behind buffer is being changed so the flush timer must wait
+STATIC BOOLEAN          mLogFileBusy = FALSE;
+// mLogFlushEvent
+/// The timer event to flush the write-behind buffer
+STATIC EFI_EVENT        mLogFlushEvent = NULL;
+// mLogBeforeExitEvent
+/// The event to flush and save the log while boot services are still available just before they exit
+STATIC EFI_EVENT        mLogBeforeExitEvent = NULL;
+// mLogExitEvent
+/// The event to stop console and file output when boot services exit
+STATIC EFI_EVENT        mLogExitEvent = NULL;
+// mLogLevelNames
+/// The names of the log levels
+STATIC CHAR16       *mLogLevelNames[] = {
+  L"None",
+  L"Error",
+  L"Warning",
+  L"Info",
+  L"Verbose"
+};
+// mLogModuleNames
+/// The names of the log modules
+STATIC CHAR16       *mLogModuleNames[LOG_MODULE_COUNT] = {
+  L"General",
+  L"Platform",
+  L"File",
+  L"Config",
+  L"GUI",
+  L"Xml"
+};
+// gLogLevels
+/// The runtime log level of each log module
+UINT32               gLogLevels[LOG_MODULE_COUNT] = {
+  PROJECT_LOG_LEVEL,
+  PROJECT_LOG_LEVEL,
+  PROJECT_LOG_LEVEL,
+  PROJECT_LOG_LEVEL,
+  PROJECT_LOG_LEVEL,
+  PROJECT_LOG_LEVEL
+};
+// mLogConsole
+/// The console output buffer, with room for a terminator
+STATIC CHAR16           mLogConsole[LOG_CONSOLE_SIZE + 1];
+// mLogConsoleLength
+/// The count of characters waiting in the console output buffer
+STATIC UINTN            mLogConsoleLength = 0;
+// mLogConsoleLines
+/// The count of lines waiting in the console output buffer
+STATIC UINTN            mLogConsoleLines = 0;
+// mLogConsoleBusy
+/// Whether the console output buffer is being changed so the console timer must wait
+STATIC BOOLEAN          mLogConsoleBusy = FALSE;
+// mLogConsoleEvent
+/// The timer event to write the console output buffer shortly after output is buffered
+STATIC EFI_EVENT        mLogConsoleEvent = NULL;
+// mLogSpans
+/// The recorded timing spans
+STATIC LOG_SPAN         mLogSpans[LOG_SPAN_MAX];
+// mLogSpanCount
+/// The count of recorded timing spans
+STATIC UINTN            mLogSpanCount = 0;
+// mLogSpanDepth
+/// The count of open timing spans
+STATIC UINTN            mLogSpanDepth = 0;
 // mLogHandle
 /// Log protocol handle
 STATIC EFI_HANDLE    mLogHandle = NULL;
@@ -120,7 +425,7 @@ STATIC EFI_GUID      mLogGuid = { 0x2E838A34, 0xDDA6, 0x4D65, { 0x8B, 0xB4, 0x04
 /// Log formatted text to log and/or console
 /// @param Format The format specifier for formatting the text
 /// @param ...    The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 Log (
@@ -139,7 +444,7 @@ Log (
 /// @param Prefix The aligned prefix
 /// @param Format The format specifier for formatting the text
 /// @param ...    The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 Log2 (
@@ -160,7 +465,7 @@ Log2 (
 /// @param Prefix The aligned prefix
 /// @param Format The format specifier for formatting the text
 /// @param ...    The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 Log3 (
@@ -176,8 +481,597 @@ Log3 (
   VA_END(Args);
   return Count;
 }
-// LogVPrint
-/// Print to the log with variable arguments list
+// LogFileFlush
+/// Write the write-behind buffer to the open log file
+/// @param Commit Whether to also commit the log file to the storage media
+/// @return Whether the buffered output was written or not
+STATIC EFI_STATUS
+EFIAPI
+LogFileFlush (
+  IN BOOLEAN Commit
+) {
+  EFI_STATUS Status;
+  UINTN      Size = mLogBufferSize;
+  // Nothing to write
+  if ((mLogFile == NULL) || (Size == 0)) {
+    return EFI_SUCCESS;
+  }
+  mLogBufferSize = 0;
+  Status = FileHandleWrite(mLogFile, &Size, mLogBuffer);
+  if (!EFI_ERROR(Status) && Commit) {
+    Status = FileHandleFlush(mLogFile);
+  }
+  if (EFI_ERROR(Status)) {
+    mLogFileStatus = Status;
+  }
+  return Status;
+}
+// LogFileClose
+/// Flush and close the open log file
+/// @return Whether the buffered output was written or not
+STATIC EFI_STATUS
+EFIAPI
+LogFileClose (
+  VOID
+) {
+  EFI_STATUS Status = LogFileFlush(FALSE);
+  if (mLogFile != NULL) {
+    FileHandleClose(mLogFile);
+    mLogFile = NULL;
+  }
+  if (mLogFilePath != NULL) {
+    FreePool(mLogFilePath);
+    mLogFilePath = NULL;
+  }
+  mLogBufferSize = 0;
+  return Status;
+}
+// LogFileOpen
+/// Open a log file for appending buffered output, the log file stays open until another path is used
+/// @param Path The log file path
+/// @return Whether the log file was opened or not
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the log file is open
+STATIC EFI_STATUS
+EFIAPI
+LogFileOpen (
+  IN CHAR16 *Path
+) {
+  EFI_STATUS Status;
+  // The log file is already open
+  if ((mLogFile != NULL) && (StriCmp(mLogFilePath, Path) == 0)) {
+    return EFI_SUCCESS;
+  }
+  LogFileClose();
+  // Allocate the write-behind buffer once
+  if (mLogBuffer == NULL) {
+    mLogBuffer = (UINT8 *)AllocatePool(LOG_BUFFER_SIZE);
+    if (mLogBuffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+  }
+  mLogFilePath = StrDup(Path);
+  if (mLogFilePath == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  // Open the log file and set position at end of file to append
+  Status = FileHandleOpen(&mLogFile, NULL, Path, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_CREATE, 0);
+  if (!EFI_ERROR(Status)) {
+    Status = FileHandleSetPosition(mLogFile, 0xFFFFFFFFFFFFFFFF);
+  }
+  if (EFI_ERROR(Status)) {
+    LogFileClose();
+  }
+  return Status;
+}
+// LogFileWrite
+/// Write output to a log file through the write-behind buffer
+/// @param Path   The log file path
+/// @param Buffer The output to write
+/// @param Size   The size, in bytes, of the output, which must not be larger than LOG_BUFFER_SIZE
+/// @return Whether the output was written or not
+STATIC EFI_STATUS
+EFIAPI
+LogFileWrite (
+  IN CHAR16 *Path,
+  IN VOID   *Buffer,
+  IN UINTN   Size
+) {
+  EFI_STATUS Status;
+  // A flush outside of printing failed so stop file output now
+  if (EFI_ERROR(mLogFileStatus)) {
+    return mLogFileStatus;
+  }
+  mLogFileBusy = TRUE;
+  Status = LogFileOpen(Path);
+  if (!EFI_ERROR(Status)) {
+    // Write the buffered output once the buffer is full
+    if ((mLogBufferSize + Size) > LOG_BUFFER_SIZE) {
+      Status = LogFileFlush(FALSE);
+    }
+    if (!EFI_ERROR(Status)) {
+      CopyMem(mLogBuffer + mLogBufferSize, Buffer, Size);
+      mLogBufferSize += Size;
+    }
+  }
+  mLogFileBusy = FALSE;
+  return Status;
+}
+// LogFlushNotify
+/// Notification of log file flush timer event
+/// @param Event   The event that triggered the notification
+/// @param Context The context passed when registering this notification
+STATIC VOID
+EFIAPI
+LogFlushNotify (
+  IN EFI_EVENT  Event,
+  IN VOID      *Context
+) {
+  // Output is being buffered so try again on the next tick
+  if (!mLogFileBusy) {
+    LogFileFlush(TRUE);
+  }
+}
+// LogConsoleFlush
+/// Write the console output buffer to the console
+STATIC VOID
+EFIAPI
+LogConsoleFlush (
+  VOID
+) {
+  CHAR16 Saved;
+  UINTN  Index;
+  UINTN  Length;
+  // Write the buffered output in pieces
+  if ((gST != NULL) && (gST->ConOut != NULL) && (gST->ConOut->OutputString != NULL)) {
+    for (Index = 0; Index < mLogConsoleLength; Index += Length) {
+      Length = MIN(mLogConsoleLength - Index, LOG_CONSOLE_PIECE);
+      Saved = mLogConsole[Index + Length];
+      mLogConsole[Index + Length] = L'\0';
+      gST->ConOut->OutputString(gST->ConOut, mLogConsole + Index);
+      mLogConsole[Index + Length] = Saved;
+    }
+  }
+  mLogConsoleLength = 0;
+  mLogConsoleLines = 0;
+}
+// LogConsoleWrite
+/// Write output to the console through the console output buffer
+/// @param Text  The output text
+/// @param Count The count of characters of output text
+STATIC VOID
+EFIAPI
+LogConsoleWrite (
+  IN CHAR16 *Text,
+  IN UINTN   Count
+) {
+  UINTN Index;
+  UINTN Length;
+  mLogConsoleBusy = TRUE;
+  // Start the timer when the buffer stops being empty so output never waits long
+  if ((mLogConsoleLength == 0) && (mLogConsoleEvent != NULL) &&
+      EFI_ERROR(gBS->SetTimer(mLogConsoleEvent, TimerRelative, LOG_CONSOLE_INTERVAL))) {
+    gBS->CloseEvent(mLogConsoleEvent);
+    mLogConsoleEvent = NULL;
+  }
+  while (Count > 0) {
+    // Write the buffered output once the buffer is full
+    if (mLogConsoleLength == LOG_CONSOLE_SIZE) {
+      LogConsoleFlush();
+    }
+    // Copy as much output as fits and count the lines
+    Length = MIN(Count, LOG_CONSOLE_SIZE - mLogConsoleLength);
+    for (Index = 0; Index < Length; ++Index) {
+      mLogConsole[mLogConsoleLength++] = Text[Index];
+      if (Text[Index] == L'\n') {
+        ++mLogConsoleLines;
+      }
+    }
+    Text += Length;
+    Count -= Length;
+  }
+  // Write a burst of lines now, or everything if there is no timer
+  if ((mLogConsoleLines >= LOG_CONSOLE_LINES) || (mLogConsoleEvent == NULL)) {
+    LogConsoleFlush();
+  }
+  mLogConsoleBusy = FALSE;
+}
+// LogConsoleNotify
+/// Notification of console output timer event
+/// @param Event   The event that triggered the notification
+/// @param Context The context passed when registering this notification
+STATIC VOID
+EFIAPI
+LogConsoleNotify (
+  IN EFI_EVENT  Event,
+  IN VOID      *Context
+) {
+  // Output is being buffered so wait a little longer
+  if (!mLogConsoleBusy) {
+    LogConsoleFlush();
+  } else if (mLogConsoleEvent != NULL) {
+    gBS->SetTimer(mLogConsoleEvent, TimerRelative, LOG_CONSOLE_INTERVAL);
+  }
+}
+// LogContentsGrow
+/// Grow the log contents by doubling until there is room for more text
+/// @param Size The size, in bytes, that the log contents must be able to hold
+/// @return Whether the log contents grew or not
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the log contents grew successfully
+STATIC EFI_STATUS
+EFIAPI
+LogContentsGrow (
+  IN UINTN Size
+) {
+  EFI_PHYSICAL_ADDRESS  Address;
+  CHAR16               *Contents;
+  UINTN                 Pages = (mLogContentsPages == 0) ? LOG_CONTENTS_MIN_PAGES : (mLogContentsPages << 1);
+  while (EFI_PAGES_TO_SIZE(Pages) < Size) {
+    Pages <<= 1;
+  }
+  // Never grow a bounded log past its capacity
+  if ((mLogCapacity != 0) && (Pages > EFI_SIZE_TO_PAGES(mLogCapacity)) && (EFI_PAGES_TO_SIZE(EFI_SIZE_TO_PAGES(mLogCapacity)) >= Size)) {
+    Pages = EFI_SIZE_TO_PAGES(mLogCapacity);
+  }
+  // Try to extend the log contents in place with the pages that follow
+  if (mLogContents != NULL) {
+    Address = (EFI_PHYSICAL_ADDRESS)(UINTN)mLogContents + EFI_PAGES_TO_SIZE(mLogContentsPages);
+    if (!EFI_ERROR(gBS->AllocatePages(AllocateAddress, EfiBootServicesData, Pages - mLogContentsPages, &Address))) {
+      mLogContentsPages = Pages;
+      return EFI_SUCCESS;
+    }
+  }
+  // Otherwise move the log contents to larger pages
+  Contents = (CHAR16 *)AllocatePages(Pages);
+  if (Contents == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  if (mLogContents != NULL) {
+    CopyMem(Contents, mLogContents, mLogContentsSize);
+    FreePages(mLogContents, mLogContentsPages);
+  }
+  mLogContents = Contents;
+  mLogContentsPages = Pages;
+  return EFI_SUCCESS;
+}
+// LogContentsDiscard
+/// Discard the oldest whole lines of a bounded log after the pinned text, at least a quarter of the rest of the log at once so discarding is rare
+/// @param Size The size, in bytes, of the text that needs room
+STATIC VOID
+EFIAPI
+LogContentsDiscard (
+  IN UINTN Size
+) {
+  CHAR16 Lost[LOG_LOST_MAX_LENGTH];
+  UINTN  Length = mLogContentsSize / sizeof(CHAR16);
+  UINTN  Start;
+  UINTN  End;
+  // Keep the pinned text rounded down to a whole line the first time text is discarded
+  if (mLogLostSize == 0) {
+    End = MIN(mLogPinned, mLogContentsSize) / sizeof(CHAR16);
+    while ((End > 0) && (mLogContents[End - 1] != L'\n')) {
+      --End;
+    }
+    mLogKept = End * sizeof(CHAR16);
+  }
+  // Discard whole lines after the kept text and the previous lost line
+  Start = (mLogKept + mLogLostSize) / sizeof(CHAR16);
+  End = mLogContentsSize + Size + (LOG_LOST_MAX_LENGTH * sizeof(CHAR16));
+  End = (End > mLogCapacity) ? (End - mLogCapacity) : 0;
+  End = Start + (MAX(End, (mLogCapacity - mLogKept) >> 2) / sizeof(CHAR16));
+  if (End > Length) {
+    End = Length;
+  }
+  while ((End < Length) && (mLogContents[End - 1] != L'\n')) {
+    ++End;
+  }
+  // Count the discarded lines
+  for (; Start < End; ++Start) {
+    if (mLogContents[Start] == L'\n') {
+      ++mLogLost;
+    }
+  }
+  // Replace the discarded text with a line telling how many lines were lost
+  mLogLostSize = UnicodeSPrint(Lost, sizeof(Lost), L"[%lu lines lost]\n", mLogLost) * sizeof(CHAR16);
+  CopyMem(((UINT8 *)mLogContents) + mLogKept + mLogLostSize, mLogContents + End, (Length - End) * sizeof(CHAR16));
+  CopyMem(((UINT8 *)mLogContents) + mLogKept, Lost, mLogLostSize);
+  mLogContentsSize = mLogKept + mLogLostSize + ((Length - End) * sizeof(CHAR16));
+}
+// LogContentsReserve
+/// Make sure there is room at the end of the log contents for more text
+/// @param Size The size, in bytes, of the text and its terminator
+/// @return The end of the log contents where the text can be created or NULL if memory could not be allocated
+STATIC CHAR16 *
+EFIAPI
+LogContentsReserve (
+  IN UINTN Size
+) {
+  // Discard the oldest text of a bounded log to make room
+  if ((mLogCapacity != 0) && ((mLogContentsSize + Size) > mLogCapacity)) {
+    LogContentsDiscard(Size);
+  }
+  if ((mLogContentsSize + Size) > EFI_PAGES_TO_SIZE(mLogContentsPages)) {
+    if (EFI_ERROR(LogContentsGrow(mLogContentsSize + Size))) {
+      return NULL;
+    }
+  }
+  return (CHAR16 *)(((UINT8 *)mLogContents) + mLogContentsSize);
+}
+// LogRecordsFormat
+/// Format the text of all waiting log records into the log contents
+STATIC VOID
+EFIAPI
+LogRecordsFormat (
+  VOID
+) {
+  LOG_RECORDS *Records;
+  LOG_RECORD  *Record;
+  CHAR16      *Text;
+  UINTN        Offset;
+  UINTN        Prefix[2];
+  UINTN        Size = (LOG_PRINT_MAX_LENGTH + 1) * sizeof(CHAR16);
+  // Nothing to do
+  if ((mLogRecords == NULL) || (mLogRecords->Size == 0)) {
+    return;
+  }
+  // Format the text of each record in the order they were recorded
+  for (Records = mLogRecords; Records != NULL; Records = Records->Next) {
+    for (Offset = 0; Offset < Records->Size; Offset += Record->Size) {
+      Record = (LOG_RECORD *)(((UINT8 *)Records->Records) + Offset);
+      if (Record->Prefix != NULL) {
+        Text = LogContentsReserve(Size);
+        if (Text == NULL) {
+          break;
+        }
+        Prefix[0] = Record->Width;
+        Prefix[1] = (UINTN)Record->Prefix;
+        mLogContentsSize += (UnicodeBSPrint(Text, Size, L"%- *s ", (BASE_LIST)Prefix) * sizeof(CHAR16));
+      }
+      if (Record->Format != NULL) {
+        Text = LogContentsReserve(Size);
+        if (Text == NULL) {
+          break;
+        }
+        mLogContentsSize += (UnicodeBSPrint(Text, Size, Record->Format, (BASE_LIST)Record->Arguments) * sizeof(CHAR16));
+      }
+    }
+  }
+  // Keep the first block of records to be reused
+  while (mLogRecords->Next != NULL) {
+    Records = mLogRecords->Next;
+    mLogRecords->Next = Records->Next;
+    FreePages(Records, LOG_RECORDS_PAGES);
+  }
+  mLogRecords->Size = 0;
+  mLogRecords->Limit = LOG_RECORDS_SIZE;
+  mLogRecordsLast = mLogRecords;
+}
+// LogRecordCopy
+/// Copy an argument to the end of a block of log records
+/// @param Marker The end of the record arguments, which the copy must not overlap
+/// @param Limit  On input, the start of the copied arguments, on output, the start of the copy
+/// @param Data   The argument to copy
+/// @param Size   The size, in bytes, of the argument
+/// @return The copy of the argument or NULL if there is no room in the block
+STATIC VOID *
+EFIAPI
+LogRecordCopy (
+  IN     BASE_LIST   Marker,
+  IN OUT UINT8     **Limit,
+  IN     VOID       *Data,
+  IN     UINTN       Size
+) {
+  // Keep room for at least one more argument after the copy
+  if ((UINTN)((*Limit) - (UINT8 *)Marker) < (Size + sizeof(UINT64) + sizeof(UINT64))) {
+    return NULL;
+  }
+  *Limit = (UINT8 *)(((UINTN)((*Limit) - Size)) & ~(UINTN)(sizeof(UINT64) - 1));
+  CopyMem(*Limit, Data, Size);
+  return *Limit;
+}
+// LogRecordArguments
+/// Record the arguments for a format specifier in the same layout that BASE_ARG reads them
+/// @param Format The format specifier for formatting the text
+/// @param Args   The variable arguments list for formatting
+/// @param Marker The start of the record arguments
+/// @param Limit  On input, the start of the copied arguments, on output, the start of the copied arguments including any new copies
+/// @return The end of the record arguments or NULL if there is no room in the block
+STATIC BASE_LIST
+EFIAPI
+LogRecordArguments (
+  IN     CHAR16     *Format,
+  IN     VA_LIST     Args,
+  IN     BASE_LIST   Marker,
+  IN OUT UINT8     **Limit
+) {
+  VOID    *Data;
+  BOOLEAN  Long;
+  BOOLEAN  Done;
+  // Follow the format specifier the same way the print library does to find the type of each argument
+  for (; *Format != L'\0'; ++Format) {
+    if (*Format != L'%') {
+      continue;
+    }
+    Long = FALSE;
+    // Skip the flags, width and precision, which may also be arguments
+    for (Done = FALSE; !Done; ) {
+      if ((UINTN)((*Limit) - (UINT8 *)Marker) < sizeof(UINT64)) {
+        return NULL;
+      }
+      switch (*++Format) {
+        case L'\0':
+          return Marker;
+
+        case L'L':
+        case L'l':
+          Long = TRUE;
+          break;
+
+        case L'*':
+          BASE_ARG(Marker, UINTN) = VA_ARG(Args, UINTN);
+          break;
+
+        case L'.':
+        case L'-':
+        case L'+':
+        case L' ':
+        case L',':
+        case L'0':
+        case L'1':
+        case L'2':
+        case L'3':
+        case L'4':
+        case L'5':
+        case L'6':
+        case L'7':
+        case L'8':
+        case L'9':
+          break;
+
+        default:
+          Done = TRUE;
+          break;
+      }
+    }
+    // Record the argument for the type
+    switch (*Format) {
+      case L'p':
+        BASE_ARG(Marker, VOID *) = VA_ARG(Args, VOID *);
+        break;
+
+      case L'X':
+      case L'x':
+      case L'd':
+      case L'u':
+        if (Long) {
+          BASE_ARG(Marker, INT64) = VA_ARG(Args, INT64);
+        } else {
+          BASE_ARG(Marker, int) = VA_ARG(Args, int);
+        }
+        break;
+
+      case L'c':
+        BASE_ARG(Marker, UINTN) = VA_ARG(Args, UINTN);
+        break;
+
+      case L'r':
+        BASE_ARG(Marker, RETURN_STATUS) = VA_ARG(Args, RETURN_STATUS);
+        break;
+
+      case L's':
+      case L'S':
+      case L'a':
+      case L'g':
+      case L't':
+        // Copy what the argument points to since it may change before the text is formatted
+        Data = VA_ARG(Args, VOID *);
+        if (Data != NULL) {
+          switch (*Format) {
+            case L'a':
+              Data = LogRecordCopy(Marker, Limit, Data, AsciiStrSize((CHAR8 *)Data));
+              break;
+
+            case L'g':
+              Data = LogRecordCopy(Marker, Limit, Data, sizeof(GUID));
+              break;
+
+            case L't':
+              Data = LogRecordCopy(Marker, Limit, Data, sizeof(EFI_TIME));
+              break;
+
+            default:
+              Data = LogRecordCopy(Marker, Limit, Data, StrSize((CHAR16 *)Data));
+              break;
+          }
+          if (Data == NULL) {
+            return NULL;
+          }
+        }
+        BASE_ARG(Marker, VOID *) = Data;
+        break;
+
+      default:
+        break;
+    }
+  }
+  return Marker;
+}
+// LogRecord
+/// Record a print to be formatted later
+/// @param Width  The alignment width
+/// @param Prefix The aligned prefix
+/// @param Format The format specifier for formatting the text
+/// @param Args   The variable arguments list for formatting
+/// @return Whether the print was recorded or not
+STATIC BOOLEAN
+EFIAPI
+LogRecord (
+  IN UINTN    Width,
+  IN CHAR16  *Prefix OPTIONAL,
+  IN CHAR16  *Format OPTIONAL,
+  IN VA_LIST  Args
+) {
+  LOG_RECORDS *Records = mLogRecordsLast;
+  LOG_RECORD  *Record;
+  UINT8       *Limit;
+  BASE_LIST    Marker;
+  VA_LIST      Copy;
+  while (TRUE) {
+    // A bounded log formats the records instead of growing, otherwise append a new block of records
+    if ((Records == NULL) && (mLogCapacity != 0) && (mLogRecords != NULL)) {
+      LogRecordsFormat();
+      Records = mLogRecords;
+    }
+    if (Records == NULL) {
+      Records = (LOG_RECORDS *)AllocatePages(LOG_RECORDS_PAGES);
+      if (Records == NULL) {
+        return FALSE;
+      }
+      Records->Next = NULL;
+      Records->Size = 0;
+      Records->Limit = LOG_RECORDS_SIZE;
+      if (mLogRecordsLast == NULL) {
+        mLogRecords = Records;
+      } else {
+        mLogRecordsLast->Next = Records;
+      }
+      mLogRecordsLast = Records;
+    }
+    // Create the record at the end of the block
+    Record = (LOG_RECORD *)(((UINT8 *)Records->Records) + Records->Size);
+    Limit = ((UINT8 *)Records->Records) + Records->Limit;
+    Marker = (BASE_LIST)Record->Arguments;
+    if ((((UINT8 *)Marker) + sizeof(UINT64)) <= Limit) {
+      Record->Width = Width;
+      Record->Prefix = NULL;
+      Record->Format = Format;
+      if (Prefix != NULL) {
+        Record->Prefix = (CHAR16 *)LogRecordCopy(Marker, &Limit, Prefix, StrSize(Prefix));
+      }
+      if ((Prefix == NULL) || (Record->Prefix != NULL)) {
+        if (Format != NULL) {
+          VA_COPY(Copy, Args);
+          Marker = LogRecordArguments(Format, Copy, Marker, &Limit);
+          VA_END(Copy);
+        }
+        if (Marker != NULL) {
+          Record->Size = (UINTN)((UINT8 *)Marker - (UINT8 *)Record);
+          Records->Size += Record->Size;
+          Records->Limit = (UINTN)(Limit - (UINT8 *)Records->Records);
+          return TRUE;
+        }
+      }
+    }
+    // The print is too large for a block so format the text now
+    if (Records->Size == 0) {
+      return FALSE;
+    }
+    Records = NULL;
+  }
+}
+// LogVPrintText
+/// Format the text of a print and output it
 /// @param Outputs The log output methods to use for printing
 /// @param Path    The log file path for use file output method
 /// @param Format  The format specifier for formatting the text
@@ -185,44 +1079,26 @@ Log3 (
 /// @return The count of characters printed to the log
 STATIC UINTN
 EFIAPI
-LogVPrint (
+LogVPrintText (
   IN OUT UINT32  *Outputs,
   IN     CHAR16  *Path OPTIONAL,
   IN     CHAR16  *Format,
   IN     VA_LIST  Args
 ) {
-  UINTN Count = 0;
+  UINTN   Count = 0;
+  CHAR16 *Text;
   // Get size needed for log output
-  UINTN Size = SPrintLength(Format, Args);
-  if ((Size++ > 0) && (Size <= (LOG_CHUNK_SIZE / (4 * sizeof(CHAR16))))) {
+  UINTN   Size = SPrintLength(Format, Args);
+  if ((Size++ > 0) && (Size <= LOG_PRINT_MAX_LENGTH)) {
     Size *= sizeof(CHAR16);
-    // Create a new chunk if needed
-    if (mLogChunk == NULL) {
-      if (mLogChunks != NULL) {
-        // Get the last chunk
-        for (mLogChunk = mLogChunks; mLogChunk->Next != NULL; mLogChunk = mLogChunk->Next);
-      } else {
-        // Create a new root chunk
-        mLogChunk = mLogChunks = (LOG_CHUNK *)AllocatePages(EFI_SIZE_TO_PAGES(LOG_CHUNK_SIZE));
-        if (mLogChunk == NULL) {
-          return 0;
-        }
-        mLogChunk->Next = NULL;
-        mLogChunk->Size = 0;
-      }
-    }
-    // Check to make sure there is a valid chunk
-    if ((mLogChunk->Size + Size + sizeof(CHAR16)) >= LOG_CHUNK_SIZE) {
-      mLogChunk->Next = (LOG_CHUNK *)AllocatePages(EFI_SIZE_TO_PAGES(LOG_CHUNK_SIZE));
-      if (mLogChunk->Next == NULL) {
-        return 0;
-      }
-      mLogChunk = mLogChunk->Next;
-      mLogChunk->Next = NULL;
-      mLogChunk->Size = 0;
+    // Any records come before this text
+    LogRecordsFormat();
+    // Create formatted text at the end of the log contents, with room for its terminator
+    Text = LogContentsReserve(Size + sizeof(CHAR16));
+    if (Text == NULL) {
+      return 0;
     }
-    // Create formatted text
-    Count = UnicodeVSPrint(mLogChunk->Text + mLogChunk->Size, LOG_CHUNK_SIZE - mLogChunk->Size, Format, Args);
+    Count = UnicodeVSPrint(Text, EFI_PAGES_TO_SIZE(mLogContentsPages) - mLogContentsSize, Format, Args);
     if (Count > 0) {
       // Print to log file
       if (((*Outputs) & LOG_OUTPUT_FILE) != 0) {
@@ -231,11 +1107,9 @@ LogVPrint (
           Path = mLogPath;
         }
         if (Path != NULL) {
-          EFI_STATUS Status;
-          // Append to log file
-          Size = Count * sizeof(CHAR16);
-          Status = FileHandleAppendByPath(NULL, Path, &Size, mLogChunk->Text + mLogChunk->Size);
-          if (EFI_ERROR(Status)) {
+          // Append to log file unless the whole log is saved when finished
+          if (((mLogOutputs & LOG_OUTPUT_DEFERRED) == 0) &&
+              EFI_ERROR(LogFileWrite(Path, Text, Count * sizeof(CHAR16)))) {
             (*Outputs) &= ~LOG_OUTPUT_FILE;
           }
         } else {
@@ -244,29 +1118,93 @@ LogVPrint (
       }
       // Print to console
       if (((*Outputs) & LOG_OUTPUT_CONSOLE) != 0) {
-        // Write to console
-        if (Count >= 256) {
-          CHAR16 Tmp[256];
-          // We may need to break the print string down to be 256 characters since some firmware freak out about larger
-          for (Size = 0; Size < Count; Size += 255) {
-            StrnCpyS(Tmp, 256, mLogChunk->Text + mLogChunk->Size + Size, 255);
-            Print(L"%s", Tmp);
-          }
-        } else {
-          Print(L"%s", mLogChunk->Text + mLogChunk->Size);
-        }
+        LogConsoleWrite(Text, Count);
       }
       // Advance the log
-      mLogChunk->Size += (Count * sizeof(CHAR16));
+      mLogContentsSize += (Count * sizeof(CHAR16));
     }
   }
   return Count;
 }
+// LogPrintText
+/// Format the text of a print and output it
+/// @param Outputs The log output methods to use for printing
+/// @param Path    The log file path for use file output method
+/// @param Format  The format specifier for formatting the text
+/// @param ...     The parameters for the format string
+/// @return The count of characters printed to the log
+STATIC UINTN
+EFIAPI
+LogPrintText (
+  IN OUT UINT32  *Outputs,
+  IN     CHAR16  *Path OPTIONAL,
+  IN     CHAR16  *Format,
+  ...
+) {
+  VA_LIST Args;
+  UINTN   Count;
+  VA_START(Args, Format);
+  Count = LogVPrintText(Outputs, Path, Format, Args);
+  VA_END(Args);
+  return Count;
+}
+// LogVPrintPrefix
+/// Print to the log with an aligned prefix and variable arguments list
+/// @param Outputs The log output methods to use for printing
+/// @param Path    The log file path for use file output method
+/// @param Width   The alignment width
+/// @param Prefix  The aligned prefix
+/// @param Format  The format specifier for formatting the text
+/// @param Args    The variable arguments list for formatting
+/// @return The count of characters printed to the log, which is zero if the print was recorded
+STATIC UINTN
+EFIAPI
+LogVPrintPrefix (
+  IN OUT UINT32  *Outputs,
+  IN     CHAR16  *Path OPTIONAL,
+  IN     UINTN    Width,
+  IN     CHAR16  *Prefix OPTIONAL,
+  IN     CHAR16  *Format OPTIONAL,
+  IN     VA_LIST  Args
+) {
+  UINTN Count = 0;
+  // Record the print if the text is not needed until later
+  if ((((*Outputs) & (LOG_OUTPUT_BINARY | LOG_OUTPUT_CONSOLE)) == LOG_OUTPUT_BINARY) &&
+      ((((*Outputs) & LOG_OUTPUT_FILE) == 0) || ((mLogOutputs & LOG_OUTPUT_DEFERRED) != 0)) &&
+      LogRecord(Width, Prefix, Format, Args)) {
+    return 0;
+  }
+  // Otherwise format the text now
+  if (Prefix != NULL) {
+    Count += LogPrintText(Outputs, Path, L"%- *s ", Width, Prefix);
+  }
+  if (Format != NULL) {
+    Count += LogVPrintText(Outputs, Path, Format, Args);
+  }
+  return Count;
+}
+// LogVPrint
+/// Print to the log with variable arguments list
+/// @param Outputs The log output methods to use for printing
+/// @param Path    The log file path for use file output method
+/// @param Format  The format specifier for formatting the text
+/// @param Args    The variable arguments list for formatting
+/// @return The count of characters printed to the log
+STATIC UINTN
+EFIAPI
+LogVPrint (
+  IN OUT UINT32  *Outputs,
+  IN     CHAR16  *Path OPTIONAL,
+  IN     CHAR16  *Format,
+  IN     VA_LIST  Args
+) {
+  return LogVPrintPrefix(Outputs, Path, 0, NULL, Format, Args);
+}
 // VLog
 /// Log formatted text to log and/or console
 /// @param Format The format specifier for formatting the text
 /// @param Args   The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 VLog (
@@ -283,7 +1221,7 @@ VLog (
 /// @param Prefix The aligned prefix
 /// @param Format The format specifier for formatting the text
 /// @param Args   The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 VLog2 (
@@ -299,7 +1237,7 @@ VLog2 (
 /// @param Prefix The aligned prefix
 /// @param Format The format specifier for formatting the text
 /// @param Args   The parameters for the format string
-/// @return The count of characters written to the log output
+/// @return The count of characters written to the log output, which is zero if the print was recorded to be formatted later
 UINTN
 EFIAPI
 VLog3 (
@@ -308,14 +1246,29 @@ VLog3 (
   CHAR16  *Format,
   VA_LIST  Args
 ) {
-  UINTN Count = 0;
-  if (Prefix != NULL) {
-    Count += Log(L"%- *s ", Width, Prefix);
-  }
-  if (Format != NULL) {
-    Count += VLog(Format, Args);
+  if ((mLog != NULL) && (mLog->VPrintPrefix != NULL)) {
+    return mLog->VPrintPrefix(&mLogOutputs, mLogPath, Width, Prefix, Format, Args);
   }
-  return Count;
+  return LogVPrintPrefix(&mLogOutputs, mLogPath, Width, Prefix, Format, Args);
+}
+// LogPrefix
+/// Format a log prefix into a buffer, so a prefix built from values stays aligned even when the print is recorded to be formatted later
+/// @param Prefix On output, the formatted prefix, which is truncated to the alignment width
+/// @param Format The format specifier for formatting the prefix
+/// @param ...    The parameters for the format string
+/// @return The formatted prefix, which is Prefix
+CHAR16 *
+EFIAPI
+LogPrefix (
+  OUT CHAR16  Prefix[LOG_PREFIX_WIDTH + 1],
+  IN  CHAR16 *Format,
+  ...
+) {
+  VA_LIST Args;
+  VA_START(Args, Format);
+  UnicodeVSPrint(Prefix, (LOG_PREFIX_WIDTH + 1) * sizeof(CHAR16), Format, Args);
+  VA_END(Args);
+  return Prefix;
 }
 
 // SetLogOutput
@@ -336,7 +1289,81 @@ EFIAPI
 SetLogOutput (
   IN UINT32 Outputs
 ) {
-  mLogOutputs = (Outputs & LOG_OUTPUT_ALL);
+  mLogOutputs = (Outputs & (LOG_OUTPUT_ALL | LOG_OUTPUT_DEFERRED | LOG_OUTPUT_BINARY));
+}
+
+// GetLogLevel
+/// Get the runtime log level of a log module
+/// @param Module The log module
+/// @return The log level of the log module or LOG_LEVEL_NONE if the log module is invalid
+UINT32
+EFIAPI
+GetLogLevel (
+  IN UINT32 Module
+) {
+  if (Module >= LOG_MODULE_COUNT) {
+    return LOG_LEVEL_NONE;
+  }
+  return gLogLevels[Module];
+}
+// SetLogLevel
+/// Set the runtime log level of a log module, prints with a higher log level for the log module are skipped before formatting
+/// @param Module The log module or LOG_MODULE_COUNT for all log modules
+/// @param Level  The log level, which is limited to the build log level
+/// @return Whether the log level was set or not
+/// @retval EFI_INVALID_PARAMETER If Module or Level is invalid
+/// @retval EFI_SUCCESS           If the log level was set
+EFI_STATUS
+EFIAPI
+SetLogLevel (
+  IN UINT32 Module,
+  IN UINT32 Level
+) {
+  UINT32 Index;
+  // Check parameters
+  if ((Module > LOG_MODULE_COUNT) || (Level > LOG_LEVEL_VERBOSE)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Levels that were compiled out can not be enabled
+  if (Level > PROJECT_LOG_LEVEL) {
+    Level = PROJECT_LOG_LEVEL;
+  }
+  if (Module < LOG_MODULE_COUNT) {
+    gLogLevels[Module] = Level;
+  } else {
+    for (Index = 0; Index < LOG_MODULE_COUNT; ++Index) {
+      gLogLevels[Index] = Level;
+    }
+  }
+  return EFI_SUCCESS;
+}
+// GetLogLevelName
+/// Get the name of a log level
+/// @param Level The log level
+/// @return The name of the log level or NULL if the log level is invalid
+CHAR16 *
+EFIAPI
+GetLogLevelName (
+  IN UINT32 Level
+) {
+  if (Level >= ARRAY_SIZE(mLogLevelNames)) {
+    return NULL;
+  }
+  return mLogLevelNames[Level];
+}
+// GetLogModuleName
+/// Get the name of a log module
+/// @param Module The log module
+/// @return The name of the log module or NULL if the log module is invalid
+CHAR16 *
+EFIAPI
+GetLogModuleName (
+  IN UINT32 Module
+) {
+  if (Module >= LOG_MODULE_COUNT) {
+    return NULL;
+  }
+  return mLogModuleNames[Module];
 }
 
 // GetLogPath
@@ -416,38 +1443,33 @@ LogSaveLog (
   IN CHAR16  *Path
 ) {
   EFI_STATUS       Status = EFI_NOT_FOUND;
-  LOG_CHUNK       *Chunk = mLogChunks;
   EFI_FILE_HANDLE  Handle = NULL;
+  UINTN            Size;
   // Check parameters
   if (Path == NULL) {
     return EFI_INVALID_PARAMETER;
   }
+  // Format any records first
+  LogRecordsFormat();
+  Size = mLogContentsSize;
   // Nothing to do
-  if (Chunk == NULL) {
+  if (Size == 0) {
     return EFI_SUCCESS;
   }
+  // Write any buffered output and close the log file first since it may be the same file
+  LogFileClose();
   // Open log file
   Status = FileHandleOpen(&Handle, NULL, Path, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_CREATE, 0);
   if (!EFI_ERROR(Status)) {
     // Make sure the file size is zero ie truncate
     Status = FileHandleSetSize(Handle, 0);
     if (!EFI_ERROR(Status)) {
-      // Write each chunk to log file
-      while (Chunk != NULL) {
-        // Write this chunk to log file
-        UINTN Size = Chunk->Size;
-        Status = FileHandleWrite(Handle, &Size, (VOID *)Chunk->Text);
-        if (EFI_ERROR(Status)) {
-          break;
-        }
-        // Get next chunk
-        Chunk = Chunk->Next;
-      }
+      // Write the whole log contents at once
+      Status = FileHandleWrite(Handle, &Size, (VOID *)mLogContents);
     }
     // Close the file
     FileHandleClose(Handle);
   }
-  // Return the last chunk status
   return Status;
 }
 // SaveLog
@@ -468,6 +1490,142 @@ SaveLog (
   return LogSaveLog(Path);
 }
 
+// LogGetContents
+/// Get the contiguous log contents
+/// @param Contents On output, the log text
+/// @param Size     On output, the size, in bytes, of the log text
+/// @return Whether the log contents were returned or not
+/// @retval EFI_INVALID_PARAMETER If Contents or Size is NULL
+/// @retval EFI_NOT_FOUND         If the log is empty
+/// @retval EFI_SUCCESS           If the log contents were returned
+STATIC EFI_STATUS
+EFIAPI
+LogGetContents (
+  OUT CHAR16 **Contents,
+  OUT UINTN   *Size
+) {
+  // Check parameters
+  if ((Contents == NULL) || (Size == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  LogRecordsFormat();
+  if (mLogContentsSize == 0) {
+    return EFI_NOT_FOUND;
+  }
+  *Contents = mLogContents;
+  *Size = mLogContentsSize;
+  return EFI_SUCCESS;
+}
+// GetLogContents
+/// Get the contiguous log contents without copying, for writing the whole log with a single write
+/// @param Contents On output, the log text, which is not null terminated, must not be changed or freed, and is only valid until the next log print
+/// @param Size     On output, the size, in bytes, of the log text
+/// @return Whether the log contents were returned or not
+/// @retval EFI_INVALID_PARAMETER If Contents or Size is NULL
+/// @retval EFI_NOT_FOUND         If the log is empty
+/// @retval EFI_SUCCESS           If the log contents were returned
+EFI_STATUS
+EFIAPI
+GetLogContents (
+  OUT CHAR16 **Contents,
+  OUT UINTN   *Size
+) {
+  if ((mLog != NULL) && (mLog->GetContents != NULL)) {
+    return mLog->GetContents(Contents, Size);
+  }
+  return LogGetContents(Contents, Size);
+}
+
+// LogSetCapacity
+/// Bound the log contents
+/// @param Capacity The capacity, in bytes, of the log contents or zero for no bound
+/// @param Pinned   The size, in bytes, of text at the start of the log that is never discarded
+/// @return Whether the log contents were bounded or not
+/// @retval EFI_INVALID_PARAMETER If Capacity is less than LOG_CAPACITY_MIN or Pinned is more than half of Capacity
+/// @retval EFI_SUCCESS           If the log contents were bounded
+STATIC EFI_STATUS
+EFIAPI
+LogSetCapacity (
+  IN UINTN Capacity,
+  IN UINTN Pinned
+) {
+  // Check parameters
+  if ((Capacity != 0) && ((Capacity < LOG_CAPACITY_MIN) || (Pinned > (Capacity >> 1)) || (mLogKept > (Capacity >> 1)))) {
+    return EFI_INVALID_PARAMETER;
+  }
+  mLogCapacity = Capacity;
+  // The pinned text can not change once text has been discarded
+  if (mLogLostSize == 0) {
+    mLogPinned = Pinned;
+  }
+  return EFI_SUCCESS;
+}
+// SetLogCapacity
+/// Bound the log contents so the oldest whole lines are discarded when the log is full, except the pinned text at the start of the log, such as the boot header
+/// @param Capacity The capacity, in bytes, of the log contents or zero for no bound
+/// @param Pinned   The size, in bytes, of text at the start of the log that is never discarded, which is rounded down to a whole line and can not change once text has been discarded
+/// @return Whether the log contents were bounded or not
+/// @retval EFI_INVALID_PARAMETER If Capacity is less than LOG_CAPACITY_MIN or Pinned is more than half of Capacity
+/// @retval EFI_SUCCESS           If the log contents were bounded
+EFI_STATUS
+EFIAPI
+SetLogCapacity (
+  IN UINTN Capacity,
+  IN UINTN Pinned
+) {
+  if ((mLog != NULL) && (mLog->SetCapacity != NULL)) {
+    return mLog->SetCapacity(Capacity, Pinned);
+  }
+  return LogSetCapacity(Capacity, Pinned);
+}
+// LogGetLost
+/// Get the count of lines discarded from a bounded log
+/// @return The count of lines discarded
+STATIC UINT64
+EFIAPI
+LogGetLost (
+  VOID
+) {
+  return mLogLost;
+}
+// GetLogLost
+/// Get the count of lines discarded from a bounded log
+/// @return The count of lines discarded
+UINT64
+EFIAPI
+GetLogLost (
+  VOID
+) {
+  if ((mLog != NULL) && (mLog->GetLost != NULL)) {
+    return mLog->GetLost();
+  }
+  return LogGetLost();
+}
+
+// LogFlush
+/// Write any buffered log output now
+STATIC VOID
+EFIAPI
+LogFlush (
+  VOID
+) {
+  LogConsoleFlush();
+  LogFileFlush(TRUE);
+}
+// FlushLog
+/// Write any buffered log output to the console and log file now, such as before waiting for input
+VOID
+EFIAPI
+FlushLog (
+  VOID
+) {
+  if ((mLog != NULL) && (mLog->Flush != NULL)) {
+    mLog->Flush();
+  } else {
+    LogFlush();
+  }
+}
+
 // LogDateTime
 /// Log the date and/or time
 /// @param Date Log the date
@@ -530,6 +1688,19 @@ LogTime (
 ) {
   return LogDateTime(NULL, LOG_TIME);
 }
+// LogCounterDifference
+/// Get the count of performance counter ticks between two performance counter values, the performance counter may count up or down
+/// @param Start The earlier performance counter value
+/// @param End   The later performance counter value
+/// @return The count of performance counter ticks between the values
+STATIC UINT64
+EFIAPI
+LogCounterDifference (
+  IN UINT64 Start,
+  IN UINT64 End
+) {
+  return (End > Start) ? (End - Start) : (Start - End);
+}
 // LogTimestamp
 /// Log a timestamp
 /// @return The number of characters logged
@@ -540,13 +1711,181 @@ LogTimestamp (
 ) {
   UINT64 Start = ((mLog == NULL) || (mLog->GetStart == NULL)) ? mLogCounterStart : mLog->GetStart();
   UINT64 Counter = GetPerformanceCounter();
-  UINT64 Nanoseconds = GetTimeInNanoSecond((Counter > Start) ? (Counter - Start) : (Start - Counter));
+  UINT64 Nanoseconds = GetTimeInNanoSecond(LogCounterDifference(Start, Counter));
   UINT64 Seconds = DivU64x64Remainder(Nanoseconds, 1000000000, &Nanoseconds);
   UINT64 Minutes = DivU64x64Remainder(Seconds, 60, &Seconds);
   UINT64 Hours = DivU64x64Remainder(Minutes, 60, &Minutes);
   return Log(L"%u:%02u:%02u.%03u", (UINT32)Hours, (UINT32)Minutes, (UINT32)Seconds, (UINT32)DivU64x32(Nanoseconds, 1000000));
 }
 
+// LogSpanBegin
+/// Begin a timing span
+/// @param Name The name of the timing span
+/// @return The timing span or LOG_SPAN_INVALID if no more timing spans can be recorded
+STATIC UINTN
+EFIAPI
+LogSpanBegin (
+  IN CHAR16 *Name
+) {
+  LOG_SPAN *Span;
+  if ((Name == NULL) || (mLogSpanCount >= LOG_SPAN_MAX)) {
+    return LOG_SPAN_INVALID;
+  }
+  Span = mLogSpans + mLogSpanCount;
+  StrnCpyS(Span->Name, LOG_SPAN_NAME_LENGTH, Name, LOG_SPAN_NAME_LENGTH - 1);
+  Span->End = 0;
+  Span->Depth = mLogSpanDepth++;
+  Span->Begin = GetPerformanceCounter();
+  return mLogSpanCount++;
+}
+// BeginLogSpan
+/// Begin a timing span, which is nested inside any timing spans that are open
+/// @param Name The name of the timing span, which is copied and may be truncated
+/// @return The timing span to end or LOG_SPAN_INVALID if no more timing spans can be recorded
+UINTN
+EFIAPI
+BeginLogSpan (
+  IN CHAR16 *Name
+) {
+  if ((mLog != NULL) && (mLog->SpanBegin != NULL)) {
+    return mLog->SpanBegin(Name);
+  }
+  return LogSpanBegin(Name);
+}
+// LogSpanEnd
+/// End a timing span
+/// @param Span The timing span
+STATIC VOID
+EFIAPI
+LogSpanEnd (
+  IN UINTN Span
+) {
+  UINT64 Counter = GetPerformanceCounter();
+  if ((Span >= mLogSpanCount) || (mLogSpans[Span].End != 0)) {
+    return;
+  }
+  mLogSpans[Span].End = Counter;
+  if (mLogSpanDepth > 0) {
+    --mLogSpanDepth;
+  }
+}
+// EndLogSpan
+/// End a timing span
+/// @param Span The timing span returned when it began, nothing happens if it is LOG_SPAN_INVALID
+VOID
+EFIAPI
+EndLogSpan (
+  IN UINTN Span
+) {
+  if ((mLog != NULL) && (mLog->SpanEnd != NULL)) {
+    mLog->SpanEnd(Span);
+  } else {
+    LogSpanEnd(Span);
+  }
+}
+// LogSpanEscape
+/// Escape a timing span name as the contents of a JSON string
+/// @param Name    The timing span name
+/// @param Escaped On output, the escaped name
+STATIC VOID
+EFIAPI
+LogSpanEscape (
+  IN  CHAR16 *Name,
+  OUT CHAR8   Escaped[LOG_SPAN_ESCAPED_SIZE]
+) {
+  UINTN Size = 0;
+  for (; *Name != L'\0'; ++Name) {
+    if ((*Name == L'"') || (*Name == L'\\')) {
+      Escaped[Size++] = '\\';
+      Escaped[Size++] = (CHAR8)*Name;
+    } else if ((*Name < 0x20) || (*Name >= 0x7F)) {
+      // Control and non-ASCII characters are written as code units
+      Size += AsciiSPrint(Escaped + Size, LOG_SPAN_ESCAPED_SIZE - Size, "\\u%04x", (UINT32)*Name);
+    } else {
+      Escaped[Size++] = (CHAR8)*Name;
+    }
+  }
+  Escaped[Size] = '\0';
+}
+// LogSaveSpans
+/// Save the timing spans to a trace file
+/// @param Path The trace file path
+/// @return Whether the trace file was saved or not
+/// @retval EFI_INVALID_PARAMETER If Path is NULL
+/// @retval EFI_NOT_FOUND         If there are no timing spans
+/// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
+/// @retval EFI_SUCCESS           If the trace file was saved
+STATIC EFI_STATUS
+EFIAPI
+LogSaveSpans (
+  IN CHAR16 *Path
+) {
+  EFI_STATUS       Status;
+  EFI_FILE_HANDLE  Handle = NULL;
+  CHAR8           *Trace;
+  UINT64           Now = GetPerformanceCounter();
+  UINT64           End;
+  UINTN            Size;
+  UINTN            Index;
+  CHAR8            Name[LOG_SPAN_ESCAPED_SIZE];
+  // Check parameters
+  if (Path == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  if (mLogSpanCount == 0) {
+    return EFI_NOT_FOUND;
+  }
+  // Create the trace events, in microseconds, with timing spans that have not ended lasting until now
+  Trace = (CHAR8 *)AllocatePool((mLogSpanCount + 1) * LOG_SPAN_EVENT_SIZE);
+  if (Trace == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Size = AsciiSPrint(Trace, LOG_SPAN_EVENT_SIZE, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  for (Index = 0; Index < mLogSpanCount; ++Index) {
+    End = (mLogSpans[Index].End != 0) ? mLogSpans[Index].End : Now;
+    LogSpanEscape(mLogSpans[Index].Name, Name);
+    Size += AsciiSPrint(Trace + Size, LOG_SPAN_EVENT_SIZE,
+                        "%a\n{\"name\":\"%a\",\"cat\":\"boot\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%lu,\"dur\":%lu,\"args\":{\"depth\":%u}}",
+                        (Index == 0) ? "" : ",", Name,
+                        DivU64x32(GetTimeInNanoSecond(LogCounterDifference(mLogCounterStart, mLogSpans[Index].Begin)), 1000),
+                        DivU64x32(GetTimeInNanoSecond(LogCounterDifference(mLogSpans[Index].Begin, End)), 1000),
+                        mLogSpans[Index].Depth);
+  }
+  Size += AsciiSPrint(Trace + Size, LOG_SPAN_EVENT_SIZE, "\n]}\n");
+  // Write the trace file
+  Status = FileHandleOpen(&Handle, NULL, Path, EFI_FILE_MODE_READ | EFI_FILE_MODE_WRITE | EFI_FILE_MODE_CREATE, 0);
+  if (!EFI_ERROR(Status)) {
+    // Make sure the file size is zero ie truncate
+    Status = FileHandleSetSize(Handle, 0);
+    if (!EFI_ERROR(Status)) {
+      Status = FileHandleWrite(Handle, &Size, Trace);
+    }
+    FileHandleClose(Handle);
+  }
+  FreePool(Trace);
+  return Status;
+}
+// SaveLogSpans
+/// Save the timing spans to a trace file in the Chrome trace event format
+/// @param Path The trace file path or NULL for the default trace file next to the default log file
+/// @return Whether the trace file was saved or not
+/// @retval EFI_NOT_FOUND        If there are no timing spans
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the trace file was saved
+EFI_STATUS
+EFIAPI
+SaveLogSpans (
+  IN CHAR16 *Path OPTIONAL
+) {
+  if (Path == NULL) {
+    Path = LOG_SPANS_FILE;
+  }
+  if ((mLog != NULL) && (mLog->SaveSpans != NULL)) {
+    return mLog->SaveSpans(Path);
+  }
+  return LogSaveSpans(Path);
+}
+
 // PrintLogInformation
 /// Print log information
 STATIC VOID
@@ -574,6 +1913,12 @@ PrintLogInformation (
   } else {
     Log2(L"Log outputs:", L"None\n");
   }
+  if ((mLogOutputs & (LOG_OUTPUT_FILE | LOG_OUTPUT_DEFERRED)) == (LOG_OUTPUT_FILE | LOG_OUTPUT_DEFERRED)) {
+    Log2(L"Log file writes:", L"Deferred\n");
+  }
+  if ((mLogOutputs & LOG_OUTPUT_BINARY) != 0) {
+    Log2(L"Log formatting:", L"Deferred\n");
+  }
 }
 
 // SetBestConsoleMode
@@ -632,12 +1977,61 @@ LogGetStart (
   return mLogCounterStart;
 }
 
+// LogBeforeExitNotify
+/// Notification of before exit boot services event, while boot services can still be used
+/// @param Event   The event that triggered the notification
+/// @param Context The context passed when registering this notification
+STATIC VOID
+EFIAPI
+LogBeforeExitNotify (
+  IN EFI_EVENT  Event,
+  IN VOID      *Context
+) {
+  // Timers stop when boot services exit so write console output as it is printed
+  LogConsoleFlush();
+  mLogConsoleEvent = NULL;
+  // Format any records while memory can still be allocated
+  LogRecordsFormat();
+  // Write the log while the file system is still available
+  if ((mLogOutputs & (LOG_OUTPUT_FILE | LOG_OUTPUT_DEFERRED)) == (LOG_OUTPUT_FILE | LOG_OUTPUT_DEFERRED)) {
+    LogSaveLog(mLogPath);
+  } else {
+    LogFileClose();
+  }
+  // There is no file output once the log is saved
+  mLogOutputs &= ~LOG_OUTPUT_FILE;
+  mLogFileStatus = EFI_UNSUPPORTED;
+}
+// LogExitNotify
+/// Notification of exit boot services event, which must not use boot services so only stops output that needs them
+/// @param Event   The event that triggered the notification
+/// @param Context The context passed when registering this notification
+STATIC VOID
+EFIAPI
+LogExitNotify (
+  IN EFI_EVENT  Event,
+  IN VOID      *Context
+) {
+  // The console and file system belong to boot services
+  mLogConsoleEvent = NULL;
+  mLogOutputs &= ~(LOG_OUTPUT_CONSOLE | LOG_OUTPUT_FILE);
+  mLogFileStatus = EFI_UNSUPPORTED;
+}
+
 // mLogProtocol
 /// Log protocol
 STATIC LOG_PROTOCOL mLogProtocol = {
   LogVPrint,
   LogGetStart,
-  LogSaveLog
+  LogSaveLog,
+  LogGetContents,
+  LogVPrintPrefix,
+  LogFlush,
+  LogSetCapacity,
+  LogGetLost,
+  LogSpanBegin,
+  LogSpanEnd,
+  LogSaveSpans
 };
 
 // LogLibInitialize
@@ -675,11 +2069,37 @@ LogLibInitialize (
   }
   // Print log information
   PrintLogInformation();
+  // Create events to flush the log file periodically, to save it before boot services exit and stop output when they exit, and to flush the console shortly after output
+  if ((gBS->CreateEvent != NULL) && (gBS->SetTimer != NULL) && (gBS->CloseEvent != NULL)) {
+    if (!EFI_ERROR(gBS->CreateEvent(EVT_TIMER | EVT_NOTIFY_SIGNAL, TPL_CALLBACK, LogFlushNotify, NULL, &mLogFlushEvent)) &&
+        EFI_ERROR(gBS->SetTimer(mLogFlushEvent, TimerPeriodic, LOG_FLUSH_INTERVAL))) {
+      gBS->CloseEvent(mLogFlushEvent);
+      mLogFlushEvent = NULL;
+    }
+    if ((gBS->CreateEventEx == NULL) ||
+        EFI_ERROR(gBS->CreateEventEx(EVT_NOTIFY_SIGNAL, TPL_CALLBACK, LogBeforeExitNotify, NULL, &gEfiEventBeforeExitBootServicesGuid, &mLogBeforeExitEvent))) {
+      mLogBeforeExitEvent = NULL;
+    }
+    if (EFI_ERROR(gBS->CreateEvent(EVT_SIGNAL_EXIT_BOOT_SERVICES, TPL_CALLBACK, LogExitNotify, NULL, &mLogExitEvent))) {
+      mLogExitEvent = NULL;
+    }
+    if (EFI_ERROR(gBS->CreateEvent(EVT_TIMER | EVT_NOTIFY_SIGNAL, TPL_CALLBACK, LogConsoleNotify, NULL, &mLogConsoleEvent))) {
+      mLogConsoleEvent = NULL;
+    }
+  }
   // Install log protocol
   mLogHandle = NULL;
   mLogProtocol.VPrint = LogVPrint,
   mLogProtocol.GetStart = LogGetStart;
   mLogProtocol.Save = LogSaveLog;
+  mLogProtocol.GetContents = LogGetContents;
+  mLogProtocol.VPrintPrefix = LogVPrintPrefix;
+  mLogProtocol.Flush = LogFlush;
+  mLogProtocol.SetCapacity = LogSetCapacity;
+  mLogProtocol.GetLost = LogGetLost;
+  mLogProtocol.SpanBegin = LogSpanBegin;
+  mLogProtocol.SpanEnd = LogSpanEnd;
+  mLogProtocol.SaveSpans = LogSaveSpans;
   return gBS->InstallMultipleProtocolInterfaces(&mLogHandle, &mLogGuid, &mLogProtocol, NULL);
 }
 // LogLibFinish
@@ -691,23 +2111,67 @@ EFIAPI
 LogLibFinish (
   VOID
 ) {
+  CHAR16 *Contents;
+  UINTN   Size;
+  // Format any records now since they may use format strings from this image
+  if ((mLog != NULL) && ((mLogOutputs & LOG_OUTPUT_BINARY) != 0)) {
+    GetLogContents(&Contents, &Size);
+  }
   // Uninstall log
   mLog = NULL;
   if (mLogHandle != NULL) {
     gBS->UninstallMultipleProtocolInterfaces(mLogHandle, &mLogGuid, (VOID *)&mLogProtocol, NULL);
     mLogHandle = NULL;
   }
+  // Cancel the log file and console events
+  if (mLogFlushEvent != NULL) {
+    gBS->CloseEvent(mLogFlushEvent);
+    mLogFlushEvent = NULL;
+  }
+  if (mLogBeforeExitEvent != NULL) {
+    gBS->CloseEvent(mLogBeforeExitEvent);
+    mLogBeforeExitEvent = NULL;
+  }
+  if (mLogExitEvent != NULL) {
+    gBS->CloseEvent(mLogExitEvent);
+    mLogExitEvent = NULL;
+  }
+  if (mLogConsoleEvent != NULL) {
+    gBS->CloseEvent(mLogConsoleEvent);
+    mLogConsoleEvent = NULL;
+  }
+  LogConsoleFlush();
+  // Save the whole log in one pass if deferred, otherwise write any buffered output
+  if ((mLogPath != NULL) && ((mLogOutputs & (LOG_OUTPUT_FILE | LOG_OUTPUT_DEFERRED)) == (LOG_OUTPUT_FILE | LOG_OUTPUT_DEFERRED))) {
+    LogSaveLog(mLogPath);
+  } else {
+    LogFileClose();
+  }
+  if (mLogBuffer != NULL) {
+    FreePool(mLogBuffer);
+    mLogBuffer = NULL;
+  }
   // Free the log path
   if (mLogPath != NULL) {
     FreePool(mLogPath);
     mLogPath = NULL;
   }
-  // Free all the log chunks
-  while (mLogChunks != NULL) {
-    mLogChunk = mLogChunks;
-    mLogChunks = mLogChunk->Next;
-    FreePages(mLogChunk, EFI_SIZE_TO_PAGES(LOG_CHUNK_SIZE));
+  // Free the log contents
+  if (mLogContents != NULL) {
+    FreePages(mLogContents, mLogContentsPages);
+    mLogContents = NULL;
+  }
+  mLogContentsSize = 0;
+  mLogContentsPages = 0;
+  mLogKept = 0;
+  mLogLost = 0;
+  mLogLostSize = 0;
+  // Free the log records
+  while (mLogRecords != NULL) {
+    mLogRecordsLast = mLogRecords;
+    mLogRecords = mLogRecordsLast->Next;
+    FreePages(mLogRecordsLast, LOG_RECORDS_PAGES);
   }
-  mLogChunk = NULL;
+  mLogRecordsLast = NULL;
   return EFI_SUCCESS;
 }
@@ -79,6 +79,9 @@ struct _LANG_PARSER {
   // TokenSize
   /// The current parsed token maximum count of characters, including null-terminator
   UINTN           TokenSize;
+  // TokenLimit
+  /// The maximum size, in bytes, of the current parsed token buffer, zero for no limit
+  UINTN           TokenLimit;
   // Token
   /// The current parsed token
   CHAR16         *Token;
@@ -396,6 +399,7 @@ ParseCharacter (
   IN     VOID        *Context OPTIONAL
 ) {
   EFI_STATUS Status;
+  UINTN      Size;
   // Check parameters
   if (Parser == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -409,6 +413,16 @@ ParseCharacter (
     ParseError(Parser, L"Invalid parser state");
     return EFI_NOT_FOUND;
   }
+  // Check the token buffer would not grow past the limit before it is grown by appending
+  if ((Parser->TokenLimit != 0) &&
+      ((Parser->Token == NULL) || (Parser->TokenCount >= Parser->TokenSize) || ((Parser->TokenSize - Parser->TokenCount) < 3))) {
+    // The token buffer starts with eight characters and then doubles in size
+    Size = ((Parser->TokenSize == 0) || (Parser->TokenCount >= Parser->TokenSize)) ? 8 : (Parser->TokenSize * 2);
+    if ((Size * sizeof(CHAR16)) > Parser->TokenLimit) {
+      ParseError(Parser, L"Token too large");
+      return EFI_BUFFER_TOO_SMALL;
+    }
+  }
   // Append the character to the token
   Status = StrAppend(&(Parser->Token), &(Parser->TokenCount), &(Parser->TokenSize), Character);
   if (EFI_ERROR(Status)) {
@@ -1105,6 +1119,48 @@ SetParseState (
   // Set the state
   return SetNextParseState(Parser, Id, FALSE);
 }
+// SetParseTokenLimit
+/// Set the maximum size of the language parser token buffer
+/// @param Parser The language parser
+/// @param Limit  The maximum size, in bytes, of the token buffer or zero for no limit
+/// @return Whether the token buffer limit was set or not
+/// @retval EFI_INVALID_PARAMETER If Parser is NULL
+/// @retval EFI_SUCCESS           If the token buffer limit was set successfully
+EFI_STATUS
+EFIAPI
+SetParseTokenLimit (
+  IN OUT LANG_PARSER *Parser,
+  IN     UINTN        Limit
+) {
+  // Check parameters
+  if (Parser == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Set the token buffer limit
+  Parser->TokenLimit = Limit;
+  return EFI_SUCCESS;
+}
+// GetParseTokenSize
+/// Get the allocated size of the language parser token buffer
+/// @param Parser The language parser
+/// @param Size   On output, the size, in bytes, of the allocated token buffer
+/// @return Whether the token buffer size was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Parser or Size is NULL
+/// @retval EFI_SUCCESS           If the token buffer size was retrieved successfully
+EFI_STATUS
+EFIAPI
+GetParseTokenSize (
+  IN  LANG_PARSER *Parser,
+  OUT UINTN       *Size
+) {
+  // Check parameters
+  if ((Parser == NULL) || (Size == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Return the token buffer size
+  *Size = (Parser->Token == NULL) ? 0 : (Parser->TokenSize * sizeof(CHAR16));
+  return EFI_SUCCESS;
+}
 // GetParseState
 /// Get the language parser state
 /// @param Parser The language parser
@@ -1380,6 +1436,7 @@ FreeParser (
   Parser->DecodedCharacter = 0;
   Parser->TokenCount = 0;
   Parser->TokenSize = 0;
+  Parser->TokenLimit = 0;
   // Free the parser
   FreePool(Parser);
   return EFI_SUCCESS;
@@ -11,7 +11,36 @@
 
 // CPU_FEATURE_PRINT
 /// Print a CPU package feature and value
-#define CPU_FEATURE_PRINT(Feature) LOG3(33, L"      " L ## #Feature L":", L"%a\n", ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\" L ## #Feature, FALSE, Index) ? "true" : "false")
+#define CPU_FEATURE_PRINT(Feature) LOG3_VERBOSE(LOG_MODULE_PLATFORM, 33, L"      " L ## #Feature L":", L"%a\n", ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\" L ## #Feature, FALSE) ? "true" : "false")
+
+// CPU_SMBIOS_OVERRIDE
+/// Which CPU package information is overridden by SMBIOS
+typedef struct _CPU_SMBIOS_OVERRIDE CPU_SMBIOS_OVERRIDE;
+struct _CPU_SMBIOS_OVERRIDE {
+
+  // All
+  /// Whether all information is overridden by SMBIOS
+  BOOLEAN All;
+  // CPU
+  /// Whether all CPU information is overridden by SMBIOS
+  BOOLEAN CPU;
+  // Clock
+  /// Whether the CPU clock is overridden by SMBIOS
+  BOOLEAN Clock;
+  // Frequency
+  /// Whether the CPU frequency is overridden by SMBIOS
+  BOOLEAN Frequency;
+
+};
+
+// mCPUSmBiosOverrideSchema
+/// The SMBIOS override configuration section schema
+STATIC CONFIG_SCHEMA mCPUSmBiosOverrideSchema[] = {
+  CONFIG_SCHEMA_BOOLEAN(L"Override", CPU_SMBIOS_OVERRIDE, All, FALSE),
+  CONFIG_SCHEMA_BOOLEAN(L"Override\\CPU", CPU_SMBIOS_OVERRIDE, CPU, FALSE),
+  CONFIG_SCHEMA_BOOLEAN(L"Override\\CPU\\Clock", CPU_SMBIOS_OVERRIDE, Clock, FALSE),
+  CONFIG_SCHEMA_BOOLEAN(L"Override\\CPU\\Frequency", CPU_SMBIOS_OVERRIDE, Frequency, FALSE)
+};
 
 // mCPUIDRegisters
 /// Registers for CPUID results
@@ -22,6 +51,15 @@ UINT32 mCPUMaxIndex = 0;
 // mCPUMaxExtIndex
 /// CPU maximum extended CPUID index
 UINT32 mCPUMaxExtIndex = 0x80000000;
+// mCPUSubscription
+/// The first package configuration change subscription
+STATIC CONFIG_SUBSCRIPTION *mCPUSubscription = NULL;
+// mCPUGeneration
+/// The first package configuration change generation of the cached CPU frequency
+STATIC UINTN                mCPUGeneration = 0;
+// mCPUFrequency
+/// The cached CPU frequency
+STATIC UINT64               mCPUFrequency = 0;
 
 // GetPackageFrequency
 /// Get CPU package frequency
@@ -31,9 +69,9 @@ EFIAPI
 GetPackageFrequency (
   UINTN Index
 ) {
-  return RShiftU64(MultU64x64(ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Clock", 0, Index),
-                              ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Maximum", 1, Index)),
-                              ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Step", 0, Index));
+  return RShiftU64(MultU64x64(ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Clock", 0),
+                              ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Maximum", 1)),
+                              ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Step", 0));
 }
 // PrintCPUInformation
 /// Print CPU package information
@@ -42,9 +80,10 @@ EFIAPI
 PrintCPUInformation (
   VOID
 ) {
-  UINTN Index;
-  UINTN PackageCount;
-  UINTN TurboCount;
+  UINTN  Index;
+  UINTN  PackageCount;
+  UINTN  TurboCount;
+  CHAR16 Prefix[LOG_PREFIX_WIDTH + 1];
   // Print package information
   Log2(L"Total threads:", L"%u\n", ConfigGetUnsignedWithDefault(L"\\CPU\\Threads", 1));
   Log2(L"Total cores:", L"%u\n", ConfigGetUnsignedWithDefault(L"\\CPU\\Cores", 1));
@@ -52,15 +91,15 @@ PrintCPUInformation (
   Log2(L"Packages:", L"%u\n", PackageCount);
   // Print information about each package
   for (Index = 0; Index < PackageCount; ++Index) {
-    Log3(LOG_PREFIX_WIDTH - Log(L"  Package(%u)", Index), L":", L"%s\n", ConfigSGetStringWithDefault(L"\\CPU\\Package\\%u\\Description", L"Unknown CPU", Index));
-    Log2(L"    Model:", L"%X\n", ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Model", 0, Index));
-    Log2(L"    Threads:", L"%u\n", ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Threads", 1, Index));
-    Log2(L"    Cores:", L"%u\n", ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Threads", 1, Index));
+    Log2(LogPrefix(Prefix, L"  Package(%u):", Index), L"%s\n", ConfigGetIndexedStringWithDefault(L"\\CPU\\Package", Index, L"Description", L"Unknown CPU"));
+    Log2(L"    Model:", L"%X\n", ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Model", 0));
+    Log2(L"    Threads:", L"%u\n", ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Threads", 1));
+    Log2(L"    Cores:", L"%u\n", ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Threads", 1));
     Log2(L"    Frequency:", L"%uMHz\n", DivU64x32(GetPackageFrequency(Index), 1000000));
-    Log2(L"    Clock:", L"%ukHz\n", DivU64x32(ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Clock", 1, Index), 1000));
-    Log2(L"    Minimum:", L"%u\n", ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Minimum", 1, Index));
-    Log2(L"    Maximum:", L"%u\n", ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Maximum", 1, Index));
-    TurboCount = ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Turbo\\Count", 0, Index);
+    Log2(L"    Clock:", L"%ukHz\n", DivU64x32(ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Clock", 1), 1000));
+    Log2(L"    Minimum:", L"%u\n", ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Minimum", 1));
+    Log2(L"    Maximum:", L"%u\n", ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Maximum", 1));
+    TurboCount = ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Turbo\\Count", 0);
     if (TurboCount > 0) {
       UINTN TurboIndex = 0;
       Log2(L"    Turbo:", L"%u", ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Turbo\\%u", 1, Index, TurboIndex));
@@ -72,7 +111,7 @@ PrintCPUInformation (
       Log2(L"    Turbo:", L"false\n");
     }
     // Print package features
-    LOG(L"    Features:\n");
+    LOG_VERBOSE(LOG_MODULE_PLATFORM, L"    Features:\n");
     CPU_FEATURE_PRINT(FPUOnChip);
     CPU_FEATURE_PRINT(VirtualModeEnhancements);
     CPU_FEATURE_PRINT(DebugExtensions);
@@ -221,7 +260,31 @@ EFIAPI
 GetCPUFrequency (
   VOID
 ) {
-  return GetPackageFrequency(0);
+  UINTN Generation;
+  // Keep the frequency until the first package configuration changes since this is used for every timer delay
+  if ((mCPUSubscription == NULL) && EFI_ERROR(ConfigSubscribe(L"\\CPU\\Package\\0", NULL, NULL, &mCPUSubscription))) {
+    mCPUSubscription = NULL;
+    return GetPackageFrequency(0);
+  }
+  Generation = ConfigSubscriptionGeneration(mCPUSubscription);
+  if (Generation != mCPUGeneration) {
+    mCPUFrequency = GetPackageFrequency(0);
+    mCPUGeneration = Generation;
+  }
+  return mCPUFrequency;
+}
+// FinishCPUInformation
+/// Free the CPU configuration change subscription
+VOID
+EFIAPI
+FinishCPUInformation (
+  VOID
+) {
+  if (mCPUSubscription != NULL) {
+    ConfigUnsubscribe(mCPUSubscription);
+    mCPUSubscription = NULL;
+  }
+  mCPUGeneration = 0;
 }
 // IsCPUMobile
 /// Check if CPU is mobile
@@ -317,6 +380,37 @@ DetermineCPUVendor (
   return CPU_VENDOR_UNKNOWN;
 }
 
+// GetCPUIdentity
+/// Get the CPU identity, which changes when the processor or its microcode changes
+/// @param Signature On output, the CPUID processor signature
+/// @param Microcode On output, the microcode revision or zero if unknown
+VOID
+EFIAPI
+GetCPUIdentity (
+  OUT UINT32 *Signature,
+  OUT UINT32 *Microcode
+) {
+  CPU_VENDOR Vendor = DetermineCPUVendor();
+  *Signature = 0;
+  *Microcode = 0;
+  if (mCPUMaxIndex < 0x1) {
+    return;
+  }
+  if (Vendor == CPU_VENDOR_INTEL) {
+    // The revision is only reported in IA32_BIOS_SIGN_ID after clearing it and performing CPUID
+    AsmWriteMsr64(0x8B, 0);
+    CPUID(1);
+    *Microcode = (UINT32)RShiftU64(AsmReadMsr64(0x8B), 32);
+  } else {
+    CPUID(1);
+    if (Vendor == CPU_VENDOR_AMD) {
+      // Patch level
+      *Microcode = (UINT32)AsmReadMsr64(0x8B);
+    }
+  }
+  *Signature = mCPUIDRegisters[0];
+}
+
 // UpdatePackageInformation
 /// Update package information
 /// @param Index The physical package index
@@ -334,7 +428,7 @@ UpdatePackageInformation (
   }
 
   // Set vendor for this package in configuration
-  Status = ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Vendor", (UINTN)Vendor, Index);
+  Status = ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Vendor", (UINTN)Vendor);
   if (EFI_ERROR(Status)) {
     return Status;
   }
@@ -357,15 +451,14 @@ EFIAPI
 UpdatePackagesInformation (
   VOID
 ) {
-  SMBIOS_STRUCTURE **Tables = NULL;
-  UINTN              Count = 0;
-  UINTN              Index;
+  SMBIOS_STRUCTURE  **Tables = NULL;
+  UINTN               Count = 0;
+  UINTN               Index;
+  CPU_SMBIOS_OVERRIDE Override;
 
   // Check if CPU information should be updated by SMBIOS
-  if (ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override", FALSE) ||
-      ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override\\CPU", FALSE) ||
-      ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override\\CPU\\Clock", FALSE) ||
-      ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override\\CPU\\Frequency", FALSE)) {
+  ConfigSectionLoad(L"\\SMBIOS", mCPUSmBiosOverrideSchema, ARRAY_SIZE(mCPUSmBiosOverrideSchema), &Override, NULL);
+  if (Override.All || Override.CPU || Override.Clock || Override.Frequency) {
     // Update CPU information with information from SMBIOS
     Count = 0;
     Tables = NULL;
@@ -378,20 +471,15 @@ UpdatePackagesInformation (
           // Check processor tray is populated and enabled
           if ((CPUBitmask(Type4->Status, 6, 6) == 1) && (CPUBitmask(Type4->Status, 0, 2) == 1) && (Type4->ProcessorType == CentralProcessor)) {
             // Adjust package information
-            if ((Type4->ExternalClock != 0) &&
-                (ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override", FALSE) ||
-                 ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override\\CPU", FALSE) ||
-                 ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override\\CPU\\Clock", FALSE))) {
+            if ((Type4->ExternalClock != 0) && (Override.All || Override.CPU || Override.Clock)) {
               // Adjust package clock
-              ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", Type4->ExternalClock * 1000000, PkgIndex);
+              ConfigSetIndexedUnsigned(L"\\CPU\\Package", PkgIndex, L"Clock", Type4->ExternalClock * 1000000);
             }
-            if (ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override", FALSE) ||
-                ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override\\CPU", FALSE) ||
-                ConfigGetBooleanWithDefault(L"\\SMBIOS\\Override\\CPU\\Frequency", FALSE)) {
+            if (Override.All || Override.CPU || Override.Frequency) {
               // Adjust package frequency
-              UINT64 Frequency = LShiftU64(MultU64x32((UINT64)Type4->CurrentSpeed, 1000000), ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Step", 0, PkgIndex));
-              ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum",
-                                (UINTN)DivU64x64Remainder(Frequency, ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Clock", (UINTN)Frequency, PkgIndex), NULL), PkgIndex);
+              UINT64 Frequency = LShiftU64(MultU64x32((UINT64)Type4->CurrentSpeed, 1000000), ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", PkgIndex, L"Step", 0));
+              ConfigSetIndexedUnsigned(L"\\CPU\\Package", PkgIndex, L"Maximum",
+                                      (UINTN)DivU64x64Remainder(Frequency, ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", PkgIndex, L"Clock", (UINTN)Frequency), NULL));
             }
             // Increment package index
             ++PkgIndex;
@@ -90,7 +90,7 @@ SwitchCPUIntelFamilyToMobile (
   return Family;
 }
 
-#define SET_CPU_FEATURE(Feature, Value) ConfigSSetBoolean(L"\\CPU\\Package\\%u\\Feature\\" L ## #Feature, (BOOLEAN)(Value), Index)
+#define SET_CPU_FEATURE(Feature, Value) ConfigSetIndexedBoolean(L"\\CPU\\Package", Index, L"Feature\\" L ## #Feature, (BOOLEAN)(Value))
 
 // DetermineCPUIntelFeatures
 /// Determine CPU features information
@@ -361,22 +361,22 @@ DetermineCPUIntelFrequency (
       switch (CPUBitmask(AsmReadMsr32(0x2C), 0, 2)) {
         case 1:
           // 001B 133 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 133333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 133333333);
           break;
 
         case 2:
           // 010B 200 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 200000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 200000000);
           break;
 
         case 3:
           // 011B 166 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 166666667, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 166666667);
           break;
 
         case 4:
           // 100B 333 MHz (Model 6)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 333333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 333333333);
           break;
 
         default:
@@ -385,13 +385,13 @@ DetermineCPUIntelFrequency (
             case 3:
             case 4:
               // 000B 266 MHz (Model 3 or 4)
-              ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 266666667, Index);
+              ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 266666667);
               break;
 
             case 2:
             default:
               // 000B 100 MHz (Model 2)
-              ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 100000000, Index);
+              ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 100000000);
               break;
           }
           break;
@@ -407,38 +407,38 @@ DetermineCPUIntelFrequency (
       switch (CPUBitmask(AsmReadMsr32(0xCD), 0, 2)) {
         case 0:
           // 000B: 267 MHz (FSB 1067)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 266666667, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 266666667);
           break;
 
         case 1:
           // 001B: 133 MHz (FSB 533)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 133333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 133333333);
           break;
 
         case 2:
           // 010B: 200 MHz (FSB 800)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 200000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 200000000);
           break;
 
         case 3:
           // 011B: 167 MHz (FSB 667)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 166666667, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 166666667);
           break;
 
         case 4:
           // 100B: 333 MHz (FSB 1333)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 333333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 333333333);
           break;
 
         case 6:
           // 110B: 400 MHz (FSB 1600)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 400000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 400000000);
           break;
 
         case 5:
         default:
           // 101B: 100 MHz (FSB 400)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 100000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 100000000);
           break;
       }
       break;
@@ -448,23 +448,23 @@ DetermineCPUIntelFrequency (
       switch (CPUBitmask(AsmReadMsr32(0xCD), 0, 2)) {
         case 1:
           // 001B: 133 MHz (FSB 533)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 133333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 133333333);
           break;
 
         case 3:
           // 011B: 167 MHz (FSB 667)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 166666667, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 166666667);
           break;
 
         case 7:
           // 111B: 083 MHz (FSB 333)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 83333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 83333333);
           break;
 
         case 5:
         default:
           // 101B: 100 MHz (FSB 400)
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 100000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 100000000);
           break;
       }
       break;
@@ -474,28 +474,28 @@ DetermineCPUIntelFrequency (
       switch (CPUBitmask(AsmReadMsr32(0xCD), 0, 2)) {
         case 0:
           // 000B: 083.3 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 83333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 83333333);
           break;
 
         case 2:
           // 010B: 133.3 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 133333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 133333333);
           break;
 
         case 3:
           // 011B: 116.7 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 116666667, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 116666667);
           break;
 
         case 4:
           // 100B: 080.0 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 80000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 80000000);
           break;
 
         case 1:
         default:
           // 001B: 100.0 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 100000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 100000000);
           break;
       }
       break;
@@ -505,48 +505,48 @@ DetermineCPUIntelFrequency (
       switch (CPUBitmask(AsmReadMsr32(0xCD), 0, 3)) {
         case 0:
           // 0000B: 083.3 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 83333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 83333333);
           break;
 
         case 2:
           // 0010B: 133.3 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 133333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 133333333);
           break;
 
         case 3:
           // 0011B: 116.7 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 116666667, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 116666667);
           break;
 
         case 4:
           // 0100B: 080.0 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 80000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 80000000);
           break;
 
         case 5:
           // 0101B: 093.3 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 93333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 93333333);
           break;
 
         case 6:
           // 0110B: 090.0 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 90000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 90000000);
           break;
 
         case 7:
           // 0111B: 088.9 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 88888889, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 88888889);
           break;
 
         case 8:
           // 1000B: 087.5 MHz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 87500000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 87500000);
           break;
 
         case 1:
         default:
           // 0000B: 100.0 Mhz
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 100000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 100000000);
           break;
       }
       break;
@@ -555,7 +555,7 @@ DetermineCPUIntelFrequency (
       // 4th Gen Atom clock frequency
       switch (CPUBitmask(AsmReadMsr32(0xCD), 0, 3)) {
         default:
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 100000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 100000000);
           break;
       }
       break;
@@ -564,7 +564,7 @@ DetermineCPUIntelFrequency (
     case CPU_FAMILY_CORE_i_MOBILE:
     case CPU_FAMILY_XEON_CORE_i:
       // Core i clock frequency - 133MHz
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 133333333, Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 133333333);
       break;
 
     case CPU_FAMILY_PENTIUM_M:
@@ -587,25 +587,25 @@ DetermineCPUIntelFrequency (
     case CPU_FAMILY_XEON_6TH_CORE_i:
     case CPU_FAMILY_XEON_7TH_CORE_i:
       // >= 2nd Gen Core i families clock frequency - 100MHz
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 100000000, Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 100000000);
       break;
 
     case CPU_FAMILY_XEON_PHI:
       // Xeon Phi clock frequency
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 100000000, Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 100000000);
       break;
 
 #if defined(MDE_CPU_IA32)
 
     case CPU_FAMILY_ITANIUM:
       // Itanium clock frequency - 133MHz
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 133333333, Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 133333333);
       break;
 
     case CPU_FAMILY_ITANIUM2:
       // Itanium 2 clock frequency
       // Default clock is 400MHz but no idea how to determine frequency in IA32 mode
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 400000000, Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 400000000);
       break;
 
     case CPU_FAMILY_PENTIUM_PRO:
@@ -618,16 +618,16 @@ DetermineCPUIntelFrequency (
       // P6 families
       switch (CPUBitmask(AsmReadMsr32(0x2A), 18, 19)) {
         case 1:
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 133333333, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 133333333);
           break;
 
         case 2:
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 100000000, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 100000000);
           break;
 
         case 0:
         default:
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
           break;
       }
       break;
@@ -644,7 +644,7 @@ DetermineCPUIntelFrequency (
 
     default:
       // Determine clock frequency by TSC if possible
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", (UINTN)DetectCPUFrequency(), Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", (UINTN)DetectCPUFrequency());
       break;
 
   }
@@ -654,9 +654,9 @@ DetermineCPUIntelFrequency (
 #if defined(MDE_CPU_IA32)
 
     case CPU_FAMILY_PENTIUM_MMX:
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Step", 1, Index);
-      Maximum = (UINTN)DivU64x32(LShiftU64((UINT64)ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Clock", 0, Index), 1), 66666667);
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Step", 1);
+      Maximum = (UINTN)DivU64x32(LShiftU64((UINT64)ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Clock", 0), 1), 66666667);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
       break;
 
     case CPU_FAMILY_PENTIUM:
@@ -664,66 +664,66 @@ DetermineCPUIntelFrequency (
     case CPU_FAMILY_PENTIUM_OVERDRIVE:
     case CPU_FAMILY_MOBILE_PENTIUM_MMX:
     case CPU_FAMILY_PENTIUM_MMX_OVERDRIVE:
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Step", 1, Index);
-      Clock = ConfigSGetUnsignedWithDefault(L"\\CPU\\Package\\%u\\Clock", 0, Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Step", 1);
+      Clock = ConfigGetIndexedUnsignedWithDefault(L"\\CPU\\Package", Index, L"Clock", 0);
       if ((Clock >= 70000000) && (Clock <= 80000000)) {
         // 75MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 50000000, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 50000000);
         Maximum = 3;
       } else if ((Clock > 80000000) && (Clock <= 85000000)) {
         // 83MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
         Maximum = 3;
       } else if ((Clock > 85000000) && (Clock <= 95000000)) {
         // 90MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 60000000, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 60000000);
         Maximum = 3;
       } else if ((Clock > 95000000) && (Clock <= 105000000)) {
         // 100MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
         Maximum = 3;
       } else if ((Clock > 115000000) && (Clock <= 125000000)) {
         // 120MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 60000000, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 60000000);
         Maximum = 4;
       } else if ((Clock > 128000000) && (Clock <= 138000000)) {
         // 133MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
         Maximum = 4;
       } else if ((Clock > 145000000) && (Clock <= 155000000)) {
         // 150MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 60000000, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 60000000);
         Maximum = 3;
       } else if ((Clock > 161000000) && (Clock <= 171000000)) {
         // 166MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
         Maximum = 5;
       } else if ((Clock > 175000000) && (Clock <= 185000000)) {
         // 180MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 60000000, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 60000000);
         Maximum = 6;
       } else if ((Clock > 195000000) && (Clock <= 205000000)) {
         // 200MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
         Maximum = 6;
       } else if ((Clock > 228000000) && (Clock <= 238000000)) {
         // 233MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
         Maximum = 7;
       } else if ((Clock > 261000000) && (Clock <= 271000000)) {
         // 266MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
         Maximum = 8;
       } else if ((Clock > 295000000) && (Clock <= 305000000)) {
         // 300MHz
-        ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Clock", 66666667, Index);
+        ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Clock", 66666667);
         Maximum = 9;
       } else {
         // Set default multiplers
         Maximum = 2;
       }
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", Maximum, Index);
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", Maximum, Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", Maximum);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", Maximum);
       break;
 
 #endif
@@ -741,7 +741,7 @@ DetermineCPUIntelFrequency (
     case CPU_FAMILY_ATOM:
     case CPU_FAMILY_XEON_PHI:
       // Determine Pentium M/Core/Core2/Atom multipliers
-      if (ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\ModelSpecificRegisters", FALSE, Index)) {
+      if (ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\ModelSpecificRegisters", FALSE)) {
         // Read the MSR_PERF_STATUS model specific register
         MSR = AsmReadMsr64(0x198);
         Step = (UINTN)CPUBitmask(MSR, 46, 46);
@@ -756,15 +756,15 @@ DetermineCPUIntelFrequency (
         // Check if multipliers exist
         if ((Minimum != 0) && (Maximum != 0)) {
           // Set turbo multiplier
-          if (ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\Turbo", FALSE, Index)) {
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Turbo\\Count", 1, Index);
+          if (ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\Turbo", FALSE)) {
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Turbo\\Count", 1);
             ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Turbo\\%u", Maximum + (UINTN)LShiftU64(1, Step), Index, 0);
           }
           if (Step != 0) {
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Step", 1, Index);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Step", 1);
           }
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", Minimum, Index);
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", Maximum, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", Minimum);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", Maximum);
           break;
         }
       } else
@@ -794,7 +794,7 @@ DetermineCPUIntelFrequency (
     case CPU_FAMILY_3RD_ATOM:
     case CPU_FAMILY_4TH_ATOM:
       // Core i families
-      if (ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\ModelSpecificRegisters", FALSE, Index)) {
+      if (ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\ModelSpecificRegisters", FALSE)) {
         // Determine CPU minimum and maximum multipliers from MSR_PLATFORM_INFO model specific register
         MSR = AsmReadMsr64(0xCE);
         Maximum = (UINT8)CPUBitmask(MSR, 8, 15);
@@ -802,7 +802,7 @@ DetermineCPUIntelFrequency (
         // Check if multipliers exist
         if ((Minimum != 0) && (Maximum != 0)) {
           // Determine CPU turbo multipliers
-          if (ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\Turbo", FALSE, Index)) {
+          if (ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\Turbo", FALSE)) {
             UINTN Mask;
             UINTN TurboCount = 0;
             // Read MSR_TURBO_RATIO_LIMIT model specific register
@@ -815,8 +815,8 @@ DetermineCPUIntelFrequency (
               }
             }
           }
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", Minimum, Index);
-          ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", Maximum, Index);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", Minimum);
+          ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", Maximum);
           break;
         }
       } else
@@ -831,42 +831,42 @@ DetermineCPUIntelFrequency (
     case CPU_FAMILY_XEON_PENTIUM_III:
     case CPU_FAMILY_CELERON:
       // P6 families
-      if (ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\ModelSpecificRegisters", FALSE, Index)) {
+      if (ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\ModelSpecificRegisters", FALSE)) {
         switch (CPUBitmask(AsmReadMsr32(0x2A), 22, 25)) {
           case 1:
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", 3, Index);
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", 3, Index);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", 3);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", 3);
             break;
 
           case 2:
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", 4, Index);
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", 4, Index);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", 4);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", 4);
             break;
 
           case 5:
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", 7, Index);
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", 7, Index);
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Step", 1, Index);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", 7);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", 7);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Step", 1);
             break;
 
           case 6:
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", 9, Index);
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", 9, Index);
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Step", 1, Index);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", 9);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", 9);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Step", 1);
             break;
 
           case 7:
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", 5, Index);
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", 5, Index);
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Step", 1, Index);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", 5);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", 5);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Step", 1);
             break;
 
           case 0:
           case 3:
           case 4:
           default:
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", 2, Index);
-            ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", 2, Index);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", 2);
+            ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", 2);
             break;
         }
         break;
@@ -878,8 +878,8 @@ DetermineCPUIntelFrequency (
 
     default:
       // Set default multiplers
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Minimum", 1, Index);
-      ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Maximum", 1, Index);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Minimum", 1);
+      ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Maximum", 1);
       break;
   }
 }
@@ -1516,7 +1516,7 @@ UpdateIntelPackageInformation (
   // Determine features
   DetermineCPUIntelFeatures(Index);
   // Check if hardware multi threading is supported if core or cache topology reporting is not or failed
-  if (ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\HardwareMultiThread", FALSE, Index) && (SubIndex == 0)) {
+  if (ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\HardwareMultiThread", FALSE) && (SubIndex == 0)) {
     // Get the logical CPU count the old way
     Threads = (UINTN)CPUBitmask(mCPUIDRegisters[1], 16, 23);
   }
@@ -1532,8 +1532,8 @@ UpdateIntelPackageInformation (
     Threads = Cores;
   }
   // Add these counts to the total system counts
-  ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Threads", Threads, Index);
-  ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Cores", Cores, Index);
+  ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Threads", Threads);
+  ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Cores", Cores);
   ConfigSetUnsigned(L"\\CPU\\Threads", ConfigGetUnsignedWithDefault(L"\\CPU\\Threads", 0) + Threads);
   ConfigSetUnsigned(L"\\CPU\\Cores", ConfigGetUnsignedWithDefault(L"\\CPU\\Cores", 0) + Cores);
   // Determine extended features
@@ -1568,15 +1568,15 @@ UpdateIntelPackageInformation (
     // Create a unicode copy of the string
     if (!EFI_ERROR(AsciiStrToUnicodeStrS(Str, String, ARRAY_SIZE(String)))) {
       // Copy description to CPU information
-      ConfigSSetString(L"\\CPU\\Package\\%u\\Description", String, Index);
+      ConfigSetIndexedString(L"\\CPU\\Package", Index, L"Description", String);
     }
   }
   // Read IA32_MISC_ENABLE model specific register
-  if (ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\ModelSpecificRegisters", FALSE, Index)) {
+  if (ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\ModelSpecificRegisters", FALSE)) {
     UINT64 MSR;
     MSR = AsmReadMsr64(0x1A0);
     // Determine if speedstep is enabled
-    if (ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\Dynamic", FALSE, Index)) {
+    if (ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\Dynamic", FALSE)) {
       SET_CPU_FEATURE(Dynamic, CPUBitmask(MSR, 16, 16));
     }
     // Determine if turbo is enabled
@@ -1588,14 +1588,14 @@ UpdateIntelPackageInformation (
     if (CPUBitmask(AsmReadMsr32(0x17), 28, 28) != 0) {
       SET_CPU_FEATURE(Mobile, TRUE);
     }
-    if (ConfigSGetBooleanWithDefault(L"\\CPU\\Package\\%u\\Feature\\Mobile", FALSE, Index)) {
+    if (ConfigGetIndexedBooleanWithDefault(L"\\CPU\\Package", Index, L"Feature\\Mobile", FALSE)) {
       Family = SwitchCPUIntelFamilyToMobile(Family);
     }
   }
   // Determine frequency
   DetermineCPUIntelFrequency(Index, Model, Family);
   // Set family
-  ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Family", Family, Index);
+  ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Family", Family);
   // Set model
-  return ConfigSSetUnsigned(L"\\CPU\\Package\\%u\\Model", Model, Index);
+  return ConfigSetIndexedUnsigned(L"\\CPU\\Package", Index, L"Model", Model);
 }
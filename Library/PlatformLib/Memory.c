@@ -51,7 +51,7 @@ PrintMemoryInformation (
   UINTN Count = ConfigGetUnsignedWithDefault(CONFIG_KEY_MEMORY_COUNT, CONFIG_KEY_MEMORY_COUNT_VALUE);
   Log2(L"Memory modules:", L"%u\n", Count);
   for (Index = 0; Index < Count; ++Index) {
-    Log2(L"  Memory module:", L"0x%02X\n", ConfigSGetUnsignedWithDefault(L"\\Memory\\Module\\%u\\Type", 0, Index));
+    Log2(L"  Memory module:", L"0x%02X\n", ConfigGetIndexedUnsignedWithDefault(L"\\Memory\\Module", Index, L"Type", 0));
   }
 }
 
@@ -120,7 +120,10 @@ ReadMemoryFromIntelDevice (
   IN UINT8  Index,
   IN UINT16 Offset
 ) {
-  UINTN Counter;
+  UINTN  Counter;
+#if PROJECT_LOG_LEVEL >= LOG_LEVEL_VERBOSE
+  CHAR16 Prefix[LOG_PREFIX_WIDTH + 1];
+#endif
 
   // Check parameters
   if ((Address == 0) || (Index < 0x50) || (Index > 0x57) || (Offset > MEMORY_SPD_SIZE)) {
@@ -135,7 +138,7 @@ ReadMemoryFromIntelDevice (
   }
   // Check for time out
   if (Counter >= (MEMORY_SPD_TIMEOUT / MEMORY_SPD_INTERVAL)) {
-    LOG3(LOG_PREFIX_WIDTH - LOG(L"  Slot %u", Index - 0x50), L":", L"Timed out on reset\n");
+    LOG2_VERBOSE(LOG_MODULE_PLATFORM, LogPrefix(Prefix, L"  Slot %u:", Index - 0x50), L"Timed out on reset\n");
     return 0;
   }
   // Send the command to retrieve a byte
@@ -150,12 +153,12 @@ ReadMemoryFromIntelDevice (
   }
   // Check for time out
   if (Counter >= (MEMORY_SPD_TIMEOUT / MEMORY_SPD_INTERVAL)) {
-    LOG3(LOG_PREFIX_WIDTH - LOG(L"  Slot %u", Index - 0x50), L":", L"Timed out on read\n");
+    LOG2_VERBOSE(LOG_MODULE_PLATFORM, LogPrefix(Prefix, L"  Slot %u:", Index - 0x50), L"Timed out on read\n");
     return 0;
   }
   // Check for an error
   if ((IoRead8(Address) & 2) == 0) {
-    LOG3(LOG_PREFIX_WIDTH - LOG(L"  Slot %u", Index - 0x50), L":", L"Error on read\n");
+    LOG2_VERBOSE(LOG_MODULE_PLATFORM, LogPrefix(Prefix, L"  Slot %u:", Index - 0x50), L"Error on read\n");
     return 0;
   }
   // Store the retrieved byte
@@ -171,12 +174,16 @@ EFIAPI
 DetectMemoryInformationFromIntelDevice (
   IN EFI_PCI_IO_PROTOCOL *Device
 ) {
-  EFI_STATUS Status;
-  UINTN      Address = 0;
-  UINT16     PciStatus = 0;
-  UINT8      HostStatus = 0;
-  UINT8      Index;
+  EFI_STATUS  Status;
+  CONFIG_KEY *CountKey = NULL;
+  UINTN       Address = 0;
+  UINT16      PciStatus = 0;
+  UINT8       HostStatus = 0;
+  UINT8       Index;
   UINT8      Spd[MEMORY_SPD_SIZE];
+#if PROJECT_LOG_LEVEL >= LOG_LEVEL_VERBOSE
+  CHAR16      Prefix[LOG_PREFIX_WIDTH + 1];
+#endif
   // Check parameters
   if (Device == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -195,7 +202,7 @@ DetectMemoryInformationFromIntelDevice (
   if (EFI_ERROR(Status)) {
     return Status;
   }
-  LOG2(L"  PCI status:", L"0x%04X\n", PciStatus);
+  LOG2_VERBOSE(LOG_MODULE_PLATFORM, L"  PCI status:", L"0x%04X\n", PciStatus);
   // Make sure host command interface is enabled
   Status = Device->Pci.Read(Device, EfiPciIoWidthUint8, 0x40, 1, &HostStatus);
   if (EFI_ERROR(Status)) {
@@ -210,7 +217,7 @@ DetectMemoryInformationFromIntelDevice (
   if (EFI_ERROR(Status)) {
     return Status;
   }
-  LOG2(L"  Host status:", L"0x%02X\n", HostStatus);
+  LOG2_VERBOSE(LOG_MODULE_PLATFORM, L"  Host status:", L"0x%02X\n", HostStatus);
   // Read base address from configuration space
   Status = Device->Pci.Read(Device, EfiPciIoWidthUint32, 0x20, 1, &Address);
   if (EFI_ERROR(Status)) {
@@ -221,20 +228,25 @@ DetectMemoryInformationFromIntelDevice (
     return EFI_UNSUPPORTED;
   }
   Address &= 0xFFF0;
-  LOG2(L"  Base address:", L"0x%08X\n", Address);
+  LOG2_VERBOSE(LOG_MODULE_PLATFORM, L"  Base address:", L"0x%08X\n", Address);
+  // Resolve the slot count once since it is read and written for every slot
+  Status = ConfigKeyOpen(CONFIG_KEY_MEMORY_COUNT, &CountKey);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
   // Iterate through each slot
   for (Index = 0x50; Index < 0x58; ++Index) {
     UINT16 Offset;
     UINT8  MemoryType;
     // Get the current slot count
-    UINTN  Count = ConfigGetUnsignedWithDefault(CONFIG_KEY_MEMORY_COUNT, CONFIG_KEY_MEMORY_COUNT_VALUE);
+    UINTN  Count = ConfigKeyGetUnsignedWithDefault(CountKey, CONFIG_KEY_MEMORY_COUNT_VALUE);
     // Get the memory module type key byte
     MemoryType = ReadMemoryFromIntelDevice(Address, Index, SPD_MEMORY_TYPE);
     // Check for invalid module type
     if ((MemoryType == 0x00) || (MemoryType == 0x0D) || (MemoryType > 0x11)) {
       Spd[SPD_MEMORY_TYPE] = (MemoryType == 0xFF) ? 0xFF : 0x00;
     } else {
-      LOG3(LOG_PREFIX_WIDTH - LOG(L"  Slot %u", Index - 0x50), L":", L"0x%02X\n", MemoryType);
+      LOG2_VERBOSE(LOG_MODULE_PLATFORM, LogPrefix(Prefix, L"  Slot %u:", Index - 0x50), L"0x%02X\n", MemoryType);
       // Iterate through the map to read
       for (Offset = 0; Offset < SPD_MEMORY_TYPE; ++Offset) {
         // Store the retrieved byte
@@ -248,12 +260,13 @@ DetectMemoryInformationFromIntelDevice (
       PopulateMemoryInformationFromSPD(Count, Spd);
     }
     // Increment slot count
-    Status = ConfigSetUnsigned(CONFIG_KEY_MEMORY_COUNT, Count + 1);
+    Status = ConfigKeySetUnsigned(CountKey, Count + 1);
     if (EFI_ERROR(Status)) {
-      return Status;
+      break;
     }
   }
-  return EFI_SUCCESS;
+  ConfigKeyClose(CountKey);
+  return Status;
 }
 
 // DetectMemoryInformationFromDevice
@@ -278,7 +291,7 @@ DetectMemoryInformationFromDevice (
   if (EFI_ERROR(Status)) {
     return Status;
   }
-  LOG2(L"SMBus:", L"0x%04X, 0x%04X\n", Ids[0], Ids[1]);
+  LOG2_VERBOSE(LOG_MODULE_PLATFORM, L"SMBus:", L"0x%04X, 0x%04X\n", Ids[0], Ids[1]);
   switch (Ids[0]) {
     case 0x8086:
       // Intel SMBus
@@ -346,7 +359,7 @@ DetectMemoryInformation (
     if (!EFI_ERROR(FindSmBiosTables(SMBIOS_TYPE_PHYSICAL_MEMORY_ARRAY, &Count, &Tables)) && (Tables != NULL)) {
       UINT32 SlotIndex = 0;
       // Iterate through the physical memory arrays
-      LOG2(L"Memory arrays:", L"%u\n", Count);
+      LOG2_VERBOSE(LOG_MODULE_PLATFORM, L"Memory arrays:", L"%u\n", Count);
       for (Index = 0; Index < Count; ++Index) {
         SMBIOS_STRUCTURE    *Table;
         // Get the physical memory array table
@@ -354,8 +367,8 @@ DetectMemoryInformation (
         if ((Type16 == NULL) || (Type16->Use != MemoryArrayUseSystemMemory)) {
           continue;
         }
-        LOG2(L"  Memory array:", L"%u\n", Index);
-        LOG2(L"    Slot count:", L"%u\n", Type16->NumberOfMemoryDevices);
+        LOG2_VERBOSE(LOG_MODULE_PLATFORM, L"  Memory array:", L"%u\n", Index);
+        LOG2_VERBOSE(LOG_MODULE_PLATFORM, L"    Slot count:", L"%u\n", Type16->NumberOfMemoryDevices);
         // Get the first memory slot table for this memory array
         Table = GetNextSmBiosTable((SMBIOS_STRUCTURE *)Type16);
         while ((Table != NULL) && (Table->Type == SMBIOS_TYPE_MEMORY_DEVICE)) {
@@ -64,6 +64,16 @@ EFIAPI
 UpdatePackagesInformation (
   VOID
 );
+// GetCPUIdentity
+/// Get the CPU identity, which changes when the processor or its microcode changes
+/// @param Signature On output, the CPUID processor signature
+/// @param Microcode On output, the microcode revision or zero if unknown
+VOID
+EFIAPI
+GetCPUIdentity (
+  OUT UINT32 *Signature,
+  OUT UINT32 *Microcode
+);
 // PrintCPUInformation
 /// Print CPU package information
 VOID
@@ -71,5 +81,12 @@ EFIAPI
 PrintCPUInformation (
   VOID
 );
+// FinishCPUInformation
+/// Free the CPU configuration change subscription
+VOID
+EFIAPI
+FinishCPUInformation (
+  VOID
+);
 
 #endif // __CPU_INFORMATION_HEADER__
@@ -10,6 +10,207 @@
 #include <Library/SmBiosLib.h>
 
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+
+// CONFIG_KEY_PLATFORM_PERSIST
+/// Whether to persist detected platform information in a variable and reload it on later boots of the same machine
+#define CONFIG_KEY_PLATFORM_PERSIST L"\\Platform\\Persist"
+// CONFIG_KEY_PLATFORM_PERSIST_VALUE
+/// Platform information is detected every boot by default
+#define CONFIG_KEY_PLATFORM_PERSIST_VALUE FALSE
+
+// PLATFORM_PERSIST_VARIABLE
+/// The name of the persisted platform information variable
+#define PLATFORM_PERSIST_VARIABLE L"PlatformInformation"
+// PLATFORM_PERSIST_SIGNATURE
+/// The persisted platform information signature
+#define PLATFORM_PERSIST_SIGNATURE SIGNATURE_32('P', 'L', 'T', 'P')
+// PLATFORM_PERSIST_VERSION
+/// The persisted platform information format version
+#define PLATFORM_PERSIST_VERSION 1
+// PLATFORM_PERSIST_COUNT
+/// The count of persisted configuration paths
+#define PLATFORM_PERSIST_COUNT 2
+
+// PLATFORM_PERSIST_HEADER
+/// Persisted platform information header, followed by the exported configuration of each persisted path in order
+typedef struct _PLATFORM_PERSIST_HEADER PLATFORM_PERSIST_HEADER;
+struct _PLATFORM_PERSIST_HEADER {
+
+  // Signature
+  /// The persisted platform information signature
+  UINT32   Signature;
+  // Version
+  /// The persisted platform information format version
+  UINT32   Version;
+  // CPUSignature
+  /// The CPUID processor signature of the machine
+  UINT32   CPUSignature;
+  // Microcode
+  /// The microcode revision of the machine
+  UINT32   Microcode;
+  // Uuid
+  /// The SMBIOS system UUID of the machine
+  EFI_GUID Uuid;
+  // Sizes
+  /// The size, in bytes, of the exported configuration of each persisted path
+  UINT32   Sizes[PLATFORM_PERSIST_COUNT];
+
+};
+
+// mPlatformPersistGuid
+/// The persisted platform information variable vendor GUID
+STATIC EFI_GUID mPlatformPersistGuid = { 0x6B1C9F0E, 0x3A57, 0x4D2B, { 0x9E, 0x48, 0x7C, 0x15, 0xD2, 0x6A, 0xB3, 0x90 } };
+// mPlatformPersistPaths
+/// The configuration paths written by platform detection, which are persisted
+STATIC CHAR16  *mPlatformPersistPaths[PLATFORM_PERSIST_COUNT] = {
+  L"\\CPU",
+  L"\\Memory"
+};
+
+// GetPlatformIdentity
+/// Get the identity of the machine for persisted platform information
+/// @param Header On output, the persisted platform information header with the machine identity
+STATIC VOID
+EFIAPI
+GetPlatformIdentity (
+  OUT PLATFORM_PERSIST_HEADER *Header
+) {
+  SMBIOS_STRUCTURE *Table;
+  ZeroMem(Header, sizeof(PLATFORM_PERSIST_HEADER));
+  Header->Signature = PLATFORM_PERSIST_SIGNATURE;
+  Header->Version = PLATFORM_PERSIST_VERSION;
+  GetCPUIdentity(&(Header->CPUSignature), &(Header->Microcode));
+  // Get the system UUID, which stays zero without SMBIOS
+  Table = FindSmBiosTable(NULL, 1);
+  if ((Table != NULL) && (Table->Length >= (OFFSET_OF(SMBIOS_TABLE_TYPE1, Uuid) + sizeof(EFI_GUID)))) {
+    CopyGuid(&(Header->Uuid), (EFI_GUID *)&(((SMBIOS_TABLE_TYPE1 *)Table)->Uuid));
+  }
+}
+// LoadPlatformInformation
+/// Load the platform information persisted by a previous boot of this machine
+/// @return Whether the persisted platform information was loaded or not
+/// @retval EFI_NOT_FOUND            If no platform information was persisted
+/// @retval EFI_INCOMPATIBLE_VERSION If the platform information was persisted for another machine, processor microcode or format
+/// @retval EFI_VOLUME_CORRUPTED     If the persisted platform information is malformed
+/// @retval EFI_OUT_OF_RESOURCES     If memory could not be allocated
+/// @retval EFI_SUCCESS              If the persisted platform information was loaded successfully
+STATIC EFI_STATUS
+EFIAPI
+LoadPlatformInformation (
+  VOID
+) {
+  EFI_STATUS               Status;
+  PLATFORM_PERSIST_HEADER  Identity;
+  PLATFORM_PERSIST_HEADER *Header;
+  UINT8                   *Buffer = NULL;
+  UINTN                    Size = 0;
+  UINTN                    Offset;
+  UINTN                    Index;
+  // Get the size of the persisted platform information
+  Status = gRT->GetVariable(PLATFORM_PERSIST_VARIABLE, &mPlatformPersistGuid, NULL, &Size, NULL);
+  if (Status != EFI_BUFFER_TOO_SMALL) {
+    return EFI_NOT_FOUND;
+  }
+  if (Size < sizeof(PLATFORM_PERSIST_HEADER)) {
+    return EFI_VOLUME_CORRUPTED;
+  }
+  Buffer = (UINT8 *)AllocatePool(Size);
+  if (Buffer == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Status = gRT->GetVariable(PLATFORM_PERSIST_VARIABLE, &mPlatformPersistGuid, NULL, &Size, Buffer);
+  if (EFI_ERROR(Status)) {
+    FreePool(Buffer);
+    return Status;
+  }
+  // Check the information was persisted by this machine with the same processor microcode
+  Header = (PLATFORM_PERSIST_HEADER *)Buffer;
+  GetPlatformIdentity(&Identity);
+  if ((Size < sizeof(PLATFORM_PERSIST_HEADER)) ||
+      (CompareMem(Header, &Identity, OFFSET_OF(PLATFORM_PERSIST_HEADER, Sizes)) != 0)) {
+    FreePool(Buffer);
+    return EFI_INCOMPATIBLE_VERSION;
+  }
+  Offset = sizeof(PLATFORM_PERSIST_HEADER);
+  for (Index = 0; Index < PLATFORM_PERSIST_COUNT; ++Index) {
+    if (Header->Sizes[Index] > (Size - Offset)) {
+      FreePool(Buffer);
+      return EFI_VOLUME_CORRUPTED;
+    }
+    Offset += Header->Sizes[Index];
+  }
+  if (Offset != Size) {
+    FreePool(Buffer);
+    return EFI_VOLUME_CORRUPTED;
+  }
+  // Import the exported configuration of each path
+  Offset = sizeof(PLATFORM_PERSIST_HEADER);
+  for (Index = 0; !EFI_ERROR(Status) && (Index < PLATFORM_PERSIST_COUNT); ++Index) {
+    if (Header->Sizes[Index] != 0) {
+      Status = ConfigImport(mPlatformPersistPaths[Index], Header->Sizes[Index], Buffer + Offset);
+    }
+    Offset += Header->Sizes[Index];
+  }
+  FreePool(Buffer);
+  // Do not leave a partial import for detection to merge into
+  if (EFI_ERROR(Status)) {
+    for (Index = 0; Index < PLATFORM_PERSIST_COUNT; ++Index) {
+      ConfigPartialFree(mPlatformPersistPaths[Index]);
+    }
+  }
+  return Status;
+}
+// SavePlatformInformation
+/// Persist the detected platform information for later boots of this machine
+/// @return Whether the platform information was persisted or not
+/// @retval EFI_OUT_OF_RESOURCES If memory could not be allocated
+/// @retval EFI_SUCCESS          If the platform information was persisted successfully
+STATIC EFI_STATUS
+EFIAPI
+SavePlatformInformation (
+  VOID
+) {
+  EFI_STATUS               Status = EFI_SUCCESS;
+  PLATFORM_PERSIST_HEADER *Header;
+  VOID                    *Exports[PLATFORM_PERSIST_COUNT];
+  UINTN                    Sizes[PLATFORM_PERSIST_COUNT];
+  UINTN                    Size = sizeof(PLATFORM_PERSIST_HEADER);
+  UINTN                    Index;
+  // Export each path, a path that was not detected is persisted empty
+  for (Index = 0; Index < PLATFORM_PERSIST_COUNT; ++Index) {
+    Exports[Index] = NULL;
+    Sizes[Index] = 0;
+    if (EFI_ERROR(ConfigExport(mPlatformPersistPaths[Index], &(Sizes[Index]), &(Exports[Index])))) {
+      Exports[Index] = NULL;
+      Sizes[Index] = 0;
+    }
+    Size += Sizes[Index];
+  }
+  // Write the identity and then the exported configuration
+  Header = (PLATFORM_PERSIST_HEADER *)AllocateZeroPool(Size);
+  if (Header == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+  } else {
+    UINT8 *Buffer = (UINT8 *)(Header + 1);
+    GetPlatformIdentity(Header);
+    for (Index = 0; Index < PLATFORM_PERSIST_COUNT; ++Index) {
+      Header->Sizes[Index] = (UINT32)Sizes[Index];
+      if (Exports[Index] != NULL) {
+        CopyMem(Buffer, Exports[Index], Sizes[Index]);
+        Buffer += Sizes[Index];
+      }
+    }
+    Status = gRT->SetVariable(PLATFORM_PERSIST_VARIABLE, &mPlatformPersistGuid, EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS, Size, Header);
+    FreePool(Header);
+  }
+  for (Index = 0; Index < PLATFORM_PERSIST_COUNT; ++Index) {
+    if (Exports[Index] != NULL) {
+      FreePool(Exports[Index]);
+    }
+  }
+  return Status;
+}
 
 // PrintSystemInformation
 /// Print system information
@@ -75,42 +276,90 @@ PrintSystemInformation (
 
 }
 
-// PlatformLibInitialize
-/// Platform library initialize use
-/// @return Whether the platform initialized successfully or not
-/// @retval EFI_UNSUPPORTED The platform is unsupported or no boot services locate/install/uninstall protocol
-/// @retval EFI_SUCCESS     The platform successfully initialized
-EFI_STATUS
+// InitializePlatformInformation
+/// Detect or reload the platform information
+/// @return Whether the platform information was initialized successfully or not
+STATIC EFI_STATUS
 EFIAPI
-PlatformLibInitialize (
+InitializePlatformInformation (
   VOID
 ) {
   EFI_STATUS Status;
+  BOOLEAN    Persist;
+  UINTN      Span;
 
   // Check if platform information already exists
   if (ConfigGetBooleanWithDefault(L"\\Platform\\Initialized", FALSE)) {
     return EFI_SUCCESS;
   }
 
+  // Reload the platform information persisted by a previous boot of this machine instead of detecting again
+  Persist = ConfigGetBooleanWithDefault(CONFIG_KEY_PLATFORM_PERSIST, CONFIG_KEY_PLATFORM_PERSIST_VALUE);
+  if (Persist) {
+    Status = LoadPlatformInformation();
+    Log2(L"Persisted platform:", L"%r\n", Status);
+    if (!EFI_ERROR(Status)) {
+      PrintSystemInformation();
+      return ConfigSetBoolean(L"\\Platform\\Initialized", TRUE);
+    }
+  } else {
+    // Remove any platform information persisted while the option was enabled
+    gRT->SetVariable(PLATFORM_PERSIST_VARIABLE, &mPlatformPersistGuid, 0, 0, NULL);
+  }
+
+  // Stage the detected information so it is merged into the configuration at once
+  ConfigTransactionBegin();
+
   // Update package information
   Status = UpdatePackageInformation(0);
   if (EFI_ERROR(Status)) {
+    ConfigTransactionCommit();
     return Status;
   }
 
   // TODO: Run detection code on each package
 
   // Update all packages information
+  Span = BeginLogSpan(L"UpdatePackagesInformation");
   UpdatePackagesInformation();
+  EndLogSpan(Span);
 
   // Detect memory information from SPD and SMBIOS
+  Span = BeginLogSpan(L"DetectMemoryInformation");
   DetectMemoryInformation();
+  EndLogSpan(Span);
+
+  // Set platform information initialized with the detected information so the published snapshot stays current
+  Status = ConfigSetBoolean(L"\\Platform\\Initialized", TRUE);
+
+  // Apply the detected information before it is persisted or printed
+  ConfigTransactionCommit();
+
+  // Persist the detected platform information for the next boot
+  if (Persist) {
+    Log2(L"  Persist status:", L"%r\n", SavePlatformInformation());
+  }
 
   // Print system information
   PrintSystemInformation();
+  return Status;
+}
 
-  // Set platform information intialized
-  return ConfigSetBoolean(L"\\Platform\\Initialized", TRUE);
+// PlatformLibInitialize
+/// Platform library initialize use
+/// @return Whether the platform initialized successfully or not
+/// @retval EFI_UNSUPPORTED The platform is unsupported or no boot services locate/install/uninstall protocol
+/// @retval EFI_SUCCESS     The platform successfully initialized
+EFI_STATUS
+EFIAPI
+PlatformLibInitialize (
+  VOID
+) {
+  EFI_STATUS Status;
+  UINTN      Span = BeginLogSpan(L"PlatformLibInitialize");
+  Status = InitializePlatformInformation();
+  EndLogSpan(Span);
+  return Status;
 }
 
 // PlatformLibFinish
@@ -122,5 +371,6 @@ EFIAPI
 PlatformLibFinish (
   VOID
 ) {
+  FinishCPUInformation();
   return EFI_SUCCESS;
 }
@@ -131,7 +131,7 @@ ToBase64 (
 /// @param Size   On output, the size, in bytes, of the data
 /// @param Data   On output, the decoded data, which must be freed
 /// @return Whether the Base64 encoded string was converted to data or not
-/// @retval EFI_INVALID_PARAMETER If Base64, Size, or Data is NULL or *Data is not NULL
+/// @retval EFI_INVALID_PARAMETER If Base64, Size, or Data is NULL or *Data is not NULL or the Base64 encoded string is empty or invalid
 /// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
 /// @retval EFI_SUCCESS           If the Base64 string was converted to data successfully
 EFI_STATUS
@@ -141,97 +141,107 @@ FromBase64 (
   OUT UINTN   *Size,
   OUT VOID   **Data
 ) {
-  UINTN   DataSize;
-  UINTN   Length;
-  UINTN   Offset;
-  UINTN   Index;
-  VOID   *Buffer;
-  UINT8  *Ptr;
-  CHAR16 *NewBase64;
-  CHAR16 *String;
-  CHAR16 *Str;
-  UINT32  Character;
+  UINTN  DataSize;
+  UINTN  PackedSize;
+  UINT8 *Buffer;
   // Check parameters
   if ((Base64 == NULL) || (Size == NULL) || (Data == NULL) || (*Data != NULL)) {
     return EFI_INVALID_PARAMETER;
   }
-  // Get the string length
-  Length = 0;
-  Offset = 0;
-  Str = Base64;
-  while (*Str != '\0') {
-    if (*Str == '=') {
-      ++Offset;
-    } else if (IsBase64Character(*Str)) {
-      ++Length;
-      Offset = 0;
-    }
-    ++Str;
-  }
-  if (Offset > 2) {
-    Offset = 0;
-  }
-  Length -= (4 - Offset);
-  Offset = (3 - Offset);
-  if ((Length == 0) || ((Length % 4) != 0)) {
+  // Measure the Base64 encoded string
+  DataSize = PackBase64(Base64, NULL);
+  if (DataSize == 0) {
     return EFI_INVALID_PARAMETER;
   }
-  // Make a copy of the corrected Base64
-  NewBase64 = (CHAR16 *)AllocateZeroPool((Length + 1) * sizeof(CHAR16));
-  if (NewBase64 == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-  Str = Base64;
-  String = NewBase64;
-  while (*Str != '\0') {
-    Character = *Str++;
-    if (IsBase64Character(Character)) {
-      *String++ = (CHAR16)Character;
-    }
-  }
-  *String = '\0';
-  // Get the size needed and add padding to align to 16 bytes
-  DataSize = (((Length + Offset + 3) / 4) * 3);
-  DataSize += (0x10 - (DataSize & 0x7));
-  // Allocate the data buffer
-  Buffer = AllocateZeroPool(DataSize);
+  // Allocate a buffer for the packed characters with zeroed padding after the data
+  PackedSize = PackedBase64Size(DataSize);
+  Buffer = (UINT8 *)AllocateZeroPool(PackedSize + 0x10);
   if (Buffer == NULL) {
-    FreePool(NewBase64);
     return EFI_OUT_OF_RESOURCES;
   }
-  // Iterate through the encoded string to decode the data
-  Index = 0;
-  Str = NewBase64;
-  Ptr = (UINT8 *)Buffer;
-  while (Index < Length) {
-    *Ptr = ((FromBase64Character(Str[Index++]) & 0x3F) << 2);
-    Character = FromBase64Character(Str[Index++]);
-    *Ptr++ |= ((Character >> 4) & 0x03);
-    *Ptr = ((Character & 0xF) << 4);
-    Character = FromBase64Character(Str[Index++]);
-    *Ptr++ |= ((Character >> 2) & 0xF);
-    *Ptr = ((Character & 0x3) << 6);
-    *Ptr++ |= (FromBase64Character(Str[Index++]) & 0x3F);
-  }
-  // Decode the extra offset bytes
-  if (Offset == 1) {
-    *Ptr = ((FromBase64Character(Str[Index++]) & 0x3F) << 2);
-    Character = FromBase64Character(Str[Index++]);
-    *Ptr |= ((Character >> 4) & 0x03);
-  } else if (Offset == 2) {
-    *Ptr = ((FromBase64Character(Str[Index++]) & 0x3F) << 2);
-    Character = FromBase64Character(Str[Index++]);
-    *Ptr++ |= ((Character >> 4) & 0x03);
-    *Ptr = ((Character & 0x0F) << 4);
-    Character = FromBase64Character(Str[Index++]);
-    *Ptr |= ((Character >> 2) & 0xF);
-  }
-  FreePool(NewBase64);
+  // Pack the Base64 characters and decode them in place
+  PackBase64(Base64, Buffer);
+  UnpackBase64(Buffer, Buffer, DataSize);
+  ZeroMem(Buffer + DataSize, PackedSize - DataSize);
   // Return the data
-  *Size = (((Length / 4) * 3) + Offset);
+  *Size = DataSize;
   *Data = Buffer;
   return EFI_SUCCESS;
 }
+// PackedBase64Size
+/// Get the count of packed Base64 characters for a decoded data size
+/// @param Size The size, in bytes, of the decoded data
+/// @return The count of packed Base64 characters, which have no padding
+UINTN
+EFIAPI
+PackedBase64Size (
+  IN UINTN Size
+) {
+  return ((Size / 3) * 4) + (((Size % 3) == 0) ? 0 : ((Size % 3) + 1));
+}
+// PackBase64
+/// Measure a Base64 encoded string and pack its Base64 characters into bytes, anything that is not a Base64 character is skipped up to any padding
+/// @param Base64 The Base64 encoded string
+/// @param Buffer The buffer to receive the packed Base64 characters, which must hold the count of packed Base64 characters for the decoded data size, or NULL to only measure
+/// @return The size, in bytes, of the decoded data or zero if the Base64 encoded string is empty or invalid
+UINTN
+EFIAPI
+PackBase64 (
+  IN  CHAR16 *Base64,
+  OUT UINT8  *Buffer OPTIONAL
+) {
+  UINTN Count = 0;
+  if (Base64 == NULL) {
+    return 0;
+  }
+  // Count the Base64 characters and pack them if there is a buffer
+  for (; (*Base64 != '\0') && (*Base64 != '='); ++Base64) {
+    if (IsBase64Character(*Base64)) {
+      if (Buffer != NULL) {
+        Buffer[Count] = (UINT8)*Base64;
+      }
+      ++Count;
+    }
+  }
+  // A single character in the last group cannot encode a whole byte
+  if ((Count % 4) == 1) {
+    return 0;
+  }
+  return ((Count / 4) * 3) + (((Count % 4) == 0) ? 0 : ((Count % 4) - 1));
+}
+// UnpackBase64
+/// Decode packed Base64 characters, the data is never longer than the packed characters so the data may be decoded in place
+/// @param Packed The packed Base64 characters
+/// @param Data   The buffer to receive the decoded data, which may be the packed Base64 characters
+/// @param Size   The size, in bytes, of the decoded data
+VOID
+EFIAPI
+UnpackBase64 (
+  IN  UINT8 *Packed,
+  OUT UINT8 *Data,
+  IN  UINTN  Size
+) {
+  UINT32 Group;
+  UINTN  Count;
+  UINTN  Index;
+  while (Size > 0) {
+    // Read the whole group before writing since the data may overlap it
+    Count = (Size >= 3) ? 4 : (Size + 1);
+    Group = 0;
+    for (Index = 0; Index < 4; ++Index) {
+      Group = (Group << 6) | ((Index < Count) ? FromBase64Character(Packed[Index]) : 0);
+    }
+    Packed += Count;
+    *Data++ = (UINT8)(Group >> 16);
+    if (Size > 1) {
+      *Data++ = (UINT8)(Group >> 8);
+    }
+    if (Size > 2) {
+      *Data++ = (UINT8)Group;
+    }
+    Size -= (Size >= 3) ? 3 : Size;
+  }
+}
 // AsciiToBase64
 /// Convert data to Base64 encoded ASCII string
 /// @param Size   The size, in bytes, of the data to encode
@@ -232,6 +232,53 @@ StrniCmp (
   }
   return TO_UPPER(*Str1) - TO_UPPER(*Str2);
 }
+// StrniHash
+/// Calculate a case-insensitive hash of a string
+/// @param Str   The string to hash
+/// @param Count The maximum count of characters to hash
+/// @return The case-insensitive hash of the string, strings equivalent with StrniCmp have the same hash
+UINT32
+EFIAPI
+StrniHash (
+  IN CHAR16 *Str,
+  IN UINTN   Count
+) {
+  UINT32 Hash = 0x811C9DC5;
+  if (Str != NULL) {
+    // FNV-1a of the upper case characters
+    while ((Count-- > 0) && (*Str != L'\0')) {
+      Hash = (Hash ^ TO_UPPER(*Str)) * 0x01000193;
+      ++Str;
+    }
+  }
+  return Hash;
+}
+// StrniFold
+/// Copy a string folded to upper case for case-insensitive comparison
+/// @param Destination On output, the folded string, which must have room for Count characters and a null terminator
+/// @param Source      The string to fold
+/// @param Count       The maximum count of characters to fold
+/// @return The count of characters folded, strings equivalent with StrniCmp have identical folded strings
+UINTN
+EFIAPI
+StrniFold (
+  OUT CHAR16 *Destination,
+  IN  CHAR16 *Source,
+  IN  UINTN   Count
+) {
+  UINTN Length = 0;
+  if (Destination == NULL) {
+    return 0;
+  }
+  if (Source != NULL) {
+    while ((Length < Count) && (Source[Length] != L'\0')) {
+      Destination[Length] = TO_UPPER(Source[Length]);
+      ++Length;
+    }
+  }
+  Destination[Length] = L'\0';
+  return Length;
+}
 
 // StriColl
 /// Performs a case-insensitive collation of two strings
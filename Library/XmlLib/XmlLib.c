@@ -65,42 +65,60 @@ XmlAttributeFree (
 }
 // XmlAttributeListFree
 /// Free XML document tree node attribute
+/// @param Parser    The XML parser that accounts for the tree node attribute or NULL
 /// @param Attribute The XML document tree node attribute
 STATIC VOID
 EFIAPI
 XmlAttributeListFree (
-  IN XML_LIST *Attribute
+  IN OUT XML_PARSER *Parser OPTIONAL,
+  IN     XML_LIST   *Attribute
 ) {
   // Check parameters
   if (Attribute != NULL) {
+    if (Attribute->Attribute.Name != NULL) {
+      XmlUsageFree(Parser, 0, 0, StrSize(Attribute->Attribute.Name));
+    }
+    if (Attribute->Attribute.Value != NULL) {
+      XmlUsageFree(Parser, 0, 0, StrSize(Attribute->Attribute.Value));
+    }
     XmlAttributeFreeMembers(&(Attribute->Attribute));
+    XmlUsageFree(Parser, 0, sizeof(XML_LIST), 0);
     FreePool(Attribute);
   }
 }
 // XmlTreeFree
 /// Free XML document tree node
-/// @param Tree The XML document tree node
+/// @param Parser The XML parser that accounts for the tree node or NULL
+/// @param Tree   The XML document tree node
 STATIC VOID
 EFIAPI
 XmlTreeFree (
-  IN XML_TREE *Tree
+  IN OUT XML_PARSER *Parser OPTIONAL,
+  IN     XML_TREE   *Tree
 ) {
   if (Tree != NULL) {
     Tree->Next = NULL;
     if (Tree->Name != NULL) {
+      XmlUsageFree(Parser, 0, 0, StrSize(Tree->Name));
       FreePool(Tree->Name);
       Tree->Name = NULL;
     }
+    if (Tree->Value != NULL) {
+      XmlUsageFree(Parser, 0, 0, StrSize(Tree->Value));
+      FreePool(Tree->Value);
+      Tree->Value = NULL;
+    }
     while (Tree->Attributes != NULL) {
       XML_LIST *Attribute = Tree->Attributes;
-      Tree->Attributes = Attribute;
-      XmlAttributeListFree(Attribute);
+      Tree->Attributes = Attribute->Next;
+      XmlAttributeListFree(Parser, Attribute);
     }
     while (Tree->Children != NULL) {
       XML_TREE *Child = Tree->Children;
       Tree->Children = Child->Next;
-      XmlTreeFree(Child);
+      XmlTreeFree(Parser, Child);
     }
+    XmlUsageFree(Parser, 1, sizeof(XML_TREE), 0);
     FreePool(Tree);
   }
 }
@@ -134,11 +152,13 @@ XmlSchemaFree (
 }
 // XmlDocumentFree
 /// Free XML document
+/// @param Parser   The XML parser that accounts for the XML document
 /// @param Document The XML document
 STATIC VOID
 EFIAPI
 XmlDocumentFree (
-  IN XML_DOCUMENT *Document
+  IN OUT XML_PARSER   *Parser,
+  IN     XML_DOCUMENT *Document
 ) {
   if (Document != NULL) {
     if (Document->Encoding != NULL) {
@@ -149,13 +169,40 @@ XmlDocumentFree (
       FreePool(Document->Schema);
       Document->Schema = NULL;
     }
+    while (Document->Attributes != NULL) {
+      XML_LIST *Attribute = Document->Attributes;
+      Document->Attributes = Attribute->Next;
+      XmlAttributeListFree(Parser, Attribute);
+    }
     if (Document->Tree != NULL) {
-      FreePool(Document->Tree);
+      XmlTreeFree(Parser, Document->Tree);
       Document->Tree = NULL;
     }
     FreePool(Document);
   }
 }
+// XmlStackFree
+/// Free XML parser document tree stack
+/// @param Parser The XML parser
+STATIC VOID
+EFIAPI
+XmlStackFree (
+  IN XML_PARSER *Parser
+) {
+  if (Parser != NULL) {
+    while (Parser->Stack != NULL) {
+      XML_STACK *Stack = Parser->Stack;
+      Parser->Stack = Stack->Previous;
+      // Streamed tree nodes other than the root are only owned by the stack
+      if ((Parser->Stream != NULL) && (Stack->Tree != NULL) &&
+          ((Parser->Document == NULL) || (Stack->Tree != Parser->Document->Tree))) {
+        XmlTreeFree(Parser, Stack->Tree);
+      }
+      FreePool(Stack);
+      XmlUsageFree(Parser, 0, sizeof(XML_STACK), 0);
+    }
+  }
+}
 // XmlParserFree
 /// Free XML parser
 /// @param Parser The XML parser
@@ -165,10 +212,15 @@ XmlParserFree (
   IN XML_PARSER *Parser
 ) {
   if (Parser != NULL) {
+    XmlStackFree(Parser);
     if (Parser->Document != NULL) {
-      XmlDocumentFree(Parser->Document);
+      XmlDocumentFree(Parser, Parser->Document);
       Parser->Document = NULL;
     }
+    if (Parser->Parser != NULL) {
+      FreeParser(Parser->Parser);
+      Parser->Parser = NULL;
+    }
     FreePool(Parser);
   }
 }
@@ -222,8 +274,12 @@ XmlReset (
   if (Parser == NULL) {
     return EFI_INVALID_PARAMETER;
   }
-  XmlDocumentFree(Parser->Document);
+  XmlStackFree(Parser);
+  XmlDocumentFree(Parser, Parser->Document);
   Parser->Document = NULL;
+  // Reset the memory usage for the next document
+  ZeroMem(&(Parser->Usage), sizeof(XML_USAGE));
+  XmlUsageUpdate(Parser);
   return EFI_SUCCESS;
 }
 // XmlFree
@@ -245,12 +301,112 @@ XmlFree (
   return EFI_SUCCESS;
 }
 
+// XmlSetLimits
+/// Set the limits of an XML parser, parsing fails with EFI_BUFFER_TOO_SMALL if a limit is exceeded
+/// @param Parser The XML parser
+/// @param Limits The XML parser limits or NULL to remove all limits
+/// @return Whether the XML parser limits were set or not
+/// @retval EFI_INVALID_PARAMETER If Parser is NULL
+/// @retval EFI_BUFFER_TOO_SMALL  If the current usage already exceeds the limits
+/// @retval EFI_SUCCESS           If the XML parser limits were set successfully
+EFI_STATUS
+EFIAPI
+XmlSetLimits (
+  IN OUT XML_PARSER *Parser,
+  IN     XML_LIMITS *Limits OPTIONAL
+) {
+  // Check parameters
+  if (Parser == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Set the limits
+  if (Limits == NULL) {
+    ZeroMem(&(Parser->Limits), sizeof(XML_LIMITS));
+  } else {
+    CopyMem(&(Parser->Limits), Limits, sizeof(XML_LIMITS));
+  }
+  // Apply the limits to the current usage
+  return XmlUsageUpdate(Parser);
+}
+// XmlGetLimits
+/// Get the limits of an XML parser
+/// @param Parser The XML parser
+/// @param Limits On output, the XML parser limits
+/// @return Whether the XML parser limits were retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Parser or Limits is NULL
+/// @retval EFI_SUCCESS           If the XML parser limits were retrieved successfully
+EFI_STATUS
+EFIAPI
+XmlGetLimits (
+  IN  XML_PARSER *Parser,
+  OUT XML_LIMITS *Limits
+) {
+  // Check parameters
+  if ((Parser == NULL) || (Limits == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  CopyMem(Limits, &(Parser->Limits), sizeof(XML_LIMITS));
+  return EFI_SUCCESS;
+}
+// XmlGetUsage
+/// Get the memory usage of an XML parser for the current document
+/// @param Parser The XML parser
+/// @param Usage  On output, the XML parser memory usage
+/// @return Whether the XML parser memory usage was retrieved or not
+/// @retval EFI_INVALID_PARAMETER If Parser or Usage is NULL
+/// @retval EFI_SUCCESS           If the XML parser memory usage was retrieved successfully
+EFI_STATUS
+EFIAPI
+XmlGetUsage (
+  IN  XML_PARSER *Parser,
+  OUT XML_USAGE  *Usage
+) {
+  // Check parameters
+  if ((Parser == NULL) || (Usage == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Refresh the token buffer size before returning the usage
+  XmlUsageUpdate(Parser);
+  CopyMem(Usage, &(Parser->Usage), sizeof(XML_USAGE));
+  return EFI_SUCCESS;
+}
+
+// XmlSetStream
+/// Set an XML parser to stream tree nodes to a callback while parsing instead of building the document tree
+/// @param Parser  The XML parser
+/// @param Stream  The streaming parse callback or NULL to build the document tree
+/// @param Context The context to pass to the streaming parse callback
+/// @return Whether the streaming parse callback was set or not
+/// @retval EFI_INVALID_PARAMETER If Parser is NULL
+/// @retval EFI_ACCESS_DENIED     If the XML parser is in the middle of a document
+/// @retval EFI_SUCCESS           If the streaming parse callback was set successfully
+EFI_STATUS
+EFIAPI
+XmlSetStream (
+  IN OUT XML_PARSER *Parser,
+  IN     XML_STREAM  Stream OPTIONAL,
+  IN     VOID       *Context OPTIONAL
+) {
+  // Check parameters
+  if (Parser == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Tree nodes already on the stack are owned differently in each mode
+  if (Parser->Stack != NULL) {
+    return EFI_ACCESS_DENIED;
+  }
+  Parser->Stream = Stream;
+  Parser->StreamContext = Context;
+  return EFI_SUCCESS;
+}
+
 // XmlParse
 /// Parse a buffer for XML and finish the XML document
 /// @param Parser An XML parser used to parse
 /// @param Size   The size, in bytes, of the buffer to parse
 /// @param Buffer The buffer to parse
 /// @return Whether the buffer was parsed or not
+/// @retval EFI_BUFFER_TOO_SMALL If a limit set with XmlSetLimits was exceeded
 EFI_STATUS
 EFIAPI
 XmlParse (
@@ -1291,7 +1447,7 @@ XmlTreeRemoveAttribute (
     if (StrCmp(Name, Tree->Attributes->Attribute.Name) == 0) {
       Attribute = Tree->Attributes;
       Tree->Attributes = Attribute->Next;
-      XmlAttributeListFree(Attribute);
+      XmlAttributeListFree(NULL, Attribute);
       return EFI_SUCCESS;
     } else {
       // Check rest of attributes
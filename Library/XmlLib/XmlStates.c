@@ -102,33 +102,151 @@ DECL_LANG_STATES(mXmlStates)
   END_LANG_STATE(),
 END_LANG_STATES();
 
+// XmlUsageUpdate
+/// Update the XML parser memory usage totals and check them against the limits
+/// @param Parser The XML parser
+/// @return Whether the XML parser memory usage is within the limits or not
+/// @retval EFI_INVALID_PARAMETER If Parser is NULL
+/// @retval EFI_BUFFER_TOO_SMALL  If the XML parser memory usage exceeds the limits
+/// @retval EFI_SUCCESS           If the XML parser memory usage is within the limits
+EFI_STATUS
+EFIAPI
+XmlUsageUpdate (
+  IN OUT XML_PARSER *Parser
+) {
+  UINTN Used;
+  // Check parameters
+  if (Parser == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Get the size of the parser token buffer
+  if ((Parser->Parser == NULL) || EFI_ERROR(GetParseTokenSize(Parser->Parser, &(Parser->Usage.TokenBytes)))) {
+    Parser->Usage.TokenBytes = 0;
+  }
+  // Update the totals and peaks
+  Used = Parser->Usage.NodeBytes + Parser->Usage.StringBytes;
+  Parser->Usage.TotalBytes = Used + Parser->Usage.TokenBytes;
+  if (Parser->Usage.TotalBytes > Parser->Usage.PeakBytes) {
+    Parser->Usage.PeakBytes = Parser->Usage.TotalBytes;
+  }
+  if (Parser->Usage.Depth > Parser->Usage.PeakDepth) {
+    Parser->Usage.PeakDepth = Parser->Usage.Depth;
+  }
+  // Check the limits
+  if ((Parser->Limits.MaxDepth != 0) && (Parser->Usage.Depth > Parser->Limits.MaxDepth)) {
+    return EFI_BUFFER_TOO_SMALL;
+  }
+  if ((Parser->Limits.MaxNodes != 0) && (Parser->Usage.NodeCount > Parser->Limits.MaxNodes)) {
+    return EFI_BUFFER_TOO_SMALL;
+  }
+  if (Parser->Limits.MaxBytes == 0) {
+    SetParseTokenLimit(Parser->Parser, 0);
+  } else {
+    if (Parser->Usage.TotalBytes > Parser->Limits.MaxBytes) {
+      return EFI_BUFFER_TOO_SMALL;
+    }
+    // Limit the token buffer to whatever memory remains
+    SetParseTokenLimit(Parser->Parser, Parser->Limits.MaxBytes - Used);
+  }
+  return EFI_SUCCESS;
+}
+// XmlUsageAllocate
+/// Account for memory about to be allocated for the XML document
+/// @param Parser     The XML parser
+/// @param NodeCount  The count of tree nodes to be allocated
+/// @param NodeSize   The size, in bytes, to be allocated for tree nodes, attributes or the tree stack
+/// @param StringSize The size, in bytes, to be allocated for strings
+/// @return Whether the memory may be allocated or not
+/// @retval EFI_INVALID_PARAMETER If Parser is NULL
+/// @retval EFI_BUFFER_TOO_SMALL  If allocating the memory would exceed the limits
+/// @retval EFI_SUCCESS           If the memory may be allocated
+STATIC EFI_STATUS
+EFIAPI
+XmlUsageAllocate (
+  IN OUT XML_PARSER *Parser,
+  IN     UINTN       NodeCount,
+  IN     UINTN       NodeSize,
+  IN     UINTN       StringSize
+) {
+  EFI_STATUS Status;
+  // Check parameters
+  if (Parser == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  // Add to the usage
+  Parser->Usage.NodeCount += NodeCount;
+  Parser->Usage.NodeBytes += NodeSize;
+  Parser->Usage.StringBytes += StringSize;
+  Status = XmlUsageUpdate(Parser);
+  if (EFI_ERROR(Status)) {
+    // Remove from the usage since the memory will not be allocated
+    Parser->Usage.NodeCount -= NodeCount;
+    Parser->Usage.NodeBytes -= NodeSize;
+    Parser->Usage.StringBytes -= StringSize;
+    XmlUsageUpdate(Parser);
+  }
+  return Status;
+}
+// XmlUsageFree
+/// Account for memory freed from the XML document
+/// @param Parser     The XML parser or NULL if the memory is not accounted
+/// @param NodeCount  The count of tree nodes freed
+/// @param NodeSize   The size, in bytes, freed from tree nodes, attributes or the tree stack
+/// @param StringSize The size, in bytes, freed from strings
+VOID
+EFIAPI
+XmlUsageFree (
+  IN OUT XML_PARSER *Parser OPTIONAL,
+  IN     UINTN       NodeCount,
+  IN     UINTN       NodeSize,
+  IN     UINTN       StringSize
+) {
+  if (Parser != NULL) {
+    Parser->Usage.NodeCount -= MIN(NodeCount, Parser->Usage.NodeCount);
+    Parser->Usage.NodeBytes -= MIN(NodeSize, Parser->Usage.NodeBytes);
+    Parser->Usage.StringBytes -= MIN(StringSize, Parser->Usage.StringBytes);
+    XmlUsageUpdate(Parser);
+  }
+}
+
 // XmlTreeCreate
 /// Create XML document tree node
-/// @param Tree On output, the created tree node, which needs freed with XmlTreeFree
-/// @param Name The name of the tree node
+/// @param Parser The XML parser that accounts for the tree node
+/// @param Tree   On output, the created tree node, which needs freed with XmlTreeFree
+/// @param Name   The name of the tree node
 /// @return Whether the XML document tree node was created or not
-/// @retval EFI_INVALID_PARAMETER If Tree or Name is NULL
+/// @retval EFI_INVALID_PARAMETER If Parser, Tree or Name is NULL
+/// @retval EFI_BUFFER_TOO_SMALL  If the tree node would exceed the XML parser limits
 /// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
 /// @retval EFI_SUCCESS           If the XML document tree node was created successfully
 STATIC EFI_STATUS
 EFIAPI
 XmlTreeCreate (
-  OUT XML_TREE **Tree,
-  IN  CHAR16    *Name
+  IN OUT XML_PARSER  *Parser,
+  OUT    XML_TREE   **Tree,
+  IN     CHAR16      *Name
 ) {
-  XML_TREE *Ptr;
+  EFI_STATUS  Status;
+  XML_TREE   *Ptr;
   // Check parameters
-  if ((Tree == NULL) || (Name == NULL) || (*Name == '\0')) {
+  if ((Parser == NULL) || (Tree == NULL) || (Name == NULL) || (*Name == '\0')) {
     return EFI_INVALID_PARAMETER;
   }
+  // Account for the tree node
+  Status = XmlUsageAllocate(Parser, 1, sizeof(XML_TREE), StrSize(Name));
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
   // Allocate tree node
   Ptr = (XML_TREE *)AllocateZeroPool(sizeof(XML_TREE));
   if (Ptr == NULL) {
+    XmlUsageFree(Parser, 1, sizeof(XML_TREE), StrSize(Name));
     return EFI_OUT_OF_RESOURCES;
   }
   // Set name
   Ptr->Name = StrDup(Name);
   if (Ptr->Name == NULL) {
+    XmlUsageFree(Parser, 1, sizeof(XML_TREE), StrSize(Name));
     FreePool(Ptr);
     return EFI_OUT_OF_RESOURCES;
   }
@@ -143,31 +261,42 @@ XmlTreeCreate (
 }
 // XmlAttributeCreate
 /// Create XML document tree node attribute
+/// @param Parser    The XML parser that accounts for the tree node attribute
 /// @param Attribute On output, the created tree node attribute, which needs freed with XmlAttributeFree
 /// @param Name      The name of the tree node attribute
 /// @return Whether the XML document tree node attribute was created or not
-/// @retval EFI_INVALID_PARAMETER If Attribute or Name is NULL
+/// @retval EFI_INVALID_PARAMETER If Parser, Attribute or Name is NULL
+/// @retval EFI_BUFFER_TOO_SMALL  If the tree node attribute would exceed the XML parser limits
 /// @retval EFI_OUT_OF_RESOURCES  If memory could not be allocated
 /// @retval EFI_SUCCESS           If the XML document tree node attribute was created successfully
 STATIC EFI_STATUS
 EFIAPI
 XmlAttributeCreate (
-  OUT XML_LIST **Attribute,
-  IN  CHAR16    *Name
+  IN OUT XML_PARSER  *Parser,
+  OUT    XML_LIST   **Attribute,
+  IN     CHAR16      *Name
 ) {
-  XML_LIST *Ptr;
+  EFI_STATUS  Status;
+  XML_LIST   *Ptr;
   // Check parameters
-  if ((Attribute == NULL) || (Name == NULL) || (*Name == '\0')) {
+  if ((Parser == NULL) || (Attribute == NULL) || (Name == NULL) || (*Name == '\0')) {
     return EFI_INVALID_PARAMETER;
   }
+  // Account for the tree node attribute
+  Status = XmlUsageAllocate(Parser, 0, sizeof(XML_LIST), StrSize(Name));
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
   // Allocate tree node attribute
   Ptr = (XML_LIST *)AllocateZeroPool(sizeof(XML_LIST));
   if (Ptr == NULL) {
+    XmlUsageFree(Parser, 0, sizeof(XML_LIST), StrSize(Name));
     return EFI_OUT_OF_RESOURCES;
   }
   // Set name
   Ptr->Attribute.Name = StrDup(Name);
   if (Ptr->Attribute.Name == NULL) {
+    XmlUsageFree(Parser, 0, sizeof(XML_LIST), StrSize(Name));
     FreePool(Ptr);
     return EFI_OUT_OF_RESOURCES;
   }
@@ -180,6 +309,7 @@ XmlAttributeCreate (
 }
 // XmlAttributeFree
 /// Free XML document tree node attribute
+/// @param Parser    The XML parser that accounts for the tree node attribute
 /// @param Attribute The tree node attribute to free
 /// @return Whether the XML document tree node attribute was freed or not
 /// @retval EFI_INVALID_PARAMETER If Attribute is NULL
@@ -187,59 +317,123 @@ XmlAttributeCreate (
 STATIC EFI_STATUS
 EFIAPI
 XmlAttributeFree (
-  IN XML_LIST *Attribute
+  IN OUT XML_PARSER *Parser,
+  IN     XML_LIST   *Attribute
 ) {
   // Check parameters
   if (Attribute == NULL) {
     return EFI_INVALID_PARAMETER;
   }
   if (Attribute->Attribute.Name != NULL) {
+    XmlUsageFree(Parser, 0, 0, StrSize(Attribute->Attribute.Name));
     FreePool(Attribute->Attribute.Name);
     Attribute->Attribute.Name = NULL;
   }
   if (Attribute->Attribute.Value != NULL) {
+    XmlUsageFree(Parser, 0, 0, StrSize(Attribute->Attribute.Value));
     FreePool(Attribute->Attribute.Value);
     Attribute->Attribute.Value = NULL;
   }
+  XmlUsageFree(Parser, 0, sizeof(XML_LIST), 0);
   FreePool(Attribute);
   return EFI_SUCCESS;
 }
 // XmlTreeFree
 /// Free XML document tree node
-/// @param Attribute The tree node to free
+/// @param Parser The XML parser that accounts for the tree node
+/// @param Tree   The tree node to free
 /// @return Whether the XML document tree node was freed or not
 /// @retval EFI_INVALID_PARAMETER If Tree is NULL
 /// @retval EFI_SUCCESS           If the XML document tree node was freed successfully
 STATIC EFI_STATUS
 EFIAPI
 XmlTreeFree (
-  IN XML_TREE *Tree
+  IN OUT XML_PARSER *Parser,
+  IN     XML_TREE   *Tree
 ) {
   // Check parameters
   if (Tree == NULL) {
     return EFI_INVALID_PARAMETER;
   }
   if (Tree->Name != NULL) {
+    XmlUsageFree(Parser, 0, 0, StrSize(Tree->Name));
     FreePool(Tree->Name);
     Tree->Name = NULL;
   }
   if (Tree->Value != NULL) {
+    XmlUsageFree(Parser, 0, 0, StrSize(Tree->Value));
     FreePool(Tree->Value);
     Tree->Value = NULL;
   }
   while (Tree->Attributes != NULL) {
     XML_LIST *Attribute = Tree->Attributes;
     Tree->Attributes = Attribute->Next;
-    XmlAttributeFree(Attribute);
+    XmlAttributeFree(Parser, Attribute);
   }
   while (Tree->Children != NULL) {
     XML_TREE *Child = Tree->Children;
     Tree->Children = Child->Next;
-    XmlTreeFree(Child);
+    XmlTreeFree(Parser, Child);
   }
+  XmlUsageFree(Parser, 1, sizeof(XML_TREE), 0);
   FreePool(Tree);
   return EFI_SUCCESS;
 }
+// XmlStreamOpen
+/// Send the open streaming parse event for a tree node on the XML document tree stack, if not already sent
+/// @param Parser The XML parser
+/// @param Stack  The XML document tree stack object of the tree node
+/// @return Whether parsing should continue or not
+STATIC EFI_STATUS
+EFIAPI
+XmlStreamOpen (
+  IN OUT XML_PARSER *Parser,
+  IN OUT XML_STACK  *Stack
+) {
+  if ((Parser->Stream == NULL) || (Stack->Tree == NULL) || Stack->Opened) {
+    return EFI_SUCCESS;
+  }
+  Stack->Opened = TRUE;
+  return Parser->Stream(Stack->Tree, Stack->Level, XML_STREAM_OPEN, Parser->StreamContext);
+}
+// XmlStackPop
+/// Pop the current tree node from the XML document tree stack
+/// @param Parser The XML parser
+/// @return Whether the tree node was popped or not
+/// @retval EFI_NOT_READY If the XML document tree stack is empty
+/// @retval EFI_SUCCESS   If the tree node was popped successfully
+STATIC EFI_STATUS
+EFIAPI
+XmlStackPop (
+  IN OUT XML_PARSER *Parser
+) {
+  EFI_STATUS  Status = EFI_SUCCESS;
+  XML_STACK  *Stack;
+  if (Parser->Stack == NULL) {
+    return EFI_NOT_READY;
+  }
+  Stack = Parser->Stack;
+  Parser->Stack = Stack->Previous;
+  if ((Parser->Stream != NULL) && (Stack->Tree != NULL)) {
+    // Stream the completed tree node
+    Status = XmlStreamOpen(Parser, Stack);
+    if (!EFI_ERROR(Status)) {
+      Status = Parser->Stream(Stack->Tree, Stack->Level, XML_STREAM_CLOSE, Parser->StreamContext);
+    }
+    // Streamed tree nodes other than the root are not linked into the document so free them now
+    if (Stack->Tree != Parser->Document->Tree) {
+      XmlTreeFree(Parser, Stack->Tree);
+      // The freed tree node still counts toward the document node limit
+      ++(Parser->Usage.NodeCount);
+    }
+  }
+  FreePool(Stack);
+  if (Parser->Usage.Depth > 0) {
+    --(Parser->Usage.Depth);
+  }
+  XmlUsageFree(Parser, 0, sizeof(XML_STACK), 0);
+  return Status;
+}
 
 // XmlCallback
 /// XML token parsed callback
@@ -284,8 +478,14 @@ XmlCallback (
           Length = StrLen(Stack->Tree->Value);
           if (Length > 0) {
             // Append a space
-            CHAR16 *Value = (CHAR16 *)AllocateZeroPool((++Length + 1) * sizeof(CHAR16));
+            CHAR16 *Value;
+            Status = XmlUsageAllocate(XmlParser, 0, 0, sizeof(CHAR16));
+            if (EFI_ERROR(Status)) {
+              return Status;
+            }
+            Value = (CHAR16 *)AllocateZeroPool((++Length + 1) * sizeof(CHAR16));
             if (Value == NULL) {
+              XmlUsageFree(XmlParser, 0, 0, sizeof(CHAR16));
               return EFI_OUT_OF_RESOURCES;
             }
             StrCpyS(Value, Length + 1, Stack->Tree->Value);
@@ -304,17 +504,32 @@ XmlCallback (
           UINTN Length = StrLen(Stack->Tree->Value);
           if (Length > 0) {
             // Append the token
-            UINTN Size = (Length + 1) * sizeof(CHAR16);
-            Stack->Tree->Value = ReallocatePool(Size, Size + (TokenLength * sizeof(CHAR16)), Stack->Tree->Value);
-            if (Stack->Tree->Value == NULL) {
+            CHAR16 *Value;
+            UINTN   Size = (Length + 1) * sizeof(CHAR16);
+            Status = XmlUsageAllocate(XmlParser, 0, 0, TokenLength * sizeof(CHAR16));
+            if (EFI_ERROR(Status)) {
+              return Status;
+            }
+            Value = ReallocatePool(Size, Size + (TokenLength * sizeof(CHAR16)), Stack->Tree->Value);
+            if (Value == NULL) {
+              XmlUsageFree(XmlParser, 0, 0, TokenLength * sizeof(CHAR16));
               return EFI_OUT_OF_RESOURCES;
             }
+            Stack->Tree->Value = Value;
             StrCpyS(Stack->Tree->Value + Length, TokenLength + 1, Token);
-            Stack->Tree->Value[Length + TokenLength + 1] = L'\0';
+            Stack->Tree->Value[Length + TokenLength] = L'\0';
           }
         } else {
           // Start a new value
+          Status = XmlUsageAllocate(XmlParser, 0, 0, (TokenLength + 1) * sizeof(CHAR16));
+          if (EFI_ERROR(Status)) {
+            return Status;
+          }
           Stack->Tree->Value = StrDup(Token);
+          if (Stack->Tree->Value == NULL) {
+            XmlUsageFree(XmlParser, 0, 0, (TokenLength + 1) * sizeof(CHAR16));
+            return EFI_OUT_OF_RESOURCES;
+          }
         }
       }
       break;
@@ -322,44 +537,61 @@ XmlCallback (
     case XML_LANG_STATE_TAG_NAME:
       // Check if this is an immdiate close tag
       if (StrCmp(Token, L"/>") == 0) {
-        if (XmlParser->Stack == NULL) {
-          return EFI_NOT_READY;
+        Status = XmlStackPop(XmlParser);
+        if (EFI_ERROR(Status)) {
+          return Status;
         }
-        Stack = XmlParser->Stack;
-        XmlParser->Stack = Stack->Previous;
-        FreePool(Stack);
       } else {
         // New tag name
         Tree = NULL;
+        // Open the parent for streaming before its first child
+        if (XmlParser->Stack != NULL) {
+          Status = XmlStreamOpen(XmlParser, XmlParser->Stack);
+          if (EFI_ERROR(Status)) {
+            return Status;
+          }
+        }
         // Create new tree node
-        Status = XmlTreeCreate(&Tree, Token);
+        Status = XmlTreeCreate(XmlParser, &Tree, Token);
         if (EFI_ERROR(Status)) {
           return Status;
         }
+        // Account for the new stack object
+        ++(XmlParser->Usage.Depth);
+        Status = XmlUsageAllocate(XmlParser, 0, sizeof(XML_STACK), 0);
+        if (EFI_ERROR(Status)) {
+          --(XmlParser->Usage.Depth);
+          XmlTreeFree(XmlParser, Tree);
+          return Status;
+        }
         // Allocate a new stack object
         Stack = (XML_STACK *)AllocateZeroPool(sizeof(XML_STACK));
         if (Stack == NULL) {
-          XmlTreeFree(Tree);
+          --(XmlParser->Usage.Depth);
+          XmlUsageFree(XmlParser, 0, sizeof(XML_STACK), 0);
+          XmlTreeFree(XmlParser, Tree);
           return EFI_OUT_OF_RESOURCES;
         }
         // Check if there is already a stack
         if (XmlParser->Stack == NULL) {
           // Check there is no document element
           if (XmlParser->Document->Tree != NULL) {
-            XmlTreeFree(Tree);
+            --(XmlParser->Usage.Depth);
+            XmlUsageFree(XmlParser, 0, sizeof(XML_STACK), 0);
+            XmlTreeFree(XmlParser, Tree);
             FreePool(Stack);
             return EFI_NOT_READY;
           }
           // Set the root node
           XmlParser->Document->Tree = Tree;
-          // Set the stack object
-          Stack->Previous = NULL;
-          Stack->Tree = Tree;
-          XmlParser->Stack = Stack;
         } else if (XmlParser->Stack->Tree == NULL) {
-          XmlTreeFree(Tree);
+          --(XmlParser->Usage.Depth);
+          XmlUsageFree(XmlParser, 0, sizeof(XML_STACK), 0);
+          XmlTreeFree(XmlParser, Tree);
           FreePool(Stack);
           return EFI_NOT_READY;
+        } else if (XmlParser->Stream != NULL) {
+          // Streamed tree nodes are not linked into their parent
         } else if (XmlParser->Stack->Tree->Children == NULL) {
           // Set tree as first child
           XmlParser->Stack->Tree->Children = Tree;
@@ -374,6 +606,7 @@ XmlCallback (
         // Set the stack object
         Stack->Previous = XmlParser->Stack;
         Stack->Tree = Tree;
+        Stack->Level = (Stack->Previous == NULL) ? 0 : (Stack->Previous->Level + 1);
         XmlParser->Stack = Stack;
       }
       break;
@@ -381,24 +614,23 @@ XmlCallback (
     case XML_LANG_STATE_ATTRIBUTE:
       // Check if this is an immdiate close tag
       if (StrCmp(Token, L"/>") == 0) {
-        if (XmlParser->Stack == NULL) {
-          return EFI_NOT_READY;
+        Status = XmlStackPop(XmlParser);
+        if (EFI_ERROR(Status)) {
+          return Status;
         }
-        Stack = XmlParser->Stack;
-        XmlParser->Stack = Stack->Previous;
-        FreePool(Stack);
       } else {
         // New tag attribute
         Stack = XmlParser->Stack;
         // Create attribute
         List = NULL;
-        Status = XmlAttributeCreate(&List, Token);
+        Status = XmlAttributeCreate(XmlParser, &List, Token);
         if (EFI_ERROR(Status)) {
           return Status;
         }
         // Check if document attribute
         if (Stack == NULL) {
           if (XmlParser->Document->Tree != NULL) {
+            XmlAttributeFree(XmlParser, List);
             return EFI_NOT_READY;
           }
           // Add attribute to document
@@ -413,6 +645,7 @@ XmlCallback (
           }
         } else if (Stack->Tree == NULL) {
           // No node to add attribute
+          XmlAttributeFree(XmlParser, List);
           return EFI_NOT_READY;
         } else {
           // Add attribute to tree node
@@ -432,12 +665,10 @@ XmlCallback (
     case XML_LANG_STATE_ATTRIBUTE_VALUE:
       // Check if this is an immdiate close tag
       if (StrCmp(Token, L"/>") == 0) {
-        if (XmlParser->Stack == NULL) {
-          return EFI_NOT_READY;
+        Status = XmlStackPop(XmlParser);
+        if (EFI_ERROR(Status)) {
+          return Status;
         }
-        Stack = XmlParser->Stack;
-        XmlParser->Stack = Stack->Previous;
-        FreePool(Stack);
       } else {
         // Tag attribute value
         Stack = XmlParser->Stack;
@@ -465,7 +696,15 @@ XmlCallback (
           return EFI_NOT_FOUND;
         }
         // Set the attribute value
+        Status = XmlUsageAllocate(XmlParser, 0, 0, (TokenLength + 1) * sizeof(CHAR16));
+        if (EFI_ERROR(Status)) {
+          return Status;
+        }
         List->Attribute.Value = StrDup(Token);
+        if (List->Attribute.Value == NULL) {
+          XmlUsageFree(XmlParser, 0, 0, (TokenLength + 1) * sizeof(CHAR16));
+          return EFI_OUT_OF_RESOURCES;
+        }
       }
       break;
 
@@ -478,8 +717,10 @@ XmlCallback (
         return EFI_NOT_FOUND;
       }
       // Free stack object
-      XmlParser->Stack = Stack->Previous;
-      FreePool(Stack);
+      Status = XmlStackPop(XmlParser);
+      if (EFI_ERROR(Status)) {
+        return Status;
+      }
       break;
 
     case XML_LANG_STATE_ENTITY:
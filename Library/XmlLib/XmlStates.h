@@ -57,6 +57,12 @@ struct _XML_STACK {
   // Tree
   /// The XML document tree node
   XML_TREE  *Tree;
+  // Level
+  /// The level of generation of the tree node, zero for the root
+  UINTN      Level;
+  // Opened
+  /// Whether the tree node has been opened by the streaming parse callback
+  BOOLEAN    Opened;
 
 };
 
@@ -124,7 +130,46 @@ struct _XML_PARSER {
   // Stack
   /// XML document tree stack
   XML_STACK    *Stack;
+  // Limits
+  /// XML parser limits
+  XML_LIMITS    Limits;
+  // Usage
+  /// XML parser memory usage for the current document
+  XML_USAGE     Usage;
+  // Stream
+  /// The streaming parse callback or NULL to build the document tree
+  XML_STREAM    Stream;
+  // StreamContext
+  /// The context to pass to the streaming parse callback
+  VOID         *StreamContext;
 
 };
 
+// XmlUsageUpdate
+/// Update the XML parser memory usage totals and check them against the limits
+/// @param Parser The XML parser
+/// @return Whether the XML parser memory usage is within the limits or not
+/// @retval EFI_INVALID_PARAMETER If Parser is NULL
+/// @retval EFI_BUFFER_TOO_SMALL  If the XML parser memory usage exceeds the limits
+/// @retval EFI_SUCCESS           If the XML parser memory usage is within the limits
+EFI_STATUS
+EFIAPI
+XmlUsageUpdate (
+  IN OUT XML_PARSER *Parser
+);
+// XmlUsageFree
+/// Account for memory freed from the XML document
+/// @param Parser     The XML parser or NULL if the memory is not accounted
+/// @param NodeCount  The count of tree nodes freed
+/// @param NodeSize   The size, in bytes, freed from tree nodes, attributes or the tree stack
+/// @param StringSize The size, in bytes, freed from strings
+VOID
+EFIAPI
+XmlUsageFree (
+  IN OUT XML_PARSER *Parser OPTIONAL,
+  IN     UINTN       NodeCount,
+  IN     UINTN       NodeSize,
+  IN     UINTN       StringSize
+);
+
 #endif // __XML_LIBRARY_STATES_HEADER__